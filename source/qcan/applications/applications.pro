@@ -22,4 +22,5 @@ TEMPLATE = subdirs
 # list of sub directories
 #
 SUBDIRS  = ./plugins \
-           ./server
+           ./server  \
+           ./server-daemon
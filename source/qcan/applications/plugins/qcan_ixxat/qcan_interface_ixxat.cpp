@@ -160,11 +160,41 @@ QString QCanInterfaceIxxat::name()
 // read()                                                                     //
 //                                                                            //
 //----------------------------------------------------------------------------//
-QCanInterface::InterfaceError_e QCanInterfaceIxxat::read(QCanFrame &clFrameR)
+QCanInterface::InterfaceError_e QCanInterfaceIxxat::read(QByteArray &clDataR)
 {
-   CANMSG  tsCanMsgT;
-   HRESULT slResultT;
-   int32_t slByteCntrT;
+   InterfaceError_e  teErrorT;
+   uint32_t          ulFrameCntT;
+   QCanRawFrame_ts   tsFrameT;
+   QCanFrame         clFrameT;
+
+   teErrorT = readBatch(&tsFrameT, 1, ulFrameCntT);
+   if (teErrorT == eERROR_NONE)
+   {
+      clFrameT.fromRawFrame(tsFrameT);
+      clDataR = clFrameT.toByteArray();
+   }
+
+   return (teErrorT);
+}
+
+
+//----------------------------------------------------------------------------//
+// readBatch()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e QCanInterfaceIxxat::readBatch(
+                                    QCanRawFrame_ts * ptsFrameListV,
+                                    uint32_t ulFrameMaxV,
+                                    uint32_t & ulFrameCntR)
+{
+   CANMSG            atsCanMsgT[QCAN_INTERFACE_BATCH_MAX];
+   CANMSG *          ptsCanMsgT;
+   QCanRawFrame_ts * ptsFrameT;
+   HRESULT           slResultT;
+   UINT32            ulMsgCntT;
+   UINT32            ulMsgIdxT;
+
+   ulFrameCntR = 0;
 
    //----------------------------------------------------------------
    // check lib have been loaded
@@ -175,61 +205,86 @@ QCanInterface::InterfaceError_e QCanInterfaceIxxat::read(QCanFrame &clFrameR)
    }
 
    //----------------------------------------------------------------
-   // get next message in FIFO
+   // get up to ulFrameMaxV messages from the FIFO by one call
    //
-   slResultT = pclIxxatVciP.pfnCanChannelPeekMessageP(vdCanChannelP,&tsCanMsgT);
+   ulMsgCntT = ulFrameMaxV;
+   if (ulMsgCntT > QCAN_INTERFACE_BATCH_MAX)
+   {
+      ulMsgCntT = QCAN_INTERFACE_BATCH_MAX;
+   }
+   slResultT = pclIxxatVciP.pfnCanChannelPeekMultipleMessagesP(vdCanChannelP,
+                                                               &ulMsgCntT,
+                                                               atsCanMsgT);
 
    if (slResultT == VCI_OK)
    {
-      // handle data depending on type
-      switch (tsCanMsgT.uMsgInfo.Bytes.bType)
+      for (ulMsgIdxT = 0; ulMsgIdxT < ulMsgCntT; ulMsgIdxT++)
       {
-         case CAN_MSGTYPE_DATA :
-            qDebug() << tr("handle CAN_MSGTYPE_DATA");
-
-            // copy all needed parameters to QCanFrame structure
-            if (tsCanMsgT.uMsgInfo.Bits.ext)
-            {
-               clFrameR.setIdentifier(tsCanMsgT.dwMsgId);
-            } else
-            {
-               clFrameR.setIdentifier((uint16_t)tsCanMsgT.dwMsgId);
-            }
-
-            clFrameR.setDlc(tsCanMsgT.uMsgInfo.Bits.dlc);
-
-            for (slByteCntrT = 0; slByteCntrT < clFrameR.dlc(); slByteCntrT++)
-            {
-               clFrameR.setData(slByteCntrT, tsCanMsgT.abData[slByteCntrT]);
-            }
-
-            clStatisticP.ulRcvCount++;
-
-            return eERROR_NONE;
-
-            break;
+         ptsCanMsgT = &atsCanMsgT[ulMsgIdxT];
 
-         case CAN_MSGTYPE_INFO :
-            qDebug() << tr("handle CAN_MSGTYPE_INFO");
-            break;
-
-         case CAN_MSGTYPE_ERROR :
-            qDebug() << tr("handle CAN_MSGTYPE_ERROR");
-            break;
-
-         case CAN_MSGTYPE_STATUS :
-            qDebug() << tr("handle CAN_MSGTYPE_STATUS");
-            break;
+         // handle data depending on type
+         switch (ptsCanMsgT->uMsgInfo.Bytes.bType)
+         {
+            case CAN_MSGTYPE_DATA :
+               //-----------------------------------------------
+               // copy the message directly to the frame
+               //
+               ptsFrameT = &ptsFrameListV[ulFrameCntR];
+               ptsFrameT->ubMsgCtrl  = 0;
+               if (ptsCanMsgT->uMsgInfo.Bits.ext)
+               {
+                  ptsFrameT->ulIdentifier = ptsCanMsgT->dwMsgId &
+                                            QCAN_FRAME_ID_MASK_EXT;
+                  ptsFrameT->ubMsgCtrl   |= QCAN_RAW_CTRL_EXT;
+               } else
+               {
+                  ptsFrameT->ulIdentifier = ptsCanMsgT->dwMsgId &
+                                            QCAN_FRAME_ID_MASK_STD;
+               }
+               if (ptsCanMsgT->uMsgInfo.Bits.rtr)
+               {
+                  ptsFrameT->ubMsgCtrl |= QCAN_RAW_CTRL_RTR;
+               }
+
+               ptsFrameT->ubMsgDlc   = ptsCanMsgT->uMsgInfo.Bits.dlc & 0x0F;
+               ptsFrameT->uwReserved = 0;
+               ptsFrameT->ulTimeSec  = 0;
+               ptsFrameT->ulTimeNsec = 0;
+               memcpy(ptsFrameT->aubData, ptsCanMsgT->abData,
+                      QCanData::dlcToSize(ptsFrameT->ubMsgDlc));
+
+               clStatisticP.ulRcvCount++;
+               ulFrameCntR++;
+               break;
+
+            case CAN_MSGTYPE_INFO :
+               qDebug() << tr("handle CAN_MSGTYPE_INFO");
+               break;
+
+            case CAN_MSGTYPE_ERROR :
+               qDebug() << tr("handle CAN_MSGTYPE_ERROR");
+               break;
+
+            case CAN_MSGTYPE_STATUS :
+               qDebug() << tr("handle CAN_MSGTYPE_STATUS");
+               break;
+
+            default :
+               qDebug() << tr("UNKNOWN Message Type");
+               break;
+         }
+      }
 
-         default :
-            qDebug() << tr("UNKNOWN Message Type");
-            break;
+      if (ulFrameCntR > 0)
+      {
+         return eERROR_NONE;
       }
    }
 
    else if (slResultT != (HRESULT)VCI_E_RXQUEUE_EMPTY)
    {
-      qWarning() << "QCanInterface::read() -> CanChannelPeekMessage()" <<
+      qWarning() << "QCanInterface::readBatch() -> "
+                    "CanChannelPeekMultipleMessages()" <<
                     "fail with error:" <<
                     pclIxxatVciP.formatedError((HRESULT)slResultT);
       return eERROR_DEVICE;
@@ -494,14 +549,12 @@ uint32_t QCanInterfaceIxxat::supportedFeatures()
 
 
 //----------------------------------------------------------------------------//
-// write()                                                                    //
+// waitForFrames()                                                            //
 //                                                                            //
 //----------------------------------------------------------------------------//
-QCanInterface::InterfaceError_e	QCanInterfaceIxxat::write( const QCanFrame &clFrameR)
+QCanInterface::InterfaceError_e QCanInterfaceIxxat::waitForFrames(uint32_t ulTimeoutV)
 {
-   CANMSG  tsCanMsgT;
    HRESULT slResultT;
-   int32_t slByteCntrT;
 
    //----------------------------------------------------------------
    // check lib have been loaded
@@ -512,48 +565,132 @@ QCanInterface::InterfaceError_e	QCanInterfaceIxxat::write( const QCanFrame &clFr
    }
 
    //----------------------------------------------------------------
-   // prepare CAN message
+   // block until the receive FIFO of the channel holds a message
    //
-   tsCanMsgT.uMsgInfo.Bytes.bAccept = 0;
-   tsCanMsgT.uMsgInfo.Bytes.bAddFlags = 0;
-   tsCanMsgT.uMsgInfo.Bytes.bFlags = 0;
-   tsCanMsgT.uMsgInfo.Bytes.bType = 0;
+   slResultT = pclIxxatVciP.pfnCanChannelWaitRxEventP(vdCanChannelP, ulTimeoutV);
 
-   // copy all needed parameters to QCanFrame structure
-   if (clFrameR.isExtended())
+   if (slResultT == VCI_OK)
    {
-      tsCanMsgT.uMsgInfo.Bits.ext = 1;
-   } else
+      return eERROR_NONE;
+   }
+   else if (slResultT == (HRESULT)VCI_E_TIMEOUT)
    {
-      tsCanMsgT.uMsgInfo.Bits.ext = 0;
+      return eERROR_FIFO_RCV_EMPTY;
    }
 
-   tsCanMsgT.dwMsgId = clFrameR.identifier();
+   return eERROR_DEVICE;
+}
+
+
+//----------------------------------------------------------------------------//
+// write()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e	QCanInterfaceIxxat::write( const QCanFrame &clFrameR)
+{
+   uint32_t          ulFrameCntT;
+   QCanRawFrame_ts   tsFrameT;
+
+   clFrameR.toRawFrame(tsFrameT);
+
+   return (writeBatch(&tsFrameT, 1, ulFrameCntT));
+}
 
-   tsCanMsgT.uMsgInfo.Bits.dlc = clFrameR.dlc();
 
-   for (slByteCntrT = 0; slByteCntrT < clFrameR.dlc(); slByteCntrT++)
+//----------------------------------------------------------------------------//
+// writeBatch()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e	QCanInterfaceIxxat::writeBatch(
+                                    const QCanRawFrame_ts * ptsFrameListV,
+                                    uint32_t ulFrameCntV,
+                                    uint32_t & ulFrameCntR)
+{
+   CANMSG                  atsCanMsgT[QCAN_INTERFACE_BATCH_MAX];
+   CANMSG *                ptsCanMsgT;
+   const QCanRawFrame_ts * ptsFrameT;
+   HRESULT                 slResultT;
+   UINT32                  ulMsgCntT;
+   UINT32                  ulMsgIdxT;
+
+   ulFrameCntR = 0;
+
+   //----------------------------------------------------------------
+   // check lib have been loaded
+   //
+   if (!pclIxxatVciP.isAvailable())
    {
-      tsCanMsgT.abData[slByteCntrT] = clFrameR.data(slByteCntrT);
+      return eERROR_LIBRARY;
    }
-   tsCanMsgT.uMsgInfo.Bytes.bType = CAN_MSGTYPE_DATA;
-   tsCanMsgT.dwTime = 0;
-   slResultT = pclIxxatVciP.pfnCanChannelPostMessageP(vdCanChannelP, &tsCanMsgT);
 
-   if (slResultT == VCI_OK)
+   while (ulFrameCntR < ulFrameCntV)
    {
-      qDebug() << tr("PosMessage() OK");
+      //--------------------------------------------------------
+      // prepare up to QCAN_INTERFACE_BATCH_MAX CAN messages
+      //
+      ulMsgCntT = ulFrameCntV - ulFrameCntR;
+      if (ulMsgCntT > QCAN_INTERFACE_BATCH_MAX)
+      {
+         ulMsgCntT = QCAN_INTERFACE_BATCH_MAX;
+      }
 
-      clStatisticP.ulTrmCount++;
-      return eERROR_NONE;
-   }
-   else if (slResultT != (HRESULT)VCI_E_TXQUEUE_FULL)
-   {
-      qWarning() << tr("Fail to call pfnCanChannelPostMessageP(): ") + QString::number(slResultT,16);
-      return eERROR_DEVICE;
+      for (ulMsgIdxT = 0; ulMsgIdxT < ulMsgCntT; ulMsgIdxT++)
+      {
+         ptsFrameT  = &ptsFrameListV[ulFrameCntR + ulMsgIdxT];
+         ptsCanMsgT = &atsCanMsgT[ulMsgIdxT];
+
+         ptsCanMsgT->uMsgInfo.Bytes.bAccept   = 0;
+         ptsCanMsgT->uMsgInfo.Bytes.bAddFlags = 0;
+         ptsCanMsgT->uMsgInfo.Bytes.bFlags    = 0;
+         ptsCanMsgT->uMsgInfo.Bytes.bType     = CAN_MSGTYPE_DATA;
+
+         if (ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_EXT)
+         {
+            ptsCanMsgT->uMsgInfo.Bits.ext = 1;
+         }
+         if (ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_RTR)
+         {
+            ptsCanMsgT->uMsgInfo.Bits.rtr = 1;
+         }
+
+         ptsCanMsgT->dwMsgId = ptsFrameT->ulIdentifier;
+         ptsCanMsgT->uMsgInfo.Bits.dlc = ptsFrameT->ubMsgDlc & 0x0F;
+         if (ptsCanMsgT->uMsgInfo.Bits.dlc > 8)
+         {
+            ptsCanMsgT->uMsgInfo.Bits.dlc = 8;
+         }
+         memcpy(ptsCanMsgT->abData, ptsFrameT->aubData,
+                ptsCanMsgT->uMsgInfo.Bits.dlc);
+         ptsCanMsgT->dwTime = 0;
+      }
+
+      //--------------------------------------------------------
+      // the number of messages accepted by the transmit FIFO
+      // is returned in ulMsgCntT
+      //
+      slResultT = pclIxxatVciP.pfnCanChannelPostMultipleMessagesP(vdCanChannelP,
+                                                                  &ulMsgCntT,
+                                                                  atsCanMsgT);
+      if (slResultT == VCI_OK)
+      {
+         clStatisticP.ulTrmCount += ulMsgCntT;
+         ulFrameCntR += ulMsgCntT;
+         if (ulMsgCntT == 0)
+         {
+            return eERROR_FIFO_TRM_FULL;
+         }
+      }
+      else if (slResultT != (HRESULT)VCI_E_TXQUEUE_FULL)
+      {
+         qWarning() << tr("Fail to call pfnCanChannelPostMultipleMessagesP(): ") + QString::number(slResultT,16);
+         return eERROR_DEVICE;
+      }
+      else
+      {
+         return eERROR_FIFO_TRM_FULL;
+      }
    }
 
-   return eERROR_FIFO_TRM_FULL;
+   return eERROR_NONE;
 
 }
-
@@ -128,7 +128,11 @@ public:
 
    QString           name(void) Q_DECL_OVERRIDE;
 
-   InterfaceError_e  read( QCanFrame &clFrameR) Q_DECL_OVERRIDE;
+   InterfaceError_e  read( QByteArray &clDataR) Q_DECL_OVERRIDE;
+
+   InterfaceError_e  readBatch(QCanRawFrame_ts * ptsFrameListV,
+                               uint32_t ulFrameMaxV,
+                               uint32_t & ulFrameCntR) Q_DECL_OVERRIDE;
 
    InterfaceError_e  setBitrate( int32_t slBitrateV,
                                  int32_t slBrsClockV) Q_DECL_OVERRIDE;
@@ -141,8 +145,14 @@ public:
 
    uint32_t          supportedFeatures(void) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  waitForFrames(uint32_t ulTimeoutV) Q_DECL_OVERRIDE;
+
    InterfaceError_e  write(const QCanFrame &clFrameR) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  writeBatch(const QCanRawFrame_ts * ptsFrameListV,
+                                uint32_t ulFrameCntV,
+                                uint32_t & ulFrameCntR) Q_DECL_OVERRIDE;
+
 Q_SIGNALS:
     void errorOccurred(int32_t slCanBusErrorV);
 };
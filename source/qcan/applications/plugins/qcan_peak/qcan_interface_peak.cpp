@@ -48,6 +48,15 @@ QCanInterfacePeak::QCanInterfacePeak(uint16_t uwPCanChannelV)
 
    btConnectedP = false;
    btFdUsedP = false;
+   btRcvEventP = false;
+
+   //----------------------------------------------------------------
+   // auto-reset event for the receive thread, it is registered
+   // each time the channel is initialised
+   //
+   #ifdef Q_OS_WIN32
+   hRcvEventP = CreateEvent(NULL, FALSE, FALSE, NULL);
+   #endif
 }
 
 //----------------------------------------------------------------------------//
@@ -62,6 +71,13 @@ QCanInterfacePeak::~QCanInterfacePeak()
    {
       pclPcanBasicP.unInitialize(uwPCanChannelP);
    }
+
+   #ifdef Q_OS_WIN32
+   if (hRcvEventP != NULL)
+   {
+      CloseHandle(hRcvEventP);
+   }
+   #endif
 }
 
 //----------------------------------------------------------------------------//
@@ -76,6 +92,7 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::connect(void)
       if (tsStatusT == PCAN_ERROR_OK)
       {
          btConnectedP = true;
+         setupReceiveEvent();
          return eERROR_NONE;
       }
 
@@ -109,6 +126,7 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::disconnect()
 {
    if (pclPcanBasicP.isAvailable())
    {
+      btRcvEventP = false;
       TPCANStatus tsStatusT = pclPcanBasicP.unInitialize(uwPCanChannelP);
       if (tsStatusT == PCAN_ERROR_OK)
       {
@@ -185,45 +203,104 @@ QString QCanInterfacePeak::name()
 //----------------------------------------------------------------------------//
 QCanInterface::InterfaceError_e  QCanInterfacePeak::read(QByteArray &clDataR)
 {
+   InterfaceError_e  teErrorT;
+   uint32_t          ulFrameCntT;
+   QCanRawFrame_ts   tsFrameT;
+   QCanData          clDataT(QCanData::eTYPE_CAN);
+
+   //----------------------------------------------------------------
+   // a single frame is read by the batch function and copied to
+   // a byte array for transfer
+   //
+   teErrorT = readBatch(&tsFrameT, 1, ulFrameCntT);
+   if (teErrorT == eERROR_NONE)
+   {
+      clDataT.fromRawFrame(tsFrameT);
+      clDataR = clDataT.toByteArray();
+   }
+
+   return (teErrorT);
+}
+
+
+//----------------------------------------------------------------------------//
+// readBatch()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e  QCanInterfacePeak::readBatch(
+                                    QCanRawFrame_ts * ptsFrameListV,
+                                    uint32_t ulFrameMaxV,
+                                    uint32_t & ulFrameCntR)
+{
+   InterfaceError_e  teErrorT = eERROR_NONE;
+   bool              btErrFrameT = false;
+
+   ulFrameCntR = 0;
+
    if (!pclPcanBasicP.isAvailable())
    {
       return eERROR_LIBRARY;
    }
 
-   //----------------------------------------------------------------
-   // check channel have been connected
-   //
-   #if QCAN_SUPPORT_CAN_FD > 0
-   if (btFdUsedP == true)
+   while ((ulFrameCntR < ulFrameMaxV) && (btErrFrameT == false))
    {
-      return readFD(clDataR);
+      #if QCAN_SUPPORT_CAN_FD > 0
+      if (btFdUsedP == true)
+      {
+         teErrorT = readFD(ptsFrameListV[ulFrameCntR], btErrFrameT);
+      }
+      else
+      #endif
+      {
+         teErrorT = readCAN(ptsFrameListV[ulFrameCntR], btErrFrameT);
+      }
+
+      if (teErrorT != eERROR_NONE)
+      {
+         break;
+      }
+
+      //--------------------------------------------------------
+      // the batch ends after an error frame, the bus status is
+      // reported again by the next call
+      //
+      ulFrameCntR++;
+   }
+
+   if (ulFrameCntR > 0)
+   {
+      teErrorT = eERROR_NONE;
    }
-   #endif
 
-   return readCAN(clDataR);
+   return (teErrorT);
 }
 
+
 //----------------------------------------------------------------------------//
 // readCAN()                                                                  //
 //                                                                            //
 //----------------------------------------------------------------------------//
-QCanInterface::InterfaceError_e  QCanInterfacePeak::readCAN(QByteArray &clDataR)
+QCanInterface::InterfaceError_e  QCanInterfacePeak::readCAN(
+                                    QCanRawFrame_ts & tsFrameR,
+                                    bool & btErrFrameR)
 {
    TPCANStatus       ulStatusT;
-   uint8_t           ubCntT;
    TPCANMsg          tsCanMsgT;
    TPCANTimestamp    tsCanTimeStampT;
    uint32_t          ulMicroSecsT;
-   QCanFrame         clCanFrameT;
    QCanFrameError    clErrFrameT;
-   QCanTimeStamp     clTimeStampT;
    InterfaceError_e  clRetValueT = eERROR_NONE;
    
    //----------------------------------------------------------------
-   // get next message from FIFO
+   // get next message from FIFO, status messages are skipped
    //
-   ulStatusT = pclPcanBasicP.read(uwPCanChannelP, &tsCanMsgT, 
-                                  &tsCanTimeStampT);
+   do
+   {
+      ulStatusT = pclPcanBasicP.read(uwPCanChannelP, &tsCanMsgT,
+                                     &tsCanTimeStampT);
+   }
+   while ((ulStatusT == PCAN_ERROR_OK) &&
+          ((tsCanMsgT.MSGTYPE & PCAN_MESSAGE_STATUS) > 0));
 
    
    //----------------------------------------------------------------
@@ -232,77 +309,48 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::readCAN(QByteArray &clDataR)
    if (ulStatusT == PCAN_ERROR_OK)
    {
       //--------------------------------------------------------
-      // handle data depending on type
+      // Classical CAN frame with standard or extended
+      // identifier, the message structure is copied
+      // directly to the frame
       //
-      if((tsCanMsgT.MSGTYPE & PCAN_MESSAGE_STATUS) > 0)
+      tsFrameR.ubMsgCtrl = 0;
+      if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
       {
-         //------------------------------------------------
-         // this is a status message
-         //
-         clRetValueT = eERROR_FIFO_RCV_EMPTY;
+         tsFrameR.ulIdentifier = tsCanMsgT.ID & QCAN_FRAME_ID_MASK_EXT;
+         tsFrameR.ubMsgCtrl   |= QCAN_RAW_CTRL_EXT;
       }
       else
       {
-         //------------------------------------------------
-         // Classical CAN frame with standard or
-         // extended identifier
-         //
-         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
-         {
-            clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_EXT);
-         }
-         else
-         {
-            clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_STD);
-         }
-            
-         //------------------------------------------------
-         // Classical CAN remote frame
-         //
-         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_RTR)
-         {
-            clCanFrameT.setRemote(true);
-         }
-         
-         //------------------------------------------------
-         // copy the identifier
-         //
-         clCanFrameT.setIdentifier(tsCanMsgT.ID);
+         tsFrameR.ulIdentifier = tsCanMsgT.ID & QCAN_FRAME_ID_MASK_STD;
+      }
 
-         //------------------------------------------------
-         // copy the DLC
-         //
-         clCanFrameT.setDlc(tsCanMsgT.LEN);
+      //--------------------------------------------------------
+      // Classical CAN remote frame
+      //
+      if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_RTR)
+      {
+         tsFrameR.ubMsgCtrl |= QCAN_RAW_CTRL_RTR;
+      }
 
-         //------------------------------------------------
-         // copy the data
-         //
-         for (ubCntT = 0; ubCntT < clCanFrameT.dataSize(); ubCntT++)
-         {
-            clCanFrameT.setData(ubCntT, tsCanMsgT.DATA[ubCntT]);
-         }
+      tsFrameR.ubMsgDlc   = tsCanMsgT.LEN & 0x0F;
+      tsFrameR.uwReserved = 0;
+      memcpy(tsFrameR.aubData, tsCanMsgT.DATA, 
+             QCanData::dlcToSize(tsFrameR.ubMsgDlc));
 
-         //------------------------------------------------
-         // copy the time-stamp
-         // the value is a multiple of 1 us and has a
-         // total time span of 4294,9 secs 
-         //
-         ulMicroSecsT = tsCanTimeStampT.millis * 1000;
-         ulMicroSecsT = ulMicroSecsT + tsCanTimeStampT.micros;
-         clTimeStampT.fromMicroSeconds(ulMicroSecsT);
-         
-         clCanFrameT.setTimeStamp(clTimeStampT);
-         
-         //------------------------------------------------
-         // increase statistic counter
-         //
-         clStatisticP.ulRcvCount++;
-         
-         //------------------------------------------------
-         // copy the CAN frame to a byte array for transfer
-         //
-         clDataR = clCanFrameT.toByteArray();
-      }
+      //--------------------------------------------------------
+      // copy the time-stamp
+      // the value is a multiple of 1 us and has a
+      // total time span of 4294,9 secs 
+      //
+      ulMicroSecsT = tsCanTimeStampT.millis * 1000;
+      ulMicroSecsT = ulMicroSecsT + tsCanTimeStampT.micros;
+      tsFrameR.ulTimeSec  = ulMicroSecsT / 1000000;
+      tsFrameR.ulTimeNsec = (ulMicroSecsT % 1000000) * 1000;
+
+      //--------------------------------------------------------
+      // increase statistic counter
+      //
+      clStatisticP.ulRcvCount++;
    }
    else
    {
@@ -312,10 +360,8 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::readCAN(QByteArray &clDataR)
       if ((ulStatusT & (TPCANStatus)PCAN_ERROR_ANYBUSERR) > 0)
       {
          setupErrorFrame(ulStatusT, clErrFrameT);
-         //------------------------------------------------
-         // copy the error frame to a byte array 
-         //
-         clDataR = clErrFrameT.toByteArray();
+         clErrFrameT.toRawFrame(tsFrameR);
+         btErrFrameR = true;
       }
 
       //--------------------------------------------------------
@@ -340,23 +386,26 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::readCAN(QByteArray &clDataR)
 //                                                                            //
 //----------------------------------------------------------------------------//
 #if QCAN_SUPPORT_CAN_FD > 0
-QCanInterface::InterfaceError_e  QCanInterfacePeak::readFD(QByteArray &clDataR)
+QCanInterface::InterfaceError_e  QCanInterfacePeak::readFD(
+                                    QCanRawFrame_ts & tsFrameR,
+                                    bool & btErrFrameR)
 {
    TPCANStatus       ulStatusT;
-   uint8_t           ubCntT;
    TPCANMsgFD        tsCanMsgT;
    TPCANTimestampFD  tsCanTimeStampT;
-   uint32_t          ulMicroSecsT;
-   QCanFrame         clCanFrameT;
    QCanFrameError    clErrFrameT;
-   QCanTimeStamp     clTimeStampT;
    InterfaceError_e  clRetValueT = eERROR_NONE;
 
    //----------------------------------------------------------------
-   // get next message from FIFO
+   // get next message from FIFO, status messages are skipped
    //
-   ulStatusT = pclPcanBasicP.readFD(uwPCanChannelP, &tsCanMsgT,
-                                    &tsCanTimeStampT);
+   do
+   {
+      ulStatusT = pclPcanBasicP.readFD(uwPCanChannelP, &tsCanMsgT,
+                                       &tsCanTimeStampT);
+   }
+   while ((ulStatusT == PCAN_ERROR_OK) &&
+          ((tsCanMsgT.MSGTYPE & PCAN_MESSAGE_STATUS) > 0));
 
 
    //----------------------------------------------------------------
@@ -365,116 +414,57 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::readFD(QByteArray &clDataR)
    if (ulStatusT == PCAN_ERROR_OK)
    {
       //--------------------------------------------------------
-      // handle data depending on type
+      // standard or extended identifier
       //
-      if((tsCanMsgT.MSGTYPE & PCAN_MESSAGE_STATUS) > 0)
+      tsFrameR.ubMsgCtrl = 0;
+      if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
       {
-         //------------------------------------------------
-         // this is a status message
-         //
-         clRetValueT = eERROR_FIFO_RCV_EMPTY;
+         tsFrameR.ulIdentifier = tsCanMsgT.ID & QCAN_FRAME_ID_MASK_EXT;
+         tsFrameR.ubMsgCtrl   |= QCAN_RAW_CTRL_EXT;
       }
       else
+      {
+         tsFrameR.ulIdentifier = tsCanMsgT.ID & QCAN_FRAME_ID_MASK_STD;
+      }
+
+      if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_FD)
       {
          //------------------------------------------------
-         // this is a CAN message
+         // ISO CAN FD frame, test for BRS and ESI bit
          //
-         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_FD)
+         tsFrameR.ubMsgCtrl |= QCAN_RAW_CTRL_FDF;
+         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_BRS)
          {
-            //----------------------------------------
-            // ISO CAN FD frame with standard or
-            // extended identifier
-            //
-            if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
-            {
-               clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_FD_EXT);
-            }
-            else
-            {
-               clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_FD_STD);
-            }
-
-            //----------------------------------------
-            // Test for BRS bit
-            //
-            if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_BRS)
-            {
-               clCanFrameT.setBitrateSwitch();
-            }
-
-            //----------------------------------------
-            // Test for ESI bit
-            //
-            if (tsCanMsgFdT.MSGTYPE & PCAN_MESSAGE_ESI)
-            {
-               clCanFrameT.setErrorStateIndicator();
-            }
+            tsFrameR.ubMsgCtrl |= QCAN_RAW_CTRL_BRS;
          }
-         else
+         if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_ESI)
          {
-            //----------------------------------------
-            // Classical CAN frame with standard or
-            // extended identifier
-            //
-            if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_EXTENDED)
-            {
-               clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_EXT);
-            }
-            else
-            {
-               clCanFrameT.setFrameFormat(QCanFrame::eFORMAT_CAN_STD);
-            }
-
-            //----------------------------------------
-            // Classical CAN remote frame
-            //
-            if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_RTR)
-            {
-               clCanFrameT.setRemote();
-            }
+            tsFrameR.ubMsgCtrl |= QCAN_RAW_CTRL_ESI;
          }
-
-         //------------------------------------------------
-         // copy the identifier
-         //
-         clCanFrameT.setIdentifier(tsCanMsgT.ID);
-
-         //------------------------------------------------
-         // copy the DLC
-         //
-         clCanFrameT.setDlc(tsCanMsgT.DLC);
-
-         //------------------------------------------------
-         // copy the data
-         //
-         for (ubCntT = 0; ubCntT < clCanFrameT.dataSize(); ubCntT++)
-         {
-            clCanFrameT.setData(ubCntT, tsCanMsgT.DATA[ubCntT]);
-         }
-
+      }
+      else if (tsCanMsgT.MSGTYPE & PCAN_MESSAGE_RTR)
+      {
          //------------------------------------------------
-         // copy the time-stamp
-         // the value is a multiple of 1 us and has a
-         // total time span of 4294,9 secs
+         // Classical CAN remote frame
          //
-         /*
-         ulMicroSecsT = tsCanTimeStampT.millis * 1000;
-         ulMicroSecsT = ulMicroSecsT + tsCanTimeStampT.micros;
-         clTimeStampT.fromMicroSeconds(ulMicroSecsT);
+         tsFrameR.ubMsgCtrl |= QCAN_RAW_CTRL_RTR;
+      }
 
-         clCanFrameT.setTimeStamp(clTimeStampT);
-         */
+      tsFrameR.ubMsgDlc   = tsCanMsgT.DLC & 0x0F;
+      tsFrameR.uwReserved = 0;
+      memcpy(tsFrameR.aubData, tsCanMsgT.DATA, 
+             QCanData::dlcToSize(tsFrameR.ubMsgDlc));
 
-         //------------------------------------------------
-         // increase statistic counter
-         //
-         clStatisticP.ulRcvCount++;
+      //--------------------------------------------------------
+      // copy the time-stamp, the value is a multiple of 1 us
+      //
+      tsFrameR.ulTimeSec  = (uint32_t) (tsCanTimeStampT / 1000000);
+      tsFrameR.ulTimeNsec = (uint32_t) (tsCanTimeStampT % 1000000) * 1000;
 
-         //------------------------------------------------
-         // copy the CAN frame to a byte array for transfer
-         //
-         clDataR = clCanFrameT.toByteArray();
-      }
+      //--------------------------------------------------------
+      // increase statistic counter
+      //
+      clStatisticP.ulRcvCount++;
    }
    else
    {
@@ -484,10 +474,8 @@ QCanInterface::InterfaceError_e  QCanInterfacePeak::readFD(QByteArray &clDataR)
       if ((ulStatusT & (TPCANStatus)PCAN_ERROR_ANYBUSERR) > 0)
       {
          setupErrorFrame(ulStatusT, clErrFrameT);
-         //------------------------------------------------
-         // copy the error frame to a byte array
-         //
-         clDataR = clErrFrameT.toByteArray();
+         clErrFrameT.toRawFrame(tsFrameR);
+         btErrFrameR = true;
       }
 
       //--------------------------------------------------------
@@ -676,6 +664,7 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::setBitrate( int32_t slNomBitR
    //----------------------------------------------------------------
    // perform initalisation CAN Interface
    //
+   btRcvEventP = false;
    pclPcanBasicP.unInitialize(uwPCanChannelP);
 
    if (slDatBitRateV != eCAN_BITRATE_NONE)
@@ -712,6 +701,8 @@ QCanInterface::InterfaceError_e QCanInterfacePeak::setBitrate( int32_t slNomBitR
       return eERROR_DEVICE;
    }
 
+   setupReceiveEvent();
+
    return eERROR_NONE;
 }
 
@@ -798,6 +789,35 @@ void QCanInterfacePeak::setupErrorFrame(TPCANStatus ulStatusV,
 }
 
 
+//----------------------------------------------------------------------------//
+// setupReceiveEvent()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanInterfacePeak::setupReceiveEvent(void)
+{
+   //----------------------------------------------------------------
+   // the event must be registered again after the channel has
+   // been initialised, otherwise waitForFrames() polls
+   //
+   btRcvEventP = false;
+
+   #ifdef Q_OS_WIN32
+   if (hRcvEventP != NULL)
+   {
+      TPCANStatus tsStatusT = pclPcanBasicP.setValue(uwPCanChannelP, PCAN_RECEIVE_EVENT, &hRcvEventP, sizeof(hRcvEventP));
+      if (tsStatusT == PCAN_ERROR_OK)
+      {
+         btRcvEventP = true;
+      }
+      else
+      {
+         qWarning() << QString("QCanInterfacePeak::setupReceiveEvent(0x" +QString::number(uwPCanChannelP,16)+")") << "fail with error:" << pclPcanBasicP.formatedError(tsStatusT);
+      }
+   }
+   #endif
+}
+
+
 //----------------------------------------------------------------------------//
 // state()                                                                    //
 //                                                                            //
@@ -857,87 +877,143 @@ uint32_t QCanInterfacePeak::supportedFeatures()
 }
 
 
+//----------------------------------------------------------------------------//
+// waitForFrames()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e QCanInterfacePeak::waitForFrames(uint32_t ulTimeoutV)
+{
+   if (btRcvEventP == false)
+   {
+      return eERROR_MODE;
+   }
+
+   #ifdef Q_OS_WIN32
+   switch (WaitForSingleObject(hRcvEventP, ulTimeoutV))
+   {
+      case WAIT_OBJECT_0:
+         return eERROR_NONE;
+
+      case WAIT_TIMEOUT:
+         return eERROR_FIFO_RCV_EMPTY;
+
+      default:
+         break;
+   }
+   return eERROR_DEVICE;
+   #else
+   Q_UNUSED(ulTimeoutV);
+   return eERROR_MODE;
+   #endif
+}
+
+
 //----------------------------------------------------------------------------//
 // write()                                                                    //
 //                                                                            //
 //----------------------------------------------------------------------------//
 QCanInterface::InterfaceError_e	QCanInterfacePeak::write(const QCanFrame &clFrameR)
 {
-   TPCANStatus ulStatusT;
-   TPCANMsg    tsCanMsgT;
+   uint32_t          ulFrameCntT;
+   QCanRawFrame_ts   tsFrameT;
+
+   clFrameR.toRawFrame(tsFrameT);
+
+   return (writeBatch(&tsFrameT, 1, ulFrameCntT));
+}
+
+
+//----------------------------------------------------------------------------//
+// writeBatch()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e	QCanInterfacePeak::writeBatch(
+                                    const QCanRawFrame_ts * ptsFrameListV,
+                                    uint32_t ulFrameCntV,
+                                    uint32_t & ulFrameCntR)
+{
+   TPCANStatus             ulStatusT = PCAN_ERROR_OK;
+   TPCANMsg                tsCanMsgT;
    #if QCAN_SUPPORT_CAN_FD > 0
-   TPCANMsgFD  tsCanMsgFdT;
+   TPCANMsgFD              tsCanMsgFdT;
    #endif
-   int32_t     slByteCntrT;
+   const QCanRawFrame_ts * ptsFrameT;
+
+   ulFrameCntR = 0;
 
    if (!pclPcanBasicP.isAvailable())
    {
       return eERROR_LIBRARY;
    }
 
-   //----------------------------------------------------------------
-   // prepare CAN message
-   //
-   if (clFrameR.frameFormat() < QCanFrame::eFORMAT_FD_STD)
+   while (ulFrameCntR < ulFrameCntV)
    {
-      // copy all needed parameters to QCanFrame structure
-      if (clFrameR.isExtended())
-      {
-         tsCanMsgT.MSGTYPE = PCAN_MESSAGE_EXTENDED;
-      }
-      else
+      ptsFrameT = &ptsFrameListV[ulFrameCntR];
+
+      //--------------------------------------------------------
+      // prepare CAN message
+      //
+      if ((ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_FDF) == 0)
       {
          tsCanMsgT.MSGTYPE = PCAN_MESSAGE_STANDARD;
-      }
-
-      tsCanMsgT.ID = clFrameR.identifier();
+         if (ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_EXT)
+         {
+            tsCanMsgT.MSGTYPE |= PCAN_MESSAGE_EXTENDED;
+         }
+         if (ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_RTR)
+         {
+            tsCanMsgT.MSGTYPE |= PCAN_MESSAGE_RTR;
+         }
 
-      tsCanMsgT.LEN= clFrameR.dlc();
+         tsCanMsgT.ID  = ptsFrameT->ulIdentifier;
+         tsCanMsgT.LEN = QCanData::dlcToSize(ptsFrameT->ubMsgDlc);
+         if (tsCanMsgT.LEN > 8)
+         {
+            tsCanMsgT.LEN = 8;
+         }
+         memcpy(tsCanMsgT.DATA, ptsFrameT->aubData, tsCanMsgT.LEN);
 
-      for (slByteCntrT = 0; slByteCntrT < clFrameR.dlc(); slByteCntrT++)
-      {
-         tsCanMsgT.DATA[slByteCntrT] = clFrameR.data(slByteCntrT);
+         ulStatusT = pclPcanBasicP.write(uwPCanChannelP, &tsCanMsgT);
       }
-
-      ulStatusT = pclPcanBasicP.write(uwPCanChannelP, &tsCanMsgT);
-
-   }
-   else
-   {
-      #if QCAN_SUPPORT_CAN_FD > 0
-
-      if (clFrameR.isExtended())
-      {
-         tsCanMsgFdT.MSGTYPE = PCAN_MESSAGE_EXTENDED;
-      } else
+      else
       {
-         tsCanMsgFdT.MSGTYPE  = PCAN_MESSAGE_STANDARD;
-         tsCanMsgFdT.MSGTYPE |= PCAN_MESSAGE_FD;
-         tsCanMsgFdT.MSGTYPE |= PCAN_MESSAGE_BRS;
-      }
+         #if QCAN_SUPPORT_CAN_FD > 0
+         tsCanMsgFdT.MSGTYPE = PCAN_MESSAGE_STANDARD | PCAN_MESSAGE_FD;
+         if (ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_EXT)
+         {
+            tsCanMsgFdT.MSGTYPE |= PCAN_MESSAGE_EXTENDED;
+         }
+         if (ptsFrameT->ubMsgCtrl & QCAN_RAW_CTRL_BRS)
+         {
+            tsCanMsgFdT.MSGTYPE |= PCAN_MESSAGE_BRS;
+         }
 
-      tsCanMsgFdT.ID = clFrameR.identifier();
+         tsCanMsgFdT.ID  = ptsFrameT->ulIdentifier;
+         tsCanMsgFdT.DLC = ptsFrameT->ubMsgDlc & 0x0F;
+         memcpy(tsCanMsgFdT.DATA, ptsFrameT->aubData,
+                QCanData::dlcToSize(tsCanMsgFdT.DLC));
 
-      tsCanMsgFdT.DLC= clFrameR.dlc();
+         ulStatusT = pclPcanBasicP.writeFD(uwPCanChannelP, &tsCanMsgFdT);
+         #else
+         ulStatusT = PCAN_ERROR_OK;
+         #endif
+      }
 
-      for (slByteCntrT = 0; slByteCntrT < clFrameR.dataSize(); slByteCntrT++)
+      if (ulStatusT != PCAN_ERROR_OK)
       {
-         tsCanMsgFdT.DATA[slByteCntrT] = clFrameR.data(slByteCntrT);
+         break;
       }
 
-      ulStatusT = pclPcanBasicP.writeFD(uwPCanChannelP, &tsCanMsgFdT);
-      #else
-      ulStatusT = 0;
-      #endif
+      clStatisticP.ulTrmCount++;
+      ulFrameCntR++;
    }
 
 
    if (ulStatusT == PCAN_ERROR_OK)
    {
-      clStatisticP.ulTrmCount++;
       return eERROR_NONE;
    }
-   else if (ulStatusT != (TPCANStatus)PCAN_ERROR_QRCVEMPTY)
+   else if (ulStatusT != (TPCANStatus)PCAN_ERROR_QXMTFULL)
    {
       qWarning() << "Fail to call CAN_Write(): " << QString::number(ulStatusT,16);
       return eERROR_DEVICE;
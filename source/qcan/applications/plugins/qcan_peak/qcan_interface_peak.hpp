@@ -55,23 +55,25 @@ private:
 
    /*!
     * \brief readCAN
-    * \param clFrameR
-    * \param ubChannelV
+    * \param tsFrameR
+    * \param btErrFrameR
     * \return
     *
-    * Read CAN message from peak USB device
+    * Read CAN message from peak USB device, \c btErrFrameR is set
+    * if \c tsFrameR holds an error frame
     */
-   InterfaceError_e  readCAN(QByteArray &clDataR);
+   InterfaceError_e  readCAN(QCanRawFrame_ts &tsFrameR, bool &btErrFrameR);
 
    /*!
     * \brief readFD
-    * \param clFrameR
-    * \param ubChannelV
+    * \param tsFrameR
+    * \param btErrFrameR
     * \return
     *
-    * Read CAN FD message from peak USB device
+    * Read CAN FD message from peak USB device, \c btErrFrameR is set
+    * if \c tsFrameR holds an error frame
     */
-   InterfaceError_e  readFD(QByteArray &clDataR);
+   InterfaceError_e  readFD(QCanRawFrame_ts &tsFrameR, bool &btErrFrameR);
 
    /*!
     * \brief ubChannelP
@@ -91,8 +93,24 @@ private:
 
    bool btFdUsedP;
 
+   #ifdef Q_OS_WIN32
+   /*!
+    * \brief hRcvEventP
+    * Event signalled by PCAN-Basic when a message is received
+    */
+   HANDLE hRcvEventP;
+   #endif
+
+   /*!
+    * \brief btRcvEventP
+    * The receive event is registered for the channel
+    */
+   bool btRcvEventP;
+
    void setupErrorFrame(TPCANStatus ulStatusV, QCanFrameError &clFrameR);
 
+   void setupReceiveEvent(void);
+
 public:
 
    QCanInterfacePeak(uint16_t uwPCanChannelV);
@@ -109,6 +127,10 @@ public:
    QString           name(void) Q_DECL_OVERRIDE;
 
    InterfaceError_e  read( QByteArray &clDataR) Q_DECL_OVERRIDE;
+
+   InterfaceError_e  readBatch(QCanRawFrame_ts * ptsFrameListV,
+                               uint32_t ulFrameMaxV,
+                               uint32_t & ulFrameCntR) Q_DECL_OVERRIDE;
    
    InterfaceError_e  setBitrate( int32_t slBitrateV,
                                  int32_t slBrsClockV) Q_DECL_OVERRIDE;
@@ -121,8 +143,14 @@ public:
 
    uint32_t          supportedFeatures(void) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  waitForFrames(uint32_t ulTimeoutV) Q_DECL_OVERRIDE;
+
    InterfaceError_e  write(const QCanFrame &clFrameR) Q_DECL_OVERRIDE;
 
+   InterfaceError_e  writeBatch(const QCanRawFrame_ts * ptsFrameListV,
+                                uint32_t ulFrameCntV,
+                                uint32_t & ulFrameCntR) Q_DECL_OVERRIDE;
+
 Q_SIGNALS:
     void errorOccurred(int32_t slCanBusErrorV);
 };
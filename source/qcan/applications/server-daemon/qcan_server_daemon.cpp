@@ -0,0 +1,460 @@
+//============================================================================//
+// File:          qcan_server_daemon.cpp                                      //
+// Description:   QCAN classes - Headless CAN server                          //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QPluginLoader>
+
+#if defined(Q_OS_UNIX)
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "qcan_server_daemon.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// name of the virtual CAN interface, equal to the server dialog
+//
+#define  QCAN_IF_VCAN_NAME    "Virtual CAN bus"
+
+
+/*----------------------------------------------------------------------------*\
+** Static variables                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#if defined(Q_OS_UNIX)
+//-------------------------------------------------------------------
+// the signal handler only writes to this socket pair, the signal
+// is handled inside the event loop by QCanServerDaemon::onSignal()
+//
+static int  aslSignalFdS[2];
+
+static void signalHandler(int slSignalV)
+{
+   char  cSignalT = (char) slSignalV;
+
+   if(::write(aslSignalFdS[0], &cSignalT, sizeof(cSignalT)) < 0)
+   {
+      return;
+   }
+}
+#endif
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanServerDaemon()                                                         //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanServerDaemon::QCanServerDaemon(QObject * pclParentV)
+   : QObject(pclParentV)
+{
+   pclCanServerP      = Q_NULLPTR;
+   pclSignalNotifierP = Q_NULLPTR;
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanServerDaemon()                                                        //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanServerDaemon::~QCanServerDaemon()
+{
+   //----------------------------------------------------------------
+   // stops all network threads
+   //
+   delete (pclCanServerP);
+}
+
+
+//----------------------------------------------------------------------------//
+// findInterface()                                                            //
+// search a CAN interface by name inside all plug-ins                         //
+//----------------------------------------------------------------------------//
+QCanInterface * QCanServerDaemon::findInterface(const QString & clNameR)
+{
+   uint8_t           ubIfCntT;
+   QCanInterface *   pclInterfaceT;
+   QString           clIfNameT;
+
+   foreach(QCanPlugin * pclPluginT, apclPluginP)
+   {
+      for(ubIfCntT = 0; ubIfCntT < pclPluginT->interfaceCount(); ubIfCntT++)
+      {
+         //-----------------------------------------------
+         // the name is only available after connection
+         //
+         pclInterfaceT = pclPluginT->getInterface(ubIfCntT);
+         pclInterfaceT->connect();
+         clIfNameT = pclInterfaceT->name();
+         pclInterfaceT->disconnect();
+
+         if(clIfNameT == clNameR)
+         {
+            return (pclInterfaceT);
+         }
+      }
+   }
+
+   return (Q_NULLPTR);
+}
+
+
+//----------------------------------------------------------------------------//
+// loadPlugins()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanServerDaemon::loadPlugins(const QString & clPluginPathR)
+{
+   QDir              clPluginDirT(clPluginPathR);
+   QString           clFileT;
+   QObject *         pclObjectT;
+   QCanPlugin *      pclPluginT;
+
+   if(clPluginDirT.exists() == false)
+   {
+      qWarning() << "Plug-in path" << clPluginPathR << "does not exist";
+      return (false);
+   }
+
+   foreach(QString clFileNameT, clPluginDirT.entryList(QDir::Files))
+   {
+      clFileT = clPluginDirT.absoluteFilePath(clFileNameT);
+      if(QLibrary::isLibrary(clFileT) == false)
+      {
+         continue;
+      }
+
+      QPluginLoader clLoaderT(clFileT);
+      pclObjectT = clLoaderT.instance();
+      pclPluginT = qobject_cast<QCanPlugin *>(pclObjectT);
+      if(pclPluginT != Q_NULLPTR)
+      {
+         qInfo() << "Plug-in" << pclPluginT->name() << "with" 
+                 << pclPluginT->interfaceCount() << "interfaces";
+         apclPluginP.append(pclPluginT);
+      }
+      else
+      {
+         qWarning() << "Plug-in" << clFileT << "could not be loaded:"
+                    << clLoaderT.errorString();
+      }
+   }
+
+   return (apclPluginP.isEmpty() == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// onSignal()                                                                 //
+// SIGINT or SIGTERM received                                                 //
+//----------------------------------------------------------------------------//
+void QCanServerDaemon::onSignal(void)
+{
+#if defined(Q_OS_UNIX)
+   char  cSignalT = 0;
+
+   pclSignalNotifierP->setEnabled(false);
+   if(::read(aslSignalFdS[1], &cSignalT, sizeof(cSignalT)) > 0)
+   {
+      qInfo() << "Signal" << (int) cSignalT << "received, stopping server";
+   }
+#endif
+
+   QCoreApplication::quit();
+}
+
+
+//----------------------------------------------------------------------------//
+// setupNetwork()                                                             //
+// apply the settings of one network                                          //
+//----------------------------------------------------------------------------//
+void QCanServerDaemon::setupNetwork(uint8_t ubNetworkIdxV, 
+                                    QSettings & clSettingsR)
+{
+   QCanNetwork *     pclNetworkT;
+   QCanInterface *   pclInterfaceT;
+   QString           clIfNameT;
+
+   pclNetworkT = pclCanServerP->network(ubNetworkIdxV);
+
+   clSettingsR.beginGroup("CAN " + QString::number(ubNetworkIdxV + 1));
+
+   pclNetworkT->setBitrate(clSettingsR.value("bitrateNom",
+                              eCAN_BITRATE_500K).toInt(),
+                           clSettingsR.value("bitrateDat",
+                              eCAN_BITRATE_NONE).toInt());
+
+   pclNetworkT->setErrorFramesEnabled(clSettingsR.value("errorFrame",
+                              false).toBool());
+
+   pclNetworkT->setFastDataEnabled(clSettingsR.value("canFD",
+                              false).toBool());
+
+   pclNetworkT->setListenOnlyEnabled(clSettingsR.value("listenOnly",
+                              false).toBool());
+
+   //----------------------------------------------------------------
+   // send queue of each client
+   //
+   pclNetworkT->setQueueSize(clSettingsR.value("queueSize",
+                              pclNetworkT->queueSize()).toUInt());
+
+   pclNetworkT->setQueuePolicy((QCanNetwork::QueuePolicy_e)
+                               clSettingsR.value("queuePolicy",
+                               QCanNetwork::eQUEUE_DROP_OLDEST).toInt());
+
+   //----------------------------------------------------------------
+   // frame budget of a dispatcher cycle and number of frames per
+   // round for each priority class
+   //
+   pclNetworkT->setFrameBudget(clSettingsR.value("frameBudget",
+                              pclNetworkT->frameBudget()).toUInt());
+
+   pclNetworkT->setPriorityWeight(QCanFrameApi::ePRIORITY_REALTIME,
+                              clSettingsR.value("weightRealtime",
+                              pclNetworkT->priorityWeight(
+                              QCanFrameApi::ePRIORITY_REALTIME)).toUInt());
+
+   pclNetworkT->setPriorityWeight(QCanFrameApi::ePRIORITY_NORMAL,
+                              clSettingsR.value("weightNormal",
+                              pclNetworkT->priorityWeight(
+                              QCanFrameApi::ePRIORITY_NORMAL)).toUInt());
+
+   pclNetworkT->setPriorityWeight(QCanFrameApi::ePRIORITY_BULK,
+                              clSettingsR.value("weightBulk",
+                              pclNetworkT->priorityWeight(
+                              QCanFrameApi::ePRIORITY_BULK)).toUInt());
+
+   //----------------------------------------------------------------
+   // transmit credits of each client for the CAN interface
+   //
+   pclNetworkT->setTransmitCredit(clSettingsR.value("transmitCredit",
+                              pclNetworkT->transmitCredit()).toUInt());
+
+   pclNetworkT->setTransmitConfirmEnabled(clSettingsR.value("transmitConfirm",
+                              false).toBool());
+
+   if(clSettingsR.value("cpuAffinity", -1).toInt() >= 0)
+   {
+      pclNetworkT->setCpuAffinity(clSettingsR.value("cpuAffinity",
+                                  -1).toInt());
+   }
+
+   //----------------------------------------------------------------
+   // the interface thread is started when the CAN interface
+   // is added
+   //
+   pclNetworkT->setInterfaceThreadEnabled(clSettingsR.value("interfaceThread",
+                              false).toBool());
+
+   //----------------------------------------------------------------
+   // the shared memory ring is created when the network is enabled
+   //
+   pclNetworkT->setSharedRingEnabled(clSettingsR.value("sharedRing",
+                              false).toBool());
+
+   //----------------------------------------------------------------
+   // physical CAN interface, the plug-ins are loaded on first use
+   //
+   clIfNameT = clSettingsR.value("interface", "").toString();
+   if((clIfNameT.isEmpty() == false) && (clIfNameT != QCAN_IF_VCAN_NAME))
+   {
+      if(apclPluginP.isEmpty())
+      {
+         loadPlugins(clPluginPathP);
+      }
+
+      pclInterfaceT = findInterface(clIfNameT);
+      if(pclInterfaceT == Q_NULLPTR)
+      {
+         qWarning() << "CAN" << ubNetworkIdxV + 1 
+                    << ": interface" << clIfNameT << "not found";
+      }
+      else if(pclNetworkT->addInterface(pclInterfaceT) == false)
+      {
+         qWarning() << "CAN" << ubNetworkIdxV + 1 
+                    << ": failed to add interface" << clIfNameT;
+      }
+   }
+
+   pclNetworkT->setNetworkEnabled(clSettingsR.value("enable",
+                              false).toBool());
+
+   clSettingsR.endGroup();
+}
+
+
+//----------------------------------------------------------------------------//
+// setupSignals()                                                             //
+// handle SIGINT and SIGTERM inside the event loop                            //
+//----------------------------------------------------------------------------//
+bool QCanServerDaemon::setupSignals(void)
+{
+#if defined(Q_OS_UNIX)
+   struct sigaction  tsActionT;
+
+   if(::socketpair(AF_UNIX, SOCK_STREAM, 0, aslSignalFdS) != 0)
+   {
+      return (false);
+   }
+
+   pclSignalNotifierP = new QSocketNotifier(aslSignalFdS[1], 
+                                            QSocketNotifier::Read, this);
+   connect( pclSignalNotifierP, SIGNAL(activated(int)),
+            this, SLOT(onSignal()));
+
+   memset(&tsActionT, 0, sizeof(tsActionT));
+   tsActionT.sa_handler = signalHandler;
+   sigemptyset(&tsActionT.sa_mask);
+   tsActionT.sa_flags = SA_RESTART;
+
+   if((sigaction(SIGINT,  &tsActionT, Q_NULLPTR) != 0) ||
+      (sigaction(SIGTERM, &tsActionT, Q_NULLPTR) != 0)   )
+   {
+      return (false);
+   }
+#endif
+
+   return (true);
+}
+
+
+//----------------------------------------------------------------------------//
+// start()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanServerDaemon::start(const QString & clConfigFileR, 
+                             const QString & clPluginPathR)
+{
+   uint8_t        ubNetworkNumT;
+   uint8_t        ubNetworkIdxT;
+   QHostAddress   clHostAddrT;
+
+   if(pclCanServerP != Q_NULLPTR)
+   {
+      return (false);
+   }
+
+   if(QFile::exists(clConfigFileR) == false)
+   {
+      qCritical() << "Configuration file" << clConfigFileR << "not found";
+      return (false);
+   }
+
+   QSettings clSettingsT(clConfigFileR, QSettings::IniFormat);
+   if(clSettingsT.status() != QSettings::NoError)
+   {
+      qCritical() << "Configuration file" << clConfigFileR << "is invalid";
+      return (false);
+   }
+
+   if(setupSignals() == false)
+   {
+      qWarning() << "Failed to install signal handler";
+   }
+
+   //----------------------------------------------------------------
+   // only the configured number of networks is created, this
+   // keeps the number of threads low on small gateways
+   //
+   clSettingsT.beginGroup("Server");
+   ubNetworkNumT = (uint8_t) clSettingsT.value("networks", 
+                                               QCAN_NETWORK_MAX).toUInt();
+   if((ubNetworkNumT == 0) || (ubNetworkNumT > QCAN_NETWORK_MAX))
+   {
+      ubNetworkNumT = QCAN_NETWORK_MAX;
+   }
+
+   clPluginPathP = clPluginPathR;
+   if(clPluginPathP.isEmpty())
+   {
+      clPluginPathP = clSettingsT.value("pluginPath", 
+                                        QCoreApplication::applicationDirPath() +
+                                        "/plugins").toString();
+   }
+
+   pclCanServerP = new QCanServer(Q_NULLPTR, QCAN_TCP_DEFAULT_PORT, 
+                                  ubNetworkNumT);
+
+   //----------------------------------------------------------------
+   // the host address must be set first, setServerAddress()
+   // enables the networks
+   //
+   clHostAddrT = QHostAddress(clSettingsT.value("hostAddress",
+                                                "127.0.0.1").toString());
+   pclCanServerP->setServerAddress(clHostAddrT);
+   pclCanServerP->setDispatcherTime(clSettingsT.value("dispatchTime",
+                                                      20).toUInt());
+   if(clSettingsT.value("dispatchEvent", false).toBool() == true)
+   {
+      pclCanServerP->setDispatcherMode(QCanNetwork::eDISPATCH_EVENT);
+   }
+
+   if(clSettingsT.value("metricsEnable", false).toBool() == true)
+   {
+      pclCanServerP->setMetricsPort((uint16_t) clSettingsT.value("metricsPort",
+                                    QCAN_METRICS_DEFAULT_PORT).toUInt());
+   }
+   clSettingsT.endGroup();
+
+   //----------------------------------------------------------------
+   // settings of each network
+   //
+   for(ubNetworkIdxT = 0; ubNetworkIdxT < ubNetworkNumT; ubNetworkIdxT++)
+   {
+      setupNetwork(ubNetworkIdxT, clSettingsT);
+   }
+
+   qInfo() << "CANpie server started with" << ubNetworkNumT << "networks";
+
+   return (true);
+}
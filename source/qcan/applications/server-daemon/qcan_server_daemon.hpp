@@ -0,0 +1,121 @@
+//============================================================================//
+// File:          qcan_server_daemon.hpp                                      //
+// Description:   QCAN classes - Headless CAN server                          //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_SERVER_DAEMON_HPP_
+#define QCAN_SERVER_DAEMON_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include <QIcon>
+#include <QList>
+#include <QObject>
+#include <QSettings>
+#include <QSocketNotifier>
+
+#include "qcan_plugin.hpp"
+#include "qcan_server.hpp"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class QCanServerDaemon
+** \brief Headless CAN server
+**
+** This class runs a QCanServer without any user interface. All settings
+** are taken from a configuration file in INI format, the keys are equal
+** to the settings of the server dialog:
+** \code
+** [Server]
+** networks=2
+** hostAddress=127.0.0.1
+** dispatchTime=10
+** dispatchEvent=false
+** metricsEnable=true
+** metricsPort=55680
+** pluginPath=/usr/lib/canpie/plugins
+**
+** [CAN%201]
+** enable=true
+** interface=SocketCAN can0
+** bitrateNom=6
+** bitrateDat=-1
+** \endcode
+** The group name of a network is "CAN 1" ... "CAN 8", QSettings writes
+** the space as "%20". The bit-rate values are defined by CAN_Bitrate_e
+** (6 = 500 kBit/s), the interface is selected by the name returned by
+** QCanInterface::name(). The plug-ins are only loaded if a network uses
+** a physical CAN interface. On Unix systems the server is stopped by the signals
+** SIGINT and SIGTERM.
+*/
+class QCanServerDaemon : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   QCanServerDaemon(QObject * pclParentV = Q_NULLPTR);
+
+   ~QCanServerDaemon();
+
+   /*!
+   ** \param[in]  clConfigFileR  Name of configuration file
+   ** \param[in]  clPluginPathR  Path of CAN plug-ins, the configuration
+   **                            value is used if empty
+   ** \return     \c true if the server has been started
+   **
+   ** Create the CAN server and set up all networks from the
+   ** configuration file \a clConfigFileR.
+   */
+   bool  start(const QString & clConfigFileR, const QString & clPluginPathR);
+
+private slots:
+
+   /*!
+   ** This function is called when the process receives SIGINT or
+   ** SIGTERM.
+   */
+   void  onSignal(void);
+
+private:
+
+   QCanInterface *   findInterface(const QString & clNameR);
+   bool              loadPlugins(const QString & clPluginPathR);
+   void              setupNetwork(uint8_t ubNetworkIdxV, QSettings & clSettingsR);
+   bool              setupSignals(void);
+
+   QCanServer *               pclCanServerP;
+   QList<QCanPlugin *>        apclPluginP;
+   QString                    clPluginPathP;
+   QSocketNotifier *          pclSignalNotifierP;
+};
+
+#endif   // QCAN_SERVER_DAEMON_HPP_
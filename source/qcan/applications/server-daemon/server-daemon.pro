@@ -0,0 +1,141 @@
+#=============================================================================#
+# File:          server-daemon.pro                                            #
+# Description:   qmake project file for headless QCAN server                  #
+#                                                                             #
+# Copyright (C) MicroControl GmbH & Co. KG                                    #
+# 53844 Troisdorf - Germany                                                   #
+# www.microcontrol.net                                                        #
+#                                                                             #
+#=============================================================================#
+
+#---------------------------------------------------------------
+# Name of QMake project
+#
+QMAKE_PROJECT_NAME = "CANpie Server Daemon"
+
+#---------------------------------------------------------------
+# template type
+#
+TEMPLATE = app
+
+#---------------------------------------------------------------
+# Qt modules used, the gui module is only required for the
+# declaration of QCanInterface::icon(), QtWidgets is not used
+#
+QT += core gui network
+QT -= widgets
+
+#---------------------------------------------------------------
+# target file name
+#
+TARGET = canpie-serverd
+
+#---------------------------------------------------------------
+# directory for target file
+#
+DESTDIR = ../../../../bin
+
+#--------------------------------------------------------------------
+# Objects directory
+#
+OBJECTS_DIR = ./objs/
+
+#---------------------------------------------------------------
+# project configuration and compiler options
+#
+CONFIG += debug release
+CONFIG += warn_on
+CONFIG += C++11
+CONFIG += silent
+CONFIG += console
+
+#---------------------------------------------------------------
+# version of the application
+#
+VERSION = 0.82.1
+
+#---------------------------------------------------------------
+# definitions for preprocessor
+#
+DEFINES =  
+
+#---------------------------------------------------------------
+# include directory search path
+#
+INCLUDEPATH  = .
+INCLUDEPATH += ./../../
+INCLUDEPATH += ./../../../qcan
+INCLUDEPATH += ./../../../canpie-fd
+
+#---------------------------------------------------------------
+# search path for source files
+#
+VPATH  = .
+VPATH += ./../..
+VPATH += ./../../../qcan
+VPATH += ./../../../canpie-fd
+
+#---------------------------------------------------------------
+# header files of project 
+#
+HEADERS =   qcan_interface.hpp         \
+            qcan_metric_server.hpp     \
+            qcan_network.hpp           \
+            qcan_pipe.hpp              \
+            qcan_server.hpp            \
+            qcan_server_daemon.hpp
+                
+            
+#---------------------------------------------------------------
+# source files of project 
+#
+SOURCES =   qcan_bus_load.cpp          \
+            qcan_data.cpp              \
+            qcan_filter.cpp            \
+            qcan_frame.cpp             \
+            qcan_frame_api.cpp         \
+            qcan_frame_error.cpp       \
+            qcan_frame_ring.cpp        \
+            qcan_frame_view.cpp        \
+            qcan_histogram.cpp         \
+            qcan_interface_reader.cpp  \
+            qcan_timestamp.cpp         \
+            qcan_metric_server.cpp     \
+            qcan_network.cpp           \
+            qcan_server.cpp            \
+            qcan_pipe.cpp              \
+            qcan_shared_ring.cpp       \
+            qcan_server_daemon.cpp     \
+            server_daemon_main.cpp
+
+#---------------------------------------------------------------
+# OS specific settings 
+#
+macx {
+
+   CONFIG(debug, debug|release) {
+      message("Building '$$QMAKE_PROJECT_NAME' DEBUG version for Mac OS X ...")
+   } else {
+      message("Building '$$QMAKE_PROJECT_NAME' RELEASE version for Mac OS X ...")
+      DEFINES += QT_NO_WARNING_OUTPUT
+      DEFINES += QT_NO_DEBUG_OUTPUT
+   }
+
+   #--------------------------------------------------
+   # do not create application bundle
+   #
+   CONFIG -= app_bundle
+
+   QMAKE_MAC_SDK = macosx10.12
+   QMAKE_MACOSX_DEPLOYMENT_TARGET = 10.9
+}
+
+win32 {
+   CONFIG(debug, debug|release) {
+      message("Building '$$QMAKE_PROJECT_NAME' DEBUG version for Windows ...")
+   } else {
+      message("Building '$$QMAKE_PROJECT_NAME' RELEASE version for Windows ...")
+      DEFINES += QT_NO_WARNING_OUTPUT
+      DEFINES += QT_NO_DEBUG_OUTPUT
+   }
+}
@@ -0,0 +1,53 @@
+//============================================================================//
+// File:          server_daemon_main.cpp                                      //
+// Description:   Headless CAN server                                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//============================================================================//
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include "qcan_server_daemon.hpp"
+
+
+
+int main(int argc, char *argv[])
+{
+   QCoreApplication     clAppT(argc, argv);
+   QCommandLineParser   clCmdParserT;
+   QCanServerDaemon     clDaemonT;
+
+   QCoreApplication::setApplicationName("canpie-serverd");
+   QCoreApplication::setApplicationVersion("0.82.1");
+
+   //----------------------------------------------------------------
+   // command line options
+   //
+   clCmdParserT.setApplicationDescription("Headless CANpie server");
+   clCmdParserT.addHelpOption();
+   clCmdParserT.addVersionOption();
+
+   QCommandLineOption clOptConfigT(QStringList() << "c" << "config",
+         "Read settings from <file>, default is canpie-server.ini",
+         "file", "canpie-server.ini");
+   clCmdParserT.addOption(clOptConfigT);
+
+   QCommandLineOption clOptPluginT(QStringList() << "p" << "plugins",
+         "Load CAN plug-ins from <path>",
+         "path");
+   clCmdParserT.addOption(clOptPluginT);
+
+   clCmdParserT.process(clAppT);
+
+   if(clDaemonT.start(clCmdParserT.value(clOptConfigT),
+                      clCmdParserT.value(clOptPluginT)) == false)
+   {
+      return (1);
+   }
+
+   return (clAppT.exec());
+}
@@ -117,12 +117,21 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    connect(ui.pclCbbNetDatBitrateM, SIGNAL(currentIndexChanged(int)),
            this, SLOT(onNetworkConfBitrateDat(int)));
 
+   connect(ui.pclBtnPerfResetM, SIGNAL(clicked()),
+           this, SLOT(onNetworkPerfReset()));
+
    connect(ui.pclCbbServHostM, SIGNAL(currentIndexChanged(int)),
            this, SLOT(onServerConfAddress(int)));
 
    connect(ui.pclSpnSrvTimeM, SIGNAL(valueChanged(int)),
            this, SLOT(onServerConfTime(int)));
 
+   connect(ui.pclCkbSrvEventM, SIGNAL(toggled(bool)),
+           this, SLOT(onServerConfEvent(bool)));
+
+   connect(ui.pclCkbSrvMetricsM, SIGNAL(toggled(bool)),
+           this, SLOT(onServerConfMetrics(bool)));
+
    //----------------------------------------------------------------
    // connect default signals / slots for statistic
    //
@@ -182,6 +191,26 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
       pclNetworkT->setListenOnlyEnabled(pclSettingsP->value("listenOnly",
                                  0).toBool());
 
+      //-----------------------------------------------------
+      // send queue of each client
+      //
+      pclNetworkT->setQueueSize(pclSettingsP->value("queueSize",
+                                 pclNetworkT->queueSize()).toUInt());
+
+      pclNetworkT->setQueuePolicy((QCanNetwork::QueuePolicy_e)
+                                  pclSettingsP->value("queuePolicy",
+                                  QCanNetwork::eQUEUE_DROP_OLDEST).toInt());
+
+      //-----------------------------------------------------
+      // the thread of the network is bound to a CPU only
+      // if configured
+      //
+      if(pclSettingsP->value("cpuAffinity", -1).toInt() >= 0)
+      {
+         pclNetworkT->setCpuAffinity(pclSettingsP->value("cpuAffinity",
+                                     -1).toInt());
+      }
+
       apclCanIfWidgetP[ubNetworkIdxT]->setInterface(pclSettingsP->value("interface"+QString::number(ubNetworkIdxT),"").toString());
 
       pclSettingsP->endGroup();
@@ -196,6 +225,20 @@ QCanServerDialog::QCanServerDialog(QWidget * parent)
    pclCanServerP->setServerAddress(clHostAddrT);
    pclCanServerP->setDispatcherTime(pclSettingsP->value("dispatchTime",
                                                          20).toInt());
+   if(pclSettingsP->value("dispatchEvent", false).toBool() == true)
+   {
+      pclCanServerP->setDispatcherMode(QCanNetwork::eDISPATCH_EVENT);
+   }
+
+   //-----------------------------------------------------------
+   // the metrics export is disabled by default
+   //
+   uwMetricsPortP = (uint16_t) pclSettingsP->value("metricsPort",
+                                    QCAN_METRICS_DEFAULT_PORT).toUInt();
+   if(pclSettingsP->value("metricsEnable", false).toBool() == true)
+   {
+      pclCanServerP->setMetricsPort(uwMetricsPortP);
+   }
    pclSettingsP->endGroup();
 
    //----------------------------------------------------------------
@@ -250,6 +293,9 @@ QCanServerDialog::~QCanServerDialog()
       pclSettingsP->setValue("errorFrame", pclNetworkT->isErrorFramesEnabled());
       pclSettingsP->setValue("canFD",      pclNetworkT->isFastDataEnabled());
       pclSettingsP->setValue("listenOnly", pclNetworkT->isListenOnlyEnabled());
+      pclSettingsP->setValue("cpuAffinity", pclNetworkT->cpuAffinity());
+      pclSettingsP->setValue("queueSize",  pclNetworkT->queueSize());
+      pclSettingsP->setValue("queuePolicy", (int) pclNetworkT->queuePolicy());
 
       pclSettingsP->setValue("interface"+QString::number(ubNetworkIdxT), 
                               apclCanIfWidgetP[ubNetworkIdxT]->name());
@@ -265,6 +311,14 @@ QCanServerDialog::~QCanServerDialog()
 
    pclSettingsP->setValue("dispatchTime",
                            pclCanServerP->dispatcherTime());
+
+   pclSettingsP->setValue("dispatchEvent",
+                           pclCanServerP->dispatcherMode() ==
+                           QCanNetwork::eDISPATCH_EVENT);
+
+   pclSettingsP->setValue("metricsEnable",
+                           pclCanServerP->metricsPort() != 0);
+   pclSettingsP->setValue("metricsPort", uwMetricsPortP);
    pclSettingsP->endGroup();
 
    delete(pclSettingsP);
@@ -552,6 +606,31 @@ void QCanServerDialog::onNetworkShowLoad(uint8_t ubLoadV, uint32_t ulMsgPerSecV)
 {
    ui.pclCntStatMsgM->setText(QString("%1").arg(ulMsgPerSecV));
    ui.pclPgbStatLoadM->setValue(ubLoadV);
+
+   //----------------------------------------------------------------
+   // the histograms are only updated when they are visible
+   //
+   if(ui.pclTabConfigM->currentWidget() == ui.pclTabConfigPerfM)
+   {
+      showPerformance(pclCanServerP->network(slLastNetworkIndexP));
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onNetworkPerfReset()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanServerDialog::onNetworkPerfReset(void)
+{
+   QCanNetwork *  pclNetworkT;
+
+   pclNetworkT = pclCanServerP->network(slLastNetworkIndexP);
+   if(pclNetworkT != Q_NULLPTR)
+   {
+      pclNetworkT->resetHistograms();
+      showPerformance(pclNetworkT);
+   }
 }
 
 
@@ -575,6 +654,43 @@ void QCanServerDialog::onServerConfAddress(int slIndexV)
    pclCanServerP->setServerAddress(clHostAddressT);
 }
 
+//----------------------------------------------------------------------------//
+// onServerConfEvent()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanServerDialog::onServerConfEvent(bool btEnableV)
+{
+   if(btEnableV == true)
+   {
+      pclCanServerP->setDispatcherMode(QCanNetwork::eDISPATCH_EVENT);
+   }
+   else
+   {
+      pclCanServerP->setDispatcherMode(QCanNetwork::eDISPATCH_TIMER);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onServerConfMetrics()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanServerDialog::onServerConfMetrics(bool btEnableV)
+{
+   if(btEnableV == true)
+   {
+      if(pclCanServerP->setMetricsPort(uwMetricsPortP) == false)
+      {
+         ui.pclCkbSrvMetricsM->setChecked(false);
+      }
+   }
+   else
+   {
+      pclCanServerP->setMetricsPort(0);
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // onServerConfTime()                                                         //
 //                                                                            //
@@ -611,6 +727,62 @@ void QCanServerDialog::setIcon(void)
 }
 
 
+//----------------------------------------------------------------------------//
+// showPerformance()                                                          //
+// show the dispatcher histograms of a network                                //
+//----------------------------------------------------------------------------//
+void QCanServerDialog::showPerformance(QCanNetwork * pclNetworkV)
+{
+   int32_t              slRowT;
+   int32_t              slColT;
+   uint64_t             uqDivisorT;
+   uint64_t             auqValueT[5];
+   QCanHistogram        clHistogramT;
+   QTableWidgetItem *   pclItemT;
+
+   if(pclNetworkV == Q_NULLPTR)
+   {
+      return;
+   }
+
+   for(slRowT = 0; slRowT < QCanNetwork::eHISTOGRAM_MAX; slRowT++)
+   {
+      pclNetworkV->histogram((QCanNetwork::Histogram_e) slRowT, clHistogramT);
+
+      //--------------------------------------------------------
+      // time values are measured in nanoseconds and shown in
+      // microseconds
+      //
+      if(slRowT == QCanNetwork::eHISTOGRAM_CYCLE_FRAMES)
+      {
+         uqDivisorT = 1;
+      }
+      else
+      {
+         uqDivisorT = 1000;
+      }
+
+      auqValueT[0] = clHistogramT.count();
+      auqValueT[1] = clHistogramT.minimum()        / uqDivisorT;
+      auqValueT[2] = clHistogramT.percentile(500)  / uqDivisorT;
+      auqValueT[3] = clHistogramT.percentile(990)  / uqDivisorT;
+      auqValueT[4] = clHistogramT.maximum()        / uqDivisorT;
+
+      for(slColT = 0; slColT < 5; slColT++)
+      {
+         pclItemT = ui.pclTblPerfM->item(slRowT, slColT);
+         if(pclItemT == Q_NULLPTR)
+         {
+            pclItemT = new QTableWidgetItem();
+            pclItemT->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+            ui.pclTblPerfM->setItem(slRowT, slColT, pclItemT);
+         }
+         pclItemT->setText(QString::number((qulonglong) auqValueT[slColT]));
+      }
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // updateUI()                                                                 //
 //                                                                            //
@@ -738,5 +910,8 @@ void QCanServerDialog::updateUI(uint8_t ubNetworkIdxV)
          ui.pclCbbServHostM->setCurrentIndex(1);
       }
       ui.pclSpnSrvTimeM->setValue(pclNetworkT->dispatcherTime());
+      ui.pclCkbSrvEventM->setChecked(pclNetworkT->dispatcherMode() ==
+                                     QCanNetwork::eDISPATCH_EVENT);
+      ui.pclCkbSrvMetricsM->setChecked(pclCanServerP->metricsPort() != 0);
    }
 }
@@ -46,8 +46,11 @@ private slots:
    void onNetworkConfEnable(bool btEnableV);
    void onNetworkConfErrorFrames(bool btEnableV);
    void onNetworkConfListenOnly(bool btEnableV);
+   void onNetworkPerfReset(void);
    
    void onServerConfAddress(int slIndexV);
+   void onServerConfEvent(bool btEnableV);
+   void onServerConfMetrics(bool btEnableV);
    void onServerConfTime(int slValueV);
 
 private:
@@ -56,6 +59,7 @@ private:
    void     setupNetworks(void);
    void     showNetworkConfiguration(void);
    void     setIcon(void);
+   void     showPerformance(QCanNetwork * pclNetworkV);
    void     updateUI(uint8_t ubNetworkIdxV);
 
    Ui_ServerConfig         ui;
@@ -69,6 +73,7 @@ private:
    QSettings *             pclSettingsP;
 
    int32_t                 slLastNetworkIndexP;
+   uint16_t                uwMetricsPortP;
 
    QToolBox *              pclTbxNetworkP;
    QCanInterfaceWidget *   apclCanIfWidgetP[QCAN_NETWORK_MAX];
@@ -89,7 +89,9 @@ VPATH += ./../../../canpie-fd
 #
 HEADERS =   qcan_interface_widget.hpp  \
             qcan_interface.hpp         \
+            qcan_metric_server.hpp     \
             qcan_network.hpp           \
+            qcan_pipe.hpp              \
             qcan_server.hpp            \
             qcan_server_dialog.hpp
                 
@@ -98,13 +100,22 @@ HEADERS =   qcan_interface_widget.hpp  \
 # source files of project 
 #
 SOURCES =   qcan_interface_widget.cpp  \
+            qcan_bus_load.cpp          \
             qcan_data.cpp              \
+            qcan_filter.cpp            \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_frame_ring.cpp        \
+            qcan_frame_view.cpp        \
+            qcan_histogram.cpp         \
+            qcan_interface_reader.cpp  \
             qcan_timestamp.cpp         \
+            qcan_metric_server.cpp     \
             qcan_network.cpp           \
             qcan_server.cpp            \
+            qcan_pipe.cpp              \
+            qcan_shared_ring.cpp       \
             qcan_server_dialog.cpp     \
             server_main.cpp
 
@@ -0,0 +1,667 @@
+//============================================================================//
+// File:          qcan_bench.cpp                                              //
+// Description:   Measure CAN network latency                                 //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+#include "qcan_bench.hpp"
+
+#include <QDebug>
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Maximum number of frames in flight for the throughput
+// measurement, the value must be below the send queue size of
+// the network
+//
+#define  QCAN_BENCH_WINDOW       256
+
+
+//----------------------------------------------------------------------------//
+// main()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int main(int argc, char *argv[])
+{
+   QCoreApplication clAppT(argc, argv);
+   QCoreApplication::setApplicationName("can-bench");
+   QCoreApplication::setApplicationVersion("1.0");
+
+
+   //----------------------------------------------------------------
+   // create the main class and connect the signals 'finished()' 
+   // and 'aboutToQuit()'
+   //
+   QCanBench clMainT;
+
+   QObject::connect(&clMainT, SIGNAL(finished()),
+                    &clAppT,  SLOT(quit()));
+   
+   QObject::connect(&clAppT, SIGNAL(aboutToQuit()),
+                    &clMainT, SLOT(aboutToQuitApp()));
+
+   
+   //----------------------------------------------------------------
+   // Execute command line parser after 10 ms. This will also start 
+   // the messaging engine in QT
+   //
+   QTimer::singleShot(10, &clMainT, SLOT(runCmdParser()));
+
+   clAppT.exec();
+}
+
+
+//----------------------------------------------------------------------------//
+// QCanBench()                                                                //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanBench::QCanBench(QObject *parent) :
+    QObject(parent)
+{
+   //----------------------------------------------------------------
+   // get the instance of the main application
+   //
+   pclAppP = QCoreApplication::instance();
+
+   pclNetworkP      = Q_NULLPTR;
+   ubConnectCntP    = 0;
+   ubDisconnectCntP = 0;
+   ulFrameCntP      = 0;
+   ulFrameMaxP      = 0;
+   slTransportIdxP  = 0;
+
+   //----------------------------------------------------------------
+   // connect signals for socket operations, the transmitting
+   // socket does not read any frames
+   //
+   QObject::connect(&clSockTrmP, SIGNAL(connected()),
+                    this, SLOT(socketConnected()));
+
+   QObject::connect(&clSockRcvP, SIGNAL(connected()),
+                    this, SLOT(socketConnected()));
+
+   QObject::connect(&clSockTrmP, SIGNAL(disconnected()),
+                    this, SLOT(socketDisconnected()));
+
+   QObject::connect(&clSockRcvP, SIGNAL(disconnected()),
+                    this, SLOT(socketDisconnected()));
+
+   QObject::connect(&clSockTrmP, SIGNAL(error(QAbstractSocket::SocketError)),
+                    this, SLOT(socketError(QAbstractSocket::SocketError)));
+
+   QObject::connect(&clSockRcvP, SIGNAL(error(QAbstractSocket::SocketError)),
+                    this, SLOT(socketError(QAbstractSocket::SocketError)));
+
+   QObject::connect(&clSockRcvP, SIGNAL(framesReceived(uint32_t)),
+                    this, SLOT(socketReceive(uint32_t)));
+}
+
+
+// shortly after quit is called the CoreApplication will signal this routine
+// this is a good place to delete any objects that were created in the
+// constructor and/or to stop any threads
+void QCanBench::aboutToQuitApp()
+{
+   if(pclNetworkP != Q_NULLPTR)
+   {
+      pclNetworkP->setNetworkEnabled(false);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// quit()                                                                     //
+// call this routine to quit the application                                  //
+//----------------------------------------------------------------------------//
+void QCanBench::quit()
+{
+   emit finished();
+}
+
+
+//----------------------------------------------------------------------------//
+// runCmdParser()                                                             //
+// 10ms after the application starts this method will parse all commands      //
+//----------------------------------------------------------------------------//
+void QCanBench::runCmdParser()
+{
+   QString  clTransportT;
+
+   //----------------------------------------------------------------
+   // setup command line parser
+   //
+   clCmdParserP.setApplicationDescription(tr("Measure latency and throughput of a CAN network"));
+   clCmdParserP.addHelpOption();
+   clCmdParserP.addVersionOption();
+
+   
+   //----------------------------------------------------------------
+   // argument <interface> is required
+   //
+   clCmdParserP.addPositionalArgument("interface", 
+                                      tr("CAN interface, e.g. can8"));
+
+   //-----------------------------------------------------------
+   // command line option: -c
+   //
+   QCommandLineOption clOptCodecT("c", 
+         tr("Measure frame encoding / decoding, no CAN interface is used"));
+   clCmdParserP.addOption(clOptCodecT);
+
+   //-----------------------------------------------------------
+   // command line option: -m <mode>
+   //
+   QCommandLineOption clOptModeT("m", 
+         tr("Dispatcher <mode>: timer or event"),
+         tr("mode"),
+         "timer");
+   clCmdParserP.addOption(clOptModeT);
+
+   //-----------------------------------------------------------
+   // command line option: -n <count>
+   //
+   QCommandLineOption clOptCountT("n", 
+         tr("Number of CAN frames to transmit"),
+         tr("count"),
+         "1000");
+   clCmdParserP.addOption(clOptCountT);
+
+   //-----------------------------------------------------------
+   // command line option: -t <transport>
+   //
+   QCommandLineOption clOptTransportT("t", 
+         tr("Socket <transport>: tcp, local, pipe, both (tcp and local) or all"),
+         tr("transport"),
+         "all");
+   clCmdParserP.addOption(clOptTransportT);
+
+   //-----------------------------------------------------------
+   // command line option: -T <msec>
+   //
+   QCommandLineOption clOptTimeT("T", 
+         tr("Dispatcher time in <msec>"),
+         tr("msec"),
+         "20");
+   clCmdParserP.addOption(clOptTimeT);
+
+
+   //----------------------------------------------------------------
+   // Process the actual command line arguments given by the user
+   //
+   clCmdParserP.process(*pclAppP);
+
+   //----------------------------------------------------------------
+   // number of frames
+   //
+   ulFrameMaxP = clCmdParserP.value(clOptCountT).toInt(Q_NULLPTR, 10);
+   if(ulFrameMaxP == 0)
+   {
+      ulFrameMaxP = 1;
+   }
+
+   //----------------------------------------------------------------
+   // the codec benchmark does not need a CAN interface
+   //
+   if(clCmdParserP.isSet(clOptCodecT))
+   {
+      runCodec();
+      quit();
+      return;
+   }
+
+   const QStringList clArgsT = clCmdParserP.positionalArguments();
+   if (clArgsT.size() != 1) 
+   {
+      fprintf(stderr, "%s\n", 
+              qPrintable(tr("Error: Must specify CAN interface.\n")));
+      clCmdParserP.showHelp(0);
+   }
+
+   
+   //----------------------------------------------------------------
+   // test format of argument <interface>
+   //
+   QString clInterfaceT = clArgsT.at(0);
+   if(!clInterfaceT.startsWith("can"))
+   {
+      fprintf(stderr, "%s %s\n", 
+              qPrintable(tr("Error: Unknown CAN interface ")),
+              qPrintable(clInterfaceT));
+      clCmdParserP.showHelp(0);
+   }
+   
+   //-----------------------------------------------------------
+   // convert CAN channel to uint8_t value
+   //
+   QString clIfNumT = clInterfaceT.right(clInterfaceT.size() - 3);
+   bool btConversionSuccessT;
+   int32_t slChannelT = clIfNumT.toInt(&btConversionSuccessT, 10);
+   if((btConversionSuccessT == false) ||
+      (slChannelT == 0) )
+   {
+      fprintf(stderr, "%s \n\n", 
+              qPrintable(tr("Error: CAN interface out of range")));
+      clCmdParserP.showHelp(0);
+   }
+   
+   //-----------------------------------------------------------
+   // store CAN interface channel (CAN_Channel_e)
+   //
+   ubChannelP = (uint8_t) (slChannelT);
+
+   //----------------------------------------------------------------
+   // create a CAN network inside this process, a CAN server must
+   // not run on the same channel
+   //
+   pclNetworkP = new QCanNetwork(this, QCAN_TCP_DEFAULT_PORT + ubChannelP - 1);
+   pclNetworkP->setServerAddress(QHostAddress(QHostAddress::LocalHost));
+   pclNetworkP->setDispatcherTime(clCmdParserP.value(clOptTimeT).toInt(Q_NULLPTR, 10));
+   if(clCmdParserP.value(clOptModeT) == "event")
+   {
+      pclNetworkP->setDispatcherMode(QCanNetwork::eDISPATCH_EVENT);
+   }
+   else
+   {
+      pclNetworkP->setDispatcherMode(QCanNetwork::eDISPATCH_TIMER);
+   }
+   pclNetworkP->setNetworkEnabled(true);
+
+   //----------------------------------------------------------------
+   // TCP, the local server and the in-process pipe are measured
+   // one after the other
+   //
+   clTransportT = clCmdParserP.value(clOptTransportT);
+   if((clTransportT == "tcp") || (clTransportT == "local") || 
+      (clTransportT == "pipe"))
+   {
+      clTransportListP.append(clTransportT);
+   }
+   else
+   {
+      clTransportListP.append("tcp");
+      clTransportListP.append("local");
+      if(clTransportT != "both")
+      {
+         clTransportListP.append("pipe");
+      }
+   }
+   startTransport();
+}
+
+
+//----------------------------------------------------------------------------//
+// nextTransport()                                                            //
+// disconnect the sockets and continue with the next transport                //
+//----------------------------------------------------------------------------//
+void QCanBench::nextTransport(void)
+{
+   slTransportIdxP++;
+   if(slTransportIdxP >= clTransportListP.size())
+   {
+      quit();
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // the next measurement is started by socketDisconnected()
+   //
+   ubDisconnectCntP = 0;
+   clSockTrmP.disconnectNetwork();
+   clSockRcvP.disconnectNetwork();
+}
+
+
+//----------------------------------------------------------------------------//
+// runCodec()                                                                 //
+// measure frames per second for encoding and decoding in fixed format      //
+//----------------------------------------------------------------------------//
+void QCanBench::runCodec(void)
+{
+   uint8_t        aubBufferT[QCAN_FRAME_ARRAY_SIZE];
+   uint8_t        ubModeT;
+   uint16_t       uwChecksumT;
+   uint32_t       ulCntT;
+   uint32_t       ulFailT;
+   qint64         sqTimeT;
+   QCanFrame      clFrameT;
+   QElapsedTimer  clTimerT;
+   const char *   apchModeT[] = { "qChecksum()", "table CRC", "no checksum" };
+
+   clCanFrameP = QCanFrame(QCanFrame::eFORMAT_FD_STD, 0x123, 15);
+
+   for(ubModeT = 0; ubModeT < 3; ubModeT++)
+   {
+      ulFailT = 0;
+      clTimerT.start();
+      for(ulCntT = 0; ulCntT < ulFrameMaxP; ulCntT++)
+      {
+         clCanFrameP.setDataUInt32(0, ulCntT);
+         switch(ubModeT)
+         {
+            //---------------------------------------------
+            // checksum calculation of Qt, as used before
+            // the table driven CRC
+            //
+            case 0:
+               clCanFrameP.toBuffer(aubBufferT, false);
+               uwChecksumT = qChecksum((const char *) aubBufferT, 
+                                       QCAN_FRAME_ARRAY_SIZE - 2);
+               aubBufferT[94] = (uint8_t) (uwChecksumT >> 8);
+               aubBufferT[95] = (uint8_t) (uwChecksumT >> 0);
+               if(qChecksum((const char *) aubBufferT, 
+                            QCAN_FRAME_ARRAY_SIZE - 2) != uwChecksumT)
+               {
+                  ulFailT++;
+               }
+               clFrameT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, false);
+               break;
+
+            case 1:
+               clCanFrameP.toBuffer(aubBufferT, true);
+               if(clFrameT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                      true) == false)
+               {
+                  ulFailT++;
+               }
+               break;
+
+            default:
+               clCanFrameP.toBuffer(aubBufferT, false);
+               clFrameT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, false);
+               break;
+         }
+      }
+      sqTimeT = clTimerT.nsecsElapsed();
+      if(sqTimeT == 0)
+      {
+         sqTimeT = 1;
+      }
+
+      fprintf(stdout, "%-12s %10llu %s, %u %s\n",
+              apchModeT[ubModeT],
+              (unsigned long long) ((Q_INT64_C(1000000000) * ulFrameMaxP) / 
+                                    sqTimeT),
+              qPrintable(tr("frames/s")),
+              ulFailT, qPrintable(tr("errors")));
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// sendBurst()                                                                //
+// transmit frames until the window is full                                   //
+//----------------------------------------------------------------------------//
+void QCanBench::sendBurst(void)
+{
+   QVector<QCanFrame>   clFrameListT;
+
+   clCanFrameP = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x124, 8);
+   while((ulBurstTrmP < ulFrameMaxP) && 
+         ((ulBurstTrmP - ulBurstRcvP) < QCAN_BENCH_WINDOW))
+   {
+      clCanFrameP.setDataUInt32(0, ulBurstTrmP);
+      clFrameListT.append(clCanFrameP);
+      ulBurstTrmP++;
+   }
+
+   if(clFrameListT.isEmpty() == false)
+   {
+      clSockTrmP.writeFrames(clFrameListT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// sendFrame()                                                                //
+// transmit the next frame, the payload holds the frame counter               //
+//----------------------------------------------------------------------------//
+void QCanBench::sendFrame(void)
+{
+   clCanFrameP = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x123, 4);
+   clCanFrameP.setDataUInt32(0, ulFrameCntP);
+
+   clLatencyTimerP.start();
+   clSockTrmP.writeFrame(clCanFrameP);
+}
+
+
+//----------------------------------------------------------------------------//
+// showResult()                                                               //
+// print the latency values in microseconds                                   //
+//----------------------------------------------------------------------------//
+void QCanBench::showResult(void)
+{
+   QString  clModeT;
+   QString  clTransportT;
+
+   if(pclNetworkP->dispatcherMode() == QCanNetwork::eDISPATCH_EVENT)
+   {
+      clModeT = "event";
+   }
+   else
+   {
+      clModeT = "timer";
+   }
+
+   clTransportT = clTransportListP.at(slTransportIdxP);
+   if(clTransportT == "local")
+   {
+      clTransportT += " (" + pclNetworkP->localServerName() + ")";
+   }
+
+   if(sqBurstTimeP == 0)
+   {
+      sqBurstTimeP = 1;
+   }
+
+   fprintf(stdout, "%s %s\n",
+           qPrintable(tr("Transport:")), qPrintable(clTransportT));
+   fprintf(stdout, "%s %s, %d %s\n",
+           qPrintable(tr("Dispatcher mode:")), qPrintable(clModeT),
+           ulFrameCntP, qPrintable(tr("frames")));
+   fprintf(stdout, "%s %lld / %lld / %lld us\n",
+           qPrintable(tr("Latency min / avg / max:")),
+           sqLatencyMinP / 1000,
+           (sqLatencySumP / ulFrameCntP) / 1000,
+           sqLatencyMaxP / 1000);
+   fprintf(stdout, "%s %llu %s\n",
+           qPrintable(tr("Throughput:")),
+           (unsigned long long) ((Q_INT64_C(1000000000) * ulBurstRcvP) / 
+                                 sqBurstTimeP),
+           qPrintable(tr("frames/s")));
+   fprintf(stdout, "%s %llu / %llu\n\n",
+           qPrintable(tr("Network frames / socket writes:")),
+           (unsigned long long) (pclNetworkP->frameWriteCount() - 
+                                 uqFrameWriteStartP),
+           (unsigned long long) (pclNetworkP->socketWriteCount() -
+                                 uqSocketWriteStartP));
+}
+
+
+//----------------------------------------------------------------------------//
+// socketConnected()                                                          //
+// start transmission when both sockets are connected                         //
+//----------------------------------------------------------------------------//
+void QCanBench::socketConnected()
+{
+   ubConnectCntP++;
+   if(ubConnectCntP == 2)
+   {
+      sendFrame();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// socketDisconnected()                                                       //
+// start the next transport when both sockets are disconnected                //
+//----------------------------------------------------------------------------//
+void QCanBench::socketDisconnected()
+{
+   ubDisconnectCntP++;
+   if(ubDisconnectCntP == 2)
+   {
+      //--------------------------------------------------------
+      // leave the signal handler of the socket before it is
+      // connected again
+      //
+      QTimer::singleShot(0, this, SLOT(startTransport()));
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// socketError()                                                              //
+// show error message and quit                                                //
+//----------------------------------------------------------------------------//
+void QCanBench::socketError(QAbstractSocket::SocketError teSocketErrorV)
+{
+   Q_UNUSED(teSocketErrorV);  // parameter not used 
+   
+   //----------------------------------------------------------------
+   // show error message in case the connection to the network fails
+   //
+   fprintf(stderr, "%s %s\n", 
+           qPrintable(tr("Failed to connect to CAN interface:")),
+           qPrintable(clSockTrmP.errorString()));
+   quit();
+}
+
+
+//----------------------------------------------------------------------------//
+// socketReceive()                                                            //
+// measure the latency and transmit the next frame                            //
+//----------------------------------------------------------------------------//
+void QCanBench::socketReceive(uint32_t ulFrameCntV)
+{
+   QCanFrame   clCanFrameT;
+   qint64      sqLatencyT;
+
+   //----------------------------------------------------------------
+   // throughput: count the frames of the burst and refill the
+   // window
+   //
+   if(btBurstP == true)
+   {
+      while(clSockRcvP.framesAvailable() > 0)
+      {
+         if(clSockRcvP.readFrame(clCanFrameT) == true)
+         {
+            ulBurstRcvP++;
+         }
+      }
+
+      if(ulBurstRcvP >= ulFrameMaxP)
+      {
+         sqBurstTimeP = clBurstTimerP.nsecsElapsed();
+         btBurstP     = false;
+         showResult();
+         nextTransport();
+      }
+      else
+      {
+         sendBurst();
+      }
+      return;
+   }
+   
+   while(ulFrameCntV)
+   {
+      if(clSockRcvP.readFrame(clCanFrameT) == true)
+      {
+         if(clCanFrameT.dataUInt32(0) == ulFrameCntP)
+         {
+            sqLatencyT = clLatencyTimerP.nsecsElapsed();
+            if(sqLatencyT < sqLatencyMinP) sqLatencyMinP = sqLatencyT;
+            if(sqLatencyT > sqLatencyMaxP) sqLatencyMaxP = sqLatencyT;
+            sqLatencySumP += sqLatencyT;
+
+            ulFrameCntP++;
+            if(ulFrameCntP < ulFrameMaxP)
+            {
+               sendFrame();
+            }
+            else
+            {
+               //---------------------------------------
+               // latency is done, continue with the
+               // throughput
+               //
+               btBurstP    = true;
+               ulBurstTrmP = 0;
+               ulBurstRcvP = 0;
+               clBurstTimerP.start();
+               sendBurst();
+               break;
+            }
+         }
+      }
+      ulFrameCntV--;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// startTransport()                                                           //
+// reset the measurement and connect both sockets                             //
+//----------------------------------------------------------------------------//
+void QCanBench::startTransport(void)
+{
+   QString  clTransportT = clTransportListP.at(slTransportIdxP);
+
+   ubConnectCntP = 0;
+   ulFrameCntP   = 0;
+   sqLatencyMinP = Q_INT64_C(0x7FFFFFFFFFFFFFFF);
+   sqLatencyMaxP = 0;
+   sqLatencySumP = 0;
+   btBurstP      = false;
+   ulBurstTrmP   = 0;
+   ulBurstRcvP   = 0;
+   sqBurstTimeP  = 0;
+
+   uqFrameWriteStartP  = pclNetworkP->frameWriteCount();
+   uqSocketWriteStartP = pclNetworkP->socketWriteCount();
+
+   //----------------------------------------------------------------
+   // connect both sockets to the CAN network
+   //
+   if(clTransportT == "pipe")
+   {
+      clSockTrmP.connectNetwork(pclNetworkP);
+      clSockRcvP.connectNetwork(pclNetworkP);
+   }
+   else
+   {
+      clSockTrmP.setLocalConnection(clTransportT == "local");
+      clSockRcvP.setLocalConnection(clTransportT == "local");
+      clSockTrmP.connectNetwork((CAN_Channel_e) ubChannelP);
+      clSockRcvP.connectNetwork((CAN_Channel_e) ubChannelP);
+   }
+}
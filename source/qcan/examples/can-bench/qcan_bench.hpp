@@ -0,0 +1,106 @@
+//============================================================================//
+// File:          qcan_bench.hpp                                              //
+// Description:   Measure CAN network latency                                 //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+#include <QCanNetwork>
+#include <QCanSocket>
+
+class QCanBench : public QObject
+{
+   Q_OBJECT
+
+public:
+   QCanBench(QObject *parent = 0);
+
+
+signals:
+   void finished();
+
+public slots:
+   void aboutToQuitApp(void);
+
+   void runCmdParser(void);
+
+   void socketConnected();
+   void socketDisconnected();
+   void socketError(QAbstractSocket::SocketError teSocketErrorV);
+   void socketReceive(uint32_t ulFrameCntV);
+   void quit();
+   void startTransport(void);
+   
+private:
+
+   void nextTransport(void);
+   void runCodec(void);
+   void sendBurst(void);
+   void sendFrame(void);
+   void showResult(void);
+
+   QCoreApplication *   pclAppP;
+
+   QCommandLineParser   clCmdParserP;
+   QCanNetwork *        pclNetworkP;
+   QCanSocket           clSockTrmP;
+   QCanSocket           clSockRcvP;
+   uint8_t              ubChannelP;
+   uint8_t              ubConnectCntP;
+   uint8_t              ubDisconnectCntP;
+
+   //----------------------------------------------------------------
+   // the measurement is repeated for each transport of the list:
+   // "tcp", "local" (local server) or "pipe" (in-process pipe)
+   //
+   QVector<QString>     clTransportListP;
+   int32_t              slTransportIdxP;
+   uint64_t             uqFrameWriteStartP;
+   uint64_t             uqSocketWriteStartP;
+
+   QElapsedTimer        clLatencyTimerP;
+   QCanFrame            clCanFrameP;
+   uint32_t             ulFrameMaxP;
+   uint32_t             ulFrameCntP;
+   qint64               sqLatencyMinP;
+   qint64               sqLatencyMaxP;
+   qint64               sqLatencySumP;
+
+   //----------------------------------------------------------------
+   // throughput is measured by a burst of frames, the number of
+   // frames in flight is limited by a window
+   //
+   bool                 btBurstP;
+   uint32_t             ulBurstTrmP;
+   uint32_t             ulBurstRcvP;
+   QElapsedTimer        clBurstTimerP;
+   qint64               sqBurstTimeP;
+};
+
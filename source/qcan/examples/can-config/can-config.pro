@@ -87,7 +87,8 @@ VPATH += ./../../../qcan
 #---------------------------------------------------------------
 # header files of project 
 #
-HEADERS =   qcan_socket.hpp            \
+HEADERS =   qcan_pipe.hpp              \
+            qcan_socket.hpp            \
             qcan_config.hpp
                 
             
@@ -98,6 +99,9 @@ SOURCES =   qcan_data.cpp              \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_frame_view.cpp        \
+            qcan_pipe.cpp              \
+            qcan_shared_ring.cpp       \
             qcan_socket.cpp            \
             qcan_timestamp.cpp         \
             qcan_config.cpp
@@ -312,51 +312,39 @@ void QCanDump::socketError(QAbstractSocket::SocketError teSocketErrorV)
 //----------------------------------------------------------------------------//
 void QCanDump::socketReceive(uint32_t ulFrameCntV)
 {
-   QByteArray     clCanDataT;
-   QCanFrame      clCanFrameT;
-   QCanFrameApi   clCanApiT;
-   QCanFrameError clCanErrorT;
-   QString        clCanStringT;
-   QCanData::Type_e  ubFrameTypeT;
+   QVector<QCanFrame>      clFrameListT;
+   QVector<QCanFrameApi>   clApiListT;
+   QString                 clCanStringT;
+   int32_t                 slIdxT;
    
+   Q_UNUSED(ulFrameCntV);     // all available frames are read at once
+
    if ((btQuitNeverP == false) && (ulQuitTimeP > 0))
    {
       clActivityTimerP.start(ulQuitTimeP);
    }
    
-   while(ulFrameCntV)
+   //----------------------------------------------------------------
+   // read all available frames in one pass
+   //
+   clCanSocketP.readFrames(clFrameListT, Q_NULLPTR, &clApiListT);
+
+   for(slIdxT = 0; slIdxT < clApiListT.size(); slIdxT++)
    {
-      if(clCanSocketP.read(clCanDataT, &ubFrameTypeT) == true)
-      {
-         switch(ubFrameTypeT)
-         {
-            case QCanData::eTYPE_API:
-               if (clCanApiT.fromByteArray(clCanDataT) == true)
-               {
-                  clCanStringT = clCanApiT.toString(btTimeStampP);
-                  fprintf(stderr, "%s\n", qPrintable(clCanStringT));
-               }
-               break;
-               
-            case QCanData::eTYPE_CAN:
-               if (clCanFrameT.fromByteArray(clCanDataT) == true)
-               {
-                  clCanStringT = clCanFrameT.toString(btTimeStampP);
-                  fprintf(stderr, "%s\n", qPrintable(clCanStringT));
-               }
-               break;
-
-            default:
-
-               break;
-               
-         }
-      }
-      ulFrameCntV--;
+      clCanStringT = clApiListT[slIdxT].toString(btTimeStampP);
+      fprintf(stderr, "%s\n", qPrintable(clCanStringT));
+   }
+
+   for(slIdxT = 0; slIdxT < clFrameListT.size(); slIdxT++)
+   {
+      clCanStringT = clFrameListT[slIdxT].toString(btTimeStampP);
+      fprintf(stderr, "%s\n", qPrintable(clCanStringT));
+
       ulQuitCountP--;
       if(ulQuitCountP == 0)
       {
          quit();
+         break;
       }
    }
 }
@@ -85,7 +85,11 @@ QCanSend::QCanSend(QObject *parent) :
    
    QObject::connect(&clCanSocketP, SIGNAL(error(QAbstractSocket::SocketError)),
                     this, SLOT(socketError(QAbstractSocket::SocketError)));
-   
+
+   QObject::connect(&clCanSocketP, SIGNAL(creditReceived(uint32_t)),
+                    this, SLOT(socketCredit(uint32_t)));
+
+   btCreditWaitP = false;
 }
 
 // shortly after quit is called the CoreApplication will signal this routine
@@ -348,95 +352,143 @@ void QCanSend::runCmdParser(void)
 //----------------------------------------------------------------------------//
 void QCanSend::sendFrame(void)
 {
-   QTime          clSystemTimeT;
-   QCanTimeStamp  clCanTimeT;
+   QTime                clSystemTimeT;
+   QCanTimeStamp        clCanTimeT;
+   QVector<QCanFrame>   clFrameListT;
+   int32_t              slBurstT = 1;
+   int32_t              slCreditT;
    
    clSystemTimeT = QTime::currentTime();
    clCanTimeT.fromMilliSeconds(clSystemTimeT.msec());
    clCanFrameP.setTimeStamp(clCanTimeT);
    
-   clCanSocketP.writeFrame(clCanFrameP);
+   //----------------------------------------------------------------
+   // without a time gap the frames are sent in bursts, which are
+   // passed to the socket in one call
+   //
+   if (ulFrameGapP == 0)
+   {
+      slBurstT = QCAN_SEND_BURST_MAX;
+   }
+
+   //----------------------------------------------------------------
+   // the burst is limited by the transmit credits of the socket,
+   // without credits the transmission is resumed by socketCredit()
+   //
+   slCreditT = clCanSocketP.transmitCredit();
+   if((slCreditT >= 0) && (slCreditT < slBurstT))
+   {
+      slBurstT = slCreditT;
+   }
+   if (slBurstT == 0)
+   {
+      btCreditWaitP = true;
+      return;
+   }
+   clFrameListT.reserve(slBurstT);
+
+   do
+   {
+      clFrameListT.append(clCanFrameP);
+      if (ulFrameCountP > 1)
+      {
+         ulFrameCountP--;
+         updateFrame();
+      }
+      else
+      {
+         ulFrameCountP = 0;
+      }
+   } while ((ulFrameCountP > 0) && (clFrameListT.size() < slBurstT));
+
+   clCanSocketP.writeFrames(clFrameListT);
    
-   if (ulFrameCountP > 1)
+   if (ulFrameCountP > 0)
+   {
+      QTimer::singleShot(ulFrameGapP, this, SLOT(sendFrame()));
+   }
+   else
+   {
+      QTimer::singleShot(50, this, SLOT(quit()));
+   }
+
+}
+
+
+//----------------------------------------------------------------------------//
+// updateFrame()                                                              //
+// increment identifier, DLC or payload of the CAN frame                      //
+//----------------------------------------------------------------------------//
+void QCanSend::updateFrame(void)
+{
+   //--------------------------------------------------------
+   // test if identifier value must be incemented
+   //
+   if (btIncIdP)
    {
-      ulFrameCountP--;
+      ulFrameIdP++;
       
-      //--------------------------------------------------------
-      // test if identifier value must be incemented
+      //------------------------------------------------
+      // test for wrap-around
       //
-      if (btIncIdP)
+      if (clCanFrameP.isExtended())
       {
-         ulFrameIdP++;
-         
-         //------------------------------------------------
-         // test for wrap-around
-         //
-         if (clCanFrameP.isExtended())
+         if (ulFrameIdP > QCAN_FRAME_ID_MASK_EXT)
          {
-            if (ulFrameIdP > QCAN_FRAME_ID_MASK_EXT)
-            {
-               ulFrameIdP = 0;
-            }
+            ulFrameIdP = 0;
          }
-         else
+      }
+      else
+      {
+         if (ulFrameIdP > QCAN_FRAME_ID_MASK_STD)
          {
-            if (ulFrameIdP > QCAN_FRAME_ID_MASK_STD)
-            {
-               ulFrameIdP = 0;
-            }
+            ulFrameIdP = 0;
          }
-         
-         //------------------------------------------------
-         // set new identifier value
-         //
-         clCanFrameP.setIdentifier(ulFrameIdP);
       }
       
-      //--------------------------------------------------------
-      // test if DLC value must be incemented
+      //------------------------------------------------
+      // set new identifier value
       //
-      if (btIncDlcP)
+      clCanFrameP.setIdentifier(ulFrameIdP);
+   }
+   
+   //--------------------------------------------------------
+   // test if DLC value must be incemented
+   //
+   if (btIncDlcP)
+   {
+      ubFrameDlcP++;
+      
+      //------------------------------------------------
+      // test for wrap-around
+      //
+      if (clCanFrameP.frameFormat() > QCanFrame::eFORMAT_CAN_EXT)
       {
-         ubFrameDlcP++;
-         
-         //------------------------------------------------
-         // test for wrap-around
-         //
-         if (clCanFrameP.frameFormat() > QCanFrame::eFORMAT_CAN_EXT)
+         if (ubFrameDlcP > 15)
          {
-            if (ubFrameDlcP > 15)
-            {
-               ubFrameDlcP = 0;
-            }
+            ubFrameDlcP = 0;
          }
-         else
+      }
+      else
+      {
+         if (ubFrameDlcP > 8)
          {
-            if (ubFrameDlcP > 8)
-            {
-               ubFrameDlcP = 0;
-            }
+            ubFrameDlcP = 0;
          }
-         //------------------------------------------------
-         // set new DLC value
-         //
-         clCanFrameP.setDlc(ubFrameDlcP);
-      }  
-      
-      //--------------------------------------------------------
-      // test if data value must be incemented
-      //
-      if (btIncDataP)
-      {
-         clCanFrameP.setDataUInt32(0, clCanFrameP.dataUInt32(0) + 1);
       }
-      
-      QTimer::singleShot(ulFrameGapP, this, SLOT(sendFrame()));
-   }
-   else
+      //------------------------------------------------
+      // set new DLC value
+      //
+      clCanFrameP.setDlc(ubFrameDlcP);
+   }  
+   
+   //--------------------------------------------------------
+   // test if data value must be incemented
+   //
+   if (btIncDataP)
    {
-      QTimer::singleShot(50, this, SLOT(quit()));
+      clCanFrameP.setDataUInt32(0, clCanFrameP.dataUInt32(0) + 1);
    }
-
 }
 
 
@@ -461,6 +513,22 @@ void QCanSend::socketConnected()
 }
 
 
+//----------------------------------------------------------------------------//
+// socketCredit()                                                             //
+// resume transmission after new credits have been granted                    //
+//----------------------------------------------------------------------------//
+void QCanSend::socketCredit(uint32_t ulCreditV)
+{
+   Q_UNUSED(ulCreditV);
+
+   if (btCreditWaitP == true)
+   {
+      btCreditWaitP = false;
+      sendFrame();
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // socketDisconnected()                                                       //
 // show error message and quit                                                //
@@ -31,6 +31,11 @@
 
 #include <QCanSocket>
 
+//-------------------------------------------------------------------
+// maximum number of CAN frames written in one burst
+//
+#define  QCAN_SEND_BURST_MAX     64
+
 class QCanSend : public QObject
 {
    Q_OBJECT
@@ -48,12 +53,15 @@ public slots:
 
    void sendFrame(void);
    void socketConnected();
+   void socketCredit(uint32_t ulCreditV);
    void socketDisconnected();
    void socketError(QAbstractSocket::SocketError teSocketErrorV);
    void quit();
    
 private:
 
+   void                 updateFrame(void);
+
    QCoreApplication *   pclAppP;
 
    QCommandLineParser   clCmdParserP;
@@ -70,6 +78,7 @@ private:
    bool                 btIncDlcP;
    bool                 btIncDataP;
    uint32_t             ulFrameCountP;
+   bool                 btCreditWaitP;
 };
 
 
@@ -93,6 +93,7 @@ VPATH += ./../../../canpie-fd
 HEADERS += client_demo.hpp       \
            qcan_frame.hpp        \
            qcan_interface.hpp    \
+           qcan_pipe.hpp         \
            qcan_socket.hpp
 
             
@@ -108,6 +109,8 @@ SOURCES +=  client_demo.cpp         \
             qcan_frame.cpp          \
             qcan_frame_api.cpp      \
             qcan_frame_error.cpp    \
+            qcan_pipe.cpp           \
+            qcan_shared_ring.cpp    \
             qcan_socket.cpp
             
 H
@@ -57,9 +57,11 @@ void  ClientDemo::onClientReceive(uint32_t ulFramesReceivedV)
 
    for(ulFrameCntT = 0; ulFrameCntT < ulFramesReceivedV; ulFrameCntT++)
    {
-      pclCanSocketP->readFrame(clFrameT);
-      clMsgStringT = clFrameT.toString();
-      ui.pclCanReceive->append(clMsgStringT);
+      if(pclCanSocketP->readFrame(clFrameT) == true)
+      {
+         clMsgStringT = clFrameT.toString();
+         ui.pclCanReceive->append(clMsgStringT);
+      }
    }
 
 }
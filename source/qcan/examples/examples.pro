@@ -21,7 +21,8 @@ TEMPLATE = subdirs
 #---------------------------------------------------------------
 # list of sub directories
 #
-SUBDIRS  = ./can-dump
+SUBDIRS  = ./can-bench
+SUBDIRS += ./can-dump
 SUBDIRS += ./can-send
 SUBDIRS += ./plugin_loader
 
@@ -0,0 +1,349 @@
+//============================================================================//
+// File:          qcan_bus_load.cpp                                           //
+// Description:   QCAN classes - CAN bus load                                 //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "qcan_bus_load.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// random data results in one stuff bit for about 30 bits
+//
+#define  QCAN_STUFF_TYPICAL_DIV     ((uint32_t) 30)
+
+
+/*----------------------------------------------------------------------------*\
+** Static variables                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// bit-rate in bit/s for each value of CAN_Bitrate_e
+//
+static const uint32_t aulBitrateS[] = {   10000,   20000,   50000,  100000,
+                                         125000,  250000,  500000,  800000,
+                                        1000000 };
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanBusLoad()                                                              //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanBusLoad::QCanBusLoad()
+{
+   teStuffingP   = eSTUFF_TYPICAL;
+   ulNomBitRateP = 0;
+   ulDatBitRateP = 0;
+   reset();
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanBusLoad()                                                             //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanBusLoad::~QCanBusLoad()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// addBits()                                                                  //
+// the data phase uses the data bit-rate only if the BRS bit is set           //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::addBits(uint32_t ulNomBitsV, uint32_t ulDatBitsV, bool btBrsV)
+{
+   if((btBrsV == true) && (ulDatBitRateP > 0))
+   {
+      uqNomBitCntP += ulNomBitsV;
+      uqDatBitCntP += ulDatBitsV;
+   }
+   else
+   {
+      uqNomBitCntP += ulNomBitsV + ulDatBitsV;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// addFrame()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::addFrame(const QCanFrameView & clFrameViewR)
+{
+   uint32_t ulNomBitsT;
+   uint32_t ulDatBitsT;
+
+   frameBits(clFrameViewR.frameFormat(), clFrameViewR.dlc(),
+             clFrameViewR.isRemote(), teStuffingP, ulNomBitsT, ulDatBitsT);
+   addBits(ulNomBitsT, ulDatBitsT, clFrameViewR.bitrateSwitch());
+}
+
+
+//----------------------------------------------------------------------------//
+// addFrame()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::addFrame(const QCanFrame & clFrameR)
+{
+   uint32_t ulNomBitsT;
+   uint32_t ulDatBitsT;
+
+   frameBits(clFrameR.frameFormat(), clFrameR.dlc(),
+             clFrameR.isRemote(), teStuffingP, ulNomBitsT, ulDatBitsT);
+   addBits(ulNomBitsT, ulDatBitsT, clFrameR.bitrateSwitch());
+}
+
+
+//----------------------------------------------------------------------------//
+// bitrateValue()                                                             //
+// convert bit-rate to bit/s                                                  //
+//----------------------------------------------------------------------------//
+uint32_t QCanBusLoad::bitrateValue(int32_t slBitrateV)
+{
+   uint32_t ulBitrateT = 0;
+
+   if((slBitrateV >= eCAN_BITRATE_10K) && (slBitrateV <= eCAN_BITRATE_1M))
+   {
+      ulBitrateT = aulBitrateS[slBitrateV];
+   }
+   else if((slBitrateV > eCAN_BITRATE_AUTO) && (slBitrateV <= 1000))
+   {
+      ulBitrateT = (uint32_t) slBitrateV * 1000;
+   }
+   else if(slBitrateV > 1000)
+   {
+      ulBitrateT = (uint32_t) slBitrateV;
+   }
+
+   return(ulBitrateT);
+}
+
+
+//----------------------------------------------------------------------------//
+// frameBits()                                                                //
+// number of bits of a CAN frame, refer to ISO 11898-1:2015                   //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::frameBits(QCanFrame::Format_e teFormatV, uint8_t ubDlcV,
+                            bool btRemoteV, Stuffing_e teStuffingV,
+                            uint32_t & ulNomBitsR, uint32_t & ulDatBitsR)
+{
+   uint32_t ulSizeT;
+   uint32_t ulArbBitsT;
+   uint32_t ulCtrlBitsT;
+   uint32_t ulStuffNomT = 0;
+   uint32_t ulStuffAllT = 0;
+
+   ulSizeT = QCanData::dlcToSize(ubDlcV & 0x0F);
+
+   if((teFormatV == QCanFrame::eFORMAT_CAN_STD) ||
+      (teFormatV == QCanFrame::eFORMAT_CAN_EXT)   )
+   {
+      //--------------------------------------------------------
+      // classical CAN: a remote frame has no payload, the
+      // payload of a data frame is limited to 8 bytes
+      //
+      if((btRemoteV == true) || (ulSizeT > 8))
+      {
+         ulSizeT = btRemoteV ? 0 : 8;
+      }
+
+      //--------------------------------------------------------
+      // bits from SOF to the end of the CRC field are subject
+      // to bit stuffing: 19 (standard) or 39 (extended) bits
+      // up to the DLC, the payload and 15 bits CRC
+      //
+      if(teFormatV == QCanFrame::eFORMAT_CAN_STD)
+      {
+         ulArbBitsT = 19 + 15 + (ulSizeT * 8);
+      }
+      else
+      {
+         ulArbBitsT = 39 + 15 + (ulSizeT * 8);
+      }
+
+      switch(teStuffingV)
+      {
+         case eSTUFF_TYPICAL:
+            ulStuffNomT = ulArbBitsT / QCAN_STUFF_TYPICAL_DIV;
+            break;
+
+         case eSTUFF_WORST:
+            ulStuffNomT = (ulArbBitsT - 1) / 4;
+            break;
+
+         default:
+
+            break;
+      }
+
+      //--------------------------------------------------------
+      // CRC delimiter (1), ACK slot and delimiter (2), end of
+      // frame (7) and intermission (3)
+      //
+      ulNomBitsR = ulArbBitsT + ulStuffNomT + 13;
+      ulDatBitsR = 0;
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // CAN FD: the arbitration phase ends with the BRS bit, it has
+   // 17 bits (standard) or 36 bits (extended)
+   //
+   if(teFormatV == QCanFrame::eFORMAT_FD_STD)
+   {
+      ulArbBitsT = 17;
+   }
+   else
+   {
+      ulArbBitsT = 36;
+   }
+
+   //----------------------------------------------------------------
+   // ESI bit, DLC and payload are subject to bit stuffing
+   //
+   ulCtrlBitsT = 5 + (ulSizeT * 8);
+
+   switch(teStuffingV)
+   {
+      case eSTUFF_TYPICAL:
+         ulStuffNomT = ulArbBitsT / QCAN_STUFF_TYPICAL_DIV;
+         ulStuffAllT = (ulArbBitsT + ulCtrlBitsT) / QCAN_STUFF_TYPICAL_DIV;
+         break;
+
+      case eSTUFF_WORST:
+         ulStuffNomT = (ulArbBitsT - 1) / 4;
+         ulStuffAllT = (ulArbBitsT + ulCtrlBitsT - 1) / 4;
+         break;
+
+      default:
+
+         break;
+   }
+
+   //----------------------------------------------------------------
+   // stuff count (4), CRC-17 or CRC-21 with 6 or 7 fixed stuff bits
+   // and the CRC delimiter (1)
+   //
+   if(ulSizeT <= 16)
+   {
+      ulCtrlBitsT += 4 + 17 + 6 + 1;
+   }
+   else
+   {
+      ulCtrlBitsT += 4 + 21 + 7 + 1;
+   }
+
+   //----------------------------------------------------------------
+   // ACK slot and delimiter (2), end of frame (7) and
+   // intermission (3)
+   //
+   ulNomBitsR = ulArbBitsT + ulStuffNomT + 12;
+   ulDatBitsR = ulCtrlBitsT + (ulStuffAllT - ulStuffNomT);
+}
+
+
+//----------------------------------------------------------------------------//
+// load()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint8_t QCanBusLoad::load(uint32_t ulPeriodV) const
+{
+   uint64_t uqBusTimeT;
+   uint64_t uqLoadT;
+
+   if((ulNomBitRateP == 0) || (ulPeriodV == 0))
+   {
+      return(0);
+   }
+
+   //----------------------------------------------------------------
+   // time in nanoseconds the bus was occupied
+   //
+   uqBusTimeT = (uqNomBitCntP * Q_UINT64_C(1000000000)) / ulNomBitRateP;
+   if(ulDatBitRateP > 0)
+   {
+      uqBusTimeT += (uqDatBitCntP * Q_UINT64_C(1000000000)) / ulDatBitRateP;
+   }
+
+   uqLoadT = (uqBusTimeT * 100) / ((uint64_t) ulPeriodV * 1000000);
+   if(uqLoadT > 100)
+   {
+      uqLoadT = 100;
+   }
+
+   return((uint8_t) uqLoadT);
+}
+
+
+//----------------------------------------------------------------------------//
+// reset()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::reset(void)
+{
+   uqNomBitCntP = 0;
+   uqDatBitCntP = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// setBitrate()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
+{
+   ulNomBitRateP = bitrateValue(slNomBitRateV);
+   ulDatBitRateP = bitrateValue(slDatBitRateV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setStuffing()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanBusLoad::setStuffing(Stuffing_e teStuffingV)
+{
+   teStuffingP = teStuffingV;
+}
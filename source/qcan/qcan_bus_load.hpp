@@ -0,0 +1,182 @@
+//============================================================================//
+// File:          qcan_bus_load.hpp                                           //
+// Description:   QCAN classes - CAN bus load                                 //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_BUS_LOAD_HPP_
+#define QCAN_BUS_LOAD_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include "qcan_frame.hpp"
+#include "qcan_frame_view.hpp"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanBusLoad
+** \brief   CAN bus load
+** 
+** The QCanBusLoad class estimates the bus load of a CAN network. For each
+** frame the number of bits on the bus is calculated from the frame format,
+** the DLC and the number of stuff bits (see frameBits()). Bits of the
+** arbitration phase are counted at the nominal bit-rate, bits of the data
+** phase of a CAN FD frame with BRS bit set are counted at the data
+** bit-rate.
+** <p>
+** The calculation only uses a few additions per frame, so it can be
+** called for every frame inside the dispatcher of QCanNetwork.
+*/
+class QCanBusLoad
+{
+public:
+
+   /*!
+   ** \enum    Stuffing_e
+   **
+   ** This enumeration defines how the number of stuff bits of a frame
+   ** is estimated.
+   */
+   enum Stuffing_e {
+
+      /*! No stuff bits                                  */
+      eSTUFF_NONE = 0,
+
+      /*! Stuff bits of random data (default)            */
+      eSTUFF_TYPICAL,
+
+      /*! Maximum number of stuff bits                   */
+      eSTUFF_WORST
+   };
+
+   QCanBusLoad();
+
+   ~QCanBusLoad();
+
+   /*!
+   ** \param[in]  clFrameViewR   View of CAN frame
+   **
+   ** Add the bits of the CAN frame \a clFrameViewR to the bit counters.
+   */
+   void  addFrame(const QCanFrameView & clFrameViewR);
+
+   /*!
+   ** \param[in]  clFrameR       CAN frame
+   **
+   ** Add the bits of the CAN frame \a clFrameR to the bit counters.
+   */
+   void  addFrame(const QCanFrame & clFrameR);
+
+   /*!
+   ** \param[in]  slBitrateV     Bit-rate
+   ** \return     Bit-rate in bit/s
+   **
+   ** The function converts the bit-rate \a slBitrateV into bit/s. The
+   ** value \a slBitrateV is either a value of CAN_Bitrate_e, a value in
+   ** kBit/s (up to 1000) or a value in bit/s. For #eCAN_BITRATE_NONE and
+   ** #eCAN_BITRATE_AUTO the function returns 0.
+   */
+   static uint32_t   bitrateValue(int32_t slBitrateV);
+
+   /*!
+   ** \param[in]  teFormatV      Frame format
+   ** \param[in]  ubDlcV         DLC value
+   ** \param[in]  btRemoteV      Remote frame
+   ** \param[in]  teStuffingV    Estimation of stuff bits
+   ** \param[out] ulNomBitsR     Number of bits at nominal bit-rate
+   ** \param[out] ulDatBitsR     Number of bits at data bit-rate
+   **
+   ** The function calculates the number of bits of a CAN frame including
+   ** the 3 bits of the intermission. For a CAN FD frame \a ulDatBitsR
+   ** returns the bits from ESI bit to CRC delimiter, including the fixed
+   ** stuff bits of the CRC field. The caller decides if these bits are
+   ** transmitted at the data bit-rate (BRS bit set). For classical CAN
+   ** frames \a ulDatBitsR is always 0.
+   */
+   static void       frameBits(QCanFrame::Format_e teFormatV, uint8_t ubDlcV,
+                               bool btRemoteV, Stuffing_e teStuffingV,
+                               uint32_t & ulNomBitsR, uint32_t & ulDatBitsR);
+
+   /*!
+   ** \param[in]  ulPeriodV      Measurement period in milliseconds
+   ** \return     Bus load in percent
+   **
+   ** The function returns the bus load in percent (value range 0 .. 100),
+   ** based on the bits counted during the last \a ulPeriodV milliseconds.
+   ** The bit counters are not cleared, see reset().
+   */
+   uint8_t           load(uint32_t ulPeriodV) const;
+
+   /*!
+   ** Clear the bit counters.
+   */
+   void              reset(void);
+
+   /*!
+   ** \param[in]  slNomBitRateV  Nominal bit-rate
+   ** \param[in]  slDatBitRateV  Data bit-rate
+   **
+   ** Set the bit-rates of the CAN network, see bitrateValue() for
+   ** possible values. If the data bit-rate is #eCAN_BITRATE_NONE the
+   ** data phase is counted at the nominal bit-rate.
+   */
+   void              setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV);
+
+   /*!
+   ** \param[in]  teStuffingV    Estimation of stuff bits
+   */
+   void              setStuffing(Stuffing_e teStuffingV);
+
+   /*!
+   ** \return     Estimation of stuff bits
+   */
+   Stuffing_e        stuffing(void) const    { return (teStuffingP);  };
+
+private:
+
+   void              addBits(uint32_t ulNomBitsV, uint32_t ulDatBitsV,
+                             bool btBrsV);
+
+   Stuffing_e        teStuffingP;
+   uint32_t          ulNomBitRateP;
+   uint32_t          ulDatBitRateP;
+
+   //----------------------------------------------------------------
+   // bits counted at the nominal and at the data bit-rate
+   //
+   uint64_t          uqNomBitCntP;
+   uint64_t          uqDatBitCntP;
+};
+
+
+#endif   // QCAN_BUS_LOAD_HPP_
@@ -32,6 +32,10 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#include <string.h>
+
+#include <QtEndian>
+
 #include "qcan_data.hpp"
 
 
@@ -45,6 +49,65 @@
 
 #define  QCAN_FRAME_TYPE_ERR         ((uint32_t) 0x80000000)
 
+//-------------------------------------------------------------------
+// compact format: marker in byte 0 of the byte array and flag for
+// the user / marker fields inside the message control field (byte 5)
+//
+#define  QCAN_FRAME_FORMAT_COMPACT   ((uint8_t) 0x20)
+
+#define  QCAN_COMPACT_CTRL_USER      ((uint8_t) 0x20)
+
+
+/*----------------------------------------------------------------------------*\
+** Static variables                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// number of payload bytes for each DLC value
+//
+static const uint8_t aubDlcSizeS[16] = {  0,  1,  2,  3,  4,  5,  6,  7,
+                                          8, 12, 16, 20, 24, 32, 48, 64 };
+
+//-------------------------------------------------------------------
+// CRC-16 (ISO 3309, reflected polynomial 0x8408) for one byte,
+// the result is identical to qChecksum() which uses 4-bit steps
+//
+static const uint16_t auwCrcTableS[256] = {
+   0x0000, 0x1189, 0x2312, 0x329B, 0x4624, 0x57AD, 0x6536, 0x74BF,
+   0x8C48, 0x9DC1, 0xAF5A, 0xBED3, 0xCA6C, 0xDBE5, 0xE97E, 0xF8F7,
+   0x1081, 0x0108, 0x3393, 0x221A, 0x56A5, 0x472C, 0x75B7, 0x643E,
+   0x9CC9, 0x8D40, 0xBFDB, 0xAE52, 0xDAED, 0xCB64, 0xF9FF, 0xE876,
+   0x2102, 0x308B, 0x0210, 0x1399, 0x6726, 0x76AF, 0x4434, 0x55BD,
+   0xAD4A, 0xBCC3, 0x8E58, 0x9FD1, 0xEB6E, 0xFAE7, 0xC87C, 0xD9F5,
+   0x3183, 0x200A, 0x1291, 0x0318, 0x77A7, 0x662E, 0x54B5, 0x453C,
+   0xBDCB, 0xAC42, 0x9ED9, 0x8F50, 0xFBEF, 0xEA66, 0xD8FD, 0xC974,
+   0x4204, 0x538D, 0x6116, 0x709F, 0x0420, 0x15A9, 0x2732, 0x36BB,
+   0xCE4C, 0xDFC5, 0xED5E, 0xFCD7, 0x8868, 0x99E1, 0xAB7A, 0xBAF3,
+   0x5285, 0x430C, 0x7197, 0x601E, 0x14A1, 0x0528, 0x37B3, 0x263A,
+   0xDECD, 0xCF44, 0xFDDF, 0xEC56, 0x98E9, 0x8960, 0xBBFB, 0xAA72,
+   0x6306, 0x728F, 0x4014, 0x519D, 0x2522, 0x34AB, 0x0630, 0x17B9,
+   0xEF4E, 0xFEC7, 0xCC5C, 0xDDD5, 0xA96A, 0xB8E3, 0x8A78, 0x9BF1,
+   0x7387, 0x620E, 0x5095, 0x411C, 0x35A3, 0x242A, 0x16B1, 0x0738,
+   0xFFCF, 0xEE46, 0xDCDD, 0xCD54, 0xB9EB, 0xA862, 0x9AF9, 0x8B70,
+   0x8408, 0x9581, 0xA71A, 0xB693, 0xC22C, 0xD3A5, 0xE13E, 0xF0B7,
+   0x0840, 0x19C9, 0x2B52, 0x3ADB, 0x4E64, 0x5FED, 0x6D76, 0x7CFF,
+   0x9489, 0x8500, 0xB79B, 0xA612, 0xD2AD, 0xC324, 0xF1BF, 0xE036,
+   0x18C1, 0x0948, 0x3BD3, 0x2A5A, 0x5EE5, 0x4F6C, 0x7DF7, 0x6C7E,
+   0xA50A, 0xB483, 0x8618, 0x9791, 0xE32E, 0xF2A7, 0xC03C, 0xD1B5,
+   0x2942, 0x38CB, 0x0A50, 0x1BD9, 0x6F66, 0x7EEF, 0x4C74, 0x5DFD,
+   0xB58B, 0xA402, 0x9699, 0x8710, 0xF3AF, 0xE226, 0xD0BD, 0xC134,
+   0x39C3, 0x284A, 0x1AD1, 0x0B58, 0x7FE7, 0x6E6E, 0x5CF5, 0x4D7C,
+   0xC60C, 0xD785, 0xE51E, 0xF497, 0x8028, 0x91A1, 0xA33A, 0xB2B3,
+   0x4A44, 0x5BCD, 0x6956, 0x78DF, 0x0C60, 0x1DE9, 0x2F72, 0x3EFB,
+   0xD68D, 0xC704, 0xF59F, 0xE416, 0x90A9, 0x8120, 0xB3BB, 0xA232,
+   0x5AC5, 0x4B4C, 0x79D7, 0x685E, 0x1CE1, 0x0D68, 0x3FF3, 0x2E7A,
+   0xE70E, 0xF687, 0xC41C, 0xD595, 0xA12A, 0xB0A3, 0x8238, 0x93B1,
+   0x6B46, 0x7ACF, 0x4854, 0x59DD, 0x2D62, 0x3CEB, 0x0E70, 0x1FF9,
+   0xF78F, 0xE606, 0xD49D, 0xC514, 0xB1AB, 0xA022, 0x92B9, 0x8330,
+   0x7BC7, 0x6A4E, 0x58D5, 0x495C, 0x3DE3, 0x2C6A, 0x1EF1, 0x0F78
+};
+
 /*----------------------------------------------------------------------------*\
 ** Class methods                                                              **
 **                                                                            **
@@ -78,6 +141,205 @@ QCanData::QCanData(const Type_e & ubTypeR)
 }
 
 
+//----------------------------------------------------------------------------//
+// arraySize()                                                                //
+// size of frame inside byte array                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanData::arraySize(const QByteArray & clByteArrayR, int32_t slPosV)
+{
+   if((slPosV < 0) || (slPosV >= clByteArrayR.size()))
+   {
+      return(0);
+   }
+
+   return(bufferSize((const uint8_t *) clByteArrayR.constData() + slPosV,
+                     clByteArrayR.size() - slPosV));
+}
+
+
+//----------------------------------------------------------------------------//
+// bufferSize()                                                               //
+// size of frame inside buffer                                                //
+//----------------------------------------------------------------------------//
+int32_t QCanData::bufferSize(const uint8_t * pubBufferV, int32_t slSizeV)
+{
+   int32_t  slSizeT = 0;
+
+   if((pubBufferV != Q_NULLPTR) && (slSizeV > 0))
+   {
+      if((pubBufferV[0] & 0xE0) == QCAN_FRAME_FORMAT_COMPACT)
+      {
+         //-----------------------------------------------------
+         // the size of a frame in compact format is defined
+         // by the DLC (byte 4) and the control field (byte 5)
+         //
+         if(slSizeV >= 6)
+         {
+            slSizeT = QCAN_FRAME_COMPACT_SIZE + aubDlcSizeS[pubBufferV[4] & 0x0F];
+            if((pubBufferV[5] & QCAN_COMPACT_CTRL_USER) > 0)
+            {
+               slSizeT += 8;
+            }
+         }
+      }
+      else
+      {
+         slSizeT = QCAN_FRAME_ARRAY_SIZE;
+      }
+   }
+
+   return(slSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// checksum()                                                                 //
+// calculate CRC-16 with one table lookup per byte                            //
+//----------------------------------------------------------------------------//
+uint16_t QCanData::checksum(const uint8_t * pubBufferV, int32_t slSizeV)
+{
+   uint16_t uwCrcT = 0xFFFF;
+
+   while(slSizeV > 0)
+   {
+      uwCrcT = (uwCrcT >> 8) ^ auwCrcTableS[(uwCrcT ^ *pubBufferV) & 0xFF];
+      pubBufferV++;
+      slSizeV--;
+   }
+
+   return((uint16_t) ~uwCrcT);
+}
+
+
+//----------------------------------------------------------------------------//
+// convertToCompact()                                                         //
+// convert CAN frame from fixed format to compact format                      //
+//----------------------------------------------------------------------------//
+QByteArray QCanData::convertToCompact(const QByteArray & clByteArrayR)
+{
+   QByteArray     clCompactT;
+   const char *   pchDataT;
+   bool           btUserT = false;
+   uint8_t        ubSizeT;
+
+   //----------------------------------------------------------------
+   // only CAN frames are converted
+   //
+   if((clByteArrayR.size() < QCAN_FRAME_ARRAY_SIZE) ||
+      ((clByteArrayR.at(0) & 0xE0) != 0))
+   {
+      return(clByteArrayR);
+   }
+
+   pchDataT = clByteArrayR.constData();
+   ubSizeT  = aubDlcSizeS[pchDataT[4] & 0x0F];
+
+   //----------------------------------------------------------------
+   // user and marker field (byte 78 .. 85) are only copied if
+   // they are used
+   //
+   for(uint8_t ubPosT = 78; ubPosT < 86; ubPosT++)
+   {
+      if(pchDataT[ubPosT] != 0)
+      {
+         btUserT = true;
+         break;
+      }
+   }
+
+   clCompactT.reserve(QCAN_FRAME_COMPACT_SIZE + 8 + ubSizeT);
+
+   //----------------------------------------------------------------
+   // identifier, DLC and control field, timestamp, user / marker
+   // and payload
+   //
+   clCompactT.append(pchDataT, 6);
+   clCompactT[0] = (char) (clCompactT.at(0) | QCAN_FRAME_FORMAT_COMPACT);
+   if(btUserT)
+   {
+      clCompactT[5] = (char) (clCompactT.at(5) | QCAN_COMPACT_CTRL_USER);
+   }
+   clCompactT.append(pchDataT + 70, 8);
+   if(btUserT)
+   {
+      clCompactT.append(pchDataT + 78, 8);
+   }
+   clCompactT.append(pchDataT + 6, ubSizeT);
+
+   return(clCompactT);
+}
+
+
+//----------------------------------------------------------------------------//
+// convertToFixed()                                                           //
+// convert CAN frame from compact format to fixed format                      //
+//----------------------------------------------------------------------------//
+QByteArray QCanData::convertToFixed(const QByteArray & clByteArrayR,
+                                    bool btChecksumV)
+{
+   int32_t        slSizeT;
+   int32_t        slPosT;
+   const char *   pchDataT;
+   char *         pchFixedT;
+
+   if((clByteArrayR.size() == 0) ||
+      ((clByteArrayR.at(0) & 0xE0) != QCAN_FRAME_FORMAT_COMPACT))
+   {
+      return(clByteArrayR);
+   }
+
+   //----------------------------------------------------------------
+   // a frame which is not complete results in an empty array
+   //
+   slSizeT = arraySize(clByteArrayR);
+   if((slSizeT == 0) || (clByteArrayR.size() < slSizeT))
+   {
+      return(QByteArray());
+   }
+
+   QByteArray clFixedT(QCAN_FRAME_ARRAY_SIZE, 0x00);
+   pchDataT  = clByteArrayR.constData();
+   pchFixedT = clFixedT.data();
+
+   //----------------------------------------------------------------
+   // identifier, DLC and control field
+   //
+   memcpy(pchFixedT, pchDataT, 6);
+   pchFixedT[0] = (char) (pchFixedT[0] & ~QCAN_FRAME_FORMAT_COMPACT);
+   pchFixedT[5] = (char) (pchFixedT[5] & ~QCAN_COMPACT_CTRL_USER);
+
+   //----------------------------------------------------------------
+   // time-stamp, user and marker field
+   //
+   memcpy(pchFixedT + 70, pchDataT + 6, 8);
+   slPosT = QCAN_FRAME_COMPACT_SIZE;
+   if((pchDataT[5] & QCAN_COMPACT_CTRL_USER) > 0)
+   {
+      memcpy(pchFixedT + 78, pchDataT + slPosT, 8);
+      slPosT += 8;
+   }
+
+   //----------------------------------------------------------------
+   // payload
+   //
+   memcpy(pchFixedT + 6, pchDataT + slPosT, slSizeT - slPosT);
+
+   //----------------------------------------------------------------
+   // build checksum from byte 0 .. 93, add checksum at the end,
+   // the array was initialised with 0
+   //
+   if(btChecksumV == true)
+   {
+      uint16_t uwChecksumT = checksum((const uint8_t *) pchFixedT,
+                                      QCAN_FRAME_ARRAY_SIZE - 2);
+      pchFixedT[94] = (char) (uwChecksumT >> 8);
+      pchFixedT[95] = (char) (uwChecksumT >> 0);
+   }
+
+   return(clFixedT);
+}
+
+
 //----------------------------------------------------------------------------//
 // ~QCanData()                                                                 //
 // destructor                                                                 //
@@ -172,117 +434,133 @@ QCanData::Type_e  QCanData::frameType(void) const
 }
 
 //----------------------------------------------------------------------------//
-// fromByteArray()                                                            //
-// convert byte array to QCanData object                                       //
+// dlcToSize()                                                                //
+// number of payload bytes for DLC value                                      //
 //----------------------------------------------------------------------------//
-bool QCanData::fromByteArray(const QByteArray & clByteArrayR)
+uint8_t QCanData::dlcToSize(uint8_t ubDlcV)
 {
+   return(aubDlcSizeS[ubDlcV & 0x0F]);
+}
+
+
+//----------------------------------------------------------------------------//
+// fromBuffer()                                                               //
+// convert buffer to QCanData object                                          //
+//----------------------------------------------------------------------------//
+bool QCanData::fromBuffer(const uint8_t * pubBufferV, int32_t slSizeV,
+                          bool btChecksumV)
+{
+   if((pubBufferV == Q_NULLPTR) || (slSizeV <= 0))
+   {
+      return(false);
+   }
+
    //----------------------------------------------------------------
-   // test size of byte array
+   // test for compact format
    //
-   if(clByteArrayR.size() < QCAN_FRAME_ARRAY_SIZE)
+   if((pubBufferV[0] & 0xE0) == QCAN_FRAME_FORMAT_COMPACT)
+   {
+      return(fromCompactBuffer(pubBufferV, slSizeV));
+   }
+
+   //----------------------------------------------------------------
+   // test size of buffer
+   //
+   if(slSizeV < QCAN_FRAME_ARRAY_SIZE)
    {
       return(false);
    }
    
-   
    //----------------------------------------------------------------
    // build checksum from byte 0 .. 93, and compare with checksum
    // value at the end
    //
-   uint16_t uwChecksumT = clByteArrayR[94];
-   uwChecksumT = uwChecksumT << 8;
-   uwChecksumT = uwChecksumT + (uint8_t) clByteArrayR[95];
-   
-   if(uwChecksumT != qChecksum(clByteArrayR.constData(), 
-                               QCAN_FRAME_ARRAY_SIZE - 2))
+   if(btChecksumV == true)
    {
-      return(false);
+      if(qFromBigEndian<uint16_t>(pubBufferV + 94) != 
+         checksum(pubBufferV, QCAN_FRAME_ARRAY_SIZE - 2))
+      {
+         return(false);
+      }
    }
    
    //----------------------------------------------------------------
-   // structure seems to be valid, now start copying the contents,
-   // start with the identifier value
-   //----------------------------------------------------------------
-
-   
-   //----------------------------------------------------------------
-   // set identifier field from byte 0 .. 3, MSB first
-   //
-   ulIdentifierP = clByteArrayR[0];
-   ulIdentifierP = ulIdentifierP << 8;
-   ulIdentifierP = ulIdentifierP + (uint8_t) clByteArrayR[1];
-   ulIdentifierP = ulIdentifierP << 8;
-   ulIdentifierP = ulIdentifierP + (uint8_t) clByteArrayR[2];
-   ulIdentifierP = ulIdentifierP << 8;
-   ulIdentifierP = ulIdentifierP + (uint8_t) clByteArrayR[3];
-
- 
-   //----------------------------------------------------------------
-   // set DLC field from byte 4
+   // structure seems to be valid, now start copying the contents:
+   // identifier (byte 0 .. 3), DLC (byte 4) and message control
+   // field (byte 5)
    //
-   ubMsgDlcP = clByteArrayR[4];
-
-   //----------------------------------------------------------------
-   // set message control field from byte 5
-   //
-   ubMsgCtrlP = clByteArrayR[5];
+   ulIdentifierP = qFromBigEndian<uint32_t>(pubBufferV);
+   ubMsgDlcP     = pubBufferV[4];
+   ubMsgCtrlP    = pubBufferV[5];
    
    //----------------------------------------------------------------
    // set message data field from byte 6 .. 69
    //
-   for(uint8_t ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
-   {
-      aubByteP[ubPosT] = clByteArrayR[6 + ubPosT];
-   }   
+   memcpy(aubByteP, pubBufferV + 6, QCAN_MSG_DATA_MAX);
 
    //----------------------------------------------------------------
-   // set message timestamp field from byte 70 .. 77, MSB first
+   // set message timestamp field from byte 70 .. 77, user field
+   // from byte 78 .. 81 and marker field from byte 82 .. 85, 
+   // MSB first
    //
-   uint32_t  ulTimeValT = 0;
-
-   ulTimeValT  = clByteArrayR[70];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[71];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[72];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[73];
-   clMsgTimeP.setSeconds(ulTimeValT);
+   clMsgTimeP.setSeconds(qFromBigEndian<uint32_t>(pubBufferV + 70));
+   clMsgTimeP.setNanoSeconds(qFromBigEndian<uint32_t>(pubBufferV + 74));
+   ulMsgUserP   = qFromBigEndian<uint32_t>(pubBufferV + 78);
+   ulMsgMarkerP = qFromBigEndian<uint32_t>(pubBufferV + 82);
    
-   ulTimeValT  = 0;
-   ulTimeValT  = clByteArrayR[74];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[75];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[76];
-   ulTimeValT  = ulTimeValT << 8;
-   ulTimeValT += (uint8_t) clByteArrayR[77];
-   clMsgTimeP.setNanoSeconds(ulTimeValT);
-   
-   //----------------------------------------------------------------
-   // set message user field from byte 78 .. 81, MSB first
-   //
-   ulMsgUserP  = clByteArrayR[78];
-   ulMsgUserP  = ulMsgUserP << 8;
-   ulMsgUserP += (uint8_t) clByteArrayR[79];
-   ulMsgUserP  = ulMsgUserP << 8;
-   ulMsgUserP += (uint8_t) clByteArrayR[80];
-   ulMsgUserP  = ulMsgUserP << 8;
-   ulMsgUserP += (uint8_t) clByteArrayR[81];
-      
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// fromByteArray()                                                            //
+// convert byte array to QCanData object                                      //
+//----------------------------------------------------------------------------//
+bool QCanData::fromByteArray(const QByteArray & clByteArrayR)
+{
+   return(fromBuffer((const uint8_t *) clByteArrayR.constData(), 
+                     clByteArrayR.size()));
+}
+
+
+//----------------------------------------------------------------------------//
+// fromRawFrame()                                                             //
+// convert binary frame to QCanData object                                    //
+//----------------------------------------------------------------------------//
+bool QCanData::fromRawFrame(const QCanRawFrame_ts & tsRawFrameR)
+{
+   uint8_t  ubSizeT;
+
+   if(tsRawFrameR.ubMsgDlc > 15)
+   {
+      return(false);
+   }
+
+   ulIdentifierP = tsRawFrameR.ulIdentifier;
+   ubMsgDlcP     = tsRawFrameR.ubMsgDlc;
+   ubMsgCtrlP    = tsRawFrameR.ubMsgCtrl;
+
+   clMsgTimeP.setSeconds(tsRawFrameR.ulTimeSec);
+   clMsgTimeP.setNanoSeconds(tsRawFrameR.ulTimeNsec);
+   ulMsgUserP   = 0;
+   ulMsgMarkerP = 0;
+
    //----------------------------------------------------------------
-   // set message marker field from byte 82 .. 85, MSB first
+   // API frames and error frames do not use the DLC value for
+   // their data, the payload of a CAN frame is defined by the DLC,
+   // the remaining bytes are cleared
    //
-   ulMsgMarkerP  = clByteArrayR[82];
-   ulMsgMarkerP  = ulMsgMarkerP << 8;
-   ulMsgMarkerP += (uint8_t) clByteArrayR[83];
-   ulMsgMarkerP  = ulMsgMarkerP << 8;
-   ulMsgMarkerP += (uint8_t) clByteArrayR[84];
-   ulMsgMarkerP  = ulMsgMarkerP << 8;
-   ulMsgMarkerP += (uint8_t) clByteArrayR[85];
-   
-   
+   if(frameType() != eTYPE_CAN)
+   {
+      ubSizeT = QCAN_MSG_DATA_MAX;
+   }
+   else
+   {
+      ubSizeT = aubDlcSizeS[ubMsgDlcP];
+   }
+   memcpy(aubByteP, tsRawFrameR.aubData, ubSizeT);
+   memset(aubByteP + ubSizeT, 0, QCAN_MSG_DATA_MAX - ubSizeT);
+
    return(true);
 }
 
@@ -353,90 +631,215 @@ void QCanData::setDataUInt32(const uint8_t & ubPosR,
 
 
 //----------------------------------------------------------------------------//
-// toByteArray()                                                              //
+// toBuffer()                                                                 //
 //                                                                            //
 //----------------------------------------------------------------------------//
-QByteArray QCanData::toByteArray() const
+int32_t QCanData::toBuffer(uint8_t * pubBufferV, bool btChecksumV) const
 {
    //----------------------------------------------------------------
-   // setup a defined length and clear contents
+   // place identifier field in byte 0 .. 3, DLC field in byte 4
+   // and message control field in byte 5
    //
-   QByteArray clByteArrayT(QCAN_FRAME_ARRAY_SIZE, 0x00);
-   
-  
+   qToBigEndian<uint32_t>(ulIdentifierP, pubBufferV);
+   pubBufferV[4] = ubMsgDlcP;
+   pubBufferV[5] = ubMsgCtrlP;
+
    //----------------------------------------------------------------
-   // place identifier field in byte 0 .. 3, MSB first
+   // place message data field in byte 6 .. 69
    //
-   clByteArrayT[0] = (uint8_t) (ulIdentifierP >> 24);
-   clByteArrayT[1] = (uint8_t) (ulIdentifierP >> 16);
-   clByteArrayT[2] = (uint8_t) (ulIdentifierP >>  8);
-   clByteArrayT[3] = (uint8_t) (ulIdentifierP >>  0);
-   
+   memcpy(pubBufferV + 6, aubByteP, QCAN_MSG_DATA_MAX);
+
    //----------------------------------------------------------------
-   // place message DLC field in byte 4
+   // place message timestamp field in byte 70 .. 77, user field
+   // in byte 78 .. 81 and marker field in byte 82 .. 85, MSB first
    //
-   clByteArrayT[4] = ubMsgDlcP;
-
+   qToBigEndian<uint32_t>(clMsgTimeP.seconds(),     pubBufferV + 70);
+   qToBigEndian<uint32_t>(clMsgTimeP.nanoSeconds(), pubBufferV + 74);
+   qToBigEndian<uint32_t>(ulMsgUserP,               pubBufferV + 78);
+   qToBigEndian<uint32_t>(ulMsgMarkerP,             pubBufferV + 82);
+   
    //----------------------------------------------------------------
-   // place message control field in byte 5
+   // byte 86 .. 93 (i.e. 8 bytes) are not used, set to 0
    //
-   clByteArrayT[5] = ubMsgCtrlP;
+   memset(pubBufferV + 86, 0, 8);
+   
+   //----------------------------------------------------------------
+   // build checksum from byte 0 .. 93, add checksum at the end
+   // 
+   if(btChecksumV == true)
+   {
+      qToBigEndian<uint16_t>(checksum(pubBufferV, QCAN_FRAME_ARRAY_SIZE - 2),
+                             pubBufferV + 94);
+   }
+   else
+   {
+      pubBufferV[94] = 0;
+      pubBufferV[95] = 0;
+   }
+
+   return(QCAN_FRAME_ARRAY_SIZE);
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArray()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanData::toByteArray() const
+{
+   QByteArray clByteArrayT(QCAN_FRAME_ARRAY_SIZE, Qt::Uninitialized);
+
+   toBuffer((uint8_t *) clByteArrayT.data());
+
+   return(clByteArrayT);
+}
+
+
+//----------------------------------------------------------------------------//
+// fromCompactBuffer()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanData::fromCompactBuffer(const uint8_t * pubBufferV, int32_t slSizeV)
+{
+   int32_t        slSizeT;
+   int32_t        slPosT;
+   uint8_t        ubPayloadT;
 
    //----------------------------------------------------------------
-   // place message data field in byte 6 .. 69
+   // size of frame is defined by DLC (byte 4) and control field
+   // (byte 5)
    //
-   for(uint8_t ubPosT = 0; ubPosT < QCAN_MSG_DATA_MAX; ubPosT++)
+   if(slSizeV < 6)
    {
-      clByteArrayT[6 + ubPosT] = aubByteP[ubPosT];
+      return(false);
+   }
+   slSizeT = QCAN_FRAME_COMPACT_SIZE + aubDlcSizeS[pubBufferV[4] & 0x0F];
+   if((pubBufferV[5] & QCAN_COMPACT_CTRL_USER) > 0)
+   {
+      slSizeT += 8;
+   }
+   if(slSizeV < slSizeT)
+   {
+      return(false);
    }
 
    //----------------------------------------------------------------
-   // place message timestamp field in byte 70 .. 77, MSB first
+   // identifier field from byte 0 .. 3 without the compact marker
    //
-   uint32_t  ulTimeValT = 0;
-
-   ulTimeValT = clMsgTimeP.seconds();
-   clByteArrayT[70] = (uint8_t) (ulTimeValT >> 24);
-   clByteArrayT[71] = (uint8_t) (ulTimeValT >> 16);
-   clByteArrayT[72] = (uint8_t) (ulTimeValT >>  8);
-   clByteArrayT[73] = (uint8_t) (ulTimeValT >>  0);
-
-   ulTimeValT = clMsgTimeP.nanoSeconds();
-   clByteArrayT[74] = (uint8_t) (ulTimeValT >>  24);
-   clByteArrayT[75] = (uint8_t) (ulTimeValT >>  16);
-   clByteArrayT[76] = (uint8_t) (ulTimeValT >>   8);
-   clByteArrayT[77] = (uint8_t) (ulTimeValT >>   0);
-   
+   ulIdentifierP  = qFromBigEndian<uint32_t>(pubBufferV);
+   ulIdentifierP &= ~(((uint32_t) QCAN_FRAME_FORMAT_COMPACT) << 24);
+
+   ubMsgDlcP  = pubBufferV[4];
+   ubMsgCtrlP = pubBufferV[5] & ~QCAN_COMPACT_CTRL_USER;
+
    //----------------------------------------------------------------
-   // place message user field in byte 78 .. 81, MSB first
+   // time-stamp from byte 6 .. 13
    //
-   clByteArrayT[78] = (uint8_t) (ulMsgUserP >>  24);
-   clByteArrayT[79] = (uint8_t) (ulMsgUserP >>  16);
-   clByteArrayT[80] = (uint8_t) (ulMsgUserP >>   8);
-   clByteArrayT[81] = (uint8_t) (ulMsgUserP >>   0);
+   clMsgTimeP.setSeconds(qFromBigEndian<uint32_t>(pubBufferV + 6));
+   clMsgTimeP.setNanoSeconds(qFromBigEndian<uint32_t>(pubBufferV + 10));
 
    //----------------------------------------------------------------
-   // place message marker field in byte 82 .. 85, MSB first
+   // optional user and marker field
    //
-   clByteArrayT[82] = (uint8_t) (ulMsgMarkerP >>  24);
-   clByteArrayT[83] = (uint8_t) (ulMsgMarkerP >>  16);
-   clByteArrayT[84] = (uint8_t) (ulMsgMarkerP >>   8);
-   clByteArrayT[85] = (uint8_t) (ulMsgMarkerP >>   0);
-   
+   slPosT = QCAN_FRAME_COMPACT_SIZE;
+   ulMsgUserP   = 0;
+   ulMsgMarkerP = 0;
+   if((pubBufferV[5] & QCAN_COMPACT_CTRL_USER) > 0)
+   {
+      ulMsgUserP   = qFromBigEndian<uint32_t>(pubBufferV + slPosT);
+      ulMsgMarkerP = qFromBigEndian<uint32_t>(pubBufferV + slPosT + 4);
+      slPosT += 8;
+   }
+
    //----------------------------------------------------------------
-   // byte 86 .. 93 (i.e. 8 bytes) are not used, set to 0
+   // payload, the remaining bytes are cleared
+   //
+   ubPayloadT = (uint8_t) (slSizeT - slPosT);
+   memcpy(aubByteP, pubBufferV + slPosT, ubPayloadT);
+   memset(aubByteP + ubPayloadT, 0, QCAN_MSG_DATA_MAX - ubPayloadT);
+
+   return(true);
+}
+
+
+//----------------------------------------------------------------------------//
+// toCompactBuffer()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanData::toCompactBuffer(uint8_t * pubBufferV) const
+{
+   int32_t     slPosT = QCAN_FRAME_COMPACT_SIZE;
+   uint8_t     ubSizeT;
+
    //----------------------------------------------------------------
-   
+   // API frames and error frames use the fixed format
+   //
+   if(frameType() != eTYPE_CAN)
+   {
+      return(toBuffer(pubBufferV));
+   }
+
+   ubSizeT = aubDlcSizeS[ubMsgDlcP & 0x0F];
+
+   qToBigEndian<uint32_t>(ulIdentifierP, pubBufferV);
+   pubBufferV[0] |= QCAN_FRAME_FORMAT_COMPACT;
+   pubBufferV[4]  = ubMsgDlcP;
+   pubBufferV[5]  = ubMsgCtrlP & ~QCAN_COMPACT_CTRL_USER;
+
+   qToBigEndian<uint32_t>(clMsgTimeP.seconds(),     pubBufferV +  6);
+   qToBigEndian<uint32_t>(clMsgTimeP.nanoSeconds(), pubBufferV + 10);
+
    //----------------------------------------------------------------
-   // build checksum from byte 0 .. 93, add checksum at the end
-   // 
-   uint16_t uwChecksumT = qChecksum(clByteArrayT.constData(), 
-                                    QCAN_FRAME_ARRAY_SIZE - 2);
-   
-   clByteArrayT[94] = (uint8_t) (uwChecksumT >> 8);
-   clByteArrayT[95] = (uint8_t) (uwChecksumT >> 0);
+   // user and marker field are only added if they are used
+   //
+   if((ulMsgUserP != 0) || (ulMsgMarkerP != 0))
+   {
+      pubBufferV[5] |= QCAN_COMPACT_CTRL_USER;
+      qToBigEndian<uint32_t>(ulMsgUserP,   pubBufferV + slPosT);
+      qToBigEndian<uint32_t>(ulMsgMarkerP, pubBufferV + slPosT + 4);
+      slPosT += 8;
+   }
 
-   return(clByteArrayT);
+   memcpy(pubBufferV + slPosT, aubByteP, ubSizeT);
+
+   return(slPosT + ubSizeT);
 }
 
 
+//----------------------------------------------------------------------------//
+// toRawFrame()                                                               //
+// convert QCanData object to binary frame                                    //
+//----------------------------------------------------------------------------//
+void QCanData::toRawFrame(QCanRawFrame_ts & tsRawFrameR) const
+{
+   tsRawFrameR.ulIdentifier = ulIdentifierP;
+   tsRawFrameR.ubMsgDlc     = ubMsgDlcP;
+   tsRawFrameR.ubMsgCtrl    = ubMsgCtrlP;
+   tsRawFrameR.uwReserved   = 0;
+   tsRawFrameR.ulTimeSec    = clMsgTimeP.seconds();
+   tsRawFrameR.ulTimeNsec   = clMsgTimeP.nanoSeconds();
+
+   if(frameType() != eTYPE_CAN)
+   {
+      memcpy(tsRawFrameR.aubData, aubByteP, QCAN_MSG_DATA_MAX);
+   }
+   else
+   {
+      memcpy(tsRawFrameR.aubData, aubByteP, aubDlcSizeS[ubMsgDlcP & 0x0F]);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// toCompactArray()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanData::toCompactArray() const
+{
+   uint8_t     aubBufferT[QCAN_FRAME_ARRAY_SIZE];
+   int32_t     slSizeT;
+
+   slSizeT = toCompactBuffer(aubBufferT);
+
+   return(QByteArray((const char *) aubBufferT, slSizeT));
+}
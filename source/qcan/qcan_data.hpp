@@ -67,6 +67,85 @@
 
 #define  QCAN_FRAME_ARRAY_SIZE       96
 
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_FRAME_COMPACT_SIZE
+**
+** The symbol QCAN_FRAME_COMPACT_SIZE defines the size of the header of
+** a CAN frame in compact format, refer to QCanData::toCompactArray().
+*/
+#define  QCAN_FRAME_COMPACT_SIZE     14
+
+
+//-------------------------------------------------------------------
+/*!
+** \defgroup QCAN_RAW_CTRL  Message control of QCanRawFrame_ts
+**
+** The symbols define the bits of the message control field
+** QCanRawFrame_ts::ubMsgCtrl.
+** \{
+*/
+
+/*! Extended frame format (29-bit identifier)                     */
+#define  QCAN_RAW_CTRL_EXT           ((uint8_t) 0x01)
+
+/*! ISO CAN FD: value of FDF bit                                   */
+#define  QCAN_RAW_CTRL_FDF           ((uint8_t) 0x02)
+
+/*! Remote frame                                                   */
+#define  QCAN_RAW_CTRL_RTR           ((uint8_t) 0x04)
+
+/*! Transmit confirmation of the CAN interface                     */
+#define  QCAN_RAW_CTRL_CONFIRM       ((uint8_t) 0x10)
+
+/*! ISO CAN FD: value of BRS bit                                   */
+#define  QCAN_RAW_CTRL_BRS           ((uint8_t) 0x40)
+
+/*! ISO CAN FD: value of ESI bit                                   */
+#define  QCAN_RAW_CTRL_ESI           ((uint8_t) 0x80)
+
+/*! \} */
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \struct  QCanRawFrame_s
+** \brief   CAN frame in binary format
+**
+** The structure holds a CAN frame in the native byte order of the host,
+** it is exchanged between the CAN network and a CAN plug-in by
+** QCanInterface::readBatch() and QCanInterface::writeBatch(). A plug-in
+** can fill the structure directly from the message buffer of the CAN
+** interface, there is no conversion into a byte array. The upper bits of
+** \c ulIdentifier carry the frame type, an error frame is created by
+** QCanFrameError::toRawFrame(). User and marker field of a CAN frame are
+** not part of the structure.
+*/
+typedef struct QCanRawFrame_s {
+
+   /*! identifier, bit 30 .. 31 define the frame type             */
+   uint32_t ulIdentifier;
+
+   /*! data length code, value range 0 .. 15                      */
+   uint8_t  ubMsgDlc;
+
+   /*! message control, refer to \ref QCAN_RAW_CTRL               */
+   uint8_t  ubMsgCtrl;
+
+   /*! reserved, always 0                                         */
+   uint16_t uwReserved;
+
+   /*! time-stamp: seconds                                        */
+   uint32_t ulTimeSec;
+
+   /*! time-stamp: nanoseconds                                    */
+   uint32_t ulTimeNsec;
+
+   /*! payload                                                    */
+   uint8_t  aubData[QCAN_MSG_DATA_MAX];
+
+} QCanRawFrame_ts;
+
 
 //-----------------------------------------------------------------------------
 /*!
@@ -134,10 +213,115 @@ public:
                           const bool & btMsbFirstR = 0) const;
 
 
+   /*!
+   ** \param[in]  clByteArrayR   Byte array
+   ** \param[in]  slPosV         Start position inside byte array
+   ** \return     Size of frame in bytes
+   **
+   ** The function returns the size of the frame starting at position
+   ** \a slPosV of the byte array \a clByteArrayR. The frame might be stored
+   ** in fixed format (#QCAN_FRAME_ARRAY_SIZE bytes) or compact format (see
+   ** toCompactArray()). If the byte array does not hold enough bytes to
+   ** evaluate the size, the function returns 0.
+   */
+   static int32_t     arraySize(const QByteArray & clByteArrayR,
+                                int32_t slPosV = 0);
+
+   /*!
+   ** \param[in]  pubBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes inside the buffer
+   ** \return     Size of frame in bytes
+   ** \see        arraySize()
+   **
+   ** The function returns the size of the frame stored in the buffer
+   ** \a pubBufferV, or 0 if the size can not be evaluated.
+   */
+   static int32_t     bufferSize(const uint8_t * pubBufferV, int32_t slSizeV);
+
+   /*!
+   ** \param[in]  pubBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes
+   ** \return     CRC-16 value
+   **
+   ** The function calculates the CRC-16 (ISO 3309) of \a slSizeV bytes
+   ** starting at \a pubBufferV. The result is identical to qChecksum(),
+   ** but the calculation uses one table lookup per byte.
+   */
+   static uint16_t    checksum(const uint8_t * pubBufferV, int32_t slSizeV);
+
+   /*!
+   ** \param[in]  ubDlcV         DLC value
+   ** \return     Number of payload bytes
+   **
+   ** The function converts the DLC value \a ubDlcV (0 .. 15) into the
+   ** number of payload bytes of a CAN FD frame.
+   */
+   static uint8_t     dlcToSize(uint8_t ubDlcV);
+
+   /*!
+   ** \param[in]  clByteArrayR   CAN frame in fixed format
+   ** \return     CAN frame in compact format
+   ** \see        convertToFixed()
+   **
+   ** The function converts a CAN frame from fixed format into compact
+   ** format without decoding it. API frames and error frames are always
+   ** stored in fixed format, they are returned unchanged.
+   */
+   static QByteArray  convertToCompact(const QByteArray & clByteArrayR);
+
+   /*!
+   ** \param[in]  clByteArrayR   CAN frame in compact format
+   ** \param[in]  btChecksumV    Calculate checksum
+   ** \return     CAN frame in fixed format
+   ** \see        convertToCompact()
+   **
+   ** The function converts a CAN frame from compact format into fixed
+   ** format. If \a clByteArrayR is not a frame in compact format, it is
+   ** returned unchanged. If \a btChecksumV is \c false the checksum field
+   ** is set to 0.
+   */
+   static QByteArray  convertToFixed(const QByteArray & clByteArrayR,
+                                     bool btChecksumV = true);
+
    Type_e      frameType(void) const;
    
+   /*!
+   ** \param[in]  clByteArrayR   Byte array
+   ** \return     \c true if conversion was successful
+   ** \see        toByteArray(), toCompactArray()
+   **
+   ** The function sets the contents of the data structure from the byte
+   ** array \a clByteArrayR. The byte array might use the fixed format or
+   ** the compact format.
+   */
    virtual bool       fromByteArray(const QByteArray & clByteArrayR);
 
+   /*!
+   ** \param[in]  pubBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes inside the buffer
+   ** \param[in]  btChecksumV    Verify checksum
+   ** \return     \c true if conversion was successful
+   ** \see        toBuffer(), fromByteArray()
+   **
+   ** The function sets the contents of the data structure from the buffer
+   ** \a pubBufferV, without creating a byte array. The buffer might use
+   ** the fixed format or the compact format. The checksum of the fixed
+   ** format is not verified if \a btChecksumV is \c false.
+   */
+   bool               fromBuffer(const uint8_t * pubBufferV, int32_t slSizeV,
+                                 bool btChecksumV = true);
+
+   /*!
+   ** \param[in]  tsRawFrameR    Frame in binary format
+   ** \return     \c true if conversion was successful
+   ** \see        toRawFrame()
+   **
+   ** The function sets the contents of the data structure from the
+   ** binary frame \a tsRawFrameR. User and marker field are cleared.
+   ** The function returns \c false if the DLC value is out of range.
+   */
+   bool               fromRawFrame(const QCanRawFrame_ts & tsRawFrameR);
+
 
    /*!
    ** \param[in]  ubPosR         Index of payload
@@ -166,8 +350,66 @@ public:
    
    virtual QByteArray toByteArray() const;
 
+   /*!
+   ** \param[out] pubBufferV     Pointer to buffer
+   ** \param[in]  btChecksumV    Calculate checksum
+   ** \return     Number of bytes written (#QCAN_FRAME_ARRAY_SIZE)
+   ** \see        fromBuffer(), toByteArray()
+   **
+   ** The function writes the data structure in fixed format into the
+   ** buffer \a pubBufferV, which must hold at least #QCAN_FRAME_ARRAY_SIZE
+   ** bytes. The buffer may also be a region of a pre-sized QByteArray
+   ** (QByteArray::data()). If \a btChecksumV is \c false the checksum
+   ** field is set to 0.
+   */
+   int32_t            toBuffer(uint8_t * pubBufferV,
+                               bool btChecksumV = true) const;
+
+   /*!
+   ** \param[out] pubBufferV     Pointer to buffer
+   ** \return     Number of bytes written
+   ** \see        toCompactArray()
+   **
+   ** The function writes the data structure in compact format into the
+   ** buffer \a pubBufferV, which must hold at least #QCAN_FRAME_ARRAY_SIZE
+   ** bytes.
+   */
+   int32_t            toCompactBuffer(uint8_t * pubBufferV) const;
+
+   /*!
+   ** \param[out] tsRawFrameR    Frame in binary format
+   ** \see        fromRawFrame()
+   **
+   ** The function writes the data structure into the binary frame
+   ** \a tsRawFrameR. For CAN frames only the payload bytes defined by
+   ** the DLC value are copied.
+   */
+   void               toRawFrame(QCanRawFrame_ts & tsRawFrameR) const;
+
+   /*!
+   ** \return     Byte array in compact format
+   ** \see        toByteArray()
+   **
+   ** The compact format holds only the payload bytes that are defined by
+   ** the DLC value. It is used for CAN frames only, API frames and error
+   ** frames are returned in fixed format.
+   ** <ul>
+   ** <li>Byte 0 .. 3: identifier, MSB first, byte 0 has bit 5 set</li>
+   ** <li>Byte 4: DLC</li>
+   ** <li>Byte 5: message control, bit 5 is set if user and marker
+   **     fields are present</li>
+   ** <li>Byte 6 .. 13: time-stamp (seconds, nanoseconds), MSB first</li>
+   ** <li>optional 8 bytes: user and marker field, MSB first</li>
+   ** <li>payload</li>
+   ** </ul>
+   ** There is no checksum, the transport layer (TCP) is reliable.
+   */
+   virtual QByteArray toCompactArray() const;
+
 
 protected:
+
+   bool        fromCompactBuffer(const uint8_t * pubBufferV, int32_t slSizeV);
    
    /*!   
    ** The identifier field may have 11 bits for standard frames
@@ -192,7 +434,7 @@ protected:
    ** <li>Bit 1: ISO CAN FD: value of FDF bit
    ** <li>Bit 2: Remote Frame
    ** <li>Bit 3: Overload Frame
-   ** <li>Bit 4: reserved, always 0
+   ** <li>Bit 4: Transmit confirmation of the CAN interface
    ** <li>Bit 5: reserved, always 0
    ** <li>Bit 6: ISO CAN FD: value of BRS bit
    ** <li>Bit 7: ISO CAN FD: value of ESI bit
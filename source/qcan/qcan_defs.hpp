@@ -63,6 +63,32 @@
 #define  QCAN_TCP_DEFAULT_PORT      55660
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_METRICS_DEFAULT_PORT
+** \ingroup QCAN_NW
+** \brief   Default port for metrics export
+**
+** This symbol defines the default TCP port for the metrics export
+** of the server, refer to QCanMetricServer.
+*/
+#define  QCAN_METRICS_DEFAULT_PORT  55680
+
+
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_LOCAL_SOCKET_NAME
+** \ingroup QCAN_NW
+** \brief   Name prefix of local server
+**
+** This symbol defines the name prefix of the local server (Unix domain
+** socket or named pipe) of a network. The TCP port of the network is
+** appended to the prefix, e.g. "canpie-55660" for the first network
+** of a server using #QCAN_TCP_DEFAULT_PORT.
+*/
+#define  QCAN_LOCAL_SOCKET_NAME     "canpie-"
+
+
 //-------------------------------------------------------------------
 /*!
 ** \def     QCAN_TCP_SOCKET_MAX
@@ -130,5 +156,18 @@
 #define  QCAN_IF_SUPPORT_CAN_FD           ((uint32_t) (0x00000004))
 
 
+//-------------------------------------------------------------------
+/*!
+** \def     QCAN_IF_SUPPORT_TRM_CONFIRM
+** \ingroup QCAN_IF
+** \brief   Support transmit confirmation
+**
+** The bit-mask value defines if a CAN interface is able to confirm
+** the transmission of CAN frames (refer to
+** QCanInterface::setTransmitConfirm()).
+*/
+#define  QCAN_IF_SUPPORT_TRM_CONFIRM      ((uint32_t) (0x00000008))
+
+
 
 #endif // QCAN_DEFS_HPP_
@@ -0,0 +1,284 @@
+//============================================================================//
+// File:          qcan_filter.cpp                                             //
+// Description:   QCAN classes - CAN frame filter                             //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "qcan_filter.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  QCAN_FILTER_STD_MASK       ((uint32_t) 0x000007FF)
+#define  QCAN_FILTER_EXT_MASK       ((uint32_t) 0x1FFFFFFF)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanFilter()                                                               //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFilter::QCanFilter()
+{
+   clear();
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanFilter()                                                              //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanFilter::~QCanFilter()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// addMask()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFilter::addMask(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                         bool btExtendedV)
+{
+   uint32_t          ulIdT;
+   uint32_t          ulFreeT;
+   uint32_t          ulCountT;
+   QCanFilterExt_ts  tsFilterT;
+
+   btIsEmptyP = false;
+
+   if(btExtendedV == false)
+   {
+      //--------------------------------------------------------
+      // test all 2048 identifiers and store the result
+      // inside the bitmap
+      //
+      ulMaskV &= QCAN_FILTER_STD_MASK;
+      for(ulIdT = 0; ulIdT <= QCAN_FILTER_STD_MASK; ulIdT++)
+      {
+         if((ulIdT & ulMaskV) == (ulIdentifierV & ulMaskV))
+         {
+            setStd(ulIdT);
+         }
+      }
+   }
+   else
+   {
+      //--------------------------------------------------------
+      // count the bits that are not evaluated, a filter which
+      // covers a small number of identifiers is expanded into
+      // the hash
+      //
+      ulMaskV &= QCAN_FILTER_EXT_MASK;
+      ulFreeT  = (~ulMaskV) & QCAN_FILTER_EXT_MASK;
+      ulCountT = 1;
+      for(ulIdT = ulFreeT; ulIdT > 0; ulIdT &= (ulIdT - 1))
+      {
+         ulCountT = ulCountT * 2;
+         if(ulCountT > QCAN_FILTER_EXT_EXPAND)
+         {
+            break;
+         }
+      }
+
+      if(ulCountT <= QCAN_FILTER_EXT_EXPAND)
+      {
+         //-------------------------------------------------
+         // run through all subsets of the free bits
+         //
+         ulIdentifierV &= ulMaskV;
+         ulIdT = 0;
+         do
+         {
+            clExtSetP.insert(ulIdentifierV | ulIdT);
+            ulIdT = (ulIdT - ulFreeT) & ulFreeT;
+         } while(ulIdT != 0);
+      }
+      else
+      {
+         tsFilterT.ulIdentifier = ulIdentifierV & ulMaskV;
+         tsFilterT.ulMask       = ulMaskV;
+         tsFilterT.ulIdStop     = 0;
+         tsFilterT.btIsRange    = false;
+         clExtListP.append(tsFilterT);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// addRange()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFilter::addRange(uint32_t ulIdStartV, uint32_t ulIdStopV,
+                          bool btExtendedV)
+{
+   uint32_t          ulIdT;
+   uint32_t          ulIdMaxT;
+   QCanFilterExt_ts  tsFilterT;
+
+   //----------------------------------------------------------------
+   // limit the range to the valid identifiers, a range which holds
+   // no valid identifier does not change the filter
+   //
+   if(btExtendedV == false)
+   {
+      ulIdMaxT = QCAN_FILTER_STD_MASK;
+   }
+   else
+   {
+      ulIdMaxT = QCAN_FILTER_EXT_MASK;
+   }
+
+   if(ulIdStopV > ulIdMaxT)
+   {
+      ulIdStopV = ulIdMaxT;
+   }
+
+   if(ulIdStartV > ulIdStopV)
+   {
+      return;
+   }
+
+   btIsEmptyP = false;
+
+   if(btExtendedV == false)
+   {
+      for(ulIdT = ulIdStartV; ulIdT <= ulIdStopV; ulIdT++)
+      {
+         setStd(ulIdT);
+      }
+   }
+   else
+   {
+      if((ulIdStopV - ulIdStartV) < QCAN_FILTER_EXT_EXPAND)
+      {
+         for(ulIdT = ulIdStartV; ulIdT <= ulIdStopV; ulIdT++)
+         {
+            clExtSetP.insert(ulIdT);
+         }
+      }
+      else
+      {
+         tsFilterT.ulIdentifier = ulIdStartV;
+         tsFilterT.ulMask       = 0;
+         tsFilterT.ulIdStop     = ulIdStopV;
+         tsFilterT.btIsRange    = true;
+         clExtListP.append(tsFilterT);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// clear()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFilter::clear(void)
+{
+   memset(aulStdMapP, 0, sizeof(aulStdMapP));
+   clExtSetP.clear();
+   clExtListP.clear();
+   btIsEmptyP = true;
+}
+
+
+//----------------------------------------------------------------------------//
+// match()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFilter::match(uint32_t ulIdentifierV, bool btExtendedV) const
+{
+   int32_t  slFilterIdxT;
+
+   if(btIsEmptyP == true)
+   {
+      return (true);
+   }
+
+   if(btExtendedV == false)
+   {
+      ulIdentifierV &= QCAN_FILTER_STD_MASK;
+      return ((aulStdMapP[ulIdentifierV >> 5] & (1UL << (ulIdentifierV & 0x1F))) != 0);
+   }
+
+   ulIdentifierV &= QCAN_FILTER_EXT_MASK;
+   if(clExtSetP.contains(ulIdentifierV))
+   {
+      return (true);
+   }
+
+   //----------------------------------------------------------------
+   // check filters that could not be expanded
+   //
+   for(slFilterIdxT = 0; slFilterIdxT < clExtListP.size(); slFilterIdxT++)
+   {
+      const QCanFilterExt_ts & tsFilterR = clExtListP.at(slFilterIdxT);
+      if(tsFilterR.btIsRange == true)
+      {
+         if((ulIdentifierV >= tsFilterR.ulIdentifier) &&
+            (ulIdentifierV <= tsFilterR.ulIdStop))
+         {
+            return (true);
+         }
+      }
+      else
+      {
+         if((ulIdentifierV & tsFilterR.ulMask) == tsFilterR.ulIdentifier)
+         {
+            return (true);
+         }
+      }
+   }
+
+   return (false);
+}
+
+
+//----------------------------------------------------------------------------//
+// setStd()                                                                   //
+// set bit for standard identifier                                            //
+//----------------------------------------------------------------------------//
+void QCanFilter::setStd(uint32_t ulIdentifierV)
+{
+   aulStdMapP[ulIdentifierV >> 5] |= (1UL << (ulIdentifierV & 0x1F));
+}
@@ -0,0 +1,153 @@
+//============================================================================//
+// File:          qcan_filter.hpp                                             //
+// Description:   QCAN classes - CAN frame filter                             //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_FILTER_HPP_
+#define QCAN_FILTER_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QSet>
+#include <QVector>
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Maximum number of extended identifiers a single filter is
+// expanded to inside the hash
+//
+#define  QCAN_FILTER_EXT_EXPAND     256
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanFilter
+** \brief   CAN frame filter
+** 
+** The QCanFilter class is a list of acceptance filters for CAN identifiers.
+** A filter is defined either by identifier / mask (see addMask()) or by an
+** identifier range (see addRange()). An empty filter accepts all CAN
+** frames.
+** <p>
+** The filter is evaluated with constant effort, independent from the
+** number of filters: standard identifiers are stored inside a bitmap with
+** 2048 entries, extended identifiers are stored inside a hash. Extended
+** identifier filters that cover more than #QCAN_FILTER_EXT_EXPAND
+** identifiers are checked one by one.
+*/
+class QCanFilter
+{
+public:
+
+   QCanFilter();
+
+   ~QCanFilter();
+
+   /*!
+   ** \param[in]  ulIdentifierV  Identifier value
+   ** \param[in]  ulMaskV        Mask value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \see        addRange()
+   **
+   ** Add a filter which accepts a CAN frame if all identifier bits that are
+   ** set in \a ulMaskV are equal to the bits of \a ulIdentifierV.
+   */
+   void  addMask(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                 bool btExtendedV = false);
+
+   /*!
+   ** \param[in]  ulIdStartV     First identifier value
+   ** \param[in]  ulIdStopV      Last identifier value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \see        addMask()
+   **
+   ** Add a filter which accepts a CAN frame with an identifier value
+   ** in the range of \a ulIdStartV to \a ulIdStopV (both inclusive).
+   ** A range which holds no valid identifier does not change the filter.
+   */
+   void  addRange(uint32_t ulIdStartV, uint32_t ulIdStopV,
+                  bool btExtendedV = false);
+
+   /*!
+   ** Remove all filters, afterwards all CAN frames are accepted.
+   */
+   void  clear(void);
+
+   /*!
+   ** \return     \c true if no filter is defined
+   */
+   bool  isEmpty(void) const  { return (btIsEmptyP); };
+
+   /*!
+   ** \param[in]  ulIdentifierV  Identifier value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \return     \c true if the CAN frame is accepted
+   **
+   ** The function returns \c true if the filter is empty or if the
+   ** identifier \a ulIdentifierV matches one of the filters.
+   */
+   bool  match(uint32_t ulIdentifierV, bool btExtendedV) const;
+
+private:
+
+   //----------------------------------------------------------------
+   // filter for extended identifiers that can not be expanded
+   // into the hash
+   //
+   typedef struct QCanFilterExt_s {
+      uint32_t   ulIdentifier;
+      uint32_t   ulMask;
+      uint32_t   ulIdStop;
+      bool       btIsRange;
+   } QCanFilterExt_ts;
+
+   void  setStd(uint32_t ulIdentifierV);
+
+   bool                          btIsEmptyP;
+
+   //----------------------------------------------------------------
+   // one bit for each standard identifier
+   //
+   uint32_t                      aulStdMapP[2048 / 32];
+
+   QSet<uint32_t>                clExtSetP;
+   QVector<QCanFilterExt_ts>     clExtListP;
+};
+
+
+#endif   // QCAN_FILTER_HPP_
@@ -46,6 +46,8 @@
 
 #define  CAN_FRAME_FORMAT_RTR       ((uint8_t) 0x04)
 
+#define  CAN_FRAME_TRM_CONFIRM      ((uint8_t) 0x10)
+
 #define  CAN_FRAME_ISO_FD_BRS       ((uint8_t) 0x40)
 
 #define  CAN_FRAME_ISO_FD_ESI       ((uint8_t) 0x80)
@@ -92,6 +94,38 @@ QCanFrame::~QCanFrame()
 
 
 
+//----------------------------------------------------------------------------//
+// arbitrationField()                                                         //
+// get bits of arbitration field, a lower value wins the arbitration          //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrame::arbitrationField(void) const
+{
+   uint32_t ulFieldT;
+   uint32_t ulRemoteT = 0;
+
+   if(isRemote() == true)
+   {
+      ulRemoteT = 1;
+   }
+
+   //----------------------------------------------------------------
+   // 11 bit base identifier, RTR / SRR, IDE, 18 bit identifier
+   // extension and RTR
+   //
+   if(isExtended() == true)
+   {
+      ulFieldT = ((identifier() >> 18) << 21) | (1UL << 20) | (1UL << 19) |
+                 ((identifier() & 0x0003FFFF) << 1) | ulRemoteT;
+   }
+   else
+   {
+      ulFieldT = (identifier() << 21) | (ulRemoteT << 20);
+   }
+
+   return(ulFieldT);
+}
+
+
 //----------------------------------------------------------------------------//
 // bitrateSwitch()                                                            //
 // get value of bit-rate switch                                               //
@@ -296,6 +330,30 @@ QCanFrame::Format_e  QCanFrame::frameFormat(void) const
    return((Format_e) (ubMsgCtrlP & 0x03));
 }
 
+//----------------------------------------------------------------------------//
+// fromBuffer()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrame::fromBuffer(const uint8_t * pubBufferV, int32_t slSizeV,
+                           bool btChecksumV)
+{
+   bool  btResultT = false;
+
+   //----------------------------------------------------------------
+   // same test as in fromByteArray()
+   //
+   if ((pubBufferV != Q_NULLPTR) && (slSizeV > 0))
+   {
+      if ((pubBufferV[0] & 0xC0) == 0)
+      {
+         btResultT = QCanData::fromBuffer(pubBufferV, slSizeV, btChecksumV);
+      }
+   }
+
+   return (btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // fromByteArray()                                                            //
 //                                                                            //
@@ -305,10 +363,11 @@ bool QCanFrame::fromByteArray(const QByteArray & clByteArrayR)
    bool  btResultT = false;
    
    //----------------------------------------------------------------
-   // a CAN frame must have the three MSB bits set to 0 in the first 
-   // byte, refer to QCanData class implementation (0b000xxxxx)
+   // a CAN frame must have the two MSB bits set to 0 in the first 
+   // byte, refer to QCanData class implementation (0b00cxxxxx),
+   // bit 'c' marks the compact format
    //
-   if ((clByteArrayR.at(0) & 0xE0) == 0)
+   if ((clByteArrayR.at(0) & 0xC0) == 0)
    {
       btResultT = (QCanData::fromByteArray(clByteArrayR)); 
    }
@@ -317,6 +376,27 @@ bool QCanFrame::fromByteArray(const QByteArray & clByteArrayR)
 }
 
 
+//----------------------------------------------------------------------------//
+// fromRawFrame()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrame::fromRawFrame(const QCanRawFrame_ts & tsRawFrameR)
+{
+   bool  btResultT = false;
+
+   //----------------------------------------------------------------
+   // same test as in fromByteArray(), the frame type is defined
+   // by bit 30 and 31 of the identifier
+   //
+   if ((tsRawFrameR.ulIdentifier & 0xC0000000) == 0)
+   {
+      btResultT = QCanData::fromRawFrame(tsRawFrameR);
+   }
+
+   return (btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // identifier()                                                               //
 // get identifier value                                                       //
@@ -371,6 +451,22 @@ bool QCanFrame::isRemote(void) const
 }
 
 
+//----------------------------------------------------------------------------//
+// isTransmitConfirm()                                                        //
+// test for transmit confirmation                                             //
+//----------------------------------------------------------------------------//
+bool QCanFrame::isTransmitConfirm(void) const
+{
+   bool btResultT = false;
+
+   if((ubMsgCtrlP & CAN_FRAME_TRM_CONFIRM) > 0)
+   {
+      btResultT = true;
+   }
+   return(btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // setBitrateSwitch()                                                         //
 // set / reset bit-rate switch bit value                                      //
@@ -657,6 +753,23 @@ void QCanFrame::setRemote(const bool & btRtrR)
 }
 
 
+//----------------------------------------------------------------------------//
+// setTransmitConfirm()                                                       //
+// set / reset transmit confirmation                                          //
+//----------------------------------------------------------------------------//
+void QCanFrame::setTransmitConfirm(const bool & btConfirmR)
+{
+   if(btConfirmR == true)
+   {
+      ubMsgCtrlP |=   CAN_FRAME_TRM_CONFIRM;
+   }
+   else
+   {
+      ubMsgCtrlP &= (~CAN_FRAME_TRM_CONFIRM);
+   }
+}
+
+
 void QCanFrame::setUser(const uint32_t & ulUserValueR)
 {
    ulMsgUserP = ulUserValueR;
@@ -668,6 +781,45 @@ QByteArray QCanFrame::toByteArray() const
    return(QCanData::toByteArray());
 }
 
+
+//----------------------------------------------------------------------------//
+// toCompactArray()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrame::toCompactArray() const
+{
+   return(QCanData::toCompactArray());
+}
+
+
+//----------------------------------------------------------------------------//
+// toBuffer()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrame::toBuffer(uint8_t * pubBufferV, bool btChecksumV) const
+{
+   return(QCanData::toBuffer(pubBufferV, btChecksumV));
+}
+
+
+//----------------------------------------------------------------------------//
+// toCompactBuffer()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanFrame::toCompactBuffer(uint8_t * pubBufferV) const
+{
+   return(QCanData::toCompactBuffer(pubBufferV));
+}
+
+//----------------------------------------------------------------------------//
+// toRawFrame()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrame::toRawFrame(QCanRawFrame_ts & tsRawFrameR) const
+{
+   QCanData::toRawFrame(tsRawFrameR);
+}
+
 //----------------------------------------------------------------------------//
 // toString()                                                                 //
 // print CAN frame                                                            //
@@ -88,6 +88,19 @@ public:
  
    virtual ~QCanFrame();
    
+   /*!
+   ** \return  Value of arbitration field
+   ** \see     identifier()
+   **
+   ** The function returns the bits of the arbitration field in the order
+   ** of transmission, starting with the most significant bit of the
+   ** identifier: base identifier, RTR (or SRR) bit, IDE bit, identifier
+   ** extension and RTR bit of an extended frame. Dominant bits have the
+   ** value 0, hence the frame with the lower value wins the arbitration
+   ** on the CAN bus. For CAN FD frames the RRS bit is dominant.
+   */
+   uint32_t    arbitrationField(void) const;
+
    /*!
    ** \return  \c true if bit-rate switch is set
    ** \see     setBitrateSwitch()
@@ -192,6 +205,29 @@ public:
 
    bool        fromByteArray(const QByteArray & clByteArrayR);
 
+   /*!
+   ** \param[in]  pubBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes inside the buffer
+   ** \param[in]  btChecksumV    Verify checksum
+   ** \return     \c true if the buffer holds a valid CAN frame
+   ** \see        toBuffer()
+   **
+   ** The function sets the CAN frame from the buffer \a pubBufferV,
+   ** see QCanData::fromBuffer().
+   */
+   bool        fromBuffer(const uint8_t * pubBufferV, int32_t slSizeV,
+                          bool btChecksumV = true);
+
+   /*!
+   ** \param[in]  tsRawFrameR    Frame in binary format
+   ** \return     \c true if \a tsRawFrameR holds a valid CAN frame
+   ** \see        toRawFrame()
+   **
+   ** The function sets the CAN frame from the binary frame
+   ** \a tsRawFrameR, see QCanData::fromRawFrame().
+   */
+   bool        fromRawFrame(const QCanRawFrame_ts & tsRawFrameR);
+
 
    /*!
    ** \return  \c true if error state indicator is set
@@ -235,6 +271,17 @@ public:
    */
    bool        isRemote(void) const;
 
+   /*!
+   ** \return  \c true if transmit confirmation
+   ** \see     setTransmitConfirm()
+   **
+   ** The function returns \c true if the CAN frame confirms the
+   ** transmission of a frame on the CAN bus. A CAN interface supporting
+   ** #QCAN_IF_SUPPORT_TRM_CONFIRM returns a copy of each frame written
+   ** with this attribute, the time-stamp holds the time of transmission.
+   */
+   bool        isTransmitConfirm(void) const;
+
    /*!
    ** \return  Marker of CAN frame
    ** \see     setMarker()
@@ -393,9 +440,56 @@ public:
    */
    inline QCanTimeStamp timeStamp(void) const { return clMsgTimeP; };
 
+   /*!
+   ** \param[in]  btConfirmR     Value of transmit confirmation
+   ** \see        isTransmitConfirm()
+   **
+   ** The function marks the CAN frame as transmit confirmation.
+   */
+   void        setTransmitConfirm(const bool & btConfirmR = true);
+
 
    
    QByteArray toByteArray() const;
+
+   /*!
+   ** \return     Byte array in compact format
+   ** \see        toByteArray()
+   **
+   ** The function converts the CAN frame into a byte array of
+   ** variable length, see QCanData::toCompactArray().
+   */
+   QByteArray toCompactArray() const;
+
+   /*!
+   ** \param[out] pubBufferV     Pointer to buffer
+   ** \param[in]  btChecksumV    Calculate checksum
+   ** \return     Number of bytes written
+   ** \see        fromBuffer(), toCompactBuffer()
+   **
+   ** The function writes the CAN frame in fixed format into the buffer
+   ** \a pubBufferV, see QCanData::toBuffer().
+   */
+   int32_t    toBuffer(uint8_t * pubBufferV, bool btChecksumV = true) const;
+
+   /*!
+   ** \param[out] pubBufferV     Pointer to buffer
+   ** \return     Number of bytes written
+   ** \see        toBuffer()
+   **
+   ** The function writes the CAN frame in compact format into the buffer
+   ** \a pubBufferV, see QCanData::toCompactBuffer().
+   */
+   int32_t    toCompactBuffer(uint8_t * pubBufferV) const;
+
+   /*!
+   ** \param[out] tsRawFrameR    Frame in binary format
+   ** \see        fromRawFrame()
+   **
+   ** The function writes the CAN frame into the binary frame
+   ** \a tsRawFrameR, see QCanData::toRawFrame().
+   */
+   void       toRawFrame(QCanRawFrame_ts & tsRawFrameR) const;
    
    /*!
    ** \return     CAN frame as QString object
@@ -97,6 +97,82 @@ int32_t QCanFrameApi::bitrateNominal(void)
    return (dataUInt32(0));
 }
 
+//----------------------------------------------------------------------------//
+// checksum()                                                                 //
+// Byte 0: checksum enabled                                                   //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::checksum(bool & btEnableR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_CHECKSUM)
+   {
+      btEnableR = (aubByteP[0] > 0);
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// confirm()                                                                  //
+// Byte 0: transmit confirmation enabled                                      //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::confirm(bool & btEnableR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_CONFIRM)
+   {
+      btEnableR = (aubByteP[0] > 0);
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// credit()                                                                   //
+// Byte 0 .. 3: number of credits                                             //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::credit(uint32_t & ulCreditR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_CREDIT)
+   {
+      ulCreditR = dataUInt32(0);
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// filter()                                                                   //
+// Byte 0: type, Byte 1: format, Byte 4 .. 7: value 1, Byte 8 .. 11: value 2  //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::filter(FilterType_e & teTypeR, uint32_t & ulValue1R,
+                          uint32_t & ulValue2R, bool & btExtendedR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_FILTER)
+   {
+      teTypeR     = (FilterType_e) aubByteP[0];
+      btExtendedR = (aubByteP[1] != 0);
+      ulValue1R   = dataUInt32(4);
+      ulValue2R   = dataUInt32(8);
+      btResultT   = true;
+   }
+
+   return(btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // function()                                                                 //
 // determine the function code                                                //
@@ -136,6 +212,27 @@ bool QCanFrameApi::name(QString & clNameR)
 }
 
 
+//----------------------------------------------------------------------------//
+// priority()                                                                 //
+// Byte 0: priority class                                                     //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::priority(Priority_e & tePriorityR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_PRIORITY)
+   {
+      if(aubByteP[0] < (uint8_t) ePRIORITY_MAX)
+      {
+         tePriorityR = (Priority_e) aubByteP[0];
+         btResultT = true;
+      }
+   }
+
+   return(btResultT);
+}
+
+
 //----------------------------------------------------------------------------//
 // setBitrate()                                                               //
 // Byte 0 .. 3: slBitrateV, Byte 4 .. 7: slBrsClockV                          //
@@ -159,6 +256,28 @@ void QCanFrameApi::setMode(CAN_Mode_e teModeV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setChecksum()                                                              //
+// Byte 0: checksum enabled                                                   //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setChecksum(bool btEnableV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_CHECKSUM;
+   aubByteP[0]  = btEnableV ? 1 : 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// setConfirm()                                                               //
+// Byte 0: transmit confirmation enabled                                      //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setConfirm(bool btEnableV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_CONFIRM;
+   aubByteP[0]  = btEnableV ? 1 : 0;
+}
+
+
 void QCanFrameApi::setDriverInit()
 {
    ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_DRIVER_INIT;
@@ -170,6 +289,61 @@ void QCanFrameApi::setDriverRelease()
 
 }
 
+//----------------------------------------------------------------------------//
+// setCredit()                                                                //
+// Byte 0 .. 3: number of credits                                             //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setCredit(uint32_t ulCreditV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_CREDIT;
+   setDataUInt32(0, ulCreditV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setFilterClear()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setFilterClear(void)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_FILTER;
+   aubByteP[0]  = (uint8_t) eFILTER_CLEAR;
+   aubByteP[1]  = 0;
+   setDataUInt32(4, 0);
+   setDataUInt32(8, 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// setFilterMask()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setFilterMask(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                                 bool btExtendedV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_FILTER;
+   aubByteP[0]  = (uint8_t) eFILTER_MASK;
+   aubByteP[1]  = (uint8_t) btExtendedV;
+   setDataUInt32(4, ulIdentifierV);
+   setDataUInt32(8, ulMaskV);
+}
+
+
+//----------------------------------------------------------------------------//
+// setFilterRange()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setFilterRange(uint32_t ulIdStartV, uint32_t ulIdStopV,
+                                  bool btExtendedV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_FILTER;
+   aubByteP[0]  = (uint8_t) eFILTER_RANGE;
+   aubByteP[1]  = (uint8_t) btExtendedV;
+   setDataUInt32(4, ulIdStartV);
+   setDataUInt32(8, ulIdStopV);
+}
+
+
 void QCanFrameApi::setName(QString clNameV)
 {
    int32_t  slSizeT;
@@ -201,6 +375,28 @@ void QCanFrameApi::setName(QString clNameV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setPriority()                                                              //
+// Byte 0: priority class                                                     //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setPriority(Priority_e tePriorityV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_PRIORITY;
+   aubByteP[0]  = (uint8_t) tePriorityV;
+}
+
+
+//----------------------------------------------------------------------------//
+// setWireFormat()                                                            //
+// Byte 0: wire format                                                        //
+//----------------------------------------------------------------------------//
+void QCanFrameApi::setWireFormat(WireFormat_e teFormatV)
+{
+   ulMsgMarkerP = QCanFrameApi::eAPI_FUNC_FORMAT;
+   aubByteP[0]  = (uint8_t) teFormatV;
+}
+
+
 //----------------------------------------------------------------------------//
 // fromByteArray()                                                            //
 //                                                                            //
@@ -271,3 +467,21 @@ QString QCanFrameApi::toString(const bool & btShowTimeR)
    return(clStringT);
 }
       
+
+
+//----------------------------------------------------------------------------//
+// wireFormat()                                                               //
+// Byte 0: wire format                                                        //
+//----------------------------------------------------------------------------//
+bool QCanFrameApi::wireFormat(WireFormat_e & teFormatR)
+{
+   bool  btResultT = false;
+
+   if(ulMsgMarkerP == QCanFrameApi::eAPI_FUNC_FORMAT)
+   {
+      teFormatR = (WireFormat_e) aubByteP[0];
+      btResultT = true;
+   }
+
+   return(btResultT);
+}
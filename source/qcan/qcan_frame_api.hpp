@@ -70,8 +70,82 @@ public:
 
       eAPI_FUNC_NAME,
 
-      eAPI_FUNC_STATE
+      eAPI_FUNC_STATE,
 
+      /*! Set acceptance filter of socket                */
+      eAPI_FUNC_FILTER,
+
+      /*! Select wire format of socket                   */
+      eAPI_FUNC_FORMAT,
+
+      /*! Enable / disable checksum of fixed format      */
+      eAPI_FUNC_CHECKSUM,
+
+      /*! Select dispatcher priority of socket           */
+      eAPI_FUNC_PRIORITY,
+
+      /*! Grant transmit credits to socket               */
+      eAPI_FUNC_CREDIT,
+
+      /*! Enable / disable transmit confirmation         */
+      eAPI_FUNC_CONFIRM
+
+   };
+
+   /*!
+   ** \enum    FilterType_e
+   **
+   ** This enumeration defines the type of an acceptance filter which is
+   ** transmitted by the function #eAPI_FUNC_FILTER.
+   */
+   enum FilterType_e {
+
+      /*! Remove all filters, all CAN frames are received */
+      eFILTER_CLEAR = 0,
+
+      /*! Identifier / mask filter                       */
+      eFILTER_MASK,
+
+      /*! Identifier range filter                        */
+      eFILTER_RANGE
+   };
+
+   /*!
+   ** \enum    WireFormat_e
+   **
+   ** This enumeration defines the format of the CAN frames which are
+   ** exchanged between socket and server, it is transmitted by the
+   ** function #eAPI_FUNC_FORMAT.
+   */
+   enum WireFormat_e {
+
+      /*! Fixed frame size of 96 bytes (default)         */
+      eWIRE_FORMAT_FIXED = 0,
+
+      /*! Variable frame size, refer to QCanData::toCompactArray() */
+      eWIRE_FORMAT_COMPACT
+   };
+
+   /*!
+   ** \enum    Priority_e
+   **
+   ** This enumeration defines the priority class of a socket, which
+   ** is used by the dispatcher of the server for reading the frames of
+   ** the socket. It is transmitted by the function #eAPI_FUNC_PRIORITY.
+   */
+   enum Priority_e {
+
+      /*! Real-time control, read before all other classes */
+      ePRIORITY_REALTIME = 0,
+
+      /*! Default class of a socket                      */
+      ePRIORITY_NORMAL,
+
+      /*! Bulk transfer, e.g. replay of a trace file     */
+      ePRIORITY_BULK,
+
+      /*! Number of priority classes                     */
+      ePRIORITY_MAX
    };
 
 
@@ -86,24 +160,156 @@ public:
 
    int32_t  bitrateNominal(void);
    
+   /*!
+   ** \param[out] btEnableR      Checksum enabled
+   ** \return     \c true if the API frame defines the checksum mode
+   ** \see        setChecksum()
+   */
+   bool  checksum(bool & btEnableR);
+
+   /*!
+   ** \param[out] btEnableR      Transmit confirmation enabled
+   ** \return     \c true if the API frame defines the confirmation mode
+   ** \see        setConfirm()
+   */
+   bool  confirm(bool & btEnableR);
+
+   /*!
+   ** \param[out] ulCreditR      Number of transmit credits
+   ** \return     \c true if the API frame grants transmit credits
+   ** \see        setCredit()
+   */
+   bool  credit(uint32_t & ulCreditR);
+
    //bool  hdi(CpHdi_ts & tsHdiR);
 
+   /*!
+   ** \param[out] teTypeR        Filter type
+   ** \param[out] ulValue1R      Identifier / first identifier of range
+   ** \param[out] ulValue2R      Mask / last identifier of range
+   ** \param[out] btExtendedR    Extended frame format
+   ** \return     \c true if the API frame defines a filter
+   ** \see        setFilterMask(), setFilterRange()
+   **
+   ** Get the acceptance filter of an API frame with the function
+   ** #eAPI_FUNC_FILTER.
+   */
+   bool  filter(FilterType_e & teTypeR, uint32_t & ulValue1R,
+                uint32_t & ulValue2R, bool & btExtendedR);
+
    ApiFunc_e function(void);
 
    bool  name(QString & clNameR);
 
+   /*!
+   ** \param[out] tePriorityR    Priority class
+   ** \return     \c true if the API frame defines a priority class
+   ** \see        setPriority()
+   */
+   bool  priority(Priority_e & tePriorityR);
+
    CAN_Mode_e  mode(void);
 
    void setBitrate(int32_t slBitrateV, int32_t slBrsClockV);
 
+   /*!
+   ** \param[in]  btEnableV      Enable checksum
+   ** \see        checksum()
+   **
+   ** Request the checksum mode for CAN frames in fixed format exchanged
+   ** between socket and server. The server confirms the request by
+   ** sending the API frame back to the socket, the checksum is only
+   ** disabled for connections via the local host.
+   */
+   void  setChecksum(bool btEnableV);
+
+   /*!
+   ** \param[in]  btEnableV      Enable transmit confirmation
+   ** \see        confirm()
+   **
+   ** Request a transmit confirmation for each CAN frame sent by the
+   ** socket. The server returns a copy of the frame with the attribute
+   ** QCanFrame::isTransmitConfirm() set after transmission, the request
+   ** is not confirmed.
+   */
+   void  setConfirm(bool btEnableV);
+
+   /*!
+   ** \param[in]  ulCreditV      Number of transmit credits
+   ** \see        credit()
+   **
+   ** Grant \a ulCreditV transmit credits to a socket. Each credit allows
+   ** the socket to send one more CAN frame to the network.
+   */
+   void  setCredit(uint32_t ulCreditV);
+
    void  setDriverInit();
 
    void  setDriverRelease();
 
+   /*!
+   ** \see        setFilterMask(), setFilterRange()
+   **
+   ** Remove all acceptance filters of the socket, afterwards the socket
+   ** receives all CAN frames of the network.
+   */
+   void  setFilterClear(void);
+
+   /*!
+   ** \param[in]  ulIdentifierV  Identifier value
+   ** \param[in]  ulMaskV        Mask value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \see        setFilterClear()
+   **
+   ** Add an identifier / mask acceptance filter to the socket. A CAN frame
+   ** is received if all identifier bits that are set in \a ulMaskV are
+   ** equal to the bits of \a ulIdentifierV.
+   */
+   void  setFilterMask(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                       bool btExtendedV = false);
+
+   /*!
+   ** \param[in]  ulIdStartV     First identifier value
+   ** \param[in]  ulIdStopV      Last identifier value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \see        setFilterClear()
+   **
+   ** Add an identifier range acceptance filter to the socket.
+   */
+   void  setFilterRange(uint32_t ulIdStartV, uint32_t ulIdStopV,
+                        bool btExtendedV = false);
+
    void  setMode(CAN_Mode_e teModeV);
 
    void  setName(QString clNameV);
 
+   /*!
+   ** \param[in]  tePriorityV    Priority class
+   ** \see        priority()
+   **
+   ** Request the priority class \a tePriorityV for the socket. The
+   ** dispatcher of the server reads the frames of sockets with a higher
+   ** priority class first, the request is not confirmed.
+   */
+   void  setPriority(Priority_e tePriorityV);
+
+   /*!
+   ** \param[in]  teFormatV      Wire format
+   ** \see        wireFormat()
+   **
+   ** Request the wire format \a teFormatV for all CAN frames exchanged
+   ** between socket and server. The server confirms the request by
+   ** sending the API frame back to the socket.
+   */
+   void  setWireFormat(WireFormat_e teFormatV);
+
+   /*!
+   ** \param[out] teFormatR      Wire format
+   ** \return     \c true if the API frame defines a wire format
+   ** \see        setWireFormat()
+   */
+   bool  wireFormat(WireFormat_e & teFormatR);
+
    //void  setHdi(CpHdi_ts * tsHdiV);
    
    bool       fromByteArray(const QByteArray & clByteArrayR);
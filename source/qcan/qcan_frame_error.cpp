@@ -181,6 +181,15 @@ QByteArray QCanFrameError::toByteArray() const
    return QCanData::toByteArray();
 }
 
+//----------------------------------------------------------------------------//
+// toRawFrame()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameError::toRawFrame(QCanRawFrame_ts & tsRawFrameR) const
+{
+   QCanData::toRawFrame(tsRawFrameR);
+}
+
 //----------------------------------------------------------------------------//
 // toString()                                                                 //
 // print CAN frame                                                            //
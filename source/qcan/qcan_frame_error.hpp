@@ -179,6 +179,16 @@ public:
 
    bool       fromByteArray(const QByteArray & clByteArrayR);
    QByteArray toByteArray() const;
+
+   /*!
+   ** \param[out] tsRawFrameR    Frame in binary format
+   **
+   ** The function writes the error frame into the binary frame
+   ** \a tsRawFrameR, it is used by a CAN plug-in to pass an error
+   ** frame by QCanInterface::readBatch().
+   */
+   void       toRawFrame(QCanRawFrame_ts & tsRawFrameR) const;
+
    virtual QString   toString(const bool & btShowTimeR = false);
    
 private:
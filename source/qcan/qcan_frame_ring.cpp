@@ -0,0 +1,176 @@
+//============================================================================//
+// File:          qcan_frame_ring.cpp                                         //
+// Description:   QCAN classes - Lock-free frame ring                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "qcan_frame_ring.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanFrameRing()                                                            //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFrameRing::QCanFrameRing(uint32_t ulSizeV)
+{
+   uint32_t ulCapacityT = 2;
+
+   //----------------------------------------------------------------
+   // the mask requires a power of two
+   //
+   while((ulCapacityT < ulSizeV) && (ulCapacityT < 0x80000000UL))
+   {
+      ulCapacityT <<= 1;
+   }
+
+   patsSlotP = new QCanFrameRingSlot_ts[ulCapacityT];
+   ulMaskP   = ulCapacityT - 1;
+
+   ulHeadP.store(0);
+   ulTailP.store(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanFrameRing()                                                           //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanFrameRing::~QCanFrameRing()
+{
+   delete [] patsSlotP;
+}
+
+
+//----------------------------------------------------------------------------//
+// count()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrameRing::count(void) const
+{
+   return (ulHeadP.loadAcquire() - ulTailP.loadAcquire());
+}
+
+
+//----------------------------------------------------------------------------//
+// front()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameRing::front(const QCanFrameRingSlot_ts * & ptsSlotR) const
+{
+   uint32_t ulTailT;
+
+   //----------------------------------------------------------------
+   // the acquire operation on the head makes the slot data of
+   // the producer visible
+   //
+   ulTailT = ulTailP.load();
+   if(ulHeadP.loadAcquire() == ulTailT)
+   {
+      return (false);
+   }
+
+   ptsSlotR = &patsSlotP[ulTailT & ulMaskP];
+   return (true);
+}
+
+
+//----------------------------------------------------------------------------//
+// pop()                                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameRing::pop(void)
+{
+   uint32_t ulTailT;
+
+   ulTailT = ulTailP.load();
+   if(ulHeadP.loadAcquire() != ulTailT)
+   {
+      ulTailP.storeRelease(ulTailT + 1);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// push()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameRing::push(const QByteArray & clDataR, int64_t sqTimeV)
+{
+   return (push((const uint8_t *) clDataR.constData(), clDataR.size(),
+                sqTimeV));
+}
+
+
+//----------------------------------------------------------------------------//
+// push()                                                                     //
+// producer: add a frame from a buffer                                        //
+//----------------------------------------------------------------------------//
+bool QCanFrameRing::push(const uint8_t * pubDataV, int32_t slSizeV,
+                         int64_t sqTimeV)
+{
+   uint32_t                ulHeadT;
+   QCanFrameRingSlot_ts *  ptsSlotT;
+
+   if((slSizeV <= 0) || (slSizeV > QCAN_FRAME_ARRAY_SIZE))
+   {
+      return (false);
+   }
+
+   //----------------------------------------------------------------
+   // the acquire operation on the tail makes sure the consumer has
+   // finished reading the slot
+   //
+   ulHeadT = ulHeadP.load();
+   if((ulHeadT - ulTailP.loadAcquire()) > ulMaskP)
+   {
+      return (false);
+   }
+
+   ptsSlotT = &patsSlotP[ulHeadT & ulMaskP];
+   memcpy(ptsSlotT->aubData, pubDataV, slSizeV);
+   ptsSlotT->slSize = slSizeV;
+   ptsSlotT->sqTime = sqTimeV;
+
+   //----------------------------------------------------------------
+   // publish the slot
+   //
+   ulHeadP.storeRelease(ulHeadT + 1);
+
+   return (true);
+}
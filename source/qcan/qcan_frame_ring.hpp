@@ -0,0 +1,182 @@
+//============================================================================//
+// File:          qcan_frame_ring.hpp                                         //
+// Description:   QCAN classes - Lock-free frame ring                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_FRAME_RING_HPP_
+#define QCAN_FRAME_RING_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QByteArray>
+
+#include "qcan_data.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Default number of slots, the value must be a power of two
+//
+#define  QCAN_FRAME_RING_SIZE       1024
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanFrameRing
+** \brief   Lock-free ring of frames
+** 
+** The QCanFrameRing class passes frames from exactly one producer thread
+** to exactly one consumer thread without locking. Each slot holds one
+** frame in the fixed wire format (#QCAN_FRAME_ARRAY_SIZE bytes) together
+** with a time stamp, so neither push() nor pop() allocates memory.
+** <p>
+** The producer calls isFull() and push(), the consumer calls front()
+** and pop(). Only the index of the respective other side is read, hence
+** the head and tail index are the only shared values.
+*/
+class QCanFrameRing
+{
+public:
+
+   /*!
+   ** \struct  QCanFrameRingSlot_s
+   **
+   ** One slot of the ring.
+   */
+   typedef struct QCanFrameRingSlot_s {
+      /*! Frame data                                     */
+      uint8_t  aubData[QCAN_FRAME_ARRAY_SIZE];
+      /*! Number of valid bytes inside aubData           */
+      int32_t  slSize;
+      /*! Time stamp of the producer                     */
+      int64_t  sqTime;
+   } QCanFrameRingSlot_ts;
+
+   /*!
+   ** \param[in]  ulSizeV        Number of slots
+   **
+   ** Create a ring with \a ulSizeV slots, the value is rounded up to
+   ** the next power of two.
+   */
+   QCanFrameRing(uint32_t ulSizeV = QCAN_FRAME_RING_SIZE);
+
+   ~QCanFrameRing();
+
+   /*!
+   ** \return     Number of slots
+   */
+   uint32_t    capacity(void) const         { return (ulMaskP + 1);   };
+
+   /*!
+   ** \return     Number of frames inside the ring
+   **
+   ** The value is only exact when it is called by the producer or
+   ** the consumer.
+   */
+   uint32_t    count(void) const;
+
+   /*!
+   ** \param[out] ptsSlotR       Pointer to the oldest slot
+   ** \return     \c true if the ring is not empty
+   ** \see        pop()
+   **
+   ** Consumer: get the oldest frame of the ring without copying it. The
+   ** slot stays valid until pop() is called.
+   */
+   bool        front(const QCanFrameRingSlot_ts * & ptsSlotR) const;
+
+   /*!
+   ** \return     \c true if the ring is empty
+   */
+   bool        isEmpty(void) const          { return (count() == 0);  };
+
+   /*!
+   ** \return     \c true if no frame can be added
+   */
+   bool        isFull(void) const           { return (count() > ulMaskP); };
+
+   /*!
+   ** \see        front()
+   **
+   ** Consumer: release the oldest slot.
+   */
+   void        pop(void);
+
+   /*!
+   ** \param[in]  clDataR        Frame data
+   ** \param[in]  sqTimeV        Time stamp
+   ** \return     \c true if the frame was added
+   **
+   ** Producer: add a frame to the ring. The function returns \c false if
+   ** the ring is full or if \a clDataR is larger than one slot.
+   */
+   bool        push(const QByteArray & clDataR, int64_t sqTimeV = 0);
+
+   /*!
+   ** \param[in]  pubDataV       Pointer to frame data
+   ** \param[in]  slSizeV        Number of bytes
+   ** \param[in]  sqTimeV        Time stamp
+   ** \return     \c true if the frame was added
+   **
+   ** Producer: add a frame from the buffer \a pubDataV to the ring,
+   ** without creating a byte array.
+   */
+   bool        push(const uint8_t * pubDataV, int32_t slSizeV,
+                    int64_t sqTimeV = 0);
+
+private:
+
+   //----------------------------------------------------------------
+   // the ring can not be copied
+   //
+   QCanFrameRing(const QCanFrameRing &);
+   QCanFrameRing & operator=(const QCanFrameRing &);
+
+   QCanFrameRingSlot_ts *  patsSlotP;
+   uint32_t                ulMaskP;
+
+   //----------------------------------------------------------------
+   // head is written by the producer, tail by the consumer, both
+   // are free running and wrap around at 2^32
+   //
+   QAtomicInteger<quint32> ulHeadP;
+   QAtomicInteger<quint32> ulTailP;
+};
+
+
+#endif   // QCAN_FRAME_RING_HPP_
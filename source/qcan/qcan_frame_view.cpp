@@ -0,0 +1,457 @@
+//============================================================================//
+// File:          qcan_frame_view.cpp                                         //
+// Description:   QCAN classes - CAN frame view                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <QtEndian>
+
+#include "qcan_frame_view.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#define  CAN_FRAME_FORMAT_EXT       ((uint8_t) 0x01)
+
+#define  CAN_FRAME_FORMAT_RTR       ((uint8_t) 0x04)
+
+#define  CAN_FRAME_TRM_CONFIRM      ((uint8_t) 0x10)
+
+#define  CAN_FRAME_ISO_FD_BRS       ((uint8_t) 0x40)
+
+//-------------------------------------------------------------------
+// compact format: marker in byte 0 and flag for the user / marker
+// fields inside byte 5, refer to QCanData
+//
+#define  QCAN_FRAME_FORMAT_COMPACT  ((uint8_t) 0x20)
+
+#define  QCAN_COMPACT_CTRL_USER     ((uint8_t) 0x20)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanFrameView()                                                            //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFrameView::QCanFrameView()
+{
+   pubBufferP = Q_NULLPTR;
+   slSizeP    = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// QCanFrameView()                                                            //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFrameView::QCanFrameView(const uint8_t * pubBufferV, int32_t slSizeV)
+{
+   setBuffer(pubBufferV, slSizeV);
+}
+
+
+//----------------------------------------------------------------------------//
+// QCanFrameView()                                                            //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanFrameView::QCanFrameView(const QByteArray & clByteArrayR)
+{
+   setBuffer((const uint8_t *) clByteArrayR.constData(), clByteArrayR.size());
+}
+
+
+//----------------------------------------------------------------------------//
+// bitrateSwitch()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::bitrateSwitch(void) const
+{
+   if(isValid() == false)
+   {
+      return(false);
+   }
+   return((pubBufferP[5] & CAN_FRAME_ISO_FD_BRS) > 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// data()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint8_t QCanFrameView::data(const uint8_t & ubPosR) const
+{
+   if(ubPosR < dataSize())
+   {
+      return(pubBufferP[payloadPos() + ubPosR]);
+   }
+   return(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// dataSize()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint8_t QCanFrameView::dataSize(void) const
+{
+   return(QCanData::dlcToSize(dlc()));
+}
+
+
+//----------------------------------------------------------------------------//
+// dlc()                                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint8_t QCanFrameView::dlc(void) const
+{
+   if(isValid() == false)
+   {
+      return(0);
+   }
+   return(pubBufferP[4]);
+}
+
+
+//----------------------------------------------------------------------------//
+// frameFormat()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanFrame::Format_e QCanFrameView::frameFormat(void) const
+{
+   if(isValid() == false)
+   {
+      return(QCanFrame::eFORMAT_CAN_STD);
+   }
+   return((QCanFrame::Format_e) (pubBufferP[5] & 0x03));
+}
+
+
+//----------------------------------------------------------------------------//
+// frameType()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanData::Type_e QCanFrameView::frameType(void) const
+{
+   QCanData::Type_e  teTypeT = QCanData::eTYPE_UNKNOWN;
+
+   if(isValid() == true)
+   {
+      switch(pubBufferP[0] & 0xC0)
+      {
+         case 0x00:
+            teTypeT = QCanData::eTYPE_CAN;
+            break;
+
+         case 0x40:
+            teTypeT = QCanData::eTYPE_API;
+            break;
+
+         case 0x80:
+            teTypeT = QCanData::eTYPE_ERROR;
+            break;
+
+         default:
+
+            break;
+      }
+   }
+
+   return(teTypeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// identifier()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrameView::identifier(void) const
+{
+   uint32_t ulIdValueT = 0;
+
+   if(isValid() == true)
+   {
+      //--------------------------------------------------------
+      // the mask removes the frame type and the compact format
+      // marker from the identifier field (byte 0 .. 3)
+      //
+      ulIdValueT = qFromBigEndian<uint32_t>(pubBufferP);
+      if(isExtended())
+      {
+         ulIdValueT = ulIdValueT & QCAN_FRAME_ID_MASK_EXT;
+      }
+      else
+      {
+         ulIdValueT = ulIdValueT & QCAN_FRAME_ID_MASK_STD;
+      }
+   }
+
+   return(ulIdValueT);
+}
+
+
+//----------------------------------------------------------------------------//
+// isCompact()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::isCompact(void) const
+{
+   if(isValid() == false)
+   {
+      return(false);
+   }
+   return((pubBufferP[0] & 0xE0) == QCAN_FRAME_FORMAT_COMPACT);
+}
+
+
+//----------------------------------------------------------------------------//
+// isExtended()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::isExtended(void) const
+{
+   if(isValid() == false)
+   {
+      return(false);
+   }
+   return((pubBufferP[5] & CAN_FRAME_FORMAT_EXT) > 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// isRemote()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::isRemote(void) const
+{
+   if(isValid() == false)
+   {
+      return(false);
+   }
+   return((pubBufferP[5] & CAN_FRAME_FORMAT_RTR) > 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// isTransmitConfirm()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::isTransmitConfirm(void) const
+{
+   if(isValid() == false)
+   {
+      return(false);
+   }
+   return((pubBufferP[5] & CAN_FRAME_TRM_CONFIRM) > 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// isValid()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::isValid(void) const
+{
+   return(slSizeP > 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// marker()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrameView::marker(void) const
+{
+   uint32_t ulMarkerT = 0;
+
+   if(isCompact() == true)
+   {
+      if((pubBufferP[5] & QCAN_COMPACT_CTRL_USER) > 0)
+      {
+         ulMarkerT = qFromBigEndian<uint32_t>(pubBufferP + 
+                                              QCAN_FRAME_COMPACT_SIZE + 4);
+      }
+   }
+   else if(isValid() == true)
+   {
+      ulMarkerT = qFromBigEndian<uint32_t>(pubBufferP + 82);
+   }
+
+   return(ulMarkerT);
+}
+
+
+//----------------------------------------------------------------------------//
+// payloadPos()                                                               //
+// position of the payload inside the buffer                                  //
+//----------------------------------------------------------------------------//
+int32_t QCanFrameView::payloadPos(void) const
+{
+   int32_t  slPosT = 6;
+
+   if(isCompact() == true)
+   {
+      slPosT = QCAN_FRAME_COMPACT_SIZE;
+      if((pubBufferP[5] & QCAN_COMPACT_CTRL_USER) > 0)
+      {
+         slPosT += 8;
+      }
+   }
+
+   return(slPosT);
+}
+
+
+//----------------------------------------------------------------------------//
+// rawData()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrameView::rawData(void) const
+{
+   return(QByteArray::fromRawData((const char *) pubBufferP, slSizeP));
+}
+
+
+//----------------------------------------------------------------------------//
+// setBuffer()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanFrameView::setBuffer(const uint8_t * pubBufferV, int32_t slSizeV)
+{
+   //----------------------------------------------------------------
+   // the view is only valid if the buffer holds the complete frame
+   //
+   pubBufferP = pubBufferV;
+   slSizeP    = QCanData::bufferSize(pubBufferV, slSizeV);
+   if(slSizeP > slSizeV)
+   {
+      slSizeP = 0;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// timeStamp()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanTimeStamp QCanFrameView::timeStamp(void) const
+{
+   QCanTimeStamp  clTimeStampT;
+   int32_t        slPosT = 70;
+
+   if(isValid() == true)
+   {
+      if(isCompact() == true)
+      {
+         slPosT = 6;
+      }
+      clTimeStampT.setSeconds(qFromBigEndian<uint32_t>(pubBufferP + slPosT));
+      clTimeStampT.setNanoSeconds(qFromBigEndian<uint32_t>(pubBufferP + 
+                                                           slPosT + 4));
+   }
+
+   return(clTimeStampT);
+}
+
+
+//----------------------------------------------------------------------------//
+// toByteArray()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrameView::toByteArray(bool btChecksumV) const
+{
+   if(isCompact() == true)
+   {
+      return(QCanData::convertToFixed(rawData(), btChecksumV));
+   }
+   return(QByteArray((const char *) pubBufferP, slSizeP));
+}
+
+
+//----------------------------------------------------------------------------//
+// toCompactArray()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QByteArray QCanFrameView::toCompactArray(void) const
+{
+   if(isCompact() == true)
+   {
+      return(QByteArray((const char *) pubBufferP, slSizeP));
+   }
+   return(QCanData::convertToCompact(rawData()));
+}
+
+
+//----------------------------------------------------------------------------//
+// toFrame()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanFrameView::toFrame(QCanFrame & clFrameR, bool btChecksumV) const
+{
+   if(isValid() == false)
+   {
+      return(false);
+   }
+   return(clFrameR.fromBuffer(pubBufferP, slSizeP, btChecksumV));
+}
+
+
+//----------------------------------------------------------------------------//
+// user()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanFrameView::user(void) const
+{
+   uint32_t ulUserT = 0;
+
+   if(isCompact() == true)
+   {
+      if((pubBufferP[5] & QCAN_COMPACT_CTRL_USER) > 0)
+      {
+         ulUserT = qFromBigEndian<uint32_t>(pubBufferP + 
+                                            QCAN_FRAME_COMPACT_SIZE);
+      }
+   }
+   else if(isValid() == true)
+   {
+      ulUserT = qFromBigEndian<uint32_t>(pubBufferP + 78);
+   }
+
+   return(ulUserT);
+}
+
@@ -0,0 +1,238 @@
+//============================================================================//
+// File:          qcan_frame_view.hpp                                         //
+// Description:   QCAN classes - CAN frame view                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_FRAME_VIEW_HPP_
+#define QCAN_FRAME_VIEW_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include "qcan_frame.hpp"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanFrameView
+** \brief   Read-only view of a frame inside a buffer
+** 
+** The QCanFrameView class gives read access to a frame which is stored
+** inside a receive buffer, using the fixed format or the compact format
+** (see QCanData::toCompactArray()). The view does not copy the buffer, each
+** field is decoded when it is accessed. Hence the buffer must not be
+** modified or released as long as the view is used.
+** <p>
+** A view is intended for code that only looks at a few fields (e.g.
+** identifier and frame format) before dropping or forwarding the frame.
+** The function toFrame() decodes the complete CAN frame, including the
+** test of the checksum.
+*/
+class QCanFrameView
+{
+public:
+
+   /*!
+   ** Constructs an empty view, isValid() returns \c false.
+   */
+   QCanFrameView();
+
+   /*!
+   ** \param[in]  pubBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes inside the buffer
+   **
+   ** Constructs a view of the frame stored at \a pubBufferV.
+   */
+   QCanFrameView(const uint8_t * pubBufferV, int32_t slSizeV);
+
+   /*!
+   ** \param[in]  clByteArrayR   Byte array
+   **
+   ** Constructs a view of the frame stored in the byte array
+   ** \a clByteArrayR, the byte array must exist as long as the view
+   ** is used.
+   */
+   QCanFrameView(const QByteArray & clByteArrayR);
+
+   /*!
+   ** \return     \c true if the bit-rate switch (BRS) bit is set
+   */
+   bool              bitrateSwitch(void) const;
+
+   /*!
+   ** \return     Pointer to the frame inside the buffer
+   */
+   const uint8_t *   constData(void) const   { return (pubBufferP); };
+
+   /*!
+   ** \param[in]  ubPosR         Index of payload
+   ** \return     Data value
+   **
+   ** The function returns the data byte at position \a ubPosR of the
+   ** payload. If \a ubPosR is outside the payload, the function
+   ** returns 0.
+   */
+   uint8_t           data(const uint8_t & ubPosR) const;
+
+   /*!
+   ** \return     Number of payload bytes
+   */
+   uint8_t           dataSize(void) const;
+
+   /*!
+   ** \return     DLC value
+   */
+   uint8_t           dlc(void) const;
+
+   /*!
+   ** \return     CAN frame format
+   */
+   QCanFrame::Format_e  frameFormat(void) const;
+
+   /*!
+   ** \return     Frame type
+   **
+   ** The function returns the frame type (CAN, API or error frame), which
+   ** is evaluated from the first byte of the buffer.
+   */
+   QCanData::Type_e  frameType(void) const;
+
+   /*!
+   ** \return     Identifier value
+   **
+   ** The function returns the identifier value of a CAN frame, masked by
+   ** the frame format.
+   */
+   uint32_t          identifier(void) const;
+
+   /*!
+   ** \return     \c true if the frame is stored in compact format
+   */
+   bool              isCompact(void) const;
+
+   /*!
+   ** \return     \c true for extended frame format
+   */
+   bool              isExtended(void) const;
+
+   /*!
+   ** \return     \c true for a remote frame
+   */
+   bool              isRemote(void) const;
+
+   /*!
+   ** \return     \c true for a transmit confirmation
+   */
+   bool              isTransmitConfirm(void) const;
+
+   /*!
+   ** \return     \c true if the buffer holds a complete frame
+   **
+   ** The function tests the size of the buffer, the checksum of the fixed
+   ** format is not evaluated.
+   */
+   bool              isValid(void) const;
+
+   /*!
+   ** \return     Message marker
+   */
+   uint32_t          marker(void) const;
+
+   /*!
+   ** \return     Byte array referencing the buffer
+   **
+   ** The function returns a byte array which references the buffer
+   ** without copying it (QByteArray::fromRawData()). The byte array is
+   ** only valid as long as the buffer exists.
+   */
+   QByteArray        rawData(void) const;
+
+   /*!
+   ** \param[in]  pubBufferV     Pointer to buffer
+   ** \param[in]  slSizeV        Number of bytes inside the buffer
+   **
+   ** Move the view to the frame stored at \a pubBufferV.
+   */
+   void              setBuffer(const uint8_t * pubBufferV, int32_t slSizeV);
+
+   /*!
+   ** \return     Size of the frame in bytes
+   */
+   int32_t           size(void) const        { return (slSizeP);    };
+
+   /*!
+   ** \return     Time-stamp
+   */
+   QCanTimeStamp     timeStamp(void) const;
+
+   /*!
+   ** \param[in]  btChecksumV    Calculate checksum
+   ** \return     Byte array in fixed format
+   ** \see        toCompactArray()
+   **
+   ** A frame in fixed format is returned unchanged, the parameter
+   ** \a btChecksumV only applies to the conversion of the compact format.
+   */
+   QByteArray        toByteArray(bool btChecksumV = true) const;
+
+   /*!
+   ** \return     Byte array in compact format
+   ** \see        toByteArray()
+   **
+   ** API frames and error frames are returned in fixed format.
+   */
+   QByteArray        toCompactArray(void) const;
+
+   /*!
+   ** \param[out] clFrameR       Reference to CAN frame
+   ** \param[in]  btChecksumV    Verify checksum
+   ** \return     \c true if the view holds a valid CAN frame
+   **
+   ** The function decodes the complete CAN frame into \a clFrameR.
+   */
+   bool              toFrame(QCanFrame & clFrameR,
+                             bool btChecksumV = true) const;
+
+   /*!
+   ** \return     User data
+   */
+   uint32_t          user(void) const;
+
+private:
+
+   int32_t           payloadPos(void) const;
+
+   const uint8_t *   pubBufferP;
+   int32_t           slSizeP;
+};
+
+
+#endif   // QCAN_FRAME_VIEW_HPP_
+
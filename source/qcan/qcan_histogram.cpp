@@ -0,0 +1,262 @@
+//============================================================================//
+// File:          qcan_histogram.cpp                                          //
+// Description:   QCAN classes - Histogram                                    //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include "qcan_histogram.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanHistogram()                                                            //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanHistogram::QCanHistogram()
+{
+   clear();
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanHistogram()                                                           //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanHistogram::~QCanHistogram()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// add()                                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanHistogram::add(uint64_t uqValueV)
+{
+   aulBucketP[bucketIndex(uqValueV)]++;
+   uqCountP++;
+   uqSumP += uqValueV;
+
+   if(uqValueV < uqMinimumP)
+   {
+      uqMinimumP = uqValueV;
+   }
+   if(uqValueV > uqMaximumP)
+   {
+      uqMaximumP = uqValueV;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// bucketCount()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanHistogram::bucketCount(int32_t slBucketV) const
+{
+   if((slBucketV < 0) || (slBucketV >= QCAN_HISTOGRAM_BUCKETS))
+   {
+      return(0);
+   }
+   return(aulBucketP[slBucketV]);
+}
+
+
+//----------------------------------------------------------------------------//
+// bucketIndex()                                                              //
+// the 2 bits below the most significant bit select the sub-bucket            //
+//----------------------------------------------------------------------------//
+int32_t QCanHistogram::bucketIndex(uint64_t uqValueV)
+{
+   int32_t  slMsbT = 0;
+   int32_t  slShiftT;
+   uint64_t uqBitsT = uqValueV;
+
+   if(uqValueV < QCAN_HISTOGRAM_SUB_BUCKETS)
+   {
+      return((int32_t) uqValueV);
+   }
+
+   //----------------------------------------------------------------
+   // position of the most significant bit by binary search
+   //
+   for(slShiftT = 32; slShiftT > 0; slShiftT >>= 1)
+   {
+      if((uqBitsT >> slShiftT) > 0)
+      {
+         slMsbT  += slShiftT;
+         uqBitsT >>= slShiftT;
+      }
+   }
+
+   return(QCAN_HISTOGRAM_SUB_BUCKETS + 
+          ((slMsbT - 2) * QCAN_HISTOGRAM_SUB_BUCKETS) +
+          (int32_t) ((uqValueV >> (slMsbT - 2)) & 0x03));
+}
+
+
+//----------------------------------------------------------------------------//
+// bucketLimit()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint64_t QCanHistogram::bucketLimit(int32_t slBucketV)
+{
+   int32_t  slShiftT;
+   uint64_t uqBaseT;
+
+   if(slBucketV < QCAN_HISTOGRAM_SUB_BUCKETS)
+   {
+      return((slBucketV < 0) ? 0 : (uint64_t) slBucketV);
+   }
+
+   slShiftT = (slBucketV - QCAN_HISTOGRAM_SUB_BUCKETS) / 
+              QCAN_HISTOGRAM_SUB_BUCKETS;
+   uqBaseT  = QCAN_HISTOGRAM_SUB_BUCKETS + 
+              ((slBucketV - QCAN_HISTOGRAM_SUB_BUCKETS) % 
+               QCAN_HISTOGRAM_SUB_BUCKETS);
+
+   //----------------------------------------------------------------
+   // the last buckets are beyond the 64-bit value range
+   //
+   if(slShiftT > 61)
+   {
+      return(UINT64_MAX);
+   }
+   return(uqBaseT << slShiftT);
+}
+
+
+//----------------------------------------------------------------------------//
+// clear()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanHistogram::clear(void)
+{
+   memset(aulBucketP, 0, sizeof(aulBucketP));
+   uqCountP   = 0;
+   uqMinimumP = UINT64_MAX;
+   uqMaximumP = 0;
+   uqSumP     = 0;
+}
+
+
+//----------------------------------------------------------------------------//
+// mean()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint64_t QCanHistogram::mean(void) const
+{
+   if(uqCountP == 0)
+   {
+      return(0);
+   }
+   return(uqSumP / uqCountP);
+}
+
+
+//----------------------------------------------------------------------------//
+// minimum()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint64_t QCanHistogram::minimum(void) const
+{
+   if(uqCountP == 0)
+   {
+      return(0);
+   }
+   return(uqMinimumP);
+}
+
+
+//----------------------------------------------------------------------------//
+// percentile()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint64_t QCanHistogram::percentile(uint32_t ulPermilleV) const
+{
+   int32_t  slBucketT;
+   uint64_t uqRankT;
+   uint64_t uqSumT = 0;
+   uint64_t uqValueT;
+
+   if(uqCountP == 0)
+   {
+      return(0);
+   }
+
+   if(ulPermilleV > 1000)
+   {
+      ulPermilleV = 1000;
+   }
+
+   //----------------------------------------------------------------
+   // number of values which must be below or equal to the result,
+   // at least one
+   //
+   uqRankT = ((uqCountP * ulPermilleV) + 999) / 1000;
+   if(uqRankT == 0)
+   {
+      uqRankT = 1;
+   }
+
+   uqValueT = uqMaximumP;
+   for(slBucketT = 0; slBucketT < QCAN_HISTOGRAM_BUCKETS; slBucketT++)
+   {
+      uqSumT += aulBucketP[slBucketT];
+      if(uqSumT >= uqRankT)
+      {
+         uqValueT = bucketLimit(slBucketT + 1) - 1;
+         break;
+      }
+   }
+
+   //----------------------------------------------------------------
+   // the bucket limit may be beyond the exact limits
+   //
+   if(uqValueT > uqMaximumP)
+   {
+      uqValueT = uqMaximumP;
+   }
+   if(uqValueT < uqMinimumP)
+   {
+      uqValueT = uqMinimumP;
+   }
+
+   return(uqValueT);
+}
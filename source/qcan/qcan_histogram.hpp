@@ -0,0 +1,148 @@
+//============================================================================//
+// File:          qcan_histogram.hpp                                          //
+// Description:   QCAN classes - Histogram                                    //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_HISTOGRAM_HPP_
+#define QCAN_HISTOGRAM_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Each power of two is divided into 4 buckets, this results in a
+// relative error of 25 % for a 64-bit value range
+//
+#define  QCAN_HISTOGRAM_SUB_BUCKETS    4
+
+#define  QCAN_HISTOGRAM_BUCKETS        256
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanHistogram
+** \brief   Histogram with logarithmic buckets
+** 
+** The QCanHistogram class counts values (e.g. latency values in
+** nanoseconds) inside buckets of logarithmic size: values from 0 to 3 have
+** a bucket of their own, above that each power of two is divided into
+** #QCAN_HISTOGRAM_SUB_BUCKETS buckets. Adding a value takes a few shift
+** operations and does not allocate memory, so the class can be used inside
+** the dispatcher of QCanNetwork.
+** <p>
+** Minimum, maximum and mean value are exact, the percentile values are
+** returned as the upper limit of the bucket.
+*/
+class QCanHistogram
+{
+public:
+
+   QCanHistogram();
+
+   ~QCanHistogram();
+
+   /*!
+   ** \param[in]  uqValueV       Value
+   **
+   ** Add the value \a uqValueV to the histogram.
+   */
+   void        add(uint64_t uqValueV);
+
+   /*!
+   ** \param[in]  slBucketV      Index of bucket
+   ** \return     Number of values inside the bucket
+   ** \see        bucketLimit()
+   */
+   uint32_t    bucketCount(int32_t slBucketV) const;
+
+   /*!
+   ** \param[in]  slBucketV      Index of bucket
+   ** \return     Lowest value of the bucket
+   ** \see        bucketCount()
+   */
+   static uint64_t bucketLimit(int32_t slBucketV);
+
+   /*!
+   ** Remove all values from the histogram.
+   */
+   void        clear(void);
+
+   /*!
+   ** \return     Number of values
+   */
+   uint64_t    count(void) const          { return (uqCountP);    };
+
+   /*!
+   ** \return     Maximum value
+   */
+   uint64_t    maximum(void) const        { return (uqMaximumP);  };
+
+   /*!
+   ** \return     Mean value
+   */
+   uint64_t    mean(void) const;
+
+   /*!
+   ** \return     Minimum value
+   */
+   uint64_t    minimum(void) const;
+
+   /*!
+   ** \param[in]  ulPermilleV    Percentile in 1/1000
+   ** \return     Value of percentile
+   **
+   ** The function returns the value below or equal to which
+   ** \a ulPermilleV / 1000 of all values are found, e.g. 500 returns the
+   ** median and 990 the 99th percentile. The result is the upper limit
+   ** of the corresponding bucket, but never larger than maximum().
+   */
+   uint64_t    percentile(uint32_t ulPermilleV) const;
+
+private:
+
+   static int32_t  bucketIndex(uint64_t uqValueV);
+
+   uint32_t    aulBucketP[QCAN_HISTOGRAM_BUCKETS];
+   uint64_t    uqCountP;
+   uint64_t    uqMinimumP;
+   uint64_t    uqMaximumP;
+   uint64_t    uqSumP;
+};
+
+
+#endif   // QCAN_HISTOGRAM_HPP_
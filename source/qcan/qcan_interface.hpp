@@ -41,12 +41,26 @@
 #define QCAN_INTERFACE_HPP_
 
 #include <stdint.h>
+
+#include <QObject>
+
 #include "qcan_defs.hpp"
 #include "qcan_frame.hpp"
 
 
 using namespace QCan;
 
+//-------------------------------------------------------------------
+/*!
+** \def  QCAN_INTERFACE_BATCH_MAX
+**
+** The symbol QCAN_INTERFACE_BATCH_MAX defines the maximum number of
+** frames which are passed by one call of QCanInterface::readBatch()
+** or QCanInterface::writeBatch().
+*/
+#define  QCAN_INTERFACE_BATCH_MAX    64
+
+
 //-----------------------------------------------------------------------------
 /*!
 ** \class   QCanInterface
@@ -56,9 +70,16 @@ using namespace QCan;
 ** interface is typically implemented inside a CAN plug-in (see QCanPlugin).
 ** After connection to the CAN interface (see connect()) the use can read and
 ** write CAN frames via this hardware.
+** <p>
+** A CAN interface added to a QCanNetwork (QCanNetwork::addInterface()) is
+** not moved to the thread of the network. The network calls the interface
+** from its own thread, the receive thread of the network
+** (QCanInterfaceReader) calls readBatch() and waitForFrames() at the same
+** time. A CAN plug-in must therefore be thread-safe.
 */
 class QCanInterface : public QObject
 {
+   Q_OBJECT
 
 public:
 
@@ -157,6 +178,51 @@ public:
    **
    */
    virtual InterfaceError_e   read( QByteArray &clDataR) = 0;
+
+   /*!
+   ** \param[out] ptsFrameListV  Pointer to array of frames
+   ** \param[in]  ulFrameMaxV    Number of elements of the array
+   ** \param[out] ulFrameCntR    Number of frames read
+   ** \return     Status code defined by InterfaceError_e
+   ** \see        writeBatch()
+   **
+   ** The function reads up to \a ulFrameMaxV frames from the CAN
+   ** interface into the array \a ptsFrameListV, the number of frames
+   ** is returned in \a ulFrameCntR. If no frame is available, the
+   ** function returns eERROR_FIFO_RCV_EMPTY. A CAN plug-in should
+   ** implement this function and fill the frames directly from the
+   ** message buffer of the CAN interface. The default implementation
+   ** calls read() for each frame.
+   */
+   virtual InterfaceError_e   readBatch(QCanRawFrame_ts * ptsFrameListV,
+                                        uint32_t ulFrameMaxV,
+                                        uint32_t & ulFrameCntR)
+   {
+      InterfaceError_e  teErrorT = eERROR_NONE;
+      QByteArray        clDataT;
+      QCanData          clFrameT(QCanData::eTYPE_CAN);
+
+      ulFrameCntR = 0;
+      while(ulFrameCntR < ulFrameMaxV)
+      {
+         teErrorT = read(clDataT);
+         if(teErrorT != eERROR_NONE)
+         {
+            break;
+         }
+         if(clFrameT.fromByteArray(clDataT) == true)
+         {
+            clFrameT.toRawFrame(ptsFrameListV[ulFrameCntR]);
+            ulFrameCntR++;
+         }
+      }
+
+      if(ulFrameCntR > 0)
+      {
+         teErrorT = eERROR_NONE;
+      }
+      return (teErrorT);
+   };
    
    /*!
    ** \param[in]  slNomBitRateV  Nominal Bit-rate value
@@ -195,6 +261,38 @@ public:
    **
    */
    virtual uint32_t           supportedFeatures(void) = 0;
+
+   /*!
+   ** \param[in]  btEnableV      Enable transmit confirmation
+   ** \return     Status code defined by InterfaceError_e
+   ** \see        write()
+   **
+   ** A CAN interface supporting #QCAN_IF_SUPPORT_TRM_CONFIRM returns a
+   ** copy of each frame written by write() after it has been transmitted
+   ** on the CAN bus. The copy is passed by read() in the order of the
+   ** write() calls, it has the attribute QCanFrame::isTransmitConfirm()
+   ** set and carries the time-stamp of transmission taken by the CAN
+   ** interface. The signal framesWritten() notifies about new
+   ** confirmations. The default implementation returns eERROR_MODE.
+   */
+   virtual InterfaceError_e   setTransmitConfirm(bool btEnableV)
+                              { Q_UNUSED(btEnableV); return (eERROR_MODE); };
+
+   /*!
+   ** \param[in]  ulTimeoutV     Time-out value in milliseconds
+   ** \return     Status code defined by InterfaceError_e
+   ** \see        readBatch()
+   **
+   ** The function blocks the calling thread until the receive FIFO of
+   ** the CAN interface holds a frame or the time-out \a ulTimeoutV has
+   ** elapsed. It is used by a receive thread (QCanInterfaceReader), which
+   ** waits on the receive event of the driver instead of polling. The
+   ** function returns eERROR_NONE if a frame is available and
+   ** eERROR_FIFO_RCV_EMPTY on time-out. The default implementation
+   ** returns eERROR_MODE, the caller polls readBatch() in that case.
+   */
+   virtual InterfaceError_e   waitForFrames(uint32_t ulTimeoutV)
+                              { Q_UNUSED(ulTimeoutV); return (eERROR_MODE); };
 	
 
    /*!
@@ -208,6 +306,46 @@ public:
    */
    virtual InterfaceError_e	write(const QCanFrame &clFrameR) = 0;
 
+   /*!
+   ** \param[in]  ptsFrameListV  Pointer to array of frames
+   ** \param[in]  ulFrameCntV    Number of frames
+   ** \param[out] ulFrameCntR    Number of frames written
+   ** \return     Status code defined by InterfaceError_e
+   ** \see        readBatch()
+   **
+   ** The function writes up to \a ulFrameCntV CAN frames of the array
+   ** \a ptsFrameListV in the given order to the CAN interface, the
+   ** number of frames accepted by the CAN interface is returned in
+   ** \a ulFrameCntR. If not all frames are written, the function returns
+   ** the status of the first frame that was not accepted, e.g.
+   ** eERROR_FIFO_TRM_FULL. The default implementation calls write()
+   ** for each frame.
+   */
+   virtual InterfaceError_e   writeBatch(const QCanRawFrame_ts * ptsFrameListV,
+                                         uint32_t ulFrameCntV,
+                                         uint32_t & ulFrameCntR)
+   {
+      InterfaceError_e  teErrorT = eERROR_NONE;
+      QCanFrame         clFrameT;
+
+      ulFrameCntR = 0;
+      while(ulFrameCntR < ulFrameCntV)
+      {
+         if(clFrameT.fromRawFrame(ptsFrameListV[ulFrameCntR]) == false)
+         {
+            teErrorT = eERROR_UNKNOWN;
+            break;
+         }
+         teErrorT = write(clFrameT);
+         if(teErrorT != eERROR_NONE)
+         {
+            break;
+         }
+         ulFrameCntR++;
+      }
+      return (teErrorT);
+   };
+
 
 
 Q_SIGNALS:
@@ -0,0 +1,172 @@
+//============================================================================//
+// File:          qcan_interface_reader.cpp                                   //
+// Description:   QCAN classes - CAN interface reader thread                  //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <QMetaObject>
+
+#include "qcan_interface.hpp"
+#include "qcan_interface_reader.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanInterfaceReader()                                                      //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanInterfaceReader::QCanInterfaceReader(QCanInterface * pclInterfaceV,
+                                         QObject * pclReceiverV,
+                                         const QElapsedTimer & clClockV,
+                                         uint32_t ulPollTimeV)
+{
+   pclInterfaceP = pclInterfaceV;
+   pclReceiverP  = pclReceiverV;
+   clClockP      = clClockV;
+   ulPollTimeP   = ulPollTimeV;
+   slNotifyP.store(0);
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanInterfaceReader()                                                     //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanInterfaceReader::~QCanInterfaceReader()
+{
+   stop();
+}
+
+
+//----------------------------------------------------------------------------//
+// run()                                                                      //
+// read the CAN interface until the thread is interrupted                     //
+//----------------------------------------------------------------------------//
+void QCanInterfaceReader::run()
+{
+   int32_t                          slSizeT;
+   int64_t                          sqTimeT;
+   uint32_t                         ulBatchT;
+   uint32_t                         ulReadT;
+   uint32_t                         ulRawIdxT;
+   QCanInterface::InterfaceError_e  teErrorT;
+   QCanInterface::InterfaceError_e  teWaitT;
+   QCanRawFrame_ts                  atsRawT[QCAN_INTERFACE_BATCH_MAX];
+   uint8_t                          aubBufferT[QCAN_FRAME_ARRAY_SIZE];
+   QCanData                         clDataT(QCanData::eTYPE_CAN);
+
+   while(isInterruptionRequested() == false)
+   {
+      //--------------------------------------------------------
+      // wait for the dispatcher if the ring is full, the
+      // frames stay inside the CAN interface meanwhile
+      //
+      if(clRingP.isFull() == true)
+      {
+         QThread::usleep(ulPollTimeP);
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // read not more frames than free slots in the ring
+      //
+      ulBatchT = clRingP.capacity() - clRingP.count();
+      if(ulBatchT > QCAN_INTERFACE_BATCH_MAX)
+      {
+         ulBatchT = QCAN_INTERFACE_BATCH_MAX;
+      }
+
+      ulReadT  = 0;
+      teErrorT = pclInterfaceP->readBatch(atsRawT, ulBatchT, ulReadT);
+      if(teErrorT != QCanInterface::eERROR_NONE)
+      {
+         //------------------------------------------------
+         // block on the receive event of the CAN interface,
+         // the FIFO is polled if there is no such event
+         //
+         teWaitT = QCanInterface::eERROR_MODE;
+         if(teErrorT == QCanInterface::eERROR_FIFO_RCV_EMPTY)
+         {
+            teWaitT = pclInterfaceP->waitForFrames(QCAN_IF_READER_WAIT_TIME);
+         }
+
+         if((teWaitT != QCanInterface::eERROR_NONE) &&
+            (teWaitT != QCanInterface::eERROR_FIFO_RCV_EMPTY))
+         {
+            QThread::usleep(ulPollTimeP);
+         }
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // all frames of one batch share the time stamp
+      //
+      sqTimeT = clClockP.nsecsElapsed();
+      for(ulRawIdxT = 0; ulRawIdxT < ulReadT; ulRawIdxT++)
+      {
+         if(clDataT.fromRawFrame(atsRawT[ulRawIdxT]) == true)
+         {
+            slSizeT = clDataT.toCompactBuffer(aubBufferT);
+            clRingP.push(aubBufferT, slSizeT, sqTimeT);
+         }
+      }
+
+      //--------------------------------------------------------
+      // notify the dispatcher only once until it has
+      // acknowledged the notification
+      //
+      if(slNotifyP.testAndSetOrdered(0, 1) == true)
+      {
+         QMetaObject::invokeMethod(pclReceiverP, "onInterfaceReceive",
+                                   Qt::QueuedConnection,
+                                   Q_ARG(uint32_t, clRingP.count()));
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// stop()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanInterfaceReader::stop(void)
+{
+   if(isRunning() == true)
+   {
+      requestInterruption();
+      wait();
+   }
+}
@@ -0,0 +1,137 @@
+//============================================================================//
+// File:          qcan_interface_reader.hpp                                   //
+// Description:   QCAN classes - CAN interface reader thread                  //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_INTERFACE_READER_HPP_
+#define QCAN_INTERFACE_READER_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QThread>
+
+#include "qcan_frame_ring.hpp"
+
+
+//-------------------------------------------------------------------
+// Maximum time in milliseconds the reader blocks on the receive
+// event of the CAN interface, it limits the delay of stop()
+//
+#define  QCAN_IF_READER_WAIT_TIME   50
+
+
+/*----------------------------------------------------------------------------*\
+** Referenced classes                                                         **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+class QCanInterface;
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanInterfaceReader
+** \brief   Thread reading a CAN interface
+** 
+** The QCanInterfaceReader class reads the frames of a CAN interface
+** inside its own thread and passes them to the dispatcher of a network
+** by a lock-free QCanFrameRing. Each frame is stamped with the time
+** of reception. When the first frame is added to the ring after the
+** dispatcher has called acknowledge(), the slot
+** <tt>onInterfaceReceive(uint32_t)</tt> of the receiver object is
+** invoked by a queued connection.
+** <p>
+** When the ring is full the reader waits for the dispatcher, frames
+** remain inside the CAN interface in that case. The frames are read
+** by QCanInterface::readBatch(), up to the number of free slots. The
+** CAN interface must allow calls of QCanInterface::readBatch() and
+** QCanInterface::writeBatch() from different threads.
+** <p>
+** When the receive FIFO is empty the reader blocks inside
+** QCanInterface::waitForFrames() on the receive event of the driver,
+** so a frame is time-stamped and passed as soon as it arrives. A CAN
+** interface without receive event is polled every \a ulPollTimeV
+** microseconds instead.
+*/
+class QCanInterfaceReader : public QThread
+{
+public:
+
+   /*!
+   ** \param[in]  pclInterfaceV  Pointer to CAN interface
+   ** \param[in]  pclReceiverV   Object notified about new frames
+   ** \param[in]  clClockV       Clock used for the time stamps
+   ** \param[in]  ulPollTimeV    Poll time in microseconds
+   **
+   ** Create a reader for the CAN interface \a pclInterfaceV. The thread
+   ** is started by QThread::start() and stopped by stop().
+   */
+   QCanInterfaceReader(QCanInterface * pclInterfaceV,
+                       QObject * pclReceiverV,
+                       const QElapsedTimer & clClockV,
+                       uint32_t ulPollTimeV = 250);
+
+   ~QCanInterfaceReader();
+
+   /*!
+   ** Consumer: acknowledge the last notification. This function must
+   ** be called before the ring is read, a frame added afterwards
+   ** triggers a new notification.
+   */
+   void              acknowledge(void)    { slNotifyP.storeRelease(0);  };
+
+   /*!
+   ** \return     Reference to the frame ring
+   */
+   QCanFrameRing &   ring(void)           { return (clRingP);           };
+
+   /*!
+   ** Request the end of the thread and wait until it has finished.
+   */
+   void              stop(void);
+
+protected:
+
+   void              run() Q_DECL_OVERRIDE;
+
+private:
+
+   QCanInterface *   pclInterfaceP;
+   QObject *         pclReceiverP;
+   QElapsedTimer     clClockP;
+   uint32_t          ulPollTimeP;
+   QCanFrameRing     clRingP;
+   QAtomicInt        slNotifyP;
+};
+
+
+#endif   // QCAN_INTERFACE_READER_HPP_
@@ -0,0 +1,412 @@
+//============================================================================//
+// File:          qcan_metric_server.cpp                                      //
+// Description:   QCAN classes - Metrics export                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <QDebug>
+#include <QTcpSocket>
+
+#include "qcan_metric_server.hpp"
+#include "qcan_server.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// maximum size of a HTTP request, a larger request is refused
+//
+#define  QCAN_METRIC_REQUEST_MAX    4096
+
+//-------------------------------------------------------------------
+// Each entry of the metric table defines one sample per network.
+// Entries of the same metric family must follow each other, the
+// HELP and TYPE lines are written for the first entry only.
+//
+typedef struct QCanMetricDef_s {
+   const char *            szFamily;
+   const char *            szSuffix;
+   const char *            szType;
+   const char *            szHelp;
+   const char *            szLabel;
+   QCanNetwork::Metric_e   teMetric;
+   bool                    btSeconds;
+} QCanMetricDef_ts;
+
+
+/*----------------------------------------------------------------------------*\
+** Static variables                                                           **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+static const QCanMetricDef_ts atsMetricDefS[] = {
+
+   { "canpie_frames_total", "", "counter",
+     "Total number of frames handled by the network",
+     "type=\"api\"",   QCanNetwork::eMETRIC_FRAME_API,    false },
+   { "canpie_frames_total", "", "counter", "",
+     "type=\"can\"",   QCanNetwork::eMETRIC_FRAME_CAN,    false },
+   { "canpie_frames_total", "", "counter", "",
+     "type=\"error\"", QCanNetwork::eMETRIC_FRAME_ERR,    false },
+
+   { "canpie_frames_dropped_total", "", "counter",
+     "Total number of frames dropped by the send queues of the clients",
+     "",               QCanNetwork::eMETRIC_FRAME_DROP,   false },
+
+   { "canpie_socket_writes_total", "", "counter",
+     "Total number of socket write operations",
+     "",               QCanNetwork::eMETRIC_SOCKET_WRITE, false },
+
+   { "canpie_socket_frames_total", "", "counter",
+     "Total number of frames written to sockets",
+     "",               QCanNetwork::eMETRIC_SOCKET_FRAME, false },
+
+   { "canpie_bus_load_percent", "", "gauge",
+     "Bus load in percent",
+     "",               QCanNetwork::eMETRIC_BUS_LOAD,     false },
+
+   { "canpie_clients", "", "gauge",
+     "Number of connected clients",
+     "",               QCanNetwork::eMETRIC_CLIENT_COUNT, false },
+
+   { "canpie_queue_frames", "", "gauge",
+     "Number of frames in the send queues of all clients",
+     "",               QCanNetwork::eMETRIC_QUEUE_COUNT,  false },
+
+   { "canpie_queue_frames_high", "", "gauge",
+     "Maximum number of frames in the send queue of a client",
+     "",               QCanNetwork::eMETRIC_QUEUE_HIGH,   false },
+
+   { "canpie_dispatch_cycle_seconds", "_sum", "summary",
+     "Duration of the dispatcher cycles",
+     "",               QCanNetwork::eMETRIC_CYCLE_TIME,   true  },
+   { "canpie_dispatch_cycle_seconds", "_count", "summary", "",
+     "",               QCanNetwork::eMETRIC_CYCLE_COUNT,  false },
+
+   { "canpie_dispatch_cycle_seconds_max", "", "gauge",
+     "Maximum duration of a dispatcher cycle",
+     "",               QCanNetwork::eMETRIC_CYCLE_TIME_MAX, true },
+
+   { "canpie_latency_seconds", "_sum", "summary",
+     "Latency of frames inside the server",
+     "direction=\"interface_to_socket\"",
+                       QCanNetwork::eMETRIC_IF_LATENCY_TIME,     true  },
+   { "canpie_latency_seconds", "_count", "summary", "",
+     "direction=\"interface_to_socket\"",
+                       QCanNetwork::eMETRIC_IF_LATENCY_COUNT,    false },
+   { "canpie_latency_seconds", "_sum", "summary", "",
+     "direction=\"socket_to_interface\"",
+                       QCanNetwork::eMETRIC_SOCKET_LATENCY_TIME,  true  },
+   { "canpie_latency_seconds", "_count", "summary", "",
+     "direction=\"socket_to_interface\"",
+                       QCanNetwork::eMETRIC_SOCKET_LATENCY_COUNT, false },
+
+   { "canpie_dispatch_deferred_total", "", "counter",
+     "Total number of clients with frames left for the next dispatcher cycle",
+     "class=\"realtime\"", QCanNetwork::eMETRIC_DEFER_REALTIME, false },
+   { "canpie_dispatch_deferred_total", "", "counter", "",
+     "class=\"normal\"",   QCanNetwork::eMETRIC_DEFER_NORMAL,   false },
+   { "canpie_dispatch_deferred_total", "", "counter", "",
+     "class=\"bulk\"",     QCanNetwork::eMETRIC_DEFER_BULK,     false },
+
+   { "canpie_transmit_queue_frames", "", "gauge",
+     "Number of frames in the transmit queue of the CAN interface",
+     "",               QCanNetwork::eMETRIC_TRM_QUEUE,    false },
+
+   { "canpie_transmit_retries_total", "", "counter",
+     "Total number of writes rejected by a full transmit FIFO",
+     "",               QCanNetwork::eMETRIC_TRM_RETRY,    false },
+
+   { "canpie_transmit_dropped_total", "", "counter",
+     "Total number of frames dropped by the transmit queue",
+     "",               QCanNetwork::eMETRIC_TRM_DROP,     false },
+
+   { "canpie_transmit_confirmed_total", "", "counter",
+     "Total number of frames confirmed by the CAN interface",
+     "",               QCanNetwork::eMETRIC_TRM_CONFIRM,  false }
+};
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanMetricServer()                                                         //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanMetricServer::QCanMetricServer(QCanServer * pclCanServerV,
+                                   QObject * pclParentV)
+   : QObject(pclParentV)
+{
+   pclCanServerP = pclCanServerV;
+
+   pclTcpSrvP = new QTcpServer(this);
+   connect( pclTcpSrvP, SIGNAL(newConnection()),
+            this, SLOT(onSocketConnect()));
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanMetricServer()                                                        //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanMetricServer::~QCanMetricServer()
+{
+   close();
+}
+
+
+//----------------------------------------------------------------------------//
+// close()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanMetricServer::close(void)
+{
+   if(pclTcpSrvP.isNull() == false)
+   {
+      pclTcpSrvP->close();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// isListening()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanMetricServer::isListening(void) const
+{
+   if(pclTcpSrvP.isNull())
+   {
+      return (false);
+   }
+   return (pclTcpSrvP->isListening());
+}
+
+
+//----------------------------------------------------------------------------//
+// listen()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanMetricServer::listen(uint16_t uwPortV, QHostAddress clHostAddressV)
+{
+   close();
+
+   if(pclTcpSrvP->listen(clHostAddressV, uwPortV) == false)
+   {
+      qWarning() << "QCanMetricServer::listen() failed on port" << uwPortV
+                 << pclTcpSrvP->errorString();
+      return (false);
+   }
+   return (true);
+}
+
+
+//----------------------------------------------------------------------------//
+// metrics()                                                                  //
+// create the metric values in Prometheus text format                         //
+//----------------------------------------------------------------------------//
+QByteArray QCanMetricServer::metrics(void) const
+{
+   uint32_t                   ulDefIdxT;
+   uint8_t                    ubNetIdxT;
+   uint64_t                   uqValueT;
+   const QCanMetricDef_ts *   ptsDefT;
+   const char *               szFamilyT = "";
+   QCanNetwork *              pclNetworkT;
+   QByteArray                 clTextT;
+
+   clTextT.reserve(8192);
+
+   for(ulDefIdxT = 0; 
+       ulDefIdxT < (sizeof(atsMetricDefS) / sizeof(QCanMetricDef_ts)); 
+       ulDefIdxT++)
+   {
+      ptsDefT = &atsMetricDefS[ulDefIdxT];
+
+      //--------------------------------------------------------
+      // description of a new metric family
+      //
+      if(qstrcmp(ptsDefT->szFamily, szFamilyT) != 0)
+      {
+         szFamilyT = ptsDefT->szFamily;
+         clTextT.append("# HELP ");
+         clTextT.append(szFamilyT);
+         clTextT.append(' ');
+         clTextT.append(ptsDefT->szHelp);
+         clTextT.append("\n# TYPE ");
+         clTextT.append(szFamilyT);
+         clTextT.append(' ');
+         clTextT.append(ptsDefT->szType);
+         clTextT.append('\n');
+      }
+
+      //--------------------------------------------------------
+      // one sample for each network, the label of the network
+      // is equal to the network name "CAN 1" ... 
+      //
+      for(ubNetIdxT = 0; ubNetIdxT < pclCanServerP->maximumNetwork(); ubNetIdxT++)
+      {
+         pclNetworkT = pclCanServerP->network(ubNetIdxT);
+         uqValueT    = pclNetworkT->metric(ptsDefT->teMetric);
+
+         clTextT.append(szFamilyT);
+         clTextT.append(ptsDefT->szSuffix);
+         clTextT.append("{network=\"");
+         clTextT.append(QByteArray::number(ubNetIdxT + 1));
+         clTextT.append('"');
+         if(ptsDefT->szLabel[0] != '\0')
+         {
+            clTextT.append(',');
+            clTextT.append(ptsDefT->szLabel);
+         }
+         clTextT.append("} ");
+
+         //-----------------------------------------------
+         // time values are measured in nanoseconds
+         //
+         if(ptsDefT->btSeconds == true)
+         {
+            clTextT.append(QByteArray::number((double) uqValueT / 1.0e9, 
+                                              'g', 12));
+         }
+         else
+         {
+            clTextT.append(QByteArray::number((qulonglong) uqValueT));
+         }
+         clTextT.append('\n');
+      }
+   }
+
+   return (clTextT);
+}
+
+
+//----------------------------------------------------------------------------//
+// onSocketConnect()                                                          //
+// a HTTP client connects to the server                                       //
+//----------------------------------------------------------------------------//
+void QCanMetricServer::onSocketConnect(void)
+{
+   QTcpSocket *   pclSocketT;
+
+   while(pclTcpSrvP->hasPendingConnections())
+   {
+      pclSocketT = pclTcpSrvP->nextPendingConnection();
+      connect( pclSocketT, SIGNAL(readyRead()),
+               this, SLOT(onSocketReceive()));
+      connect( pclSocketT, SIGNAL(disconnected()),
+               pclSocketT, SLOT(deleteLater()));
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onSocketReceive()                                                          //
+// answer a HTTP request                                                      //
+//----------------------------------------------------------------------------//
+void QCanMetricServer::onSocketReceive(void)
+{
+   QTcpSocket *   pclSocketT;
+   QByteArray     clRequestT;
+   QByteArray     clBodyT;
+   QByteArray     clStatusT;
+   QList<QByteArray> clLineT;
+
+   pclSocketT = qobject_cast<QTcpSocket *>(QObject::sender());
+   if(pclSocketT == Q_NULLPTR)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // wait for the complete request header, the request body
+   // is not used
+   //
+   clRequestT = pclSocketT->peek(QCAN_METRIC_REQUEST_MAX);
+   if(clRequestT.contains("\r\n\r\n") == false)
+   {
+      if(clRequestT.size() >= QCAN_METRIC_REQUEST_MAX)
+      {
+         pclSocketT->abort();
+      }
+      return;
+   }
+   pclSocketT->readAll();
+
+   //----------------------------------------------------------------
+   // evaluate the request line, e.g. "GET /metrics HTTP/1.1"
+   //
+   clLineT = clRequestT.left(clRequestT.indexOf("\r\n")).split(' ');
+   if((clLineT.size() < 2) || (clLineT.at(0) != "GET"))
+   {
+      clStatusT = "405 Method Not Allowed";
+   }
+   else if((clLineT.at(1) == "/metrics") || (clLineT.at(1) == "/"))
+   {
+      clStatusT = "200 OK";
+      clBodyT   = metrics();
+   }
+   else
+   {
+      clStatusT = "404 Not Found";
+   }
+
+   //----------------------------------------------------------------
+   // one response per connection
+   //
+   pclSocketT->write("HTTP/1.0 " + clStatusT + "\r\n"
+                     "Content-Type: text/plain; version=0.0.4\r\n"
+                     "Content-Length: " + 
+                     QByteArray::number(clBodyT.size()) + "\r\n"
+                     "Connection: close\r\n\r\n");
+   pclSocketT->write(clBodyT);
+   pclSocketT->disconnectFromHost();
+}
+
+
+//----------------------------------------------------------------------------//
+// port()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint16_t QCanMetricServer::port(void) const
+{
+   if(isListening() == false)
+   {
+      return (0);
+   }
+   return (pclTcpSrvP->serverPort());
+}
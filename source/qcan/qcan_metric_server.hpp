@@ -0,0 +1,135 @@
+//============================================================================//
+// File:          qcan_metric_server.hpp                                      //
+// Description:   QCAN classes - Metrics export                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_METRIC_SERVER_HPP_
+#define QCAN_METRIC_SERVER_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+#include <QHostAddress>
+#include <QObject>
+#include <QPointer>
+#include <QTcpServer>
+
+
+/*----------------------------------------------------------------------------*\
+** Referenced classes                                                         **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+class QCanServer;
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class QCanMetricServer
+** \brief Metrics export of a CAN server
+**
+** This class exports the metric values of all networks of a QCanServer
+** in the Prometheus text format. The values are served by a minimal
+** HTTP server, which is bound to the loopback interface by default.
+** A scrape reads the metric values by QCanNetwork::metric(), hence the
+** dispatcher of a network is never locked by the export.
+** <p>
+** Example for a scrape with the default port:
+** \code
+** curl http://127.0.0.1:55680/metrics
+** \endcode
+*/
+class QCanMetricServer : public QObject
+{
+   Q_OBJECT
+
+public:
+
+   /*!
+   ** \param[in]  pclCanServerV  Pointer to CAN server
+   ** \param[in]  pclParentV     Pointer to QObject parent class
+   **
+   ** Create a metrics export for the CAN server \a pclCanServerV,
+   ** call listen() to start the export.
+   */
+   QCanMetricServer(QCanServer * pclCanServerV,
+                    QObject * pclParentV = Q_NULLPTR);
+
+   ~QCanMetricServer();
+
+   /*!
+   ** \see        listen()
+   **
+   ** Stop the metrics export.
+   */
+   void        close(void);
+
+   /*!
+   ** \return     \c true if the metrics are exported
+   */
+   bool        isListening(void) const;
+
+   /*!
+   ** \param[in]  uwPortV        Port number
+   ** \param[in]  clHostAddressV Host address
+   ** \return     \c true if the server is listening
+   ** \see        close()
+   **
+   ** Start the metrics export on port \a uwPortV. The default host
+   ** address only allows access from the local machine.
+   */
+   bool        listen(uint16_t uwPortV, 
+                      QHostAddress clHostAddressV = 
+                                    QHostAddress(QHostAddress::LocalHost));
+
+   /*!
+   ** \return     Metric values in Prometheus text format
+   **
+   ** This function returns the current metric values of all networks,
+   ** it is called for each scrape.
+   */
+   QByteArray  metrics(void) const;
+
+   /*!
+   ** \return     Port number of the export
+   */
+   uint16_t    port(void) const;
+
+private slots:
+
+   void  onSocketConnect(void);
+   void  onSocketReceive(void);
+
+private:
+
+   QCanServer *            pclCanServerP;
+   QPointer<QTcpServer>    pclTcpSrvP;
+};
+
+#endif   // QCAN_METRIC_SERVER_HPP_
@@ -33,10 +33,23 @@
 \*----------------------------------------------------------------------------*/
 
 #include <QDebug>
+#include <QThread>
+
+#if defined(Q_OS_LINUX)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#endif
 
 #include "qcan_defs.hpp"
 #include "qcan_interface.hpp"
+#include "qcan_interface_reader.hpp"
 #include "qcan_network.hpp"
+#include "qcan_pipe.hpp"
+#include "qcan_shared_ring.hpp"
 
 
 /*----------------------------------------------------------------------------*\
@@ -50,6 +63,28 @@
 //
 #define  QCAN_SOCKET_CAN_IF      22345
 
+//-------------------------------------------------------------------
+// Default size of the send queue for each client (number of CAN
+// frames)
+//
+#define  QCAN_NETWORK_QUEUE_SIZE 2048
+
+//-------------------------------------------------------------------
+// Default number of frames read during one dispatcher cycle and
+// default number of frames read from a client of each priority
+// class during one round
+//
+#define  QCAN_NETWORK_FRAME_BUDGET     4096
+#define  QCAN_NETWORK_WEIGHT_REALTIME    64
+#define  QCAN_NETWORK_WEIGHT_NORMAL      16
+#define  QCAN_NETWORK_WEIGHT_BULK         4
+
+//-------------------------------------------------------------------
+// Default number of transmit credits of a client, this allows
+// about 25000 frames per second at the default dispatcher time
+//
+#define  QCAN_NETWORK_TRM_CREDIT       512
+
 
 /*----------------------------------------------------------------------------*\
 ** Static variables                                                           **
@@ -75,6 +110,19 @@ QCanNetwork::QCanNetwork(QObject * pclParentV,
    //
    this->setParent(pclParentV);
 
+   //----------------------------------------------------------------
+   // the network might run in a worker thread, types used for
+   // queued signals and methods must be known to the meta system
+   //
+   qRegisterMetaType<int32_t>("int32_t");
+   qRegisterMetaType<uint8_t>("uint8_t");
+   qRegisterMetaType<uint32_t>("uint32_t");
+   qRegisterMetaType<QCanNetwork::DispatchMode_e>("QCanNetwork::DispatchMode_e");
+   qRegisterMetaType<QCanNetwork::QueuePolicy_e>("QCanNetwork::QueuePolicy_e");
+   qRegisterMetaType<QCanFrameApi::Priority_e>("QCanFrameApi::Priority_e");
+   qRegisterMetaType<QCanPipe *>("QCanPipe *");
+   qRegisterMetaType<QCanInterface *>("QCanInterface *");
+
    //----------------------------------------------------------------
    // each network has a unique network number, starting with 1
    //
@@ -88,27 +136,53 @@ QCanNetwork::QCanNetwork(QObject * pclParentV,
    clNetNameP = "CAN " + QString("%1").arg(ubNetIdP);
 
    //----------------------------------------------------------------
-   // create initial socket list
+   // create and publish initial client list
+   //
+   pclClientListP = new QVector<QCanClient_ts *>;
+   pclClientListP->reserve(QCAN_TCP_SOCKET_MAX);
+   apclClientListP.store(pclClientListP);
+   slListReaderP.store(0);
+
+   //----------------------------------------------------------------
+   // the CAN interface is read inside the thread of the network
+   // by default
    //
-   pclTcpSockListP = new QVector<QTcpSocket *>;
-   pclTcpSockListP->reserve(QCAN_TCP_SOCKET_MAX);
+   pclIfReaderP       = Q_NULLPTR;
+   btIfThreadEnabledP = false;
 
    //----------------------------------------------------------------
    // setup a new local server which is listening to the
    // default network name
    //
-   pclTcpSrvP = new QTcpServer();
+   pclTcpSrvP = new QTcpServer(this);
 
    clTcpHostAddrP = QHostAddress(QHostAddress::Any);
    uwTcpPortP = uwPortV;
 
+   //----------------------------------------------------------------
+   // local clients can connect by the local server, the name is
+   // unique as long as the TCP port is unique
+   //
+   pclLocalSrvP = new QLocalServer(this);
+   clLocalNameP = QString(QCAN_LOCAL_SOCKET_NAME) + QString::number(uwPortV);
+
+   pclSharedRingP       = Q_NULLPTR;
+   btSharedRingEnabledP = false;
+
    //----------------------------------------------------------------
    // clear statistic
    //
-   ulCntFrameApiP = 0;
-   ulCntFrameCanP = 0;
-   ulCntFrameErrP = 0;
-   ulCntBitCurP   = 0;
+   for(int32_t slMetricT = 0; slMetricT < eMETRIC_MAX; slMetricT++)
+   {
+      aqMetricP[slMetricT].store(0);
+   }
+
+   //----------------------------------------------------------------
+   // start the monotonic clock for the dispatcher histograms
+   //
+   clClockP.start();
+   clIfTimeListP.reserve(QCAN_NETWORK_QUEUE_SIZE);
+   sqIfRecvTimeP = 0;
 
    //----------------------------------------------------------------
    // setup timing values
@@ -116,7 +190,51 @@ QCanNetwork::QCanNetwork(QObject * pclParentV,
    ulDispatchTimeP  = 20;
    ulStatisticTimeP = 1000;
    ulStatisticTickP = ulStatisticTimeP / ulDispatchTimeP;
+   teDispatchModeP  = eDISPATCH_TIMER;
+   slCpuAffinityP   = -1;
+
+   //----------------------------------------------------------------
+   // setup send queue, the default size allows to buffer about
+   // 100 ms of a saturated CAN FD network
+   //
+   teQueuePolicyP   = eQUEUE_DROP_OLDEST;
+   ulQueueSizeP     = QCAN_NETWORK_QUEUE_SIZE;
+
+   //----------------------------------------------------------------
+   // setup frame budget, real-time clients get the largest share
+   // of each round
+   //
+   ulFrameBudgetP = QCAN_NETWORK_FRAME_BUDGET;
+   aulPriorityWeightP[QCanFrameApi::ePRIORITY_REALTIME] = QCAN_NETWORK_WEIGHT_REALTIME;
+   aulPriorityWeightP[QCanFrameApi::ePRIORITY_NORMAL]   = QCAN_NETWORK_WEIGHT_NORMAL;
+   aulPriorityWeightP[QCanFrameApi::ePRIORITY_BULK]     = QCAN_NETWORK_WEIGHT_BULK;
+   slRoundStartP  = 0;
 
+   //----------------------------------------------------------------
+   // setup transmit queue, its size is limited by the credits of
+   // the clients
+   //
+   ulTrmCountP    = 0;
+   uqTrmSequenceP = 0;
+   ulTrmCreditP   = QCAN_NETWORK_TRM_CREDIT;
+   btTrmConfirmP        = false;
+   btTrmConfirmEnabledP = false;
+
+   //----------------------------------------------------------------
+   // the dispatcher timer is a child of the network, so it
+   // is stopped together with the network
+   //
+   pclDispatchTmrP = new QTimer(this);
+   connect( pclDispatchTmrP, SIGNAL(timeout()),
+            this, SLOT(onTimerEvent()));
+
+   //----------------------------------------------------------------
+   // default network settings
+   //
+   btErrorFramesEnabledP = false;
+   btFastDataEnabledP    = false;
+   btListenOnlyEnabledP  = false;
+   btNetworkEnabledP     = false;
 
    //----------------------------------------------------------------
    // setup default bit-rate
@@ -131,6 +249,17 @@ QCanNetwork::QCanNetwork(QObject * pclParentV,
 //----------------------------------------------------------------------------//
 QCanNetwork::~QCanNetwork()
 {
+   //----------------------------------------------------------------
+   // stop reading the CAN interface, frames left inside the ring
+   // are discarded
+   //
+   delete (pclIfReaderP);
+
+   //----------------------------------------------------------------
+   // readers of the shared memory ring detect the closed ring
+   //
+   delete (pclSharedRingP);
+
    //----------------------------------------------------------------
    // close TCP server
    //
@@ -140,6 +269,21 @@ QCanNetwork::~QCanNetwork()
    }
    delete(pclTcpSrvP);
 
+   if(pclLocalSrvP->isListening())
+   {
+      pclLocalSrvP->close();
+   }
+   delete(pclLocalSrvP);
+
+   //----------------------------------------------------------------
+   // release client list, including all retired lists
+   //
+   qDeleteAll(*pclClientListP);
+   delete(pclClientListP);
+   qDeleteAll(clRetiredClientP);
+   qDeleteAll(clRetiredListP);
+   qDeleteAll(clTrmQueueListP);
+
    ubNetIdP--;
 }
 
@@ -152,6 +296,18 @@ bool QCanNetwork::addInterface(QCanInterface * pclCanIfV)
 {
    bool  btResultT = false;
 
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "addInterface",
+                                Qt::BlockingQueuedConnection,
+                                Q_RETURN_ARG(bool, btResultT),
+                                Q_ARG(QCanInterface *, pclCanIfV));
+      return (btResultT);
+   }
+
    if(pclInterfaceP.isNull())
    {
       //--------------------------------------------------------
@@ -166,6 +322,34 @@ bool QCanNetwork::addInterface(QCanInterface * pclCanIfV)
             {
                pclInterfaceP = pclCanIfV;
                btResultT = true;
+
+               //----------------------------------------
+               // the CAN interface might signal new
+               // frames, this is used in event mode
+               //
+               connect( pclCanIfV, SIGNAL(framesReceived(uint32_t)),
+                        this, SLOT(onInterfaceReceive(uint32_t)));
+
+               //----------------------------------------
+               // transmit confirmations are read like
+               // received frames
+               //
+               if((btTrmConfirmEnabledP == true) && 
+                  (hasTransmitConfirmSupport() == true))
+               {
+                  if(pclCanIfV->setTransmitConfirm(true) == 
+                     QCanInterface::eERROR_NONE)
+                  {
+                     btTrmConfirmP = true;
+                     connect( pclCanIfV, SIGNAL(framesWritten(uint32_t)),
+                              this, SLOT(onInterfaceReceive(uint32_t)));
+                  }
+               }
+
+               if(btIfThreadEnabledP == true)
+               {
+                  startInterfaceReader();
+               }
             }
          }
       }
@@ -273,199 +457,169 @@ bool QCanNetwork::hasListenOnlySupport(void)
 
 
 //----------------------------------------------------------------------------//
-// frameType()                                                                //
-//                                                                            //
+// hasTransmitConfirmSupport()                                                //
+// Check if the CAN interface confirms the transmission of frames             //
 //----------------------------------------------------------------------------//
-QCanData::Type_e  QCanNetwork::frameType(const QByteArray & clSockDataR)
+bool QCanNetwork::hasTransmitConfirmSupport(void)
 {
-   QCanData::Type_e  ubTypeT;
-   
-   //----------------------------------------------------------------
-   // The frame type can be tested via the first byte of the array,
-   // please refer to the implmentation of QCanData for details.
-   //
-   switch(clSockDataR.at(0) & 0xE0)
+   bool btResultT = false;
+
+   if(pclInterfaceP.isNull() == false)
    {
-      case 0x00:
-         ubTypeT = QCanData::eTYPE_CAN;
-         break;
-      
-      case 0x40:
-         ubTypeT = QCanData::eTYPE_API;
-         break;
-      
-      case 0x80:
-         ubTypeT = QCanData::eTYPE_ERROR;
-         break;
-         
-      default:
-         ubTypeT = QCanData::eTYPE_UNKNOWN;
-         break;
+      if(pclInterfaceP->supportedFeatures() & QCAN_IF_SUPPORT_TRM_CONFIRM)
+      {
+         btResultT = true;
+      }
    }
 
-   return (ubTypeT);
+   return(btResultT);
 }
 
 
 //----------------------------------------------------------------------------//
-// handleApiFrame()                                                           //
+// clientCount()                                                              //
 //                                                                            //
 //----------------------------------------------------------------------------//
-bool  QCanNetwork::handleApiFrame(int32_t & slSockSrcR,
-                                  QByteArray & clSockDataR)
+int32_t QCanNetwork::clientCount(void)
 {
-   bool           btResultT = false;
-   QCanFrameApi   clApiFrameT;
-   
-   clApiFrameT.fromByteArray(clSockDataR);
-   
-   if(slSockSrcR != QCAN_SOCKET_CAN_IF)
-   {
-      switch(clApiFrameT.function())
-      {
-         case QCanFrameApi::eAPI_FUNC_NONE:
-
-            break;
-
-         case QCanFrameApi::eAPI_FUNC_BITRATE:
-            qDebug() << "Got bitrate setting" << clApiFrameT.bitrateNominal();
-            this->setBitrate( clApiFrameT.bitrateNominal(), 
-                              clApiFrameT.bitrateData());
-            if(!pclInterfaceP.isNull())
-            {
-               //pclInterfaceP->setBitrate( clApiFrameT.bitrate(),
-               //                           clApiFrameT.brsClock());
-            }
-            btResultT = true;
-            break;
-
-         case QCanFrameApi::eAPI_FUNC_CAN_MODE:
-
-            break;
-
-         case QCanFrameApi::eAPI_FUNC_DRIVER_INIT:
-
-            break;
-
-         case QCanFrameApi::eAPI_FUNC_DRIVER_RELEASE:
-
-            break;
-
+   int32_t  slCountT;
 
-         default:
-
-            break;
-      }
+   //----------------------------------------------------------------
+   // the reader count keeps the published list alive, refer to
+   // reclaimClients()
+   //
+   slListReaderP.ref();
+   slCountT = apclClientListP.loadAcquire()->size();
+   slListReaderP.deref();
 
-      ulCntFrameApiP++;
-      
-   }
-   return(btResultT);
+   return (slCountT);
 }
 
 
 //----------------------------------------------------------------------------//
-// handleCanFrame()                                                           //
-// push QCan frame to all open sockets                                        //
+// clientStatistic()                                                          //
+//                                                                            //
 //----------------------------------------------------------------------------//
-bool  QCanNetwork::handleCanFrame(int32_t & slSockSrcR,
-                                  QByteArray & clSockDataR)
+bool QCanNetwork::clientStatistic(int32_t slClientIdxV,
+                                  QCanClientStatistic_ts & tsStatisticR)
 {
-   int32_t        slSockIdxT;
-   bool           btResultT = false;
-   QTcpSocket *   pclSockS;
+   bool                       btResultT = false;
+   QCanClient_ts *            ptsClientT;
+   QVector<QCanClient_ts *> * pclListT;
 
-
-   //----------------------------------------------------------------
-   // check all open sockets and write CAN frame
-   //
-   for(slSockIdxT = 0; slSockIdxT < pclTcpSockListP->size(); slSockIdxT++)
+   slListReaderP.ref();
+   pclListT = apclClientListP.loadAcquire();
+   if((slClientIdxV >= 0) && (slClientIdxV < pclListT->size()))
    {
-      if(slSockIdxT != slSockSrcR)
-      {
-         pclSockS = pclTcpSockListP->at(slSockIdxT);
-         pclSockS->write(clSockDataR);
-         pclSockS->flush();
-         btResultT = true;
-      }
+      ptsClientT = pclListT->at(slClientIdxV);
+      tsStatisticR.ulQueueCount = ptsClientT->ulQueueCnt.load();
+      tsStatisticR.ulQueueHigh  = ptsClientT->ulQueueHigh.load();
+      tsStatisticR.ulDropCount  = ptsClientT->ulDropCnt.load();
+      tsStatisticR.ulDeferCount = ptsClientT->ulDeferCnt.load();
+      tsStatisticR.tePriority   = ptsClientT->tePriority;
+      btResultT = true;
    }
+   slListReaderP.deref();
 
-
-   //----------------------------------------------------------------
-   // count frame if source is a CAN interface or if the message
-   // could be dispatched
-   //
-   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
-   {
-      ulCntFrameCanP++;
-   }
-   return(btResultT);
+   return (btResultT);
 }
 
 
 //----------------------------------------------------------------------------//
-// handleErrorFrame()                                                         //
+// histogram()                                                                //
 //                                                                            //
 //----------------------------------------------------------------------------//
-bool  QCanNetwork::handleErrFrame(int32_t & slSockSrcR,
-                                  QByteArray & clSockDataR)
+bool QCanNetwork::histogram(Histogram_e teHistogramV, 
+                            QCanHistogram & clHistogramR)
 {
-   int32_t        slSockIdxT;
-   bool           btResultT = false;
-   QTcpSocket *   pclSockS;
-
-   //----------------------------------------------------------------
-   // check all open sockets and write CAN frame
-   //
-   for(slSockIdxT = 0; slSockIdxT < pclTcpSockListP->size(); slSockIdxT++)
+   if((teHistogramV < eHISTOGRAM_IF_TO_SOCKET) || 
+      (teHistogramV >= eHISTOGRAM_MAX))
    {
-      if(slSockIdxT != slSockSrcR)
-      {
-         pclSockS = pclTcpSockListP->at(slSockIdxT);
-         pclSockS->write(clSockDataR);
-         pclSockS->flush();
-         btResultT = true;
-      }
+      return (false);
    }
 
-
    //----------------------------------------------------------------
-   // count frame if source is a CAN interface or if the message
-   // could be dispatched
+   // the histograms are written by the dispatcher, take the copy
+   // inside the thread of the network
    //
-   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   if(isNetworkThread() == false)
    {
-      ulCntFrameErrP++;
+      QMetaObject::invokeMethod(this, "copyHistogram",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(int32_t, (int32_t) teHistogramV),
+                                Q_ARG(void *, (void *) &clHistogramR));
    }
-   return(btResultT);
+   else
+   {
+      copyHistogram((int32_t) teHistogramV, (void *) &clHistogramR);
+   }
+
+   return (true);
 }
 
 
-QHostAddress QCanNetwork::serverAddress(void)
+//----------------------------------------------------------------------------//
+// isNetworkThread()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::isNetworkThread(void)
 {
-   return (pclTcpSrvP->serverAddress());
+   return (QThread::currentThread() == this->thread());
 }
 
 
 //----------------------------------------------------------------------------//
-// onSocketConnect()                                                          //
-// slot that manages a new local server connection                            //
+// addClient()                                                                //
+// add a new socket connection to the client list                             //
 //----------------------------------------------------------------------------//
-void QCanNetwork::onSocketConnect(void)
+void QCanNetwork::addClient(QIODevice * pclSocketV)
 {
-   QTcpSocket *   pclSocketT;
-   QCanFrameApi   clFrameApiT;
+   QIODevice *                pclSocketT = pclSocketV;
+   QCanClient_ts *            ptsClientT;
+   QVector<QCanClient_ts *> * pclListT;
+   QCanFrameApi               clFrameApiT;
    
    //----------------------------------------------------------------
-   // Get next pending connect and add this socket to the
-   // the socket list
+   // add the socket to the client list, all further operations
+   // use the common QIODevice, an in-process pipe is neither a
+   // TCP socket nor a local socket
+   //
+   ptsClientT = new QCanClient_ts;
+   ptsClientT->pclSocket      = pclSocketT;
+   ptsClientT->pclTcpSock     = qobject_cast<QTcpSocket *>(pclSocketT);
+   ptsClientT->pclLocalSock   = qobject_cast<QLocalSocket *>(pclSocketT);
+   ptsClientT->ulSendHead     = 0;
+   ptsClientT->ulSendFrameCnt = 0;
+   ptsClientT->ulQueueCnt     = 0;
+   ptsClientT->ulQueueHigh    = 0;
+   ptsClientT->ulDropCnt      = 0;
+   ptsClientT->btOverflow     = false;
+   ptsClientT->btCompact      = false;
+   ptsClientT->btChecksum     = true;
+   ptsClientT->btPending      = false;
+   ptsClientT->tePriority     = QCanFrameApi::ePRIORITY_NORMAL;
+   ptsClientT->ulDeferCnt     = 0;
+   ptsClientT->ulTrmCredit    = ulTrmCreditP;
+   ptsClientT->ulTrmPending   = 0;
+   ptsClientT->ulTrmReturn    = 0;
+   ptsClientT->btTrmConfirm   = false;
+   ptsClientT->sqRecvTime     = 0;
+   ptsClientT->clSendBuf.reserve(QCAN_FRAME_ARRAY_SIZE * 64);
+
+   //----------------------------------------------------------------
+   // publish a copy of the list that contains the new client, the
+   // previous list is retired
    //
-   pclSocketT =  pclTcpSrvP->nextPendingConnection();
-   clTcpSockMutexP.lock();
-   pclTcpSockListP->append(pclSocketT);
-   clTcpSockMutexP.unlock();
+   pclListT = new QVector<QCanClient_ts *>(*pclClientListP);
+   pclListT->append(ptsClientT);
+   clRetiredListP.append(pclClientListP);
+   pclClientListP = pclListT;
+   apclClientListP.fetchAndStoreOrdered(pclClientListP);
+   reclaimClients();
+
+   metricSet(eMETRIC_CLIENT_COUNT, (uint64_t) pclClientListP->size());
 
-   qDebug() << "QCanNetwork::onSocketConnect()" << pclTcpSockListP->size() << "open sockets";
+   qDebug() << "QCanNetwork::addClient()" << pclClientListP->size() << "open sockets";
    qDebug() << "Socket" << pclSocketT;
 
    //----------------------------------------------------------------
@@ -476,6 +630,15 @@ void QCanNetwork::onSocketConnect(void)
             SIGNAL(disconnected()),
             this,
             SLOT(onSocketDisconnect())   );
+
+   //----------------------------------------------------------------
+   // Add a slot that handles the reception of CAN frames, this is
+   // used in event mode
+   //
+   connect( pclSocketT,
+            SIGNAL(readyRead()),
+            this,
+            SLOT(onSocketReceive())   );
    
    //----------------------------------------------------------------
    // 
@@ -483,208 +646,1924 @@ void QCanNetwork::onSocketConnect(void)
    pclSocketT->write(clFrameApiT.toByteArray());
    clFrameApiT.setBitrate(slNomBitRateP, slDatBitRateP);
    pclSocketT->write(clFrameApiT.toByteArray());
+   clFrameApiT.setCredit(ptsClientT->ulTrmCredit);
+   pclSocketT->write(clFrameApiT.toByteArray());
 }
 
 
 //----------------------------------------------------------------------------//
-// onSocketDisconnect()                                                       //
-// remove local socket from list                                              //
+// addCycle()                                                                 //
+// add the values of a dispatcher cycle to the histograms                     //
 //----------------------------------------------------------------------------//
-void QCanNetwork::onSocketDisconnect(void)
+void QCanNetwork::addCycle(int64_t sqStartV, uint32_t ulFrameCntV)
+{
+   uint64_t uqCycleTimeT;
+
+   uqCycleTimeT = (uint64_t) (clClockP.nsecsElapsed() - sqStartV);
+   aclHistogramP[eHISTOGRAM_CYCLE_TIME].add(uqCycleTimeT);
+   aclHistogramP[eHISTOGRAM_CYCLE_FRAMES].add(ulFrameCntV);
+
+   metricAdd(eMETRIC_CYCLE_COUNT, 1);
+   metricAdd(eMETRIC_CYCLE_TIME, uqCycleTimeT);
+   if(uqCycleTimeT > metric(eMETRIC_CYCLE_TIME_MAX))
+   {
+      metricSet(eMETRIC_CYCLE_TIME_MAX, uqCycleTimeT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// addLatency()                                                               //
+// add a frame latency to the histogram and the metric values                 //
+//----------------------------------------------------------------------------//
+void QCanNetwork::addLatency(Histogram_e teHistogramV, int64_t sqLatencyV)
+{
+   aclHistogramP[teHistogramV].add((uint64_t) sqLatencyV);
+
+   if(teHistogramV == eHISTOGRAM_IF_TO_SOCKET)
+   {
+      metricAdd(eMETRIC_IF_LATENCY_COUNT, 1);
+      metricAdd(eMETRIC_IF_LATENCY_TIME, (uint64_t) sqLatencyV);
+   }
+   else
+   {
+      metricAdd(eMETRIC_SOCKET_LATENCY_COUNT, 1);
+      metricAdd(eMETRIC_SOCKET_LATENCY_TIME, (uint64_t) sqLatencyV);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// copyHistogram()                                                            //
+// copy a histogram inside the thread of the network                          //
+//----------------------------------------------------------------------------//
+void QCanNetwork::copyHistogram(int32_t slHistIdxV, void * pvdHistogramV)
 {
-   int32_t      slSockIdxT;
-   QTcpSocket * pclSockT;
-   QTcpSocket * pclSenderT;
+   *((QCanHistogram *) pvdHistogramV) = aclHistogramP[slHistIdxV];
+}
 
 
+//----------------------------------------------------------------------------//
+// connectPipe()                                                              //
+// add an in-process client to the client list                                //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::connectPipe(QCanPipe * pclPipeV)
+{
+   bool        btResultT = false;
+   QCanPipe *  pclPeerT;
+
    //----------------------------------------------------------------
-   // get sender of signal
+   // execute inside the thread of the network, the second end
+   // of the pipe must live in this thread
    //
-   pclSenderT = (QTcpSocket* ) QObject::sender();
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "connectPipe",
+                                Qt::BlockingQueuedConnection,
+                                Q_RETURN_ARG(bool, btResultT),
+                                Q_ARG(QCanPipe *, pclPipeV));
+      return (btResultT);
+   }
 
-   clTcpSockMutexP.lock();
-   for(slSockIdxT = 0; slSockIdxT < pclTcpSockListP->size(); slSockIdxT++)
+   if(btNetworkEnabledP == true)
    {
-      pclSockT = pclTcpSockListP->at(slSockIdxT);
-      if(pclSockT == pclSenderT)
+      pclPeerT = new QCanPipe(this);
+      if(pclPeerT->connectPeer(pclPipeV) == true)
       {
-         pclTcpSockListP->remove(slSockIdxT);
-         break;
+         addClient(pclPeerT);
+         btResultT = true;
+      }
+      else
+      {
+         delete (pclPeerT);
       }
    }
-   clTcpSockMutexP.unlock();
-
-   qDebug() << "QCanNetwork::onSocketDisconnect()" << pclTcpSockListP->size() << "open sockets";
 
+   return (btResultT);
 }
 
 
 //----------------------------------------------------------------------------//
-// onTimerEvent()                                                             //
-// remove local socket from list                                              //
+// dispatchInterface()                                                        //
+// read up to ulFrameMaxV messages from the active CAN interface              //
 //----------------------------------------------------------------------------//
-void QCanNetwork::onTimerEvent(void)
+uint32_t QCanNetwork::dispatchInterface(uint32_t ulFrameMaxV)
 {
-   int32_t        slSockIdxT;
-   int32_t        slListSizeT;
-   uint32_t       ulFrameCntT;
-   uint32_t       ulFrameMaxT;
-   uint32_t       ulMsgPerSecT;
-   uint32_t       ulMsgBitCntT;
-   QTcpSocket *   pclSockT;
-   QCanFrame      clCanFrameT;
-   QByteArray     clSockDataT;
-
+   int32_t           slSockIdxT;
+   int32_t           slSizeT;
+   int64_t           sqRecvTimeT;
+   uint32_t          ulFrameCntT = 0;
+   uint32_t          ulBatchT;
+   uint32_t          ulReadT;
+   uint32_t          ulRawIdxT;
+   QCanRawFrame_ts   atsRawT[QCAN_INTERFACE_BATCH_MAX];
+   uint8_t           aubBufferT[QCAN_FRAME_ARRAY_SIZE];
+   QCanData          clDataT(QCanData::eTYPE_CAN);
+   QCanFrameView     clFrameViewT;
+   QByteArray        clSockDataT;
 
    //----------------------------------------------------------------
-   // lock socket list
+   // the frames have already been read by the interface thread
    //
-   clTcpSockMutexP.lock();
+   if(pclIfReaderP != Q_NULLPTR)
+   {
+      return (dispatchInterfaceRing(ulFrameMaxV));
+   }
 
-   //----------------------------------------------------------------
-   // read messages from active CAN interface
+   if(pclInterfaceP.isNull() == false)
+   {
+      //--------------------------------------------------------
+      // the latency starts when the interface has signalled
+      // new frames, otherwise when the frames are read
+      //
+      sqRecvTimeT = sqIfRecvTimeP;
+      if(sqRecvTimeT == 0)
+      {
+         sqRecvTimeT = clClockP.nsecsElapsed();
+      }
+      sqIfRecvTimeP = 0;
+
+      slSockIdxT = QCAN_SOCKET_CAN_IF;
+      do
+      {
+         //-----------------------------------------------------
+         // one call of readBatch() passes a burst of frames,
+         // the batch is limited by the remaining frame budget
+         //
+         ulBatchT = QCAN_INTERFACE_BATCH_MAX;
+         if((ulFrameMaxV > 0) && ((ulFrameMaxV - ulFrameCntT) < ulBatchT))
+         {
+            ulBatchT = ulFrameMaxV - ulFrameCntT;
+         }
+
+         ulReadT = 0;
+         if(pclInterfaceP->readBatch(atsRawT, ulBatchT, ulReadT) !=
+                                             QCanInterface::eERROR_NONE)
+         {
+            break;
+         }
+         ulFrameCntT += ulReadT;
+
+         for(ulRawIdxT = 0; ulRawIdxT < ulReadT; ulRawIdxT++)
+         {
+            //---------------------------------------------
+            // the frame is converted into compact format
+            // on the stack, the view decodes it from there
+            //
+            if(clDataT.fromRawFrame(atsRawT[ulRawIdxT]) == false)
+            {
+               continue;
+            }
+            slSizeT = clDataT.toCompactBuffer(aubBufferT);
+            clFrameViewT.setBuffer(aubBufferT, slSizeT);
+
+            switch(clFrameViewT.frameType())
+            {
+               //-------------------------------------------
+               // handle API frames
+               //
+               case QCanData::eTYPE_API:
+                  clSockDataT = clFrameViewT.rawData();
+                  handleApiFrame(slSockIdxT, clSockDataT);
+                  break;
+
+               //-------------------------------------------
+               // write CAN frame to other sockets
+               //
+               case QCanData::eTYPE_CAN:
+                  if(clFrameViewT.isTransmitConfirm() == true)
+                  {
+                     handleTrmConfirm(clFrameViewT);
+                  }
+                  else
+                  {
+                     clIfTimeListP.append(sqRecvTimeT);
+                     handleCanFrame(slSockIdxT, clFrameViewT);
+                  }
+                  break;
+
+               //-------------------------------------------
+               // handle error frames
+               //
+               case QCanData::eTYPE_ERROR:
+                  clSockDataT = clFrameViewT.rawData();
+                  handleErrFrame(slSockIdxT, clSockDataT);
+                  break;
+
+               //-------------------------------------------
+               // nothing we can handle
+               //
+               default:
+
+                  break;
+            }
+         }
+
+         //-----------------------------------------------------
+         // the remaining frames are read during the next
+         // round, they keep the latency start time; without
+         // a frame budget the time is taken again each cycle
+         //
+         if((ulFrameMaxV > 0) && (ulFrameCntT == ulFrameMaxV))
+         {
+            sqIfRecvTimeP = sqRecvTimeT;
+            break;
+         }
+      }
+      while(ulReadT == ulBatchT);
+   }
+
+   return (ulFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// dispatchInterfaceRing()                                                    //
+// handle up to ulFrameMaxV messages passed by the interface thread           //
+//----------------------------------------------------------------------------//
+uint32_t QCanNetwork::dispatchInterfaceRing(uint32_t ulFrameMaxV)
+{
+   int32_t                                      slSockIdxT;
+   uint32_t                                     ulFrameCntT = 0;
+   const QCanFrameRing::QCanFrameRingSlot_ts *  ptsSlotT;
+   QCanFrameView                                clFrameViewT;
+   QByteArray                                   clSockDataT;
+
+   //----------------------------------------------------------------
+   // acknowledge the notification before the ring is read, a frame
+   // added afterwards triggers onInterfaceReceive() again
+   //
+   pclIfReaderP->acknowledge();
+   sqIfRecvTimeP = 0;
+
+   slSockIdxT = QCAN_SOCKET_CAN_IF;
+   while(pclIfReaderP->ring().front(ptsSlotT) == true)
+   {
+      //--------------------------------------------------------
+      // the view decodes the frame inside the slot, it is
+      // released after the frame has been handled
+      //
+      clFrameViewT.setBuffer(ptsSlotT->aubData, ptsSlotT->slSize);
+      if(clFrameViewT.isValid() == true)
+      {
+         switch(clFrameViewT.frameType())
+         {
+            case QCanData::eTYPE_API:
+               clSockDataT = clFrameViewT.rawData();
+               handleApiFrame(slSockIdxT, clSockDataT);
+               break;
+
+            //---------------------------------------------
+            // the latency starts with the time stamp of
+            // the interface thread
+            //
+            case QCanData::eTYPE_CAN:
+               if(clFrameViewT.isTransmitConfirm() == true)
+               {
+                  handleTrmConfirm(clFrameViewT);
+               }
+               else
+               {
+                  clIfTimeListP.append(ptsSlotT->sqTime);
+                  handleCanFrame(slSockIdxT, clFrameViewT);
+               }
+               break;
+
+            case QCanData::eTYPE_ERROR:
+               clSockDataT = clFrameViewT.rawData();
+               handleErrFrame(slSockIdxT, clSockDataT);
+               break;
+
+            default:
+
+               break;
+         }
+      }
+      pclIfReaderP->ring().pop();
+
+      //--------------------------------------------------------
+      // the remaining frames are kept inside the ring
+      //
+      ulFrameCntT++;
+      if(ulFrameCntT == ulFrameMaxV)
+      {
+         break;
+      }
+   }
+
+   return (ulFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// dispatchScheduled()                                                        //
+// read the sockets and the CAN interface by weighted round-robin             //
+//----------------------------------------------------------------------------//
+void QCanNetwork::dispatchScheduled(void)
+{
+   int32_t           slClassT;
+   int32_t           slListSizeT;
+   int32_t           slRoundIdxT;
+   int32_t           slSockIdxT;
+   uint32_t          ulBudgetT;
+   uint32_t          ulQuantumT;
+   uint32_t          ulFrameCntT;
+   bool              btIfPendingT;
+   bool              btPendingT;
+   QCanClient_ts *   ptsClientT;
+
+   //----------------------------------------------------------------
+   // a budget of 0 denotes no limit, every client is read at least
+   // once per cycle
+   //
+   ulBudgetT = ulFrameBudgetP;
+   if(ulBudgetT == 0)
+   {
+      ulBudgetT = 0xFFFFFFFF;
+   }
+
+   slListSizeT = pclClientListP->size();
+   for(slSockIdxT = 0; slSockIdxT < slListSizeT; slSockIdxT++)
+   {
+      pclClientListP->at(slSockIdxT)->btPending = true;
+   }
+   btIfPendingT = true;
+
+   //----------------------------------------------------------------
+   // each round serves the priority classes in ascending order,
+   // the CAN interface first; a source that returns less frames
+   // than its quantum has been read completely, the rounds end
+   // when all sources are read or the budget is exhausted
+   //
+   btPendingT = true;
+   while((btPendingT == true) && (ulBudgetT > 0))
+   {
+      btPendingT = false;
+      for(slClassT = 0; slClassT < QCanFrameApi::ePRIORITY_MAX; slClassT++)
+      {
+         //--------------------------------------------------------
+         // the CAN interface belongs to the real-time class
+         //
+         if((slClassT == QCanFrameApi::ePRIORITY_REALTIME) && 
+            (btIfPendingT == true) && (ulBudgetT > 0))
+         {
+            ulQuantumT  = qMin(aulPriorityWeightP[slClassT], ulBudgetT);
+            ulFrameCntT = dispatchInterface(ulQuantumT);
+            ulBudgetT  -= ulFrameCntT;
+            btIfPendingT = (ulFrameCntT == ulQuantumT);
+            btPendingT  |= btIfPendingT;
+         }
+
+         //--------------------------------------------------------
+         // the first client is rotated with each cycle, so
+         // clients of the same class share the budget
+         //
+         for(slRoundIdxT = 0; slRoundIdxT < slListSizeT; slRoundIdxT++)
+         {
+            slSockIdxT = (slRoundStartP + slRoundIdxT) % slListSizeT;
+            ptsClientT = pclClientListP->at(slSockIdxT);
+            if((ptsClientT->tePriority != slClassT)  || 
+               (ptsClientT->btPending == false)      || 
+               (ulBudgetT == 0))
+            {
+               continue;
+            }
+
+            ulQuantumT  = qMin(aulPriorityWeightP[slClassT], ulBudgetT);
+            ulFrameCntT = dispatchSocket(slSockIdxT, ulQuantumT);
+            ulBudgetT  -= ulFrameCntT;
+            ptsClientT->btPending = (ulFrameCntT == ulQuantumT);
+            btPendingT |= ptsClientT->btPending;
+         }
+      }
+   }
+
+   if(slListSizeT > 0)
+   {
+      slRoundStartP = (slRoundStartP + 1) % slListSizeT;
+   }
+
+   //----------------------------------------------------------------
+   // count the sources which still have frames to read, they are
+   // served first during the next cycle by their priority class
+   //
+   if(btIfPendingT == true)
+   {
+      metricAdd(eMETRIC_DEFER_REALTIME, 1);
+   }
+
+   for(slSockIdxT = 0; slSockIdxT < slListSizeT; slSockIdxT++)
+   {
+      ptsClientT = pclClientListP->at(slSockIdxT);
+      if((ptsClientT->btPending == true) && 
+         ((ptsClientT->clRecvBuf.size() > 0) || 
+          (ptsClientT->pclSocket->bytesAvailable() > 0)))
+      {
+         ptsClientT->ulDeferCnt.store(ptsClientT->ulDeferCnt.load() + 1);
+         metricAdd((Metric_e) (eMETRIC_DEFER_REALTIME + ptsClientT->tePriority),
+                   1);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// dispatchSocket()                                                           //
+// read up to ulFrameMaxV messages from the socket with index slSockIdxV      //
+//----------------------------------------------------------------------------//
+uint32_t QCanNetwork::dispatchSocket(int32_t slSockIdxV, uint32_t ulFrameMaxV)
+{
+   int32_t           slPosT;
+   int64_t           sqReadMaxT;
+   int64_t           sqRecvTimeT;
+   uint32_t          ulFrameCntT = 0;
+   QCanClient_ts *   ptsClientT;
+   QCanFrame         clCanFrameT;
+   QCanFrameView     clFrameViewT;
+   QByteArray        clSockDataT;
+   QCanTrmFrame_ts   tsTrmFrameT;
+   QCanTrmQueue_ts * ptsTrmQueueT = Q_NULLPTR;
+
+   //----------------------------------------------------------------
+   // the client may send CAN frames in fixed or in compact format,
+   // append the received data to the receive buffer and take the
+   // complete frames from it; with a limit only the data for
+   // ulFrameMaxV frames is read, the remaining data is kept by
+   // the socket
+   //
+   ptsClientT = pclClientListP->at(slSockIdxV);
+   if(ulFrameMaxV == 0)
+   {
+      ptsClientT->clRecvBuf.append(ptsClientT->pclSocket->readAll());
+   }
+   else
+   {
+      sqReadMaxT = ((int64_t) ulFrameMaxV * QCAN_FRAME_ARRAY_SIZE) - 
+                   ptsClientT->clRecvBuf.size();
+      if(sqReadMaxT > 0)
+      {
+         ptsClientT->clRecvBuf.append(ptsClientT->pclSocket->read(sqReadMaxT));
+      }
+   }
+
+   //----------------------------------------------------------------
+   // the receive time is set by onSocketReceive(), a value of 0
+   // denotes that it is not known
+   //
+   sqRecvTimeT = ptsClientT->sqRecvTime;
+   ptsClientT->sqRecvTime = 0;
+
+   slPosT = 0;
+   while((slPosT < ptsClientT->clRecvBuf.size()) && 
+         ((ulFrameMaxV == 0) || (ulFrameCntT < ulFrameMaxV)))
+   {
+      //--------------------------------------------------------
+      // the view decodes the frame inside the receive buffer,
+      // an invalid view denotes an incomplete frame
+      //
+      clFrameViewT.setBuffer((const uint8_t *) ptsClientT->clRecvBuf.constData()
+                             + slPosT, ptsClientT->clRecvBuf.size() - slPosT);
+      if(clFrameViewT.isValid() == false)
+      {
+         break;
+      }
+      slPosT += clFrameViewT.size();
+      ulFrameCntT++;
+
+      switch(clFrameViewT.frameType())
+      {
+         //-----------------------------------------------------
+         // handle API frames
+         //
+         case QCanData::eTYPE_API:
+            clSockDataT = clFrameViewT.rawData();
+            handleApiFrame(slSockIdxV, clSockDataT);
+            break;
+
+         //-----------------------------------------------------
+         // handle CAN frames
+         //
+         case QCanData::eTYPE_CAN:
+            //---------------------------------------------
+            // without CAN interface the frame is written
+            // to the other sockets immediately, unless the
+            // client requests a transmit confirmation
+            //
+            if((pclInterfaceP.isNull() == true) && (ulTrmCountP == 0) &&
+               (ptsClientT->btTrmConfirm == false))
+            {
+               handleCanFrame(slSockIdxV, clFrameViewT);
+               ptsClientT->ulTrmReturn++;
+            }
+
+            //---------------------------------------------
+            // the transmit queue of the client passes the
+            // frame to the CAN interface, a client exceeding
+            // its credits loses the frame, the data is
+            // copied since the receive buffer is reused
+            //
+            else if((ptsClientT->ulTrmPending < ptsClientT->ulTrmCredit) &&
+                    (clFrameViewT.toFrame(clCanFrameT, 
+                                          ptsClientT->btChecksum) == true))
+            {
+               if(ptsTrmQueueT == Q_NULLPTR)
+               {
+                  ptsTrmQueueT = transmitQueue(ptsClientT);
+               }
+               tsTrmFrameT.clFrame    = clCanFrameT;
+               tsTrmFrameT.clData     = QByteArray((const char *) 
+                                                   clFrameViewT.constData(),
+                                                   clFrameViewT.size());
+               tsTrmFrameT.btChecksum = ptsClientT->btChecksum;
+               tsTrmFrameT.ulArbField = clCanFrameT.arbitrationField();
+               tsTrmFrameT.uqSequence = uqTrmSequenceP++;
+               tsTrmFrameT.sqRecvTime = sqRecvTimeT;
+               ptsTrmQueueT->clFrameList.append(tsTrmFrameT);
+               ptsClientT->ulTrmPending++;
+               ulTrmCountP++;
+            }
+            else
+            {
+               metricAdd(eMETRIC_TRM_DROP, 1);
+               ptsClientT->ulTrmReturn++;
+            }
+            break;
+               
+         //--------------------------------------------------
+         // handle error frames
+         //
+         case QCanData::eTYPE_ERROR:
+            clSockDataT = clFrameViewT.rawData();
+            handleErrFrame(slSockIdxV, clSockDataT);
+            break;         
+            
+         default:
+            
+            break;
+      }
+   }
+
+   //----------------------------------------------------------------
+   // keep an incomplete frame and the frames exceeding the limit
+   // for the next call
+   //
+   ptsClientT->clRecvBuf.remove(0, slPosT);
+
+   //----------------------------------------------------------------
+   // the frames exceeding the limit keep the receive time
+   //
+   if((ulFrameMaxV > 0) && (ulFrameCntT == ulFrameMaxV))
+   {
+      ptsClientT->sqRecvTime = sqRecvTimeT;
+   }
+
+   return (ulFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// dispatchTransmit()                                                         //
+// write the frames of the transmit queues to the CAN interface               //
+//----------------------------------------------------------------------------//
+void QCanNetwork::dispatchTransmit(void)
+{
+   bool                             btRetryT;
+   int32_t                          slQueueIdxT;
+   uint32_t                         ulSelectCntT;
+   uint32_t                         ulWriteCntT;
+   uint32_t                         ulFrameIdxT;
+   QCanInterface::InterfaceError_e  teErrorT;
+   QCanTrmQueue_ts *                ptsQueueT;
+   QCanTrmFrame_ts *                ptsHeadT;
+   QCanTrmFrame_ts *                ptsTrmFrameT;
+   QCanTrmConfirm_ts                tsConfirmT;
+   QCanTrmQueue_ts *                aptsQueueT[QCAN_INTERFACE_BATCH_MAX];
+   QCanRawFrame_ts                  atsRawT[QCAN_INTERFACE_BATCH_MAX];
+
+   while(ulTrmCountP > 0)
+   {
+      //--------------------------------------------------------
+      // select up to QCAN_INTERFACE_BATCH_MAX frames: the head
+      // of each queue takes part in the arbitration, the frame
+      // received first wins on equal values; the head of the
+      // selected queue is advanced for the next round
+      //
+      for(ulSelectCntT = 0; (ulSelectCntT < QCAN_INTERFACE_BATCH_MAX) &&
+                            (ulSelectCntT < ulTrmCountP); ulSelectCntT++)
+      {
+         ptsTrmFrameT = Q_NULLPTR;
+         for(slQueueIdxT = 0; slQueueIdxT < clTrmQueueListP.size();
+             slQueueIdxT++)
+         {
+            ptsQueueT = clTrmQueueListP.at(slQueueIdxT);
+            if(ptsQueueT->slHead < ptsQueueT->clFrameList.size())
+            {
+               ptsHeadT = &ptsQueueT->clFrameList[ptsQueueT->slHead];
+               if((ptsTrmFrameT == Q_NULLPTR)                       ||
+                  (ptsHeadT->ulArbField < ptsTrmFrameT->ulArbField) ||
+                  ((ptsHeadT->ulArbField == ptsTrmFrameT->ulArbField) &&
+                   (ptsHeadT->uqSequence <  ptsTrmFrameT->uqSequence)))
+               {
+                  ptsTrmFrameT = ptsHeadT;
+                  aptsQueueT[ulSelectCntT] = ptsQueueT;
+               }
+            }
+         }
+         aptsQueueT[ulSelectCntT]->slHead++;
+
+         if(pclInterfaceP.isNull() == false)
+         {
+            ptsTrmFrameT->clFrame.toRawFrame(atsRawT[ulSelectCntT]);
+         }
+      }
+
+      //--------------------------------------------------------
+      // the selected frames are written by one call, the heads
+      // of the queues are set back afterwards; a removed CAN
+      // interface passes the frames to the sockets only
+      //
+      if(pclInterfaceP.isNull() == false)
+      {
+         ulWriteCntT = 0;
+         teErrorT = pclInterfaceP->writeBatch(atsRawT, ulSelectCntT,
+                                              ulWriteCntT);
+      }
+      else
+      {
+         ulWriteCntT = ulSelectCntT;
+         teErrorT    = QCanInterface::eERROR_NONE;
+      }
+
+      for(ulFrameIdxT = 0; ulFrameIdxT < ulSelectCntT; ulFrameIdxT++)
+      {
+         aptsQueueT[ulFrameIdxT]->slHead--;
+      }
+
+      //--------------------------------------------------------
+      // a CAN interface confirming the transmission keeps the
+      // frame in flight, otherwise the frame is on the bus now;
+      // the client of the queue is cleared when it has
+      // disconnected
+      //
+      for(ulFrameIdxT = 0; ulFrameIdxT < ulWriteCntT; ulFrameIdxT++)
+      {
+         ptsQueueT    = aptsQueueT[ulFrameIdxT];
+         ptsTrmFrameT = &ptsQueueT->clFrameList[ptsQueueT->slHead];
+         if((pclInterfaceP.isNull() == false) && (btTrmConfirmP == true))
+         {
+            tsConfirmT.ptsClient = ptsQueueT->ptsClient;
+            tsConfirmT.tsFrame   = *ptsTrmFrameT;
+            clTrmConfirmListP.append(tsConfirmT);
+         }
+         else
+         {
+            finishTransmit(ptsQueueT->ptsClient, *ptsTrmFrameT, false);
+         }
+         ptsQueueT->slHead++;
+         ulTrmCountP--;
+      }
+
+      //--------------------------------------------------------
+      // the frames that are not accepted because of a full FIFO
+      // are written again during the next call, they may lose
+      // the arbitration against a frame received meanwhile;
+      // other errors drop the first frame not written
+      //
+      btRetryT = false;
+      if(ulWriteCntT < ulSelectCntT)
+      {
+         if((teErrorT == QCanInterface::eERROR_NONE) ||
+            (teErrorT == QCanInterface::eERROR_FIFO_TRM_FULL))
+         {
+            metricAdd(eMETRIC_TRM_RETRY, 1);
+            btRetryT = true;
+         }
+         else
+         {
+            ptsQueueT = aptsQueueT[ulWriteCntT];
+            returnCredit(ptsQueueT->ptsClient);
+            metricAdd(eMETRIC_TRM_DROP, 1);
+            ptsQueueT->slHead++;
+            ulTrmCountP--;
+         }
+      }
+
+      //--------------------------------------------------------
+      // resize() keeps the allocated memory of an empty queue,
+      // the queue of a disconnected client is released; if the
+      // queue does not run empty, the frames already written are
+      // removed as soon as they reach the transmit credit
+      //
+      for(slQueueIdxT = clTrmQueueListP.size() - 1; slQueueIdxT >= 0;
+          slQueueIdxT--)
+      {
+         ptsQueueT = clTrmQueueListP.at(slQueueIdxT);
+         if(ptsQueueT->slHead == ptsQueueT->clFrameList.size())
+         {
+            ptsQueueT->clFrameList.resize(0);
+            ptsQueueT->slHead = 0;
+            if(ptsQueueT->ptsClient == Q_NULLPTR)
+            {
+               clTrmQueueListP.remove(slQueueIdxT);
+               delete (ptsQueueT);
+            }
+         }
+         else if((uint32_t) ptsQueueT->slHead >= ulTrmCreditP)
+         {
+            ptsQueueT->clFrameList.remove(0, ptsQueueT->slHead);
+            ptsQueueT->slHead = 0;
+         }
+      }
+
+      if(btRetryT == true)
+      {
+         break;
+      }
+   }
+
+   metricSet(eMETRIC_TRM_QUEUE, (uint64_t) ulTrmCountP);
+}
+
+
+//----------------------------------------------------------------------------//
+// finishTransmit()                                                           //
+// forward a transmitted frame to the other clients                           //
+//----------------------------------------------------------------------------//
+void QCanNetwork::finishTransmit(QCanClient_ts * ptsClientV, 
+                                 QCanTrmFrame_ts & tsTrmFrameR,
+                                 bool btConfirmV)
+{
+   int32_t     slSockSrcT;
+   int64_t     sqTrmTimeT;
+   QByteArray  clSockDataT;
+
+   slSockSrcT = returnCredit(ptsClientV);
+   sqTrmTimeT = clClockP.nsecsElapsed();
+
+   if((pclInterfaceP.isNull() == false) && (tsTrmFrameR.sqRecvTime > 0))
+   {
+      addLatency(eHISTOGRAM_SOCKET_TO_IF, 
+                 sqTrmTimeT - tsTrmFrameR.sqRecvTime);
+   }
+
+   //----------------------------------------------------------------
+   // the data of the client is used unless the checksum mode of the
+   // client has changed, the client is gone or the frame carries
+   // the time-stamp of the transmit confirmation
+   //
+   if((slSockSrcT >= 0) && (btConfirmV == false) &&
+      (ptsClientV->btChecksum == tsTrmFrameR.btChecksum))
+   {
+      handleCanFrame(slSockSrcT, QCanFrameView(tsTrmFrameR.clData));
+   }
+   else
+   {
+      clSockDataT = tsTrmFrameR.clFrame.toByteArray();
+      handleCanFrame(slSockSrcT, QCanFrameView(clSockDataT));
+   }
+
+   //----------------------------------------------------------------
+   // a client requesting transmit confirmation gets its frame back,
+   // without confirmation of the CAN interface the time-stamp is
+   // taken from the clock of the network
+   //
+   if((slSockSrcT >= 0) && (ptsClientV->btTrmConfirm == true))
+   {
+      if(btConfirmV == false)
+      {
+         tsTrmFrameR.clFrame.setTimeStamp(QCanTimeStamp(
+                                    (uint32_t) (sqTrmTimeT / 1000000000),
+                                    (uint32_t) (sqTrmTimeT % 1000000000)));
+      }
+      tsTrmFrameR.clFrame.setTransmitConfirm(true);
+
+      if(ptsClientV->btCompact == true)
+      {
+         queueFrame(ptsClientV, tsTrmFrameR.clFrame.toCompactArray());
+      }
+      else
+      {
+         queueFrame(ptsClientV, tsTrmFrameR.clFrame.toByteArray());
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// flushClients()                                                             //
+// write the collected CAN frames to all clients                              //
+//----------------------------------------------------------------------------//
+void QCanNetwork::flushClients(void)
+{
+   int32_t           slSockIdxT;
+   int32_t           slTimeIdxT;
+   int64_t           sqSendTimeT;
+   uint64_t          uqQueueSumT  = 0;
+   uint32_t          ulQueueHighT = 0;
+   QCanClient_ts *   ptsClientT;
+   QCanFrameApi      clApiFrameT;
+
+   //----------------------------------------------------------------
+   // run backwards through the list, a client might be removed,
+   // which does not change the index of the preceding clients
+   //
+   for(slSockIdxT = pclClientListP->size() - 1; slSockIdxT >= 0; slSockIdxT--)
+   {
+      ptsClientT = pclClientListP->at(slSockIdxT);
+
+      //--------------------------------------------------------
+      // disconnect a client that is not able to receive
+      // the CAN frames, the signal disconnected() is not
+      // handled for this client anymore
+      //
+      if(ptsClientT->btOverflow == true)
+      {
+         qDebug() << "QCanNetwork::flushClients() disconnect slow client";
+         QObject::disconnect(ptsClientT->pclSocket, 0, this, 0);
+         if(ptsClientT->pclLocalSock != Q_NULLPTR)
+         {
+            ptsClientT->pclLocalSock->abort();
+         }
+         else if(ptsClientT->pclTcpSock != Q_NULLPTR)
+         {
+            ptsClientT->pclTcpSock->abort();
+         }
+         else
+         {
+            ptsClientT->pclSocket->close();
+         }
+         ptsClientT->pclSocket->deleteLater();
+         removeClient(slSockIdxT);
+         continue;
+      }
+
+      //--------------------------------------------------------
+      // return the transmit credits of this cycle, the send
+      // queue limit does not apply here
+      //
+      if(ptsClientT->ulTrmReturn > 0)
+      {
+         clApiFrameT.setCredit(ptsClientT->ulTrmReturn);
+         ptsClientT->clSendBuf.append(clApiFrameT.toByteArray());
+         ptsClientT->ulTrmReturn = 0;
+      }
+
+      if(ptsClientT->clSendBuf.size() > (int) ptsClientT->ulSendHead)
+      {
+         ptsClientT->pclSocket->write(   ptsClientT->clSendBuf.constData() +
+                                         ptsClientT->ulSendHead,
+                                         ptsClientT->clSendBuf.size() -
+                                         ptsClientT->ulSendHead);
+         if(ptsClientT->pclLocalSock != Q_NULLPTR)
+         {
+            ptsClientT->pclLocalSock->flush();
+         }
+         else if(ptsClientT->pclTcpSock != Q_NULLPTR)
+         {
+            ptsClientT->pclTcpSock->flush();
+         }
+
+         metricAdd(eMETRIC_SOCKET_WRITE, 1);
+         metricAdd(eMETRIC_SOCKET_FRAME, ptsClientT->ulSendFrameCnt);
+
+         //-----------------------------------------------------
+         // resize() keeps the allocated memory of the buffer
+         //
+         ptsClientT->clSendBuf.resize(0);
+         ptsClientT->ulSendHead     = 0;
+         ptsClientT->ulSendFrameCnt = 0;
+      }
+      ptsClientT->ulQueueCnt = (uint32_t) (ptsClientT->pclSocket->bytesToWrite() /
+                                           QCAN_FRAME_ARRAY_SIZE);
+
+      uqQueueSumT += ptsClientT->ulQueueCnt;
+      if(ptsClientT->ulQueueHigh > ulQueueHighT)
+      {
+         ulQueueHighT = ptsClientT->ulQueueHigh;
+      }
+   }
+
+   metricSet(eMETRIC_CLIENT_COUNT, (uint64_t) pclClientListP->size());
+   metricSet(eMETRIC_QUEUE_COUNT, uqQueueSumT);
+   metricSet(eMETRIC_QUEUE_HIGH, ulQueueHighT);
+
+   //----------------------------------------------------------------
+   // the CAN frames of the interface have been written to all
+   // clients now
+   //
+   if(clIfTimeListP.isEmpty() == false)
+   {
+      sqSendTimeT = clClockP.nsecsElapsed();
+      for(slTimeIdxT = 0; slTimeIdxT < clIfTimeListP.size(); slTimeIdxT++)
+      {
+         addLatency(eHISTOGRAM_IF_TO_SOCKET, 
+                    sqSendTimeT - clIfTimeListP.at(slTimeIdxT));
+      }
+      clIfTimeListP.resize(0);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// queueFrame()                                                               //
+// append a CAN frame to the send queue of a client                           //
+//----------------------------------------------------------------------------//
+void QCanNetwork::queueFrame(QCanClient_ts * ptsClientV,
+                             const QByteArray & clSockDataR)
+{
+   uint64_t    uqQueueSizeT;
+   uint32_t    ulQueueCntT;
+   uint32_t    ulDropPosT;
+   int32_t     slDropSizeT;
+
+   //----------------------------------------------------------------
+   // the queue consists of the data pending inside the TCP socket
+   // and the frames collected during this dispatcher cycle, the
+   // limit is evaluated in bytes since compact frames have a 
+   // variable size
+   //
+   uqQueueSizeT  = ptsClientV->pclSocket->bytesToWrite();
+   uqQueueSizeT += ptsClientV->clSendBuf.size() - ptsClientV->ulSendHead;
+
+   if((uqQueueSizeT + clSockDataR.size()) > 
+      ((uint64_t) ulQueueSizeP * QCAN_FRAME_ARRAY_SIZE))
+   {
+      switch(teQueuePolicyP)
+      {
+         //-----------------------------------------------------
+         // drop the oldest CAN or error frame that has not been
+         // passed to the socket, API frames (credit return and
+         // mode confirmation) are never dropped: if they are at
+         // the head of the buffer the frame behind them is cut
+         // out, otherwise only the head of the buffer is moved
+         //
+         case eQUEUE_DROP_OLDEST:
+            ptsClientV->ulDropCnt++;
+            metricAdd(eMETRIC_FRAME_DROP, 1);
+            if(ptsClientV->ulSendFrameCnt == 0)
+            {
+               return;
+            }
+            ulDropPosT = ptsClientV->ulSendHead;
+            while(frameType(ptsClientV->clSendBuf, ulDropPosT) ==
+                  QCanData::eTYPE_API)
+            {
+               ulDropPosT += QCanData::arraySize(ptsClientV->clSendBuf,
+                                                 ulDropPosT);
+            }
+            slDropSizeT = QCanData::arraySize(ptsClientV->clSendBuf,
+                                              ulDropPosT);
+            if(ulDropPosT == ptsClientV->ulSendHead)
+            {
+               ptsClientV->ulSendHead += slDropSizeT;
+            }
+            else
+            {
+               ptsClientV->clSendBuf.remove(ulDropPosT, slDropSizeT);
+            }
+            ptsClientV->ulSendFrameCnt--;
+            break;
+
+         case eQUEUE_DROP_NEWEST:
+            ptsClientV->ulDropCnt++;
+            metricAdd(eMETRIC_FRAME_DROP, 1);
+            return;
+
+         //-----------------------------------------------------
+         // the client is removed by flushClients()
+         //
+         case eQUEUE_DISCONNECT:
+            ptsClientV->ulDropCnt++;
+            metricAdd(eMETRIC_FRAME_DROP, 1);
+            ptsClientV->btOverflow = true;
+            return;
+      }
+   }
+
+   ptsClientV->clSendBuf.append(clSockDataR);
+   ptsClientV->ulSendFrameCnt++;
+
+   //----------------------------------------------------------------
+   // update high watermark, the value is given in units of
+   // frames in fixed format
+   //
+   uqQueueSizeT  = ptsClientV->pclSocket->bytesToWrite();
+   uqQueueSizeT += ptsClientV->clSendBuf.size() - ptsClientV->ulSendHead;
+   ulQueueCntT   = (uint32_t) (uqQueueSizeT / QCAN_FRAME_ARRAY_SIZE);
+   ptsClientV->ulQueueCnt = ulQueueCntT;
+   if(ulQueueCntT > ptsClientV->ulQueueHigh)
+   {
+      ptsClientV->ulQueueHigh = ulQueueCntT;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// frameType()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanData::Type_e  QCanNetwork::frameType(const QByteArray & clSockDataR,
+                                         int32_t slPosV)
+{
+   QCanData::Type_e  ubTypeT;
+   
+   //----------------------------------------------------------------
+   // The frame type can be tested via the first byte of the array,
+   // please refer to the implmentation of QCanData for details.
+   //
+   switch(clSockDataR.at(slPosV) & 0xE0)
+   {
+      case 0x00:
+         ubTypeT = QCanData::eTYPE_CAN;
+         break;
+      
+      case 0x40:
+         ubTypeT = QCanData::eTYPE_API;
+         break;
+      
+      case 0x80:
+         ubTypeT = QCanData::eTYPE_ERROR;
+         break;
+         
+      default:
+         ubTypeT = QCanData::eTYPE_UNKNOWN;
+         break;
+   }
+
+   return (ubTypeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleApiFrame()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleApiFrame(int32_t & slSockSrcR,
+                                  QByteArray & clSockDataR)
+{
+   bool           btResultT = false;
+   QCanFrameApi   clApiFrameT;
+   
+   clApiFrameT.fromByteArray(clSockDataR);
+   
+   if(slSockSrcR != QCAN_SOCKET_CAN_IF)
+   {
+      switch(clApiFrameT.function())
+      {
+         case QCanFrameApi::eAPI_FUNC_NONE:
+
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_BITRATE:
+            qDebug() << "Got bitrate setting" << clApiFrameT.bitrateNominal();
+            this->setBitrate( clApiFrameT.bitrateNominal(), 
+                              clApiFrameT.bitrateData());
+            if(!pclInterfaceP.isNull())
+            {
+               //pclInterfaceP->setBitrate( clApiFrameT.bitrate(),
+               //                           clApiFrameT.brsClock());
+            }
+            btResultT = true;
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_CAN_MODE:
+
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_DRIVER_INIT:
+
+            break;
+
+         case QCanFrameApi::eAPI_FUNC_DRIVER_RELEASE:
+
+            break;
+
+         //-----------------------------------------------------
+         // acceptance filter of the sending client
+         //
+         case QCanFrameApi::eAPI_FUNC_FILTER:
+            btResultT = handleFilter(slSockSrcR, clApiFrameT);
+            break;
+
+         //-----------------------------------------------------
+         // wire format of the sending client
+         //
+         case QCanFrameApi::eAPI_FUNC_FORMAT:
+            btResultT = handleFormat(slSockSrcR, clApiFrameT);
+            break;
+
+         //-----------------------------------------------------
+         // checksum mode of the sending client
+         //
+         case QCanFrameApi::eAPI_FUNC_CHECKSUM:
+            btResultT = handleChecksum(slSockSrcR, clApiFrameT);
+            break;
+
+         //-----------------------------------------------------
+         // priority class of the sending client
+         //
+         case QCanFrameApi::eAPI_FUNC_PRIORITY:
+            btResultT = handlePriority(slSockSrcR, clApiFrameT);
+            break;
+
+         //-----------------------------------------------------
+         // transmit confirmation of the sending client
+         //
+         case QCanFrameApi::eAPI_FUNC_CONFIRM:
+            btResultT = handleConfirm(slSockSrcR, clApiFrameT);
+            break;
+
+         default:
+
+            break;
+      }
+
+      metricAdd(eMETRIC_FRAME_API, 1);
+      
+   }
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleCanFrame()                                                           //
+// push QCan frame to all open sockets                                        //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleCanFrame(int32_t & slSockSrcR,
+                                  const QCanFrameView & clFrameViewR)
+{
+   int32_t        slSockIdxT;
+   bool           btResultT = false;
+   bool           btExtendedT;
+   uint32_t       ulIdentifierT;
+   QCanClient_ts *   ptsClientT;
+   bool           btChecksumT = true;
+   uint16_t       uwChecksumT;
+   QByteArray     clFixedT;
+   QByteArray     clPlainT;
+   QByteArray     clCompactT;
+
+
+   //----------------------------------------------------------------
+   // get identifier and frame format for the acceptance filter
+   // of the clients, the payload is not touched here
+   //
+   ulIdentifierT = clFrameViewR.identifier();
+   btExtendedT   = clFrameViewR.isExtended();
+
+   //----------------------------------------------------------------
+   // a frame in fixed format from a client which has disabled the
+   // checksum does not carry a valid checksum
+   //
+   if((slSockSrcR >= 0) && (slSockSrcR < pclClientListP->size()))
+   {
+      btChecksumT = pclClientListP->at(slSockSrcR)->btChecksum;
+   }
+
+   //----------------------------------------------------------------
+   // append CAN frame to the send buffer of all other clients,
+   // the buffers are written by flushClients()
+   //
+   for(slSockIdxT = 0; slSockIdxT < pclClientListP->size(); slSockIdxT++)
+   {
+      if(slSockIdxT != slSockSrcR)
+      {
+         ptsClientT = pclClientListP->at(slSockIdxT);
+         if(ptsClientT->clFilter.match(ulIdentifierT, btExtendedT) == true)
+         {
+            //---------------------------------------------
+            // each format is created only once for all
+            // clients, the format of the source is used
+            // without copying the buffer
+            //
+            if(ptsClientT->btCompact == true)
+            {
+               if(clCompactT.isEmpty())
+               {
+                  if(clFrameViewR.isCompact())
+                  {
+                     clCompactT = clFrameViewR.rawData();
+                  }
+                  else
+                  {
+                     clCompactT = clFrameViewR.toCompactArray();
+                  }
+               }
+               queueFrame(ptsClientT, clCompactT);
+            }
+            //---------------------------------------------
+            // a client without checksum accepts any frame
+            // in fixed format, the checksum is not built
+            //
+            else if(ptsClientT->btChecksum == false)
+            {
+               if(clPlainT.isEmpty())
+               {
+                  if(clFrameViewR.isCompact())
+                  {
+                     clPlainT = clFrameViewR.toByteArray(false);
+                  }
+                  else
+                  {
+                     clPlainT = clFrameViewR.rawData();
+                  }
+               }
+               queueFrame(ptsClientT, clPlainT);
+            }
+            else
+            {
+               if(clFixedT.isEmpty())
+               {
+                  if(clFrameViewR.isCompact())
+                  {
+                     clFixedT = clFrameViewR.toByteArray(true);
+                  }
+                  else if(btChecksumT == false)
+                  {
+                     clFixedT = QByteArray((const char *) clFrameViewR.constData(),
+                                           clFrameViewR.size());
+                     uwChecksumT = QCanData::checksum(clFrameViewR.constData(),
+                                                      QCAN_FRAME_ARRAY_SIZE - 2);
+                     clFixedT[94] = (char) (uwChecksumT >> 8);
+                     clFixedT[95] = (char) (uwChecksumT >> 0);
+                  }
+                  else
+                  {
+                     clFixedT = clFrameViewR.rawData();
+                  }
+               }
+               queueFrame(ptsClientT, clFixedT);
+            }
+         }
+         btResultT = true;
+      }
+   }
+
+
+   //----------------------------------------------------------------
+   // the shared memory ring gets every frame in fixed format, the
+   // checksum is not evaluated by the readers
    //
-   if(pclInterfaceP.isNull() == false)
+   if(pclSharedRingP != Q_NULLPTR)
+   {
+      if(clFrameViewR.isCompact())
+      {
+         if(clPlainT.isEmpty())
+         {
+            clPlainT = clFrameViewR.toByteArray(false);
+         }
+         pclSharedRingP->write((const uint8_t *) clPlainT.constData(),
+                               clPlainT.size());
+      }
+      else
+      {
+         pclSharedRingP->write(clFrameViewR.constData(), clFrameViewR.size());
+      }
+   }
+
+   //----------------------------------------------------------------
+   // count frame if source is a CAN interface or if the message
+   // could be dispatched
+   //
+   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   {
+      metricAdd(eMETRIC_FRAME_CAN, 1);
+   }
+
+   //----------------------------------------------------------------
+   // every frame occupies the bus, regardless of the number of
+   // receiving clients
+   //
+   clBusLoadP.addFrame(clFrameViewR);
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleChecksum()                                                           //
+// select the checksum mode of a client                                       //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleChecksum(int32_t & slSockSrcR,
+                                  QCanFrameApi & clApiFrameR)
+{
+   bool              btResultT = false;
+   bool              btEnableT;
+   QCanClient_ts *   ptsClientT;
+
+   if((slSockSrcR < 0) || (slSockSrcR >= pclClientListP->size()))
+   {
+      return (false);
+   }
+
+   if(clApiFrameR.checksum(btEnableT) == true)
+   {
+      //--------------------------------------------------------
+      // the checksum can only be omitted for connections via
+      // the local host or the local server, a remote client
+      // keeps the checksum
+      //
+      ptsClientT = pclClientListP->at(slSockSrcR);
+      if(ptsClientT->pclTcpSock != Q_NULLPTR)
+      {
+         if(ptsClientT->pclTcpSock->peerAddress().isLoopback() == false)
+         {
+            btEnableT = true;
+         }
+      }
+      ptsClientT->btChecksum = btEnableT;
+
+      //--------------------------------------------------------
+      // confirm the mode by sending the API frame back, all
+      // following CAN frames use the new mode
+      //
+      clApiFrameR.setChecksum(btEnableT);
+      ptsClientT->clSendBuf.append(clApiFrameR.toByteArray());
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleConfirm()                                                            //
+// enable / disable transmit confirmation for a client                        //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleConfirm(int32_t & slSockSrcR,
+                                 QCanFrameApi & clApiFrameR)
+{
+   bool  btResultT = false;
+   bool  btEnableT;
+
+   if((slSockSrcR < 0) || (slSockSrcR >= pclClientListP->size()))
+   {
+      return (false);
+   }
+
+   //----------------------------------------------------------------
+   // the request is not confirmed, the frames of the client already
+   // inside the transmit queue are also concerned
+   //
+   if(clApiFrameR.confirm(btEnableT) == true)
+   {
+      pclClientListP->at(slSockSrcR)->btTrmConfirm = btEnableT;
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleFilter()                                                             //
+// update the acceptance filter of a client                                   //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleFilter(int32_t & slSockSrcR,
+                                QCanFrameApi & clApiFrameR)
+{
+   bool                       btResultT = false;
+   bool                       btExtendedT;
+   uint32_t                   ulValue1T;
+   uint32_t                   ulValue2T;
+   QCanFrameApi::FilterType_e teTypeT;
+   QCanClient_ts *            ptsClientT;
+
+   if((slSockSrcR < 0) || (slSockSrcR >= pclClientListP->size()))
+   {
+      return (false);
+   }
+
+   if(clApiFrameR.filter(teTypeT, ulValue1T, ulValue2T, btExtendedT) == true)
+   {
+      ptsClientT = pclClientListP->at(slSockSrcR);
+      switch(teTypeT)
+      {
+         case QCanFrameApi::eFILTER_CLEAR:
+            ptsClientT->clFilter.clear();
+            btResultT = true;
+            break;
+
+         case QCanFrameApi::eFILTER_MASK:
+            ptsClientT->clFilter.addMask(ulValue1T, ulValue2T, btExtendedT);
+            btResultT = true;
+            break;
+
+         case QCanFrameApi::eFILTER_RANGE:
+            ptsClientT->clFilter.addRange(ulValue1T, ulValue2T, btExtendedT);
+            btResultT = true;
+            break;
+
+         default:
+
+            break;
+      }
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleFormat()                                                             //
+// select the wire format of a client                                         //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleFormat(int32_t & slSockSrcR,
+                                QCanFrameApi & clApiFrameR)
+{
+   bool                       btResultT = false;
+   QCanFrameApi::WireFormat_e teFormatT;
+   QCanClient_ts *            ptsClientT;
+
+   if((slSockSrcR < 0) || (slSockSrcR >= pclClientListP->size()))
+   {
+      return (false);
+   }
+
+   if(clApiFrameR.wireFormat(teFormatT) == true)
+   {
+      ptsClientT = pclClientListP->at(slSockSrcR);
+      ptsClientT->btCompact = (teFormatT == QCanFrameApi::eWIRE_FORMAT_COMPACT);
+
+      //--------------------------------------------------------
+      // confirm the format by sending the API frame back, all
+      // following CAN frames use the new format, the send queue
+      // limit does not apply here
+      //
+      clApiFrameR.setWireFormat(teFormatT);
+      ptsClientT->clSendBuf.append(clApiFrameR.toByteArray());
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handlePriority()                                                           //
+// select the priority class of a client                                      //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handlePriority(int32_t & slSockSrcR,
+                                  QCanFrameApi & clApiFrameR)
+{
+   bool                       btResultT = false;
+   QCanFrameApi::Priority_e   tePriorityT;
+
+   if((slSockSrcR < 0) || (slSockSrcR >= pclClientListP->size()))
+   {
+      return (false);
+   }
+
+   //----------------------------------------------------------------
+   // the new class is used from the next round of the dispatcher,
+   // the request is not confirmed
+   //
+   if(clApiFrameR.priority(tePriorityT) == true)
+   {
+      pclClientListP->at(slSockSrcR)->tePriority = tePriorityT;
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleTrmConfirm()                                                         //
+// handle a transmit confirmation of the CAN interface                        //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleTrmConfirm(const QCanFrameView & clFrameViewR)
+{
+   bool              btResultT = false;
+   int32_t           slConfirmIdxT;
+   uint32_t          ulArbFieldT;
+   QCanFrame         clCanFrameT;
+   QCanTrmConfirm_ts tsConfirmT;
+
+   if(clFrameViewR.toFrame(clCanFrameT, false) == false)
+   {
+      return (false);
+   }
+
+   //----------------------------------------------------------------
+   // the confirmations arrive in the order of writing, a confirmation
+   // which does not match a frame in flight is ignored
+   //
+   ulArbFieldT = clCanFrameT.arbitrationField();
+   for(slConfirmIdxT = 0; slConfirmIdxT < clTrmConfirmListP.size(); 
+       slConfirmIdxT++)
+   {
+      if(clTrmConfirmListP.at(slConfirmIdxT).tsFrame.ulArbField == ulArbFieldT)
+      {
+         break;
+      }
+   }
+
+   if(slConfirmIdxT < clTrmConfirmListP.size())
+   {
+      //--------------------------------------------------------
+      // frames written before have lost their confirmation,
+      // they are forwarded without
+      //
+      while(slConfirmIdxT > 0)
+      {
+         tsConfirmT = clTrmConfirmListP.takeFirst();
+         finishTransmit(tsConfirmT.ptsClient, tsConfirmT.tsFrame, false);
+         slConfirmIdxT--;
+      }
+
+      //--------------------------------------------------------
+      // the frame is forwarded with the time-stamp of the
+      // CAN interface
+      //
+      tsConfirmT = clTrmConfirmListP.takeFirst();
+      tsConfirmT.tsFrame.clFrame.setTimeStamp(clCanFrameT.timeStamp());
+      finishTransmit(tsConfirmT.ptsClient, tsConfirmT.tsFrame, true);
+      metricAdd(eMETRIC_TRM_CONFIRM, 1);
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// handleErrorFrame()                                                         //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool  QCanNetwork::handleErrFrame(int32_t & slSockSrcR,
+                                  QByteArray & clSockDataR)
+{
+   int32_t        slSockIdxT;
+   bool           btResultT = false;
+   QCanClient_ts *   ptsClientT;
+
+   //----------------------------------------------------------------
+   // append CAN frame to the send buffer of all other clients,
+   // the buffers are written by flushClients()
+   //
+   for(slSockIdxT = 0; slSockIdxT < pclClientListP->size(); slSockIdxT++)
+   {
+      if(slSockIdxT != slSockSrcR)
+      {
+         ptsClientT = pclClientListP->at(slSockIdxT);
+         queueFrame(ptsClientT, clSockDataR);
+         btResultT = true;
+      }
+   }
+
+   if(pclSharedRingP != Q_NULLPTR)
+   {
+      pclSharedRingP->write((const uint8_t *) clSockDataR.constData(),
+                            clSockDataR.size());
+   }
+
+   //----------------------------------------------------------------
+   // count frame if source is a CAN interface or if the message
+   // could be dispatched
+   //
+   if((slSockSrcR == QCAN_SOCKET_CAN_IF) || (btResultT == true))
+   {
+      metricAdd(eMETRIC_FRAME_ERR, 1);
+   }
+   return(btResultT);
+}
+
+
+QHostAddress QCanNetwork::serverAddress(void)
+{
+   return (pclTcpSrvP->serverAddress());
+}
+
+
+//----------------------------------------------------------------------------//
+// metric()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint64_t QCanNetwork::metric(Metric_e teMetricV) const
+{
+   if((teMetricV < eMETRIC_FRAME_API) || (teMetricV >= eMETRIC_MAX))
+   {
+      return (0);
+   }
+   return (aqMetricP[teMetricV].load());
+}
+
+
+//----------------------------------------------------------------------------//
+// priorityWeight()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanNetwork::priorityWeight(QCanFrameApi::Priority_e tePriorityV)
+{
+   if((tePriorityV < QCanFrameApi::ePRIORITY_REALTIME) || 
+      (tePriorityV >= QCanFrameApi::ePRIORITY_MAX))
+   {
+      return (0);
+   }
+   return (aulPriorityWeightP[tePriorityV]);
+}
+
+
+//----------------------------------------------------------------------------//
+// onLocalConnect()                                                           //
+// slot that manages a new connection of the local server                     //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onLocalConnect(void)
+{
+   QLocalSocket *    pclSocketT;
+
+   pclSocketT = pclLocalSrvP->nextPendingConnection();
+   if(pclSocketT != Q_NULLPTR)
+   {
+      addClient(pclSocketT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onSocketConnect()                                                          //
+// slot that manages a new TCP server connection                              //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketConnect(void)
+{
+   QTcpSocket *      pclSocketT;
+
+   pclSocketT = pclTcpSrvP->nextPendingConnection();
+   if(pclSocketT != Q_NULLPTR)
+   {
+      addClient(pclSocketT);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onSocketDisconnect()                                                       //
+// remove local socket from list                                              //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketDisconnect(void)
+{
+   int32_t           slSockIdxT;
+   QCanClient_ts *   ptsClientT;
+   QObject *         pclSenderT;
+
+
+   //----------------------------------------------------------------
+   // get sender of signal
+   //
+   pclSenderT = QObject::sender();
+
+   for(slSockIdxT = 0; slSockIdxT < pclClientListP->size(); slSockIdxT++)
    {
-      slSockIdxT = QCAN_SOCKET_CAN_IF;
-      while(pclInterfaceP->read(clSockDataT) == QCanInterface::eERROR_NONE)
+      ptsClientT = pclClientListP->at(slSockIdxT);
+      if(ptsClientT->pclSocket == pclSenderT)
       {
-         switch(frameType(clSockDataT))
+         //------------------------------------------------
+         // the network end of an in-process pipe is
+         // owned by the network
+         //
+         if((ptsClientT->pclTcpSock == Q_NULLPTR) &&
+            (ptsClientT->pclLocalSock == Q_NULLPTR))
          {
-            //-----------------------------------------------------
-            // handle API frames
-            //
-            case QCanData::eTYPE_API:
-               handleApiFrame(slSockIdxT, clSockDataT);
-               break;
-               
-            //-------------------------------------
-            // write CAN frame to other sockets
-            //
-            case QCanData::eTYPE_CAN:
-               handleCanFrame(slSockIdxT, clSockDataT);
-               break;
-               
-            //--------------------------------------------------
-            // handle error frames
-            //
-            case QCanData::eTYPE_ERROR:
-               handleErrFrame(slSockIdxT, clSockDataT);
-               break;
-               
-            //-------------------------------------
-            // nothing we can handle
-            //
-            default:
-               
-               break;
+            ptsClientT->pclSocket->deleteLater();
          }
+         removeClient(slSockIdxT);
+         break;
       }
    }
 
+   qDebug() << "QCanNetwork::onSocketDisconnect()" << pclClientListP->size() << "open sockets";
+
+}
+
+
+//----------------------------------------------------------------------------//
+// onInterfaceReceive()                                                       //
+// CAN interface signals new frames                                           //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onInterfaceReceive(uint32_t ulFrameCntV)
+{
+   int64_t  sqStartT;
+   uint64_t uqFrameCntT;
+
+   Q_UNUSED(ulFrameCntV);
+
    //----------------------------------------------------------------
-   // check all open sockets and read messages
+   // keep the time of the first signal until the frames are read,
+   // this measures the waiting time in timer mode
    //
-   slListSizeT = pclTcpSockListP->size();
-   for(slSockIdxT = 0; slSockIdxT < slListSizeT; slSockIdxT++)
+   sqStartT = clClockP.nsecsElapsed();
+   if(sqIfRecvTimeP == 0)
    {
-      pclSockT = pclTcpSockListP->at(slSockIdxT);
-      ulFrameMaxT = (pclSockT->bytesAvailable()) / QCAN_FRAME_ARRAY_SIZE;
-      for(ulFrameCntT = 0; ulFrameCntT < ulFrameMaxT; ulFrameCntT++)
-      {
-         clSockDataT = pclSockT->read(QCAN_FRAME_ARRAY_SIZE);
+      sqIfRecvTimeP = sqStartT;
+   }
 
-         switch(frameType(clSockDataT))
-         {
-            //-----------------------------------------------------
-            // handle API frames
-            //
-            case QCanData::eTYPE_API:
-               handleApiFrame(slSockIdxT, clSockDataT);
-               break;
+   //----------------------------------------------------------------
+   // in timer mode the frames are handled by onTimerEvent()
+   //
+   if(teDispatchModeP == eDISPATCH_EVENT)
+   {
+      uqFrameCntT = metric(eMETRIC_FRAME_CAN);
+      dispatchInterface();
+      flushClients();
+      addCycle(sqStartT, (uint32_t) (metric(eMETRIC_FRAME_CAN) - uqFrameCntT));
+   }
+}
 
-            //-----------------------------------------------------
-            // handle CAN frames
-            //
-            case QCanData::eTYPE_CAN:
-               //---------------------------------------------
-               // check for active CAN interface
-               //
-               if(pclInterfaceP.isNull() == false)
-               {
-                  clCanFrameT.fromByteArray(clSockDataT);
-                  pclInterfaceP->write(clCanFrameT);
-               }
 
-               //---------------------------------------------
-               // write to other sockets
-               //
-               handleCanFrame(slSockIdxT, clSockDataT);
-               break;
-                  
-            //--------------------------------------------------
-            // handle error frames
-            //
-            case QCanData::eTYPE_ERROR:
-               handleErrFrame(slSockIdxT, clSockDataT);
-               break;         
-               
-            default:
-               
-               break;
+//----------------------------------------------------------------------------//
+// onSocketReceive()                                                          //
+// a socket has new data available                                           //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onSocketReceive(void)
+{
+   int32_t           slSockIdxT;
+   int64_t           sqStartT;
+   uint64_t          uqFrameCntT;
+   QCanClient_ts *   ptsClientT;
+   QObject *         pclSenderT;
+
+   //----------------------------------------------------------------
+   // get sender of signal
+   //
+   pclSenderT = QObject::sender();
+   sqStartT   = clClockP.nsecsElapsed();
+
+   for(slSockIdxT = 0; slSockIdxT < pclClientListP->size(); slSockIdxT++)
+   {
+      ptsClientT = pclClientListP->at(slSockIdxT);
+      if(ptsClientT->pclSocket == pclSenderT)
+      {
+         //------------------------------------------------
+         // keep the time of the first signal until the
+         // data is read
+         //
+         if(ptsClientT->sqRecvTime == 0)
+         {
+            ptsClientT->sqRecvTime = sqStartT;
+         }
+
+         //------------------------------------------------
+         // in timer mode the frames are handled by
+         // onTimerEvent()
+         //
+         if(teDispatchModeP == eDISPATCH_EVENT)
+         {
+            uqFrameCntT = metric(eMETRIC_FRAME_CAN);
+            dispatchSocket(slSockIdxT);
+            dispatchTransmit();
+            flushClients();
+            addCycle(sqStartT, (uint32_t) (metric(eMETRIC_FRAME_CAN) - uqFrameCntT));
          }
+         break;
       }
    }
-   clTcpSockMutexP.unlock();
+}
+
+
+//----------------------------------------------------------------------------//
+// onTimerEvent()                                                             //
+// cyclic frame dispatcher                                                    //
+//----------------------------------------------------------------------------//
+void QCanNetwork::onTimerEvent(void)
+{
+   int64_t        sqStartT;
+   uint64_t       uqFrameCntT;
 
    //----------------------------------------------------------------
-   // signal current statistic values
+   // the client list is only modified inside the thread of the
+   // network, no lock is required
    //
-   if(ulStatisticTickP > 0)
+   sqStartT    = clClockP.nsecsElapsed();
+   uqFrameCntT = metric(eMETRIC_FRAME_CAN);
+
+   //----------------------------------------------------------------
+   // read messages from the CAN interface and all open sockets
+   // within the frame budget, in event mode the sockets are read
+   // by onSocketReceive() and the CAN interface is read here for
+   // interfaces that do not signal new frames
+   //
+   if(teDispatchModeP == eDISPATCH_TIMER)
    {
-      ulStatisticTickP--;
+      dispatchScheduled();
    }
    else
    {
-      //--------------------------------------------------------
-      // reload tick value
-      //
-      ulStatisticTickP = ulStatisticTimeP / ulDispatchTimeP;
+      dispatchInterface();
+   }
 
-      //--------------------------------------------------------
-      // signal current counter values
-      //
-      showApiFrames(ulCntFrameApiP);
-      showCanFrames(ulCntFrameCanP);
-      showErrFrames(ulCntFrameErrP);
+   //----------------------------------------------------------------
+   // write the frames of the clients to the CAN interface, in event
+   // mode this retries the frames rejected by a full FIFO
+   //
+   dispatchTransmit();
 
-      //--------------------------------------------------------
-      // calculate messages per second
-      //
-      ulMsgPerSecT = ulCntFrameCanP - ulFrameCntSaveP;
+   //----------------------------------------------------------------
+   // write all CAN frames of this cycle with one operation
+   // per socket
+   //
+   flushClients();
+   addCycle(sqStartT, (uint32_t) (metric(eMETRIC_FRAME_CAN) - uqFrameCntT));
 
-      //--------------------------------------------------------
-      // calculate bus load
-      //
-      ulCntBitCurP = ulCntBitCurP * 100;
-      ulCntBitCurP = ulCntBitCurP / ulCntBitMaxP;
-      if(ulCntBitCurP > 100)
+   //----------------------------------------------------------------
+   // signal current statistic values
+   //
+   updateStatistic();
+}
+
+
+//----------------------------------------------------------------------------//
+// reclaimClients()                                                           //
+// release retired client lists                                               //
+//----------------------------------------------------------------------------//
+void QCanNetwork::reclaimClients(void)
+{
+   if(clRetiredListP.isEmpty() == true)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // a reader increments the counter before it loads the list,
+   // the ordered operation makes sure that a reader which is not
+   // counted here loads the list published before
+   //
+   if(slListReaderP.fetchAndAddOrdered(0) == 0)
+   {
+      qDeleteAll(clRetiredListP);
+      clRetiredListP.resize(0);
+      qDeleteAll(clRetiredClientP);
+      clRetiredClientP.resize(0);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// releaseConfirm()                                                           //
+// forward the frames in flight without transmit confirmation                 //
+//----------------------------------------------------------------------------//
+void QCanNetwork::releaseConfirm(void)
+{
+   QCanTrmConfirm_ts tsConfirmT;
+
+   while(clTrmConfirmListP.isEmpty() == false)
+   {
+      tsConfirmT = clTrmConfirmListP.takeFirst();
+      finishTransmit(tsConfirmT.ptsClient, tsConfirmT.tsFrame, false);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// removeClient()                                                             //
+// remove client with index slSockIdxV from list                              //
+//----------------------------------------------------------------------------//
+void QCanNetwork::removeClient(int32_t slSockIdxV)
+{
+   int32_t                    slQueueIdxT;
+   QCanTrmQueue_ts *          ptsQueueT;
+   QVector<QCanClient_ts *> * pclListT;
+
+   //----------------------------------------------------------------
+   // pending frames of the client are still transmitted, but the
+   // client is released, an empty transmit queue is removed
+   //
+   for(slQueueIdxT = 0; slQueueIdxT < clTrmQueueListP.size(); slQueueIdxT++)
+   {
+      ptsQueueT = clTrmQueueListP.at(slQueueIdxT);
+      if(ptsQueueT->ptsClient == pclClientListP->at(slSockIdxV))
       {
-         ulCntBitCurP = 100;
+         ptsQueueT->ptsClient = Q_NULLPTR;
+         if(ptsQueueT->slHead == ptsQueueT->clFrameList.size())
+         {
+            clTrmQueueListP.remove(slQueueIdxT);
+            delete (ptsQueueT);
+         }
+         break;
       }
-      //--------------------------------------------------------
-      // signal bus load and msg/sec
-      //
-      showLoad((uint8_t) ulCntBitCurP, ulMsgPerSecT);
-      ulCntBitCurP = 0;
+   }
 
-      //--------------------------------------------------------
-      // store actual frame counter value
-      //
-      ulFrameCntSaveP = ulCntFrameCanP;
+   for(slQueueIdxT = 0; slQueueIdxT < clTrmConfirmListP.size(); slQueueIdxT++)
+   {
+      if(clTrmConfirmListP.at(slQueueIdxT).ptsClient == 
+         pclClientListP->at(slSockIdxV))
+      {
+         clTrmConfirmListP[slQueueIdxT].ptsClient = Q_NULLPTR;
+      }
    }
 
-   clDispatchTmrP.singleShot(ulDispatchTimeP, this, SLOT(onTimerEvent()));
+   //----------------------------------------------------------------
+   // publish a copy of the list without the client, the client
+   // and the previous list are retired
+   //
+   pclListT = new QVector<QCanClient_ts *>(*pclClientListP);
+   pclListT->remove(slSockIdxV);
+   clRetiredClientP.append(pclClientListP->at(slSockIdxV));
+   clRetiredListP.append(pclClientListP);
+   pclClientListP = pclListT;
+   apclClientListP.fetchAndStoreOrdered(pclClientListP);
+   reclaimClients();
+
+   metricSet(eMETRIC_CLIENT_COUNT, (uint64_t) pclClientListP->size());
 }
 
 
@@ -694,14 +2573,88 @@ void QCanNetwork::onTimerEvent(void)
 //----------------------------------------------------------------------------//
 void QCanNetwork::removeInterface(void)
 {
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "removeInterface",
+                                Qt::BlockingQueuedConnection);
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // the interface thread must not access the CAN interface
+   // anymore
+   //
+   stopInterfaceReader();
+
    if(pclInterfaceP.isNull() == false)
    {
       if (pclInterfaceP->connected())
       {
          pclInterfaceP->disconnect();
       }
+      QObject::disconnect( pclInterfaceP, SIGNAL(framesReceived(uint32_t)),
+                           this, SLOT(onInterfaceReceive(uint32_t)));
+      QObject::disconnect( pclInterfaceP, SIGNAL(framesWritten(uint32_t)),
+                           this, SLOT(onInterfaceReceive(uint32_t)));
    }
    pclInterfaceP.clear();
+
+   //----------------------------------------------------------------
+   // confirmations of the removed interface will not arrive anymore
+   //
+   btTrmConfirmP = false;
+   releaseConfirm();
+}
+
+
+//----------------------------------------------------------------------------//
+// resetHistograms()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::resetHistograms(void)
+{
+   int32_t  slHistIdxT;
+
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "resetHistograms",
+                                Qt::BlockingQueuedConnection);
+      return;
+   }
+
+   for(slHistIdxT = 0; slHistIdxT < eHISTOGRAM_MAX; slHistIdxT++)
+   {
+      aclHistogramP[slHistIdxT].clear();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// returnCredit()                                                             //
+// return one transmit credit to a client                                     //
+//----------------------------------------------------------------------------//
+int32_t QCanNetwork::returnCredit(QCanClient_ts * ptsClientV)
+{
+   int32_t  slSockIdxT = -1;
+
+   //----------------------------------------------------------------
+   // the client is cleared when it has disconnected, the index is
+   // the source of the frame for handleCanFrame()
+   //
+   if(ptsClientV != Q_NULLPTR)
+   {
+      slSockIdxT = pclClientListP->indexOf(ptsClientV);
+      ptsClientV->ulTrmPending--;
+      ptsClientV->ulTrmReturn++;
+   }
+
+   return (slSockIdxT);
 }
 
 
@@ -711,6 +2664,18 @@ void QCanNetwork::removeInterface(void)
 //----------------------------------------------------------------------------//
 void QCanNetwork::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
 {
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setBitrate",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(int32_t, slNomBitRateV),
+                                Q_ARG(int32_t, slDatBitRateV));
+      return;
+   }
+
    //----------------------------------------------------------------
    // Store new bit-rates:
    // If there is no CAN FD support, the data bit rate will be set
@@ -739,30 +2704,151 @@ void QCanNetwork::setBitrate(int32_t slNomBitRateV, int32_t slDatBitRateV)
    //----------------------------------------------------------------
    // configure bit-counter for bus-load calculation
    //
-   switch(slNomBitRateV)
+   clBusLoadP.setBitrate(slNomBitRateP, slDatBitRateP);
+   clBusLoadP.reset();
+}
+
+
+//----------------------------------------------------------------------------//
+// setCpuAffinity()                                                           //
+// bind the thread of the network to a CPU                                    //
+//----------------------------------------------------------------------------//
+bool QCanNetwork::setCpuAffinity(int32_t slCpuV)
+{
+   bool  btResultT = false;
+
+   //----------------------------------------------------------------
+   // the affinity is always set for the calling thread, so this
+   // must be executed inside the thread of the network
+   //
+   if(isNetworkThread() == false)
    {
-      case eCAN_BITRATE_125K:
-         ulCntBitMaxP = 125000;
-         break;
-         
-      case eCAN_BITRATE_250K:
-         ulCntBitMaxP = 250000;
-         break;
+      QMetaObject::invokeMethod(this, "setCpuAffinity",
+                                Qt::BlockingQueuedConnection,
+                                Q_RETURN_ARG(bool, btResultT),
+                                Q_ARG(int32_t, slCpuV));
+      return (btResultT);
+   }
 
-      case eCAN_BITRATE_500K:
-         ulCntBitMaxP = 500000;
-         break;
+   #if defined(Q_OS_LINUX)
+   cpu_set_t   tsCpuSetT;
+   int32_t     slCpuCntT;
+
+   CPU_ZERO(&tsCpuSetT);
+   if(slCpuV < 0)
+   {
+      for(slCpuCntT = 0; slCpuCntT < QThread::idealThreadCount(); slCpuCntT++)
+      {
+         CPU_SET(slCpuCntT, &tsCpuSetT);
+      }
+   }
+   else if(slCpuV < CPU_SETSIZE)
+   {
+      CPU_SET(slCpuV, &tsCpuSetT);
+   }
+
+   if(CPU_COUNT(&tsCpuSetT) > 0)
+   {
+      if(pthread_setaffinity_np(pthread_self(), sizeof(tsCpuSetT),
+                                &tsCpuSetT) == 0)
+      {
+         btResultT = true;
+      }
+   }
+   #endif
+
+   #if defined(Q_OS_WIN)
+   DWORD_PTR   uqProcMaskT;
+   DWORD_PTR   uqSysMaskT;
+   DWORD_PTR   uqThreadMaskT = 0;
+
+   if(GetProcessAffinityMask(GetCurrentProcess(), &uqProcMaskT, &uqSysMaskT))
+   {
+      if(slCpuV < 0)
+      {
+         uqThreadMaskT = uqProcMaskT;
+      }
+      else if(slCpuV < (int32_t) (sizeof(DWORD_PTR) * 8))
+      {
+         uqThreadMaskT = ((DWORD_PTR) 1 << slCpuV) & uqProcMaskT;
+      }
+   }
+
+   if(uqThreadMaskT != 0)
+   {
+      if(SetThreadAffinityMask(GetCurrentThread(), uqThreadMaskT) != 0)
+      {
+         btResultT = true;
+      }
+   }
+   #endif
+
+   if(btResultT == true)
+   {
+      slCpuAffinityP = slCpuV;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setDispatcherTime()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setDispatcherTime(uint32_t ulTimeV)
+{
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setDispatcherTime",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulTimeV));
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // a value of 0 would make the timer run without delay
+   //
+   if(ulTimeV == 0)
+   {
+      ulTimeV = 1;
    }
+   ulDispatchTimeP  = ulTimeV;
+   ulStatisticTickP = ulStatisticTimeP / ulDispatchTimeP;
+   pclDispatchTmrP->setInterval(ulDispatchTimeP);
 }
 
 
 //----------------------------------------------------------------------------//
-// setDispatcherTime()                                                        //
+// setDispatcherMode()                                                        //
 //                                                                            //
 //----------------------------------------------------------------------------//
-void QCanNetwork::setDispatcherTime(uint32_t ulTimeV)
+void QCanNetwork::setDispatcherMode(DispatchMode_e teModeV)
 {
-   ulDispatchTimeP = ulTimeV;
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setDispatcherMode",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(QCanNetwork::DispatchMode_e, teModeV));
+      return;
+   }
+
+   teDispatchModeP = teModeV;
+
+   //----------------------------------------------------------------
+   // data that has been received in timer mode must be handled
+   // now, a socket will not signal it again
+   //
+   if((teModeV == eDISPATCH_EVENT) && (btNetworkEnabledP == true))
+   {
+      onTimerEvent();
+   }
 }
 
 
@@ -800,6 +2886,56 @@ void QCanNetwork::setFastDataEnabled(bool btEnableV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setFrameBudget()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setFrameBudget(uint32_t ulFrameMaxV)
+{
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setFrameBudget",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulFrameMaxV));
+      return;
+   }
+
+   ulFrameBudgetP = ulFrameMaxV;
+}
+
+
+
+
+//----------------------------------------------------------------------------//
+// setInterfaceThreadEnabled()                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setInterfaceThreadEnabled(bool btEnableV)
+{
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setInterfaceThreadEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
+   btIfThreadEnabledP = btEnableV;
+   if(btEnableV == true)
+   {
+      startInterfaceReader();
+   }
+   else
+   {
+      stopInterfaceReader();
+   }
+}
 
 
 //----------------------------------------------------------------------------//
@@ -825,6 +2961,16 @@ void QCanNetwork::setListenOnlyEnabled(bool btEnableV)
 //----------------------------------------------------------------------------//
 void QCanNetwork::setNetworkEnabled(bool btEnableV)
 {
+   //----------------------------------------------------------------
+   // the TCP server must be used inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setNetworkEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
 
    if(btEnableV == true)
    {
@@ -845,11 +2991,30 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
       connect( pclTcpSrvP, SIGNAL(newConnection()),
                this, SLOT(onSocketConnect()));
 
+      //--------------------------------------------------------
+      // the local server accepts clients on the same host, a
+      // server file left by a crashed process is removed first
+      //
+      pclLocalSrvP->setMaxPendingConnections(QCAN_TCP_SOCKET_MAX);
+      pclLocalSrvP->setSocketOptions(QLocalServer::WorldAccessOption);
+      QLocalServer::removeServer(clLocalNameP);
+      if(!pclLocalSrvP->listen(clLocalNameP))
+      {
+         qDebug() << "QCanNetwork(): can not listen to " << clLocalNameP;
+      }
+
+      connect( pclLocalSrvP, SIGNAL(newConnection()),
+               this, SLOT(onLocalConnect()));
+
+      if(btSharedRingEnabledP == true)
+      {
+         startSharedRing();
+      }
 
       //--------------------------------------------------------
-      // start network thread
+      // start frame dispatcher
       //
-      clDispatchTmrP.singleShot(ulDispatchTimeP, this, SLOT(onTimerEvent()));
+      pclDispatchTmrP->start(ulDispatchTimeP);
 
 
       //--------------------------------------------------------
@@ -863,7 +3028,7 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
       //--------------------------------------------------------
       // stop timer for message dispatching
       //
-      clDispatchTmrP.stop();
+      pclDispatchTmrP->stop();
 
       //--------------------------------------------------------
       // remove signal / slot connection
@@ -871,12 +3036,17 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
       disconnect( pclTcpSrvP, SIGNAL(newConnection()),
                      this, SLOT(onSocketConnect()));
 
+      disconnect( pclLocalSrvP, SIGNAL(newConnection()),
+                     this, SLOT(onLocalConnect()));
+
 
       //--------------------------------------------------------
       // close TCP server
       //
       qDebug() << "Close server";
       pclTcpSrvP->close();
+      pclLocalSrvP->close();
+      stopSharedRing();
 
       //--------------------------------------------------------
       // set flag for further operations
@@ -888,6 +3058,124 @@ void QCanNetwork::setNetworkEnabled(bool btEnableV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setSharedRingEnabled()                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setSharedRingEnabled(bool btEnableV)
+{
+   //----------------------------------------------------------------
+   // the ring is written inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setSharedRingEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
+   btSharedRingEnabledP = btEnableV;
+   if((btEnableV == true) && (btNetworkEnabledP == true))
+   {
+      startSharedRing();
+   }
+
+   if(btEnableV == false)
+   {
+      stopSharedRing();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setPriorityWeight()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setPriorityWeight(QCanFrameApi::Priority_e tePriorityV,
+                                    uint32_t ulFrameMaxV)
+{
+   if((tePriorityV < QCanFrameApi::ePRIORITY_REALTIME) || 
+      (tePriorityV >= QCanFrameApi::ePRIORITY_MAX))
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // at least one frame is read from a client during each round
+   //
+   if(ulFrameMaxV == 0)
+   {
+      ulFrameMaxV = 1;
+   }
+
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setPriorityWeight",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(QCanFrameApi::Priority_e, tePriorityV),
+                                Q_ARG(uint32_t, ulFrameMaxV));
+      return;
+   }
+
+   aulPriorityWeightP[tePriorityV] = ulFrameMaxV;
+}
+
+
+//----------------------------------------------------------------------------//
+// setQueuePolicy()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setQueuePolicy(QueuePolicy_e teQueuePolicyV)
+{
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setQueuePolicy",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(QCanNetwork::QueuePolicy_e, 
+                                      teQueuePolicyV));
+      return;
+   }
+
+   teQueuePolicyP = teQueuePolicyV;
+}
+
+
+//----------------------------------------------------------------------------//
+// setQueueSize()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setQueueSize(uint32_t ulFrameMaxV)
+{
+   //----------------------------------------------------------------
+   // at least one frame must fit into the queue
+   //
+   if(ulFrameMaxV == 0)
+   {
+      ulFrameMaxV = 1;
+   }
+
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setQueueSize",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulFrameMaxV));
+      return;
+   }
+
+   ulQueueSizeP = ulFrameMaxV;
+}
+
+
 //----------------------------------------------------------------------------//
 // setServerAddress()                                                         //
 //                                                                            //
@@ -907,3 +3195,240 @@ bool QCanNetwork::setServerAddress(QHostAddress clHostAddressV)
 
    return(btResultT);
 }
+
+
+//----------------------------------------------------------------------------//
+// setTransmitCredit()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setTransmitCredit(uint32_t ulCreditV)
+{
+   //----------------------------------------------------------------
+   // at least one frame must fit into the transmit queue
+   //
+   if(ulCreditV == 0)
+   {
+      ulCreditV = 1;
+   }
+
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setTransmitCredit",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(uint32_t, ulCreditV));
+      return;
+   }
+
+   ulTrmCreditP = ulCreditV;
+}
+
+
+//----------------------------------------------------------------------------//
+// setTransmitConfirmEnabled()                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::setTransmitConfirmEnabled(bool btEnableV)
+{
+   //----------------------------------------------------------------
+   // execute inside the thread of the network
+   //
+   if(isNetworkThread() == false)
+   {
+      QMetaObject::invokeMethod(this, "setTransmitConfirmEnabled",
+                                Qt::BlockingQueuedConnection,
+                                Q_ARG(bool, btEnableV));
+      return;
+   }
+
+   btTrmConfirmEnabledP = btEnableV;
+
+   //----------------------------------------------------------------
+   // a connected CAN interface is switched immediately, the frames
+   // in flight are forwarded when the confirmation is disabled
+   //
+   if((btEnableV == true) && (btTrmConfirmP == false))
+   {
+      if((hasTransmitConfirmSupport() == true) &&
+         (pclInterfaceP->setTransmitConfirm(true) == 
+          QCanInterface::eERROR_NONE))
+      {
+         btTrmConfirmP = true;
+         connect( pclInterfaceP, SIGNAL(framesWritten(uint32_t)),
+                  this, SLOT(onInterfaceReceive(uint32_t)));
+      }
+   }
+
+   if((btEnableV == false) && (btTrmConfirmP == true))
+   {
+      pclInterfaceP->setTransmitConfirm(false);
+      QObject::disconnect( pclInterfaceP, SIGNAL(framesWritten(uint32_t)),
+                           this, SLOT(onInterfaceReceive(uint32_t)));
+      btTrmConfirmP = false;
+      releaseConfirm();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// startInterfaceReader()                                                     //
+// start the thread reading the CAN interface                                 //
+//----------------------------------------------------------------------------//
+void QCanNetwork::startInterfaceReader(void)
+{
+   if((pclIfReaderP != Q_NULLPTR) || (pclInterfaceP.isNull() == true))
+   {
+      return;
+   }
+
+   pclIfReaderP = new QCanInterfaceReader(pclInterfaceP.data(), this, 
+                                          clClockP);
+   pclIfReaderP->start(QThread::HighPriority);
+}
+
+
+//----------------------------------------------------------------------------//
+// startSharedRing()                                                          //
+// create the shared memory ring for local readers                            //
+//----------------------------------------------------------------------------//
+void QCanNetwork::startSharedRing(void)
+{
+   if(pclSharedRingP != Q_NULLPTR)
+   {
+      return;
+   }
+
+   pclSharedRingP = new QCanSharedRing(clLocalNameP);
+   if(pclSharedRingP->create() == false)
+   {
+      qWarning() << "QCanNetwork(): can not create shared ring" << clLocalNameP;
+      delete (pclSharedRingP);
+      pclSharedRingP = Q_NULLPTR;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// stopInterfaceReader()                                                      //
+// stop the thread reading the CAN interface                                  //
+//----------------------------------------------------------------------------//
+void QCanNetwork::stopInterfaceReader(void)
+{
+   if(pclIfReaderP == Q_NULLPTR)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // frames left inside the ring are handled before the thread
+   // is released
+   //
+   pclIfReaderP->stop();
+   dispatchInterfaceRing();
+   delete (pclIfReaderP);
+   pclIfReaderP = Q_NULLPTR;
+}
+
+
+//----------------------------------------------------------------------------//
+// stopSharedRing()                                                           //
+// close the shared memory ring                                               //
+//----------------------------------------------------------------------------//
+void QCanNetwork::stopSharedRing(void)
+{
+   if(pclSharedRingP == Q_NULLPTR)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // the ring is marked as closed, the memory is released when
+   // the last reader detaches
+   //
+   pclSharedRingP->detach();
+   delete (pclSharedRingP);
+   pclSharedRingP = Q_NULLPTR;
+}
+
+
+//----------------------------------------------------------------------------//
+// transmitQueue()                                                            //
+// get the transmit queue of a client, it is created on first use             //
+//----------------------------------------------------------------------------//
+QCanNetwork::QCanTrmQueue_ts * QCanNetwork::transmitQueue(
+                                                QCanClient_ts * ptsClientV)
+{
+   int32_t           slQueueIdxT;
+   QCanTrmQueue_ts * ptsQueueT;
+
+   for(slQueueIdxT = 0; slQueueIdxT < clTrmQueueListP.size(); slQueueIdxT++)
+   {
+      if(clTrmQueueListP.at(slQueueIdxT)->ptsClient == ptsClientV)
+      {
+         return (clTrmQueueListP.at(slQueueIdxT));
+      }
+   }
+
+   ptsQueueT = new QCanTrmQueue_ts;
+   ptsQueueT->ptsClient = ptsClientV;
+   ptsQueueT->slHead    = 0;
+   clTrmQueueListP.append(ptsQueueT);
+
+   return (ptsQueueT);
+}
+
+
+//----------------------------------------------------------------------------//
+// updateStatistic()                                                          //
+// called for every dispatcher cycle                                          //
+//----------------------------------------------------------------------------//
+void QCanNetwork::updateStatistic(void)
+{
+   uint8_t   ubLoadT;
+   uint32_t  ulMsgPerSecT;
+
+   //----------------------------------------------------------------
+   // client lists retired while another thread was reading
+   // are released here
+   //
+   reclaimClients();
+
+   if(ulStatisticTickP > 0)
+   {
+      ulStatisticTickP--;
+   }
+   else
+   {
+      //--------------------------------------------------------
+      // reload tick value
+      //
+      ulStatisticTickP = ulStatisticTimeP / ulDispatchTimeP;
+
+      //--------------------------------------------------------
+      // signal current counter values
+      //
+      showApiFrames((uint32_t) metric(eMETRIC_FRAME_API));
+      showCanFrames((uint32_t) metric(eMETRIC_FRAME_CAN));
+      showErrFrames((uint32_t) metric(eMETRIC_FRAME_ERR));
+
+      //--------------------------------------------------------
+      // calculate messages per second
+      //
+      ulMsgPerSecT = (uint32_t) metric(eMETRIC_FRAME_CAN) - ulFrameCntSaveP;
+
+      //--------------------------------------------------------
+      // signal bus load and msg/sec
+      //
+      ubLoadT = clBusLoadP.load(ulStatisticTimeP);
+      metricSet(eMETRIC_BUS_LOAD, ubLoadT);
+      showLoad(ubLoadT, ulMsgPerSecT);
+      clBusLoadP.reset();
+
+      //--------------------------------------------------------
+      // store actual frame counter value
+      //
+      ulFrameCntSaveP = (uint32_t) metric(eMETRIC_FRAME_CAN);
+   }
+}
@@ -35,15 +35,23 @@
 ** Include files                                                              **
 **                                                                            **
 \*----------------------------------------------------------------------------*/
+#include <QAtomicInteger>
+#include <QAtomicPointer>
+#include <QElapsedTimer>
+#include <QLocalServer>
+#include <QLocalSocket>
 #include <QTcpServer>
 #include <QTcpSocket>
-#include <QMutex>
 #include <QPointer>
 #include <QTimer>
 
+#include "qcan_bus_load.hpp"
+#include "qcan_filter.hpp"
 #include "qcan_frame.hpp"
 #include "qcan_frame_api.hpp"
 #include "qcan_frame_error.hpp"
+#include "qcan_frame_view.hpp"
+#include "qcan_histogram.hpp"
 
 using namespace QCan;
 
@@ -52,6 +60,9 @@ using namespace QCan;
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 class QCanInterface;
+class QCanInterfaceReader;
+class QCanPipe;
+class QCanSharedRing;
 
 
 
@@ -65,14 +76,191 @@ class QCanInterface;
 ** It supports one physical CAN interface (QCanInterface), which can be
 ** assigned during run-time to the CAN network and a limited number of
 ** virtual CAN interfaces (sockets). Clients can connect to a QCanNetwork
-** via the QCanSocket class.
+** via the QCanSocket class, either by TCP or by the local server of the
+** network (Unix domain socket or named pipe, refer to localServerName()).
+** <p>
+** A QCanNetwork can be moved to a worker thread by QObject::moveToThread().
+** All methods that change the configuration of the network are executed
+** inside the thread of the network, they block the caller until the
+** operation has been finished.
+** <p>
+** The list of connected clients is replaced as a whole when a client
+** connects or disconnects (read-copy-update). The dispatcher never
+** waits for other threads, clientCount() and clientStatistic() read
+** the published list without locking.
 **
 */
 class QCanNetwork : public QObject
 {
    Q_OBJECT
 public:
-   
+
+   /*!
+   ** \enum   DispatchMode_e
+   **
+   ** This enumeration defines how the internal CAN frame handler is
+   ** triggered.
+   */
+   enum DispatchMode_e {
+
+      /*! CAN frames are dispatched cyclic, the cycle time is defined
+      **  by setDispatcherTime()                             */
+      eDISPATCH_TIMER = 0,
+
+      /*! CAN frames are dispatched upon reception, the timer is only
+      **  used for statistic and polling of the CAN interface */
+      eDISPATCH_EVENT
+   };
+
+   /*!
+   ** \enum   QueuePolicy_e
+   **
+   ** This enumeration defines the behaviour of the network when the
+   ** send queue of a client is full.
+   */
+   enum QueuePolicy_e {
+
+      /*! The oldest CAN frame of the queue is dropped   */
+      eQUEUE_DROP_OLDEST = 0,
+
+      /*! The new CAN frame is dropped                   */
+      eQUEUE_DROP_NEWEST,
+
+      /*! The client is disconnected from the network    */
+      eQUEUE_DISCONNECT
+   };
+
+   /*!
+   ** \enum   Histogram_e
+   **
+   ** This enumeration selects one of the dispatcher histograms,
+   ** refer to histogram(). Time values are measured in nanoseconds.
+   ** The latency from the CAN interface starts when the frame is read
+   ** from the interface (or signalled by QCanInterface::framesReceived()
+   ** in event mode), the latency from a socket starts when the socket
+   ** signals new data.
+   */
+   enum Histogram_e {
+
+      /*! Latency from CAN interface to the sockets      */
+      eHISTOGRAM_IF_TO_SOCKET = 0,
+
+      /*! Latency from a socket to the CAN interface     */
+      eHISTOGRAM_SOCKET_TO_IF,
+
+      /*! Duration of one dispatcher cycle               */
+      eHISTOGRAM_CYCLE_TIME,
+
+      /*! Number of CAN frames per dispatcher cycle      */
+      eHISTOGRAM_CYCLE_FRAMES,
+
+      /*! Number of histograms                           */
+      eHISTOGRAM_MAX
+   };
+
+   /*!
+   ** \enum   Metric_e
+   **
+   ** This enumeration selects one of the metric values of the network,
+   ** refer to metric(). Time values are measured in nanoseconds.
+   */
+   enum Metric_e {
+
+      /*! Total number of API frames                     */
+      eMETRIC_FRAME_API = 0,
+
+      /*! Total number of CAN frames                     */
+      eMETRIC_FRAME_CAN,
+
+      /*! Total number of CAN error frames               */
+      eMETRIC_FRAME_ERR,
+
+      /*! Total number of frames dropped by send queues  */
+      eMETRIC_FRAME_DROP,
+
+      /*! Total number of socket write operations        */
+      eMETRIC_SOCKET_WRITE,
+
+      /*! Total number of frames written to sockets      */
+      eMETRIC_SOCKET_FRAME,
+
+      /*! Bus load in percent                            */
+      eMETRIC_BUS_LOAD,
+
+      /*! Number of connected clients                    */
+      eMETRIC_CLIENT_COUNT,
+
+      /*! Number of frames in all send queues            */
+      eMETRIC_QUEUE_COUNT,
+
+      /*! Maximum number of frames in a send queue       */
+      eMETRIC_QUEUE_HIGH,
+
+      /*! Total number of dispatcher cycles              */
+      eMETRIC_CYCLE_COUNT,
+
+      /*! Sum of all dispatcher cycle durations          */
+      eMETRIC_CYCLE_TIME,
+
+      /*! Maximum duration of a dispatcher cycle         */
+      eMETRIC_CYCLE_TIME_MAX,
+
+      /*! Number of frames from the CAN interface        */
+      eMETRIC_IF_LATENCY_COUNT,
+
+      /*! Sum of latencies from the CAN interface        */
+      eMETRIC_IF_LATENCY_TIME,
+
+      /*! Number of frames written to the CAN interface  */
+      eMETRIC_SOCKET_LATENCY_COUNT,
+
+      /*! Sum of latencies to the CAN interface          */
+      eMETRIC_SOCKET_LATENCY_TIME,
+
+      /*! Deferred reads of real-time clients            */
+      eMETRIC_DEFER_REALTIME,
+
+      /*! Deferred reads of normal clients               */
+      eMETRIC_DEFER_NORMAL,
+
+      /*! Deferred reads of bulk clients                 */
+      eMETRIC_DEFER_BULK,
+
+      /*! Number of frames in the transmit queue         */
+      eMETRIC_TRM_QUEUE,
+
+      /*! Number of retries after a full transmit FIFO   */
+      eMETRIC_TRM_RETRY,
+
+      /*! Frames dropped by the transmit queue           */
+      eMETRIC_TRM_DROP,
+
+      /*! Frames confirmed by the CAN interface          */
+      eMETRIC_TRM_CONFIRM,
+
+      /*! Number of metric values                        */
+      eMETRIC_MAX
+   };
+
+   /*!
+   ** \struct QCanClientStatistic_s
+   **
+   ** Statistic values of the send queue of a client, refer to
+   ** clientStatistic().
+   */
+   typedef struct QCanClientStatistic_s {
+      /*! Number of CAN frames currently queued          */
+      uint32_t   ulQueueCount;
+      /*! Maximum number of CAN frames that were queued  */
+      uint32_t   ulQueueHigh;
+      /*! Number of CAN frames dropped                   */
+      uint32_t   ulDropCount;
+      /*! Number of cycles with frames left for reading  */
+      uint32_t   ulDeferCount;
+      /*! Priority class of the client                   */
+      QCanFrameApi::Priority_e   tePriority;
+   } QCanClientStatistic_ts;
+
    /*!
    ** \param[in]  pclParentV     Pointer to QObject parent class
    ** \param[in]  uwPortV        Port number
@@ -94,12 +282,27 @@ public:
 	** Each CAN network supports only one physical CAN interface.
 	** The CAN interface is removed from the network by calling
 	** the removeInterface() method. The parameter \c pclCanIfV is a pointer
-	** to an instance of a QCanInterface class.
+	** to an instance of a QCanInterface class. The CAN interface is called
+	** from the thread of the network and from its receive thread, it must
+	** be thread-safe (refer to QCanInterface).
 	** <p>
 	** The function returns \c true if the CAN interface is added, otherwise
 	** it will return \c false.
 	*/
-	bool addInterface(QCanInterface * pclCanIfV);
+	Q_INVOKABLE bool addInterface(QCanInterface * pclCanIfV);
+
+   /*!
+   ** \param[in]  pclPipeV       First end of a pipe
+   ** \return     \c true if the pipe is connected
+   ** \see        QCanSocket::connectNetwork()
+   **
+   ** This function connects an in-process client to the network. The
+   ** network creates the second end of the pipe \a pclPipeV inside its
+   ** own thread and adds it to the client list like a TCP socket or a
+   ** local socket, so the frames are dispatched in the same way. The
+   ** function fails if the network is not enabled.
+   */
+   Q_INVOKABLE bool connectPipe(QCanPipe * pclPipeV);
 
    /*!
    ** \return     Bit-rate value for Nominal Bit Timing
@@ -120,6 +323,59 @@ public:
 
 	inline int32_t  dataBitrate(void)      {  return (slDatBitRateP);    };
 
+   /*!
+   ** \return     Number of connected clients
+   ** \see        clientStatistic()
+   **
+   ** This function returns the number of sockets which are connected
+   ** to the CAN network. It does not lock the dispatcher.
+   */
+   int32_t  clientCount(void);
+
+   /*!
+   ** \param[in]  slClientIdxV   Index of client
+   ** \param[out] tsStatisticR   Statistic values
+   ** \return     \c true if the client index is valid
+   ** \see        clientCount()
+   **
+   ** This function returns the statistic values of the send queue of the
+   ** client with the index \a slClientIdxV (starting with 0). It does not
+   ** lock the dispatcher.
+   */
+   bool     clientStatistic(int32_t slClientIdxV,
+                            QCanClientStatistic_ts & tsStatisticR);
+
+   /*!
+   ** \param[in]  teMetricV      Selected metric value
+   ** \return     Value of metric
+   **
+   ** This function returns the metric value \a teMetricV. It does not
+   ** lock the dispatcher and can be called from any thread, e.g. by
+   ** a metrics exporter.
+   */
+   uint64_t metric(Metric_e teMetricV) const;
+
+   /*!
+   ** \param[in]  teHistogramV   Selected histogram
+   ** \param[out] clHistogramR   Copy of the histogram
+   ** \return     \c true if the histogram selection is valid
+   ** \see        resetHistograms()
+   **
+   ** This function returns a copy of the dispatcher histogram
+   ** \a teHistogramV. The histograms collect values since the creation
+   ** of the network or the last call of resetHistograms(). The copy is
+   ** taken inside the thread of the network.
+   */
+   bool     histogram(Histogram_e teHistogramV, 
+                      QCanHistogram & clHistogramR);
+
+   /*!
+   ** \see        histogram()
+   **
+   ** This function removes all values from the dispatcher histograms.
+   */
+   Q_INVOKABLE void resetHistograms(void);
+
    /*!
    ** \return     Current dispatcher time
    ** \see        setDispatcherTime()
@@ -129,14 +385,53 @@ public:
    */
 	uint32_t dispatcherTime(void)    {return (ulDispatchTimeP); };
 
+   /*!
+   ** \return     Current dispatcher mode
+   ** \see        setDispatcherMode()
+   **
+   ** This function returns the current mode of the internal CAN frame
+   ** handler.
+   */
+   DispatchMode_e dispatcherMode(void) {return (teDispatchModeP); };
+
+   /*!
+   ** \return     CPU number
+   ** \see        setCpuAffinity()
+   **
+   ** This function returns the CPU the network thread is bound to.
+   ** The value -1 denotes that the thread is not bound to a CPU.
+   */
+   int32_t cpuAffinity(void)        {return (slCpuAffinityP);        };
+
+   /*!
+   ** \return     Maximum number of frames per dispatcher cycle
+   ** \see        setFrameBudget()
+   */
+   uint32_t frameBudget(void)       {return (ulFrameBudgetP);        };
+
    bool hasErrorFramesSupport(void);
 
    bool hasFastDataSupport(void);
 
    bool hasListenOnlySupport(void);
 
+   /*!
+   ** \return     \c true if the CAN interface confirms transmission
+   ** \see        setTransmitConfirmEnabled()
+   */
+   bool hasTransmitConfirmSupport(void);
+
    bool isErrorFramesEnabled(void)  {return (btErrorFramesEnabledP); };
 
+   /*!
+   ** \return     \c true if the interface thread is enabled
+   ** \see        setInterfaceThreadEnabled()
+   **
+   ** This function returns \c true if the CAN interface is read by
+   ** a separate thread.
+   */
+   bool isInterfaceThreadEnabled(void) {return (btIfThreadEnabledP); };
+
    bool isFastDataEnabled(void)     {return (btFastDataEnabledP);    };
 
    bool isListenOnlyEnabled(void)   {return (btListenOnlyEnabledP);  };
@@ -150,9 +445,83 @@ public:
    */
    bool isNetworkEnabled(void)      {return (btNetworkEnabledP);     };
 
+   /*!
+   ** \return     \c true if the shared memory ring is enabled
+   ** \see        setSharedRingEnabled()
+   */
+   bool isSharedRingEnabled(void)   {return (btSharedRingEnabledP);  };
+
+   /*!
+   ** \return     \c true if transmit confirmation is enabled
+   ** \see        setTransmitConfirmEnabled()
+   */
+   bool isTransmitConfirmEnabled(void) {return (btTrmConfirmEnabledP); };
+
+   /*!
+   ** \return     Name of local server
+   **
+   ** This function returns the name of the local server (QLocalServer)
+   ** of the network. Clients on the same host can connect to this
+   ** server instead of the TCP server, which avoids the overhead of the
+   ** TCP/IP stack. The name is built from #QCAN_LOCAL_SOCKET_NAME and
+   ** the TCP port of the network. The server is listening as long as
+   ** the network is enabled.
+   */
+   QString localServerName(void)    {return (clLocalNameP);          };
+
+   /*!
+   ** \return     Number of CAN frames written to sockets
+   ** \see        socketWriteCount()
+   **
+   ** This function returns the total number of CAN frames (including
+   ** error and API frames) which have been written to the sockets.
+   */
+   uint64_t frameWriteCount(void)   {return (metric(eMETRIC_SOCKET_FRAME)); };
+
+   /*!
+   ** \return     Number of socket write operations
+   ** \see        frameWriteCount()
+   **
+   ** This function returns the total number of write operations on the
+   ** sockets. All CAN frames for a socket are collected during one
+   ** dispatcher cycle and written by a single operation, so this value
+   ** is typically much lower than frameWriteCount().
+   */
+   uint64_t socketWriteCount(void)  {return (metric(eMETRIC_SOCKET_WRITE)); };
+
+   /*!
+   ** \return     Number of transmit credits of a client
+   ** \see        setTransmitCredit()
+   */
+   uint32_t transmitCredit(void)    {return (ulTrmCreditP);          };
+
 
 	QString  name()   { return(clNetNameP); };
 
+   /*!
+   ** \param[in]  tePriorityV    Priority class
+   ** \return     Number of frames per round
+   ** \see        setPriorityWeight()
+   */
+   uint32_t priorityWeight(QCanFrameApi::Priority_e tePriorityV);
+
+   /*!
+   ** \return     Current send queue policy
+   ** \see        setQueuePolicy()
+   **
+   ** This function returns the policy for a full send queue of a client.
+   */
+   QueuePolicy_e queuePolicy(void)  {return (teQueuePolicyP);        };
+
+   /*!
+   ** \return     Size of send queue
+   ** \see        setQueueSize()
+   **
+   ** This function returns the maximum number of CAN frames in the send
+   ** queue of a client.
+   */
+   uint32_t queueSize(void)         {return (ulQueueSizeP);          };
+
 	void reset(void);
 
    /*!
@@ -160,7 +529,7 @@ public:
    **
    ** Remove a physical CAN interface from the CAN network.
    */
-	void removeInterface(void);
+	Q_INVOKABLE void removeInterface(void);
 
    QHostAddress serverAddress(void);
 
@@ -179,8 +548,20 @@ public:
    ** For selection of predefined bit-rates the value can be taken from
    ** the enumeration CANpie::CAN_Bitrate_e.
    */
-	void setBitrate(int32_t slNomBitRateV,
-	                int32_t slDatBitRateV = eCAN_BITRATE_NONE);
+	Q_INVOKABLE void setBitrate(int32_t slNomBitRateV,
+	                            int32_t slDatBitRateV = eCAN_BITRATE_NONE);
+
+   /*!
+   ** \param[in]  slCpuV         CPU number
+   ** \return     \c true if the thread affinity has been changed
+   ** \see        cpuAffinity()
+   **
+   ** This function binds the thread of the CAN network to the CPU
+   ** \a slCpuV (starting with 0). The value -1 allows the thread to
+   ** run on all CPUs. The function is supported on Linux and Windows,
+   ** on other platforms it returns \c false.
+   */
+   Q_INVOKABLE bool setCpuAffinity(int32_t slCpuV);
 
 
    /*!
@@ -190,7 +571,23 @@ public:
    ** This function sets the dispatcher time for the internal CAN frame
    ** handler in milliseconds.
    */
-	void setDispatcherTime(uint32_t ulTimeV);
+	Q_INVOKABLE void setDispatcherTime(uint32_t ulTimeV);
+
+
+   /*!
+   ** \param[in]  teModeV        Dispatcher mode
+   ** \see        dispatcherMode()
+   **
+   ** This function sets the mode of the internal CAN frame handler.
+   ** In the mode #eDISPATCH_TIMER all sockets and the CAN interface are
+   ** served cyclic with the dispatcher time. In the mode #eDISPATCH_EVENT
+   ** a CAN frame is forwarded as soon as it is received by a socket
+   ** or as soon as the CAN interface emits the signal
+   ** QCanInterface::framesReceived(). The CAN interface is still polled
+   ** with the dispatcher time, hence plug-ins that do not emit the
+   ** signal are supported in both modes.
+   */
+   Q_INVOKABLE void setDispatcherMode(QCanNetwork::DispatchMode_e teModeV);
 
 
    /*!
@@ -205,6 +602,40 @@ public:
 
    void setFastDataEnabled(bool btEnableV = true);
 
+   /*!
+   ** \param[in]  ulFrameMaxV    Maximum number of frames
+   ** \see        frameBudget()
+   **
+   ** This function limits the number of frames which are read from
+   ** the sockets and the CAN interface during one dispatcher cycle in
+   ** the mode #eDISPATCH_TIMER. The frames are read in rounds, within
+   ** each round the clients are served in the order of their priority
+   ** class (QCanSocket::setPriority()) and the number of frames read
+   ** from a client is limited by the weight of the class
+   ** (setPriorityWeight()). Frames which exceed the budget are read
+   ** during the next cycle, for a TCP connection they remain inside
+   ** the socket. The CAN interface is served like a client of the class
+   ** QCanFrameApi::ePRIORITY_REALTIME. The value 0 removes the limit.
+   */
+   Q_INVOKABLE void setFrameBudget(uint32_t ulFrameMaxV);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable interface thread
+   ** \see        isInterfaceThreadEnabled()
+   **
+   ** This function enables a separate thread for reading the CAN
+   ** interface if \a btEnableV is \c true (QCanInterfaceReader). The
+   ** thread passes the received frames by a lock-free ring to the
+   ** dispatcher, so a slow dispatcher cycle does not delay the
+   ** reception. The thread blocks on the receive event of the CAN
+   ** interface (QCanInterface::waitForFrames()) and falls back to
+   ** polling if the CAN interface has no such event. The CAN interface
+   ** must allow calls of QCanInterface::readBatch() and
+   ** QCanInterface::writeBatch() from different threads. The thread
+   ** is disabled by default.
+   */
+   Q_INVOKABLE void setInterfaceThreadEnabled(bool btEnableV = true);
+
    void setListenOnlyEnabled(bool btEnableV = true);
 
    /*!
@@ -214,10 +645,103 @@ public:
    ** This function enables the dispatching of CAN frames if \a btEnable is
    ** \c true, it is disabled on \c false.
    */
-   void setNetworkEnabled(bool btEnableV = true);
+   Q_INVOKABLE void setNetworkEnabled(bool btEnableV = true);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable shared memory ring
+   ** \see        isSharedRingEnabled()
+   **
+   ** This function enables a shared memory ring (QCanSharedRing) for
+   ** readers on the same host if \a btEnableV is \c true. The dispatcher
+   ** writes each CAN frame and error frame only once to the ring, hence
+   ** the number of readers does not increase the load of the dispatcher.
+   ** The key of the shared memory is equal to localServerName(), a reader
+   ** connects by QCanSocket::setSharedRingReader(). The ring exists as
+   ** long as the network is enabled. The ring is disabled by default.
+   */
+   Q_INVOKABLE void setSharedRingEnabled(bool btEnableV = true);
+
+   /*!
+   ** \param[in]  tePriorityV    Priority class
+   ** \param[in]  ulFrameMaxV    Number of frames per round
+   ** \see        priorityWeight()
+   **
+   ** This function sets the number of frames which are read from a
+   ** client of the priority class \a tePriorityV during one round of
+   ** the dispatcher, refer to setFrameBudget(). The number of deferred
+   ** reads of each class is available by metric().
+   */
+   Q_INVOKABLE void setPriorityWeight(QCanFrameApi::Priority_e tePriorityV,
+                                      uint32_t ulFrameMaxV);
+
+   /*!
+   ** \param[in]  teQueuePolicyV Send queue policy
+   ** \see        queuePolicy()
+   **
+   ** This function defines the behaviour of the network when the send
+   ** queue of a client is full. CAN frames which have already been passed
+   ** to the TCP socket can not be removed, hence the policy
+   ** #eQUEUE_DROP_OLDEST drops the new frame if there is no frame left in
+   ** the send queue of the network.
+   */
+   Q_INVOKABLE void setQueuePolicy(QCanNetwork::QueuePolicy_e teQueuePolicyV);
+
+   /*!
+   ** \param[in]  ulFrameMaxV    Maximum number of CAN frames
+   ** \see        queueSize()
+   **
+   ** This function sets the maximum number of CAN frames which are queued
+   ** for a client. The number includes the frames which are pending for
+   ** transmission inside the TCP socket (QTcpSocket::bytesToWrite()).
+   ** For a client using the compact wire format the limit is evaluated
+   ** in bytes, i.e. \a ulFrameMaxV times #QCAN_FRAME_ARRAY_SIZE.
+   */
+   Q_INVOKABLE void setQueueSize(uint32_t ulFrameMaxV);
 
    bool setServerAddress(QHostAddress clHostAddressV);
 
+   /*!
+   ** \param[in]  ulCreditV      Number of transmit credits
+   ** \see        transmitCredit()
+   **
+   ** CAN frames of the clients are passed to the CAN interface by a
+   ** transmit queue for each client. The queues are served like the
+   ** arbitration on the CAN bus: the pending frame with the highest
+   ** priority (QCanFrame::arbitrationField()) is written first, frames
+   ** of the same client and frames with equal priority keep the order
+   ** of reception. A frame which is not accepted by the CAN interface
+   ** (QCanInterface::eERROR_FIFO_TRM_FULL) stays inside the queue and is
+   ** written again during the next dispatcher cycle, it is forwarded to
+   ** the other clients only after it has been written to the CAN
+   ** interface. Each client gets \a ulCreditV transmit credits upon
+   ** connection, one credit is returned to the client for each of its
+   ** frames leaving the queue (refer to QCanSocket::transmitCredit()).
+   ** The network drops the frames of a client exceeding its credits.
+   ** The value is used for clients connecting after the call.
+   */
+   Q_INVOKABLE void setTransmitCredit(uint32_t ulCreditV);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable transmit confirmation
+   ** \see        isTransmitConfirmEnabled()
+   **
+   ** This function enables the transmit confirmation of a CAN interface
+   ** supporting #QCAN_IF_SUPPORT_TRM_CONFIRM. A frame written to the CAN
+   ** interface is forwarded to the other clients only after the CAN
+   ** interface has confirmed its transmission on the CAN bus, the
+   ** transmit credit is returned to the client at the same time. Hence
+   ** the transmit credits of a client limit the number of its frames in
+   ** flight and the latency histogram #eHISTOGRAM_SOCKET_TO_IF covers
+   ** the time until transmission.
+   ** <p>
+   ** A client requesting confirmations (QCanSocket::setTransmitConfirm())
+   ** gets a copy of each of its frames with QCanFrame::isTransmitConfirm()
+   ** set. The time-stamp of the copy is taken by the CAN interface, it
+   ** is taken from the clock of the network when no CAN interface
+   ** confirms the transmission. The function is disabled by default.
+   */
+   Q_INVOKABLE void setTransmitConfirmEnabled(bool btEnableV = true);
+
 signals:
    /*!
    ** \param[in]  ulFrameTotalV  Total number of frames
@@ -254,6 +778,17 @@ signals:
    void  showLoad(uint8_t ubLoadV, uint32_t ulMsgPerSecV);
 
 private slots:
+   /*!
+   ** This function is called when the CAN interface signals the
+   ** reception of new CAN frames.
+   */
+   void onInterfaceReceive(uint32_t ulFrameCntV);
+
+   /*!
+   ** This function is called upon connection to the local server.
+   */
+   void onLocalConnect(void);
+
    /*!
    ** This function is called upon socket connection.
    */
@@ -264,19 +799,152 @@ private slots:
    */
    void onSocketDisconnect(void);
 
+   /*!
+   ** This function is called when a socket has new data available.
+   */
+   void onSocketReceive(void);
+
    void onTimerEvent(void);
 
+   //----------------------------------------------------------------
+   // copy a histogram inside the thread of the network
+   //
+   void copyHistogram(int32_t slHistIdxV, void * pvdHistogramV);
 
 
 protected:
 
 private:
 
-   QCanData::Type_e  frameType(const QByteArray & clSockDataR);
+   //----------------------------------------------------------------
+   // each connected socket is represented by a client, CAN frames
+   // for the client are collected in a send buffer and written
+   // once per dispatcher cycle, incomplete frames received from
+   // the client are kept in the receive buffer, the queue
+   // statistic is read by other threads; a client is connected
+   // either by TCP, by the local server or by an in-process pipe,
+   // pclSocket points to the socket in use; the priority class
+   // selects the order in which the dispatcher reads the clients;
+   // the transmit credits limit the number of frames of the client
+   // inside the transmit queue, returned credits are sent with the
+   // next write operation; a client requesting transmit confirmation
+   // gets its own frames back; ulSendFrameCnt counts only the CAN and
+   // error frames inside the send buffer, API frames are never dropped
+   //
+   typedef struct QCanClient_s {
+      QIODevice *    pclSocket;
+      QTcpSocket *   pclTcpSock;
+      QLocalSocket * pclLocalSock;
+      QByteArray     clSendBuf;
+      QByteArray     clRecvBuf;
+      uint32_t       ulSendHead;
+      uint32_t       ulSendFrameCnt;
+      QAtomicInteger<quint32> ulQueueCnt;
+      QAtomicInteger<quint32> ulQueueHigh;
+      QAtomicInteger<quint32> ulDropCnt;
+      bool           btOverflow;
+      bool           btCompact;
+      bool           btChecksum;
+      bool           btPending;
+      QCanFrameApi::Priority_e   tePriority;
+      QAtomicInteger<quint32>    ulDeferCnt;
+      uint32_t       ulTrmCredit;
+      uint32_t       ulTrmPending;
+      uint32_t       ulTrmReturn;
+      bool           btTrmConfirm;
+      int64_t        sqRecvTime;
+      QCanFilter     clFilter;
+   } QCanClient_ts;
+
+   //----------------------------------------------------------------
+   // transmit queue for the CAN interface: the frames of each client
+   // are kept in a FIFO, the frame with the highest arbitration
+   // priority of all FIFO heads is written next, which emulates the
+   // arbitration of the clients on the CAN bus; frames with equal
+   // priority are written in the order of reception; the client of
+   // a FIFO is cleared when it disconnects, its frames are still
+   // transmitted
+   //
+   typedef struct QCanTrmFrame_s {
+      QCanFrame         clFrame;
+      QByteArray        clData;
+      bool              btChecksum;
+      uint32_t          ulArbField;
+      uint64_t          uqSequence;
+      int64_t           sqRecvTime;
+   } QCanTrmFrame_ts;
+
+   typedef struct QCanTrmQueue_s {
+      QCanClient_ts *            ptsClient;
+      QVector<QCanTrmFrame_ts>   clFrameList;
+      int32_t                    slHead;
+   } QCanTrmQueue_ts;
+
+   //----------------------------------------------------------------
+   // frame written to a CAN interface, waiting for the transmit
+   // confirmation
+   //
+   typedef struct QCanTrmConfirm_s {
+      QCanClient_ts *   ptsClient;
+      QCanTrmFrame_ts   tsFrame;
+   } QCanTrmConfirm_ts;
+
+   //----------------------------------------------------------------
+   // returns true if the caller runs in the thread of the network
+   //
+   bool  isNetworkThread(void);
+
+   void  addClient(QIODevice * pclSocketV);
+   void  addCycle(int64_t sqStartV, uint32_t ulFrameCntV);
+   void  addLatency(Histogram_e teHistogramV, int64_t sqLatencyV);
+   uint32_t dispatchInterface(uint32_t ulFrameMaxV = 0);
+   uint32_t dispatchInterfaceRing(uint32_t ulFrameMaxV = 0);
+   void     dispatchScheduled(void);
+   uint32_t dispatchSocket(int32_t slSockIdxV, uint32_t ulFrameMaxV = 0);
+   void     dispatchTransmit(void);
+   void     finishTransmit(QCanClient_ts * ptsClientV, 
+                           QCanTrmFrame_ts & tsTrmFrameR, bool btConfirmV);
+   void     releaseConfirm(void);
+   int32_t  returnCredit(QCanClient_ts * ptsClientV);
+   QCanTrmQueue_ts * transmitQueue(QCanClient_ts * ptsClientV);
+   void  flushClients(void);
+   void  queueFrame(QCanClient_ts * ptsClientV, const QByteArray & clSockDataR);
+   void  reclaimClients(void);
+   void  removeClient(int32_t slSockIdxV);
+   void  startInterfaceReader(void);
+   void  startSharedRing(void);
+   void  stopInterfaceReader(void);
+   void  stopSharedRing(void);
+
+   QCanData::Type_e  frameType(const QByteArray & clSockDataR,
+                               int32_t slPosV = 0);
    
    bool  handleApiFrame(int32_t & slSockSrcR, QByteArray & clSockDataR);
-   bool  handleCanFrame(int32_t & slSockSrcR, QByteArray & clSockDataR);
+   bool  handleCanFrame(int32_t & slSockSrcR, 
+                        const QCanFrameView & clFrameViewR);
+   bool  handleChecksum(int32_t & slSockSrcR, QCanFrameApi & clApiFrameR);
+   bool  handleConfirm(int32_t & slSockSrcR, QCanFrameApi & clApiFrameR);
+   bool  handleTrmConfirm(const QCanFrameView & clFrameViewR);
    bool  handleErrFrame(int32_t & slSockSrcR, QByteArray & clSockDataR);
+   bool  handleFilter(int32_t & slSockSrcR, QCanFrameApi & clApiFrameR);
+   bool  handleFormat(int32_t & slSockSrcR, QCanFrameApi & clApiFrameR);
+   bool  handlePriority(int32_t & slSockSrcR, QCanFrameApi & clApiFrameR);
+
+   void  updateStatistic(void);
+
+   //----------------------------------------------------------------
+   // the metric values are only written by the thread of the
+   // network, a read-modify-write operation is not required
+   //
+   inline void metricAdd(Metric_e teMetricV, uint64_t uqValueV)
+   {
+      aqMetricP[teMetricV].store(aqMetricP[teMetricV].load() + uqValueV);
+   };
+
+   inline void metricSet(Metric_e teMetricV, uint64_t uqValueV)
+   {
+      aqMetricP[teMetricV].store(uqValueV);
+   };
 
 
    //----------------------------------------------------------------
@@ -290,17 +958,75 @@ private:
    QString                 clNetNameP;
 
    QPointer<QCanInterface> pclInterfaceP;
+
+   //----------------------------------------------------------------
+   // transmit queues of the clients, number of pending frames and
+   // reception order of the frames
+   //
+   QVector<QCanTrmQueue_ts *> clTrmQueueListP;
+   uint32_t                   ulTrmCountP;
+   uint64_t                   uqTrmSequenceP;
+   uint32_t                   ulTrmCreditP;
+
+   //----------------------------------------------------------------
+   // frames waiting for the transmit confirmation of the CAN
+   // interface, in the order of writing
+   //
+   QList<QCanTrmConfirm_ts>   clTrmConfirmListP;
+   bool                       btTrmConfirmP;
+   bool                       btTrmConfirmEnabledP;
+
    QPointer<QTcpServer>    pclTcpSrvP;
-   QVector<QTcpSocket *> * pclTcpSockListP;
    QHostAddress            clTcpHostAddrP;
    uint16_t                uwTcpPortP;
-   QMutex                  clTcpSockMutexP;
+   QPointer<QLocalServer>  pclLocalSrvP;
+   QString                 clLocalNameP;
+
+   //----------------------------------------------------------------
+   // broadcast ring for local readers, the key of the shared
+   // memory is the name of the local server
+   //
+   QCanSharedRing *        pclSharedRingP;
+   bool                    btSharedRingEnabledP;
+
+   //----------------------------------------------------------------
+   // client list: the thread of the network is the only writer,
+   // a modified copy of the list is published and the previous
+   // list is retired until no other thread reads it anymore
+   //
+   QVector<QCanClient_ts *> *                pclClientListP;
+   QAtomicPointer< QVector<QCanClient_ts *> > apclClientListP;
+   QAtomicInt                                slListReaderP;
+   QVector< QVector<QCanClient_ts *> * >     clRetiredListP;
+   QVector<QCanClient_ts *>                  clRetiredClientP;
+
+   //----------------------------------------------------------------
+   // optional thread reading the CAN interface
+   //
+   QCanInterfaceReader *   pclIfReaderP;
+   bool                    btIfThreadEnabledP;
 
    //----------------------------------------------------------------
    // Frame dispatcher time
    //
-   QTimer                  clDispatchTmrP;
+   QTimer *                pclDispatchTmrP;
    uint32_t                ulDispatchTimeP;
+   DispatchMode_e          teDispatchModeP;
+
+   //----------------------------------------------------------------
+   // frame budget of a dispatcher cycle, number of frames of each
+   // priority class per round and first client of the next round
+   //
+   uint32_t                ulFrameBudgetP;
+   uint32_t                aulPriorityWeightP[QCanFrameApi::ePRIORITY_MAX];
+   int32_t                 slRoundStartP;
+
+   //----------------------------------------------------------------
+   // send queue settings
+   //
+   QueuePolicy_e           teQueuePolicyP;
+   uint32_t                ulQueueSizeP;
+   int32_t                 slCpuAffinityP;
 
    //----------------------------------------------------------------
    // bit-rate settings
@@ -309,17 +1035,26 @@ private:
    int32_t                 slDatBitRateP;
 
    //----------------------------------------------------------------
-   // statistic frame counter
+   // statistic frame counter, socket write operations, queue and
+   // dispatcher values, they can be read without locking the
+   // dispatcher
    //
-   uint32_t                ulCntFrameApiP;
-   uint32_t                ulCntFrameCanP;
-   uint32_t                ulCntFrameErrP;
+   QAtomicInteger<quint64> aqMetricP[eMETRIC_MAX];
 
    //----------------------------------------------------------------
    // statistic bit counter
    //
-   uint32_t                ulCntBitMaxP;
-   uint32_t                ulCntBitCurP;
+   QCanBusLoad             clBusLoadP;
+
+   //----------------------------------------------------------------
+   // dispatcher histograms, the time values are taken from a
+   // monotonic clock, the receive time of each frame read from
+   // the CAN interface is kept until the sockets are flushed
+   //
+   QCanHistogram           aclHistogramP[eHISTOGRAM_MAX];
+   QElapsedTimer           clClockP;
+   QVector<int64_t>        clIfTimeListP;
+   int64_t                 sqIfRecvTimeP;
 
    //----------------------------------------------------------------
    // statistic timing
@@ -335,4 +1070,8 @@ private:
    bool                    btNetworkEnabledP;
 };
 
+Q_DECLARE_METATYPE(QCanNetwork::DispatchMode_e)
+Q_DECLARE_METATYPE(QCanNetwork::QueuePolicy_e)
+Q_DECLARE_METATYPE(QCanFrameApi::Priority_e)
+
 #endif   // QCAN_NETWORK_HPP_
@@ -0,0 +1,274 @@
+//============================================================================//
+// File:          qcan_pipe.cpp                                               //
+// Description:   QCAN classes - In-process pipe                              //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include <QMutexLocker>
+
+#include "qcan_pipe.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanPipe()                                                                 //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanPipe::QCanPipe(QObject * pclParentV)
+   : QIODevice(pclParentV)
+{
+   pclSharedP = QSharedPointer<QCanPipeShared_ts>(new QCanPipeShared_ts);
+   pclSharedP->apclEnd[0]   = this;
+   pclSharedP->apclEnd[1]   = Q_NULLPTR;
+   pclSharedP->abtNotify[0] = false;
+   pclSharedP->abtNotify[1] = false;
+   slEndP = 0;
+
+   //----------------------------------------------------------------
+   // the pipe has no buffer of its own, data is copied directly
+   // between the shared buffers and the caller
+   //
+   QIODevice::open(QIODevice::ReadWrite | QIODevice::Unbuffered);
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanPipe()                                                                //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanPipe::~QCanPipe()
+{
+   close();
+}
+
+
+//----------------------------------------------------------------------------//
+// bytesAvailable()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+qint64 QCanPipe::bytesAvailable() const
+{
+   QMutexLocker   clLockT(&pclSharedP->clMutex);
+
+   return (pclSharedP->aclBuffer[slEndP].size() + QIODevice::bytesAvailable());
+}
+
+
+//----------------------------------------------------------------------------//
+// bytesToWrite()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+qint64 QCanPipe::bytesToWrite() const
+{
+   QMutexLocker   clLockT(&pclSharedP->clMutex);
+
+   return (pclSharedP->aclBuffer[1 - slEndP].size());
+}
+
+
+//----------------------------------------------------------------------------//
+// close()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanPipe::close()
+{
+   QCanPipe *  pclPeerT;
+
+   if(isOpen() == false)
+   {
+      return;
+   }
+   QIODevice::close();
+
+   //----------------------------------------------------------------
+   // the other end is informed inside its own thread, it can not
+   // be destroyed while the mutex is locked
+   //
+   QMutexLocker   clLockT(&pclSharedP->clMutex);
+
+   pclSharedP->apclEnd[slEndP] = Q_NULLPTR;
+   pclSharedP->aclBuffer[slEndP].clear();
+   pclPeerT = pclSharedP->apclEnd[1 - slEndP];
+   if(pclPeerT != Q_NULLPTR)
+   {
+      QMetaObject::invokeMethod(pclPeerT, "onPeerClose", Qt::QueuedConnection);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// connectPeer()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanPipe::connectPeer(QCanPipe * pclPeerV)
+{
+   QSharedPointer<QCanPipeShared_ts>   pclSharedT;
+
+   if((pclPeerV == Q_NULLPTR) || (pclPeerV == this) || (slEndP != 0) ||
+      (isConnected() == true))
+   {
+      return (false);
+   }
+
+   //----------------------------------------------------------------
+   // the shared state of the first end is used by both ends, the
+   // state created by the constructor is released
+   //
+   pclSharedT = pclPeerV->pclSharedP;
+   {
+      QMutexLocker   clLockT(&pclSharedT->clMutex);
+
+      if((pclSharedT->apclEnd[0] != pclPeerV) || 
+         (pclSharedT->apclEnd[1] != Q_NULLPTR))
+      {
+         return (false);
+      }
+      pclSharedT->apclEnd[1] = this;
+   }
+
+   pclSharedP = pclSharedT;
+   slEndP     = 1;
+
+   return (true);
+}
+
+
+//----------------------------------------------------------------------------//
+// isConnected()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanPipe::isConnected(void) const
+{
+   QMutexLocker   clLockT(&pclSharedP->clMutex);
+
+   return ((pclSharedP->apclEnd[0] != Q_NULLPTR) && 
+           (pclSharedP->apclEnd[1] != Q_NULLPTR));
+}
+
+
+//----------------------------------------------------------------------------//
+// onPeerClose()                                                              //
+// the other end has been closed                                              //
+//----------------------------------------------------------------------------//
+void QCanPipe::onPeerClose(void)
+{
+   emit disconnected();
+}
+
+
+//----------------------------------------------------------------------------//
+// onPeerData()                                                               //
+// the other end has written data                                             //
+//----------------------------------------------------------------------------//
+void QCanPipe::onPeerData(void)
+{
+   {
+      QMutexLocker   clLockT(&pclSharedP->clMutex);
+
+      pclSharedP->abtNotify[slEndP] = false;
+   }
+   emit readyRead();
+}
+
+
+//----------------------------------------------------------------------------//
+// readData()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+qint64 QCanPipe::readData(char * pchDataV, qint64 sqMaxSizeV)
+{
+   QMutexLocker   clLockT(&pclSharedP->clMutex);
+   QByteArray &   clBufferT = pclSharedP->aclBuffer[slEndP];
+   qint64         sqSizeT;
+
+   sqSizeT = qMin(sqMaxSizeV, (qint64) clBufferT.size());
+   if(sqSizeT > 0)
+   {
+      memcpy(pchDataV, clBufferT.constData(), sqSizeT);
+
+      //--------------------------------------------------------
+      // resize() keeps the allocated memory of the buffer
+      //
+      if(sqSizeT == clBufferT.size())
+      {
+         clBufferT.resize(0);
+      }
+      else
+      {
+         clBufferT.remove(0, (int) sqSizeT);
+      }
+   }
+
+   return (sqSizeT);
+}
+
+
+//----------------------------------------------------------------------------//
+// writeData()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+qint64 QCanPipe::writeData(const char * pchDataV, qint64 sqSizeV)
+{
+   QMutexLocker   clLockT(&pclSharedP->clMutex);
+   int32_t        slPeerT = 1 - slEndP;
+   QCanPipe *     pclPeerT;
+
+   //----------------------------------------------------------------
+   // data can only be written while the other end is open, like
+   // for a socket that is not connected
+   //
+   pclPeerT = pclSharedP->apclEnd[slPeerT];
+   if(pclPeerT == Q_NULLPTR)
+   {
+      return (-1);
+   }
+
+   pclSharedP->aclBuffer[slPeerT].append(pchDataV, (int) sqSizeV);
+
+   //----------------------------------------------------------------
+   // signal the data only once until the other end has handled
+   // the signal
+   //
+   if(pclSharedP->abtNotify[slPeerT] == false)
+   {
+      pclSharedP->abtNotify[slPeerT] = true;
+      QMetaObject::invokeMethod(pclPeerT, "onPeerData", Qt::QueuedConnection);
+   }
+
+   return (sqSizeV);
+}
@@ -0,0 +1,150 @@
+//============================================================================//
+// File:          qcan_pipe.hpp                                               //
+// Description:   QCAN classes - In-process pipe                              //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_PIPE_HPP_
+#define QCAN_PIPE_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QMutex>
+#include <QSharedPointer>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanPipe
+** \brief   In-process connection between a socket and a network
+** 
+** The QCanPipe class connects a QCanSocket and a QCanNetwork inside the
+** same process without the TCP/IP stack or the kernel. A pipe consists
+** of two ends: the first end is created by the socket, the second end
+** is created by the network and connected by connectPeer(). Data written
+** to one end is appended to the receive buffer of the other end, the
+** buffers are protected by a mutex, so both ends may live in different
+** threads. The signal readyRead() is emitted in the thread of the
+** receiving end, multiple write operations are signalled only once.
+** <p>
+** Since the network treats the pipe like any other socket (QIODevice),
+** the dispatching of frames (echo suppression, filters, send queue and
+** statistic) is identical to a TCP or local connection.
+*/
+class QCanPipe : public QIODevice
+{
+   Q_OBJECT
+
+public:
+
+   /*!
+   ** \param[in]  pclParentV     Pointer to parent
+   **
+   ** Create the first end of a pipe, the end is opened for read and
+   ** write operations. Data can be written as soon as the second end
+   ** has been connected.
+   */
+   QCanPipe(QObject * pclParentV = Q_NULLPTR);
+
+   ~QCanPipe();
+
+   /*!
+   ** \return     Number of bytes available for reading
+   */
+   qint64   bytesAvailable() const Q_DECL_OVERRIDE;
+
+   /*!
+   ** \return     Number of bytes not read by the other end
+   */
+   qint64   bytesToWrite() const Q_DECL_OVERRIDE;
+
+   /*!
+   ** Close this end of the pipe, the other end emits the signal
+   ** disconnected().
+   */
+   void     close() Q_DECL_OVERRIDE;
+
+   /*!
+   ** \param[in]  pclPeerV       First end of the pipe
+   ** \return     \c true if the pipe is connected
+   **
+   ** Connect this object as second end to the first end \a pclPeerV.
+   ** The function fails if one of the ends is closed or already connected.
+   */
+   bool     connectPeer(QCanPipe * pclPeerV);
+
+   /*!
+   ** \return     \c true if both ends are open
+   */
+   bool     isConnected(void) const;
+
+   bool     isSequential() const Q_DECL_OVERRIDE  { return (true); };
+
+signals:
+
+   /*!
+   ** This signal is emitted when the other end of the pipe has been
+   ** closed or destroyed.
+   */
+   void     disconnected(void);
+
+protected:
+
+   qint64   readData(char * pchDataV, qint64 sqMaxSizeV) Q_DECL_OVERRIDE;
+   qint64   writeData(const char * pchDataV, qint64 sqSizeV) Q_DECL_OVERRIDE;
+
+private slots:
+
+   void     onPeerClose(void);
+   void     onPeerData(void);
+
+private:
+
+   //----------------------------------------------------------------
+   // state shared by both ends: index 0 is the first end, index 1
+   // the second end, each end reads from its own buffer
+   //
+   typedef struct QCanPipeShared_s {
+      QMutex      clMutex;
+      QByteArray  aclBuffer[2];
+      QCanPipe *  apclEnd[2];
+      bool        abtNotify[2];
+   } QCanPipeShared_ts;
+
+   QSharedPointer<QCanPipeShared_ts>   pclSharedP;
+   int32_t                             slEndP;
+};
+
+
+#endif   // QCAN_PIPE_HPP_
@@ -70,7 +70,15 @@ private:
 
 };
 
-#define QCanPlugin_iid "net.microcontrol.Qt.qcan.QCanPlugin"
+//-----------------------------------------------------------------------------
+/*!
+** \def     QCanPlugin_iid
+**
+** Interface identifier of a CAN plug-in. The version suffix changes with
+** the binary interface of QCanPlugin and QCanInterface, a plug-in built
+** against an older header is not loaded (qobject_cast() fails).
+*/
+#define QCanPlugin_iid "net.microcontrol.Qt.qcan.QCanPlugin/2.0"
 Q_DECLARE_INTERFACE(QCanPlugin, QCanPlugin_iid)
 
 
@@ -34,6 +34,7 @@
 
 #include <QDebug>
 
+#include "qcan_metric_server.hpp"
 #include "qcan_server.hpp"
 
 
@@ -60,23 +61,54 @@ QCanServer::QCanServer( QObject * pclParentV,
                         uint8_t   ubNetworkNumV)
 {
    QCanNetwork *  pclCanNetT;
+   QThread *      pclThreadT;
 
    //----------------------------------------------------------------
    // set the parent
    //
    this->setParent(pclParentV);
 
+   //----------------------------------------------------------------
+   // default dispatcher settings, equal to QCanNetwork
+   //
+   ulDispatchTimeP = 20;
+   teDispatchModeP = QCanNetwork::eDISPATCH_TIMER;
+
+   //----------------------------------------------------------------
+   // the metrics export is started by setMetricsPort()
+   //
+   pclMetricSrvP = Q_NULLPTR;
+
    //----------------------------------------------------------------
    // create CAN networks
    //
    pclListNetsP = new QVector<QCanNetwork *>;
    pclListNetsP->reserve(ubNetworkNumV);
 
+   pclListThreadP = new QVector<QThread *>;
+   pclListThreadP->reserve(ubNetworkNumV);
+
    for(uint8_t ubNetCntT = 0; ubNetCntT < ubNetworkNumV; ubNetCntT++)
    {
-      pclCanNetT = new QCanNetwork(pclParentV, uwPortStartV + ubNetCntT);
+      //--------------------------------------------------------
+      // a network which is moved to another thread must not
+      // have a parent
+      //
+      pclCanNetT = new QCanNetwork(Q_NULLPTR, uwPortStartV + ubNetCntT);
       pclListNetsP->append(pclCanNetT);
 
+      //--------------------------------------------------------
+      // each network has its own thread, the network is
+      // deleted when the thread has finished
+      //
+      pclThreadT = new QThread(this);
+      pclThreadT->setObjectName(pclCanNetT->name());
+      pclCanNetT->moveToThread(pclThreadT);
+      connect( pclThreadT, SIGNAL(finished()),
+               pclCanNetT, SLOT(deleteLater()));
+      pclListThreadP->append(pclThreadT);
+
+      pclThreadT->start();
    }
 
 }
@@ -88,7 +120,25 @@ QCanServer::QCanServer( QObject * pclParentV,
 //----------------------------------------------------------------------------//
 QCanServer::~QCanServer()
 {
+   QThread *  pclThreadT;
+
+   //----------------------------------------------------------------
+   // the metrics export accesses the networks
+   //
+   delete (pclMetricSrvP);
+
+   //----------------------------------------------------------------
+   // stop all network threads, this will also delete the networks
+   //
+   for(int32_t slThreadCntT = 0; slThreadCntT < pclListThreadP->size(); slThreadCntT++)
+   {
+      pclThreadT = pclListThreadP->at(slThreadCntT);
+      pclThreadT->quit();
+      pclThreadT->wait();
+   }
 
+   delete (pclListThreadP);
+   delete (pclListNetsP);
 }
 
 uint8_t QCanServer::maximumNetwork(void) const
@@ -97,6 +147,20 @@ uint8_t QCanServer::maximumNetwork(void) const
 }
 
 
+//----------------------------------------------------------------------------//
+// metricsPort()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint16_t QCanServer::metricsPort(void) const
+{
+   if(pclMetricSrvP == Q_NULLPTR)
+   {
+      return (0);
+   }
+   return (pclMetricSrvP->port());
+}
+
+
 //----------------------------------------------------------------------------//
 // network()                                                                  //
 //                                                                            //
@@ -148,6 +212,29 @@ void QCanServer::setServerAddress(QHostAddress clHostAddressV)
 }
 
 
+//----------------------------------------------------------------------------//
+// setDispatcherMode()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanServer::setDispatcherMode(QCanNetwork::DispatchMode_e teModeV)
+{
+   QCanNetwork *  pclNetworkT;
+
+   teDispatchModeP = teModeV;
+
+   for(uint8_t ubNetCntT = 0; ubNetCntT < maximumNetwork(); ubNetCntT++)
+   {
+      pclNetworkT = network(ubNetCntT);
+
+      //-------------------------------------------------------------
+      // assign new dispatcher mode
+      //
+      pclNetworkT->setDispatcherMode(teModeV);
+
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // setDispatcherTime()                                                        //
 //                                                                            //
@@ -169,3 +256,24 @@ void QCanServer::setDispatcherTime(uint32_t ulTimeV)
 
    }
 }
+
+
+//----------------------------------------------------------------------------//
+// setMetricsPort()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanServer::setMetricsPort(uint16_t uwPortV)
+{
+   if(uwPortV == 0)
+   {
+      delete (pclMetricSrvP);
+      pclMetricSrvP = Q_NULLPTR;
+      return (true);
+   }
+
+   if(pclMetricSrvP == Q_NULLPTR)
+   {
+      pclMetricSrvP = new QCanMetricServer(this, this);
+   }
+   return (pclMetricSrvP->listen(uwPortV));
+}
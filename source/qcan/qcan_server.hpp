@@ -36,17 +36,28 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 #include <QObject>
+#include <QThread>
 
 #include "qcan_network.hpp"
 
 
+/*----------------------------------------------------------------------------*\
+** Referenced classes                                                         **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+class QCanMetricServer;
+
+
 //-----------------------------------------------------------------------------
 /*!
 ** \class QCanServer
 ** \brief CAN server
 **
 ** This class represents a CAN server, which incorporates up to
-** QCAN_NETWORK_MAX number of CAN networks (QCanNetwork).
+** QCAN_NETWORK_MAX number of CAN networks (QCanNetwork). Each CAN
+** network is running in its own thread, the statistic signals of a
+** network are delivered to the receiver by a queued connection.
 **
 */
 class QCanServer : public QObject
@@ -61,14 +72,35 @@ public:
     ~QCanServer();
 
 
+    QCanNetwork::DispatchMode_e dispatcherMode(void) { return (teDispatchModeP); };
+
     uint32_t      dispatcherTime(void)    { return (ulDispatchTimeP);   };
 
     QCanNetwork * network(uint8_t ubNetworkIdxV);
 
     uint8_t       maximumNetwork(void) const;
 
+    /*!
+    ** \return     Port of the metrics export, 0 if disabled
+    ** \see        setMetricsPort()
+    */
+    uint16_t      metricsPort(void) const;
+
+    void          setDispatcherMode(QCanNetwork::DispatchMode_e teModeV);
+
     void          setDispatcherTime(uint32_t ulTimeV);
 
+    /*!
+    ** \param[in]  uwPortV        Port number, 0 disables the export
+    ** \return     \c true on success
+    ** \see        metricsPort()
+    **
+    ** This function starts the export of the network metrics in
+    ** Prometheus text format on the loopback interface, refer to
+    ** QCanMetricServer. The default port is #QCAN_METRICS_DEFAULT_PORT.
+    */
+    bool          setMetricsPort(uint16_t uwPortV = QCAN_METRICS_DEFAULT_PORT);
+
     QHostAddress  serverAddress(void)     { return (clServerAddressP);  };
 
     void          setServerAddress(QHostAddress clHostAddressV);
@@ -76,8 +108,11 @@ public:
 private:
 
     QVector<QCanNetwork *> *  pclListNetsP;
+    QVector<QThread *> *      pclListThreadP;
     QHostAddress              clServerAddressP;
+    QCanMetricServer *        pclMetricSrvP;
     uint32_t                  ulDispatchTimeP;
+    QCanNetwork::DispatchMode_e teDispatchModeP;
 };
 
 #endif // QCAN_SERVER_HPP_
@@ -0,0 +1,346 @@
+//============================================================================//
+// File:          qcan_shared_ring.cpp                                        //
+// Description:   QCAN classes - Shared memory frame ring                     //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <atomic>
+#include <string.h>
+
+#include "qcan_shared_ring.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Identification of the memory layout, the last byte is the
+// version of the layout
+//
+#define  QCAN_SHARED_RING_MAGIC  ((uint32_t) 0x434E5201)
+
+
+/*----------------------------------------------------------------------------*\
+** Class methods                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+
+//----------------------------------------------------------------------------//
+// QCanSharedRing()                                                           //
+// constructor                                                                //
+//----------------------------------------------------------------------------//
+QCanSharedRing::QCanSharedRing(const QString & clKeyR)
+{
+   clMemoryP.setKey(clKeyR);
+
+   ptsHeaderP = Q_NULLPTR;
+   patsSlotP  = Q_NULLPTR;
+   uqMaskP    = 0;
+   uqCursorP  = 0;
+   uqOverrunP = 0;
+   btWriterP  = false;
+}
+
+
+//----------------------------------------------------------------------------//
+// ~QCanSharedRing()                                                          //
+// destructor                                                                 //
+//----------------------------------------------------------------------------//
+QCanSharedRing::~QCanSharedRing()
+{
+   detach();
+}
+
+
+//----------------------------------------------------------------------------//
+// attach()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSharedRing::attach(void)
+{
+   QCanSharedHeader_ts *   ptsHeaderT;
+
+   if(ptsHeaderP != Q_NULLPTR)
+   {
+      return (false);
+   }
+
+   if(clMemoryP.attach(QSharedMemory::ReadOnly) == false)
+   {
+      return (false);
+   }
+
+   //----------------------------------------------------------------
+   // check the layout before the memory is used
+   //
+   ptsHeaderT = (QCanSharedHeader_ts *) clMemoryP.constData();
+   if((clMemoryP.size() < (int) sizeof(QCanSharedHeader_ts))     ||
+      (ptsHeaderT->ulMagic != QCAN_SHARED_RING_MAGIC)             ||
+      (ptsHeaderT->ulSlotCount == 0)                              ||
+      (clMemoryP.size() < (int) (sizeof(QCanSharedHeader_ts) +
+             ptsHeaderT->ulSlotCount * sizeof(QCanSharedSlot_ts))) )
+   {
+      clMemoryP.detach();
+      return (false);
+   }
+
+   ptsHeaderP = ptsHeaderT;
+   patsSlotP  = (QCanSharedSlot_ts *) (ptsHeaderT + 1);
+   uqMaskP    = ptsHeaderT->ulSlotCount - 1;
+   uqCursorP  = ptsHeaderT->uqHead.loadAcquire();
+   uqOverrunP = 0;
+   btWriterP  = false;
+
+   return (true);
+}
+
+
+//----------------------------------------------------------------------------//
+// available()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t QCanSharedRing::available(void) const
+{
+   uint64_t uqCountT;
+
+   if(ptsHeaderP == Q_NULLPTR)
+   {
+      return (0);
+   }
+
+   uqCountT = ptsHeaderP->uqHead.loadAcquire() - uqCursorP;
+   if(uqCountT > (uqMaskP + 1))
+   {
+      uqCountT = uqMaskP + 1;
+   }
+   return ((uint32_t) uqCountT);
+}
+
+
+//----------------------------------------------------------------------------//
+// create()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSharedRing::create(uint32_t ulSizeV)
+{
+   uint32_t ulCapacityT = 2;
+   int32_t  slBytesT;
+
+   if(ptsHeaderP != Q_NULLPTR)
+   {
+      return (false);
+   }
+
+   while((ulCapacityT < ulSizeV) && (ulCapacityT < 0x00100000UL))
+   {
+      ulCapacityT <<= 1;
+   }
+   slBytesT = (int32_t) (sizeof(QCanSharedHeader_ts) + 
+                         ulCapacityT * sizeof(QCanSharedSlot_ts));
+
+   //----------------------------------------------------------------
+   // on Unix the memory of a crashed writer still exists, it is
+   // released when the last process detaches from it
+   //
+   if(clMemoryP.create(slBytesT) == false)
+   {
+      if(clMemoryP.error() != QSharedMemory::AlreadyExists)
+      {
+         return (false);
+      }
+      if(clMemoryP.attach() == true)
+      {
+         clMemoryP.detach();
+      }
+      if(clMemoryP.create(slBytesT) == false)
+      {
+         return (false);
+      }
+   }
+
+   memset(clMemoryP.data(), 0, slBytesT);
+   ptsHeaderP = (QCanSharedHeader_ts *) clMemoryP.data();
+   patsSlotP  = (QCanSharedSlot_ts *) (ptsHeaderP + 1);
+   uqMaskP    = ulCapacityT - 1;
+   uqCursorP  = 0;
+   uqOverrunP = 0;
+   btWriterP  = true;
+
+   ptsHeaderP->ulSlotCount = ulCapacityT;
+   ptsHeaderP->uqHead.store(0);
+   ptsHeaderP->ulOpen.store(1);
+
+   //----------------------------------------------------------------
+   // a reader accepts the memory as soon as the magic is valid
+   //
+   std::atomic_thread_fence(std::memory_order_release);
+   ptsHeaderP->ulMagic = QCAN_SHARED_RING_MAGIC;
+
+   return (true);
+}
+
+
+//----------------------------------------------------------------------------//
+// detach()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSharedRing::detach(void)
+{
+   if(ptsHeaderP == Q_NULLPTR)
+   {
+      return;
+   }
+
+   if(btWriterP == true)
+   {
+      ptsHeaderP->ulOpen.storeRelease(0);
+   }
+
+   ptsHeaderP = Q_NULLPTR;
+   patsSlotP  = Q_NULLPTR;
+   btWriterP  = false;
+   clMemoryP.detach();
+}
+
+
+//----------------------------------------------------------------------------//
+// isClosed()                                                                 //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSharedRing::isClosed(void) const
+{
+   if(ptsHeaderP == Q_NULLPTR)
+   {
+      return (true);
+   }
+   return (ptsHeaderP->ulOpen.loadAcquire() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// read()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanSharedRing::read(uint8_t * pubBufferV)
+{
+   uint64_t             uqHeadT;
+   uint64_t             uqSequenceT;
+   int32_t              slSizeT;
+   QCanSharedSlot_ts *  ptsSlotT;
+
+   if(ptsHeaderP == Q_NULLPTR)
+   {
+      return (0);
+   }
+
+   while(1)
+   {
+      uqHeadT = ptsHeaderP->uqHead.loadAcquire();
+      if(uqCursorP >= uqHeadT)
+      {
+         return (0);
+      }
+
+      //--------------------------------------------------------
+      // the writer has overwritten frames which have not been
+      // read, continue with the oldest frame of the ring
+      //
+      if((uqHeadT - uqCursorP) > (uqMaskP + 1))
+      {
+         uqOverrunP += (uqHeadT - uqCursorP) - (uqMaskP + 1);
+         uqCursorP   = uqHeadT - (uqMaskP + 1);
+      }
+
+      //--------------------------------------------------------
+      // the sequence number of the slot must be equal before
+      // and after the copy, otherwise the writer has modified
+      // the slot meanwhile
+      //
+      ptsSlotT    = &patsSlotP[uqCursorP & uqMaskP];
+      uqSequenceT = (uqCursorP * 2) + 2;
+      if(ptsSlotT->uqSequence.loadAcquire() == uqSequenceT)
+      {
+         slSizeT = ptsSlotT->slSize;
+         if((slSizeT < 0) || (slSizeT > QCAN_FRAME_ARRAY_SIZE))
+         {
+            slSizeT = 0;
+         }
+         memcpy(pubBufferV, ptsSlotT->aubData, slSizeT);
+
+         std::atomic_thread_fence(std::memory_order_acquire);
+         if((ptsSlotT->uqSequence.load() == uqSequenceT) && (slSizeT > 0))
+         {
+            uqCursorP++;
+            return (slSizeT);
+         }
+      }
+
+      uqOverrunP++;
+      uqCursorP++;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// write()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSharedRing::write(const uint8_t * pubDataV, int32_t slSizeV)
+{
+   uint64_t             uqHeadT;
+   QCanSharedSlot_ts *  ptsSlotT;
+
+   if((btWriterP == false) || (slSizeV <= 0) || 
+      (slSizeV > QCAN_FRAME_ARRAY_SIZE))
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // mark the slot as modified, the ordered operation makes sure
+   // that the mark is visible before the data is changed
+   //
+   uqHeadT  = ptsHeaderP->uqHead.load();
+   ptsSlotT = &patsSlotP[uqHeadT & uqMaskP];
+   ptsSlotT->uqSequence.fetchAndStoreOrdered((uqHeadT * 2) + 1);
+
+   memcpy(ptsSlotT->aubData, pubDataV, slSizeV);
+   ptsSlotT->slSize = slSizeV;
+
+   //----------------------------------------------------------------
+   // publish the slot and the frame
+   //
+   ptsSlotT->uqSequence.storeRelease((uqHeadT * 2) + 2);
+   ptsHeaderP->uqHead.storeRelease(uqHeadT + 1);
+}
@@ -0,0 +1,197 @@
+//============================================================================//
+// File:          qcan_shared_ring.hpp                                        //
+// Description:   QCAN classes - Shared memory frame ring                     //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef QCAN_SHARED_RING_HPP_
+#define QCAN_SHARED_RING_HPP_
+
+
+/*----------------------------------------------------------------------------*\
+** Include files                                                              **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+#include <stdint.h>
+
+#include <QAtomicInteger>
+#include <QSharedMemory>
+#include <QString>
+
+#include "qcan_data.hpp"
+
+
+/*----------------------------------------------------------------------------*\
+** Definitions                                                                **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+
+//-------------------------------------------------------------------
+// Default number of slots, the value must be a power of two
+//
+#define  QCAN_SHARED_RING_SIZE      65536
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   QCanSharedRing
+** \brief   Shared memory broadcast ring of frames
+** 
+** The QCanSharedRing class passes frames from one writer process (the
+** dispatcher of a QCanNetwork) to any number of reader processes on the
+** same host. The writer stores each frame only once, hence the cost of
+** the fan-out does not depend on the number of readers. The frames are
+** stored in fixed format (#QCAN_FRAME_ARRAY_SIZE bytes) without a valid
+** checksum.
+** <p>
+** Every frame gets a sequence number. Each slot carries the sequence
+** number of its frame, which is odd while the writer modifies the
+** slot (sequence lock). A reader keeps its own cursor and never blocks
+** the writer: if the writer has overwritten frames that were not read
+** yet, the reader continues with the oldest frame available and counts
+** the lost frames (overrunCount()).
+*/
+class QCanSharedRing
+{
+public:
+
+   /*!
+   ** \param[in]  clKeyR         Key of the shared memory
+   **
+   ** Create a ring object for the shared memory \a clKeyR. The memory
+   ** is created by create() or attached by attach().
+   */
+   QCanSharedRing(const QString & clKeyR);
+
+   ~QCanSharedRing();
+
+   /*!
+   ** \return     \c true if the ring is attached
+   ** \see        create()
+   **
+   ** Reader: attach to an existing ring in read-only mode. The cursor
+   ** of the reader starts with the next frame written.
+   */
+   bool        attach(void);
+
+   /*!
+   ** \return     Number of frames that can be read
+   */
+   uint32_t    available(void) const;
+
+   /*!
+   ** \param[in]  ulSizeV        Number of slots
+   ** \return     \c true if the ring is created
+   ** \see        attach()
+   **
+   ** Writer: create the shared memory with \a ulSizeV slots, the value is
+   ** rounded up to the next power of two. A shared memory left by a
+   ** crashed writer is released before.
+   */
+   bool        create(uint32_t ulSizeV = QCAN_SHARED_RING_SIZE);
+
+   /*!
+   ** Release the shared memory. For the writer the ring is marked as
+   ** closed before, so readers can detect the end of the ring.
+   */
+   void        detach(void);
+
+   /*!
+   ** \return     \c true if the ring is attached or created
+   */
+   bool        isAttached(void) const  { return (ptsHeaderP != Q_NULLPTR); };
+
+   /*!
+   ** \return     \c true if the writer has closed the ring
+   */
+   bool        isClosed(void) const;
+
+   /*!
+   ** \return     Name of the shared memory
+   */
+   QString     key(void) const            { return (clMemoryP.key());     };
+
+   /*!
+   ** \return     Number of frames lost by the reader
+   */
+   uint64_t    overrunCount(void) const   { return (uqOverrunP);          };
+
+   /*!
+   ** \param[out] pubBufferV     Buffer of #QCAN_FRAME_ARRAY_SIZE bytes
+   ** \return     Number of bytes copied, 0 if no frame is available
+   **
+   ** Reader: copy the next frame of the ring to \a pubBufferV.
+   */
+   int32_t     read(uint8_t * pubBufferV);
+
+   /*!
+   ** \param[in]  pubDataV       Frame data in fixed format
+   ** \param[in]  slSizeV        Number of bytes
+   **
+   ** Writer: add a frame to the ring, the oldest frame is overwritten.
+   */
+   void        write(const uint8_t * pubDataV, int32_t slSizeV);
+
+private:
+
+   //----------------------------------------------------------------
+   // layout of the shared memory: one header, followed by the slots,
+   // both are aligned to a cache line
+   //
+   typedef struct QCanSharedHeader_s {
+      uint32_t                ulMagic;
+      uint32_t                ulSlotCount;
+      QAtomicInteger<quint32> ulOpen;
+      uint32_t                ulReserved;
+      QAtomicInteger<quint64> uqHead;
+      uint8_t                 aubPad[40];
+   } QCanSharedHeader_ts;
+
+   typedef struct QCanSharedSlot_s {
+      QAtomicInteger<quint64> uqSequence;
+      int32_t                 slSize;
+      uint8_t                 aubData[QCAN_FRAME_ARRAY_SIZE];
+      uint8_t                 aubPad[20];
+   } QCanSharedSlot_ts;
+
+   //----------------------------------------------------------------
+   // the ring can not be copied
+   //
+   QCanSharedRing(const QCanSharedRing &);
+   QCanSharedRing & operator=(const QCanSharedRing &);
+
+   QSharedMemory           clMemoryP;
+   QCanSharedHeader_ts *   ptsHeaderP;
+   QCanSharedSlot_ts *     patsSlotP;
+   uint64_t                uqMaskP;
+   uint64_t                uqCursorP;
+   uint64_t                uqOverrunP;
+   bool                    btWriterP;
+};
+
+
+#endif   // QCAN_SHARED_RING_HPP_
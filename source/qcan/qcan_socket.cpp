@@ -32,11 +32,15 @@
 **                                                                            **
 \*----------------------------------------------------------------------------*/
 
+#include "qcan_network.hpp"
+#include "qcan_pipe.hpp"
+#include "qcan_shared_ring.hpp"
 #include "qcan_socket.hpp"
 
 
 #include <QDebug>
 #include <QNetworkInterface>
+#include <QTimer>
 
 /*----------------------------------------------------------------------------*\
 ** Definitions                                                                **
@@ -63,10 +67,42 @@ QCanSocket::QCanSocket(QObject * pclParentV)
    }
 
    //----------------------------------------------------------------
-   // create new TCP socket which is not connected yet
+   // create new TCP socket and local socket which are not
+   // connected yet, TCP is used by default
    //
-   pclTcpSockP = new QTcpSocket(this);
+   pclTcpSockP    = new QTcpSocket(this);
+   pclLocalSockP  = new QLocalSocket(this);
+   pclSockP       = pclTcpSockP;
+   btLocalP       = false;
+   btPipeP        = false;
    btIsConnectedP = false;
+   btCompactP     = false;
+   btChecksumRcvP = true;
+   btChecksumTrmP = true;
+   slTrmCreditP   = 0;
+   btTrmCreditP   = false;
+   btCreditRcvP   = false;
+   slRecvHeadP    = 0;
+   slRecvTailP    = 0;
+   slRecvCntP     = 0;
+
+   //----------------------------------------------------------------
+   // the shared memory ring is attached by connectNetwork()
+   //
+   pclSharedRingP = Q_NULLPTR;
+   btSharedP      = false;
+   pclRingTmrP    = new QTimer(this);
+   connect( pclRingTmrP, SIGNAL(timeout()),
+            this, SLOT(onRingTimer()));
+
+   //----------------------------------------------------------------
+   // each frame is written immediately by default
+   //
+   ulSendCntP        = 0;
+   ulFlushThresholdP = 1;
+   btCorkP           = false;
+   btFlushPendingP   = false;
+   btNoDelayP        = false;
 
    //----------------------------------------------------------------
    // set default values for host address and port
@@ -88,13 +124,71 @@ QCanSocket::QCanSocket(QObject * pclParentV)
 
    connect( pclTcpSockP, SIGNAL(readyRead()),
             this, SLOT(onSocketReceive()));
+
+   //----------------------------------------------------------------
+   // make signal / slot connection for local socket
+   //
+   connect( pclLocalSockP, SIGNAL(connected()),
+            this, SLOT(onSocketConnect()));
+
+   connect( pclLocalSockP, SIGNAL(disconnected()),
+            this, SLOT(onSocketDisconnect()));
+
+   connect( pclLocalSockP, SIGNAL(error(QLocalSocket::LocalSocketError)),
+            this, SLOT(onLocalError(QLocalSocket::LocalSocketError)));
+
+   connect( pclLocalSockP, SIGNAL(readyRead()),
+            this, SLOT(onSocketReceive()));
 }
 
 
 QCanSocket::~QCanSocket()
 {
    delete(pclTcpSockP);
+   delete(pclLocalSockP);
+   delete(pclPipeP);
+   delete(pclSharedRingP);
+}
+
 
+//----------------------------------------------------------------------------//
+// addFilterMask()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::addFilterMask(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                               bool btExtendedV)
+{
+   QCanFrameApi   clApiFrameT;
+
+   clApiFrameT.setFilterMask(ulIdentifierV, ulMaskV, btExtendedV);
+   return (writeFrame(clApiFrameT));
+}
+
+
+//----------------------------------------------------------------------------//
+// addFilterRange()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::addFilterRange(uint32_t ulIdStartV, uint32_t ulIdStopV,
+                                bool btExtendedV)
+{
+   QCanFrameApi   clApiFrameT;
+
+   clApiFrameT.setFilterRange(ulIdStartV, ulIdStopV, btExtendedV);
+   return (writeFrame(clApiFrameT));
+}
+
+
+//----------------------------------------------------------------------------//
+// clearFilter()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::clearFilter(void)
+{
+   QCanFrameApi   clApiFrameT;
+
+   clApiFrameT.setFilterClear();
+   return (writeFrame(clApiFrameT));
 }
 
 
@@ -114,7 +208,43 @@ bool QCanSocket::connectNetwork(CAN_Channel_e ubChannelV)
       qDebug() << "QCanSocket::connectNetwork() " << ubChannelV;
 
       pclTcpSockP->abort();
-      pclTcpSockP->connectToHost(clTcpHostAddrP, uwTcpPortP + ubChannelV - 1);
+      pclLocalSockP->abort();
+      clearBuffers();
+      btPipeP = false;
+
+      //--------------------------------------------------------
+      // the shared memory ring is named like the local server,
+      // frames are stored without checksum
+      //
+      if(btSharedP == true)
+      {
+         pclSharedRingP = new QCanSharedRing(QString(QCAN_LOCAL_SOCKET_NAME) +
+                                             QString::number(uwTcpPortP +
+                                                             ubChannelV - 1));
+         if(pclSharedRingP->attach() == false)
+         {
+            delete(pclSharedRingP);
+            pclSharedRingP = Q_NULLPTR;
+            slSocketErrorP = QAbstractSocket::HostNotFoundError;
+            return (false);
+         }
+         btChecksumRcvP = false;
+         pclRingTmrP->start(1);
+         QTimer::singleShot(0, this, SLOT(onSocketConnect()));
+      }
+      else if(btLocalP == true)
+      {
+         pclSockP = pclLocalSockP;
+         pclLocalSockP->connectToServer(QString(QCAN_LOCAL_SOCKET_NAME) +
+                                        QString::number(uwTcpPortP + 
+                                                        ubChannelV - 1));
+      }
+      else
+      {
+         pclSockP = pclTcpSockP;
+         pclTcpSockP->connectToHost(clTcpHostAddrP, 
+                                    uwTcpPortP + ubChannelV - 1);
+      }
       btResultT = true;
    }
 
@@ -122,6 +252,101 @@ bool QCanSocket::connectNetwork(CAN_Channel_e ubChannelV)
 }
 
 
+//----------------------------------------------------------------------------//
+// clearBuffers()                                                             //
+// reset the receive and send buffer for a new connection                     //
+//----------------------------------------------------------------------------//
+void QCanSocket::clearBuffers(void)
+{
+   clRecvBufP.clear();
+   slRecvHeadP = 0;
+   slRecvTailP = 0;
+   slRecvCntP  = 0;
+   clSendBufP.clear();
+   ulSendCntP  = 0;
+   btCompactP = false;
+   btChecksumRcvP = true;
+   btChecksumTrmP = true;
+   slTrmCreditP   = 0;
+   btTrmCreditP   = false;
+   btCreditRcvP   = false;
+}
+
+
+//----------------------------------------------------------------------------//
+// closeSharedRing()                                                          //
+// stop reading the shared memory ring                                        //
+//----------------------------------------------------------------------------//
+void QCanSocket::closeSharedRing(void)
+{
+   pclRingTmrP->stop();
+   delete(pclSharedRingP);
+   pclSharedRingP = Q_NULLPTR;
+   onSocketDisconnect();
+}
+
+
+//----------------------------------------------------------------------------//
+// connectNetwork()                                                           //
+// connect by an in-process pipe                                              //
+//----------------------------------------------------------------------------//
+bool QCanSocket::connectNetwork(QCanNetwork * pclNetworkV)
+{
+   bool btResultT = false;
+
+   if((btIsConnectedP == false) && (pclNetworkV != Q_NULLPTR))
+   {
+      pclTcpSockP->abort();
+      pclLocalSockP->abort();
+      clearBuffers();
+
+      //--------------------------------------------------------
+      // a pipe can not be connected twice, so a new one is
+      // created for each connection
+      //
+      delete(pclPipeP);
+      pclPipeP = new QCanPipe(this);
+
+      connect( pclPipeP, SIGNAL(disconnected()),
+               this, SLOT(onSocketDisconnect()));
+
+      connect( pclPipeP, SIGNAL(readyRead()),
+               this, SLOT(onSocketReceive()));
+
+      //--------------------------------------------------------
+      // the method is called by name, so an application using
+      // the socket does not have to link the network
+      //
+      QMetaObject::invokeMethod(pclNetworkV, "connectPipe",
+                                Qt::DirectConnection,
+                                Q_RETURN_ARG(bool, btResultT),
+                                Q_ARG(QCanPipe *, pclPipeP.data()));
+      if(btResultT == true)
+      {
+         pclSockP = pclPipeP;
+         btPipeP  = true;
+         QTimer::singleShot(0, this, SLOT(onSocketConnect()));
+      }
+      else
+      {
+         delete(pclPipeP);
+      }
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// cork()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::cork(void)
+{
+   btCorkP = true;
+}
+
+
 //----------------------------------------------------------------------------//
 // disconnectNetwork()                                                        //
 //                                                                            //
@@ -129,7 +354,30 @@ bool QCanSocket::connectNetwork(CAN_Channel_e ubChannelV)
 void QCanSocket::disconnectNetwork(void)
 {
    qDebug() << "QCanSocket::disconnectNetwork() ";
-   pclTcpSockP->disconnectFromHost();
+   flush();
+   if(btPipeP == true)
+   {
+      if((pclPipeP.isNull() == false) && (pclPipeP->isOpen() == true))
+      {
+         pclPipeP->close();
+         onSocketDisconnect();
+      }
+   }
+   else if(btSharedP == true)
+   {
+      if(pclSharedRingP != Q_NULLPTR)
+      {
+         closeSharedRing();
+      }
+   }
+   else if(btLocalP == true)
+   {
+      pclLocalSockP->disconnectFromServer();
+   }
+   else
+   {
+      pclTcpSockP->disconnectFromHost();
+   }
 }
 
 
@@ -149,7 +397,45 @@ QAbstractSocket::SocketError QCanSocket::error() const
 //----------------------------------------------------------------------------//
 QString QCanSocket::errorString() const
 {
-   return(pclTcpSockP->errorString());
+   return(pclSockP->errorString());
+}
+
+
+//----------------------------------------------------------------------------//
+// flush()                                                                    //
+// write the send buffer to the network                                       //
+//----------------------------------------------------------------------------//
+bool QCanSocket::flush(void)
+{
+   bool  btResultT = true;
+
+   if(clSendBufP.size() > 0)
+   {
+      btResultT = false;
+      if((btIsConnectedP == true) && (btSharedP == false))
+      {
+         if(pclSockP->write(clSendBufP) == clSendBufP.size())
+         {
+            if(pclSockP == pclLocalSockP.data())
+            {
+               pclLocalSockP->flush();
+            }
+            else if(pclSockP == pclTcpSockP.data())
+            {
+               pclTcpSockP->flush();
+            }
+            btResultT = true;
+         }
+      }
+
+      //--------------------------------------------------------
+      // resize() keeps the allocated memory of the buffer
+      //
+      clSendBufP.resize(0);
+      ulSendCntP = 0;
+   }
+
+   return(btResultT);
 }
 
 
@@ -159,11 +445,8 @@ QString QCanSocket::errorString() const
 //----------------------------------------------------------------------------//
 int32_t QCanSocket::framesAvailable(void) const
 {
-   uint32_t    ulFrameCountT;
-
-
-   ulFrameCountT = pclTcpSockP->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE;
-   return(ulFrameCountT);
+   receiveFrames();
+   return(slRecvCntP);
 }
 
 
@@ -177,6 +460,46 @@ bool QCanSocket::isConnected(void)
 }
 
 
+//----------------------------------------------------------------------------//
+// onFlushTimer()                                                             //
+// write frames below the flush threshold                                     //
+//----------------------------------------------------------------------------//
+void QCanSocket::onFlushTimer(void)
+{
+   btFlushPendingP = false;
+   if(btCorkP == false)
+   {
+      flush();
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// onRingTimer()                                                              //
+// poll the shared memory ring                                                //
+//----------------------------------------------------------------------------//
+void QCanSocket::onRingTimer(void)
+{
+   if(pclSharedRingP == Q_NULLPTR)
+   {
+      return;
+   }
+
+   //----------------------------------------------------------------
+   // frames written before the network has closed the ring are
+   // read before the socket is disconnected
+   //
+   if(pclSharedRingP->available() > 0)
+   {
+      onSocketReceive();
+   }
+   else if(pclSharedRingP->isClosed() == true)
+   {
+      closeSharedRing();
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // onSocketConnect()                                                          //
 //                                                                            //
@@ -190,6 +513,11 @@ void QCanSocket::onSocketConnect(void)
    // variable
    //
    btIsConnectedP = true;
+   if((btNoDelayP == true) && (pclSockP == pclTcpSockP.data()) && 
+      (btSharedP == false))
+   {
+      pclTcpSockP->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+   }
    emit connected();
 }
 
@@ -226,7 +554,14 @@ void QCanSocket::onSocketError(QAbstractSocket::SocketError teSocketErrorV)
       //
       case QAbstractSocket::RemoteHostClosedError:
       case QAbstractSocket::NetworkError:
-         pclTcpSockP->abort();
+         if(btLocalP == true)
+         {
+            pclLocalSockP->abort();
+         }
+         else
+         {
+            pclTcpSockP->abort();
+         }
          btIsConnectedP = false;
          emit disconnected();
          break;
@@ -245,26 +580,137 @@ void QCanSocket::onSocketError(QAbstractSocket::SocketError teSocketErrorV)
 }
 
 
+//----------------------------------------------------------------------------//
+// onLocalError()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::onLocalError(QLocalSocket::LocalSocketError teSocketErrorV)
+{
+   //----------------------------------------------------------------
+   // the values of QLocalSocket::LocalSocketError are equal to the
+   // values of QAbstractSocket::SocketError
+   //
+   onSocketError((QAbstractSocket::SocketError) teSocketErrorV);
+}
+
+
 //----------------------------------------------------------------------------//
 // onSocketReceive()                                                          //
 //                                                                            //
 //----------------------------------------------------------------------------//
 void QCanSocket::onSocketReceive(void)
 {
-   uint32_t    ulFrameCountT;
+   receiveFrames();
+   if(btCreditRcvP == true)
+   {
+      btCreditRcvP = false;
+      if(slTrmCreditP > 0)
+      {
+         emit creditReceived((uint32_t) slTrmCreditP);
+      }
+   }
+   if(slRecvCntP > 0)
+   {
+      framesReceived(slRecvCntP);
+   }
+}
+
+//----------------------------------------------------------------------------//
+// nextFrame()                                                                //
+// take the next frame from the receive buffer                                //
+//----------------------------------------------------------------------------//
+bool QCanSocket::nextFrame(int32_t & slPosR, int32_t & slSizeR)
+{
+   bool  btResultT = false;
+
+   if(slRecvCntP > 0)
+   {
+      slPosR  = slRecvHeadP;
+      slSizeR = QCanData::arraySize(clRecvBufP, slRecvHeadP);
+      slRecvHeadP += slSizeR;
+      slRecvCntP--;
+      btResultT = true;
+   }
+
+   return (btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// overrunCount()                                                             //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint64_t QCanSocket::overrunCount(void) const
+{
+   if(pclSharedRingP == Q_NULLPTR)
+   {
+      return (0);
+   }
+   return (pclSharedRingP->overrunCount());
+}
 
-   ulFrameCountT = pclTcpSockP->bytesAvailable() / QCAN_FRAME_ARRAY_SIZE;
-   framesReceived(ulFrameCountT);
+
+//----------------------------------------------------------------------------//
+// queueData()                                                                //
+// append a frame to the send buffer                                          //
+//----------------------------------------------------------------------------//
+bool QCanSocket::queueData(const QByteArray & clFrameDataR)
+{
+   bool  btResultT = true;
+
+   clSendBufP.append(clFrameDataR);
+   ulSendCntP++;
+
+   if(btCorkP == false)
+   {
+      if(ulSendCntP >= ulFlushThresholdP)
+      {
+         btResultT = flush();
+      }
+      else if(btFlushPendingP == false)
+      {
+         //---------------------------------------------------
+         // make sure the frames are not held back longer
+         // than one cycle of the event loop
+         //
+         btFlushPendingP = true;
+         QTimer::singleShot(0, this, SLOT(onFlushTimer()));
+      }
+   }
+
+   return(btResultT);
 }
 
+
+//----------------------------------------------------------------------------//
+// read()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
 bool QCanSocket::read(QByteArray & clFrameDataR, 
                       QCanData::Type_e * pubFrameTypeV)
 {
-   bool  btResultT = false;
+   bool     btResultT = false;
+   int32_t  slPosT;
+   int32_t  slSizeT;
 
-   if(framesAvailable() > 0)
+   receiveFrames();
+   if(nextFrame(slPosT, slSizeT) == true)
    {
-      clFrameDataR = pclTcpSockP->read(QCAN_FRAME_ARRAY_SIZE);
+      clFrameDataR = QCanData::convertToFixed(clRecvBufP.mid(slPosT, slSizeT));
+
+      //--------------------------------------------------------
+      // the caller decodes the byte array with checksum test,
+      // so a CAN frame in fixed format received without checksum
+      // gets one here
+      //
+      if((btChecksumRcvP == false) && ((clRecvBufP.at(slPosT) & 0xE0) == 0x00))
+      {
+         uint16_t uwChecksumT = QCanData::checksum(
+                                    (const uint8_t *) clFrameDataR.constData(),
+                                    QCAN_FRAME_ARRAY_SIZE - 2);
+         clFrameDataR[94] = (char) (uwChecksumT >> 8);
+         clFrameDataR[95] = (char) (uwChecksumT >> 0);
+      }
       if (pubFrameTypeV != Q_NULLPTR)
       {
          switch(clFrameDataR.at(0) & 0xE0)
@@ -293,24 +739,272 @@ bool QCanSocket::read(QByteArray & clFrameDataR,
    
 }
 
+
+//----------------------------------------------------------------------------//
+// receiveFrames()                                                            //
+// read all data from the TCP socket and count the complete frames            //
+//----------------------------------------------------------------------------//
+void QCanSocket::receiveFrames(void) const
+{
+   int32_t                    slSizeT;
+   QByteArray                 clFrameDataT;
+   QCanFrameApi               clApiFrameT;
+   QCanFrameApi::WireFormat_e teFormatT;
+   bool                       btChecksumT;
+   int32_t                    slPosT;
+   uint32_t                   ulFrameCntT;
+   uint32_t                   ulCreditT;
+   bool                       btControlT;
+
+   if(pclSharedRingP != Q_NULLPTR)
+   {
+      //--------------------------------------------------------
+      // copy the frames of the shared memory ring directly into
+      // the receive buffer, the ring does not hold API frames
+      //
+      ulFrameCntT = pclSharedRingP->available();
+      if(ulFrameCntT > 0)
+      {
+         if(slRecvHeadP > 0)
+         {
+            clRecvBufP.remove(0, slRecvHeadP);
+            slRecvTailP -= slRecvHeadP;
+            slRecvHeadP  = 0;
+         }
+         slPosT = clRecvBufP.size();
+         clRecvBufP.resize(slPosT + (ulFrameCntT * QCAN_FRAME_ARRAY_SIZE));
+         while(ulFrameCntT > 0)
+         {
+            slSizeT = pclSharedRingP->read((uint8_t *) clRecvBufP.data() +
+                                           slPosT);
+            if(slSizeT == 0)
+            {
+               break;
+            }
+            slPosT += slSizeT;
+            ulFrameCntT--;
+         }
+         clRecvBufP.resize(slPosT);
+      }
+   }
+   else if(pclSockP->bytesAvailable() > 0)
+   {
+      //--------------------------------------------------------
+      // remove the frames that have already been read, then
+      // append everything available in one bulk read
+      //
+      if(slRecvHeadP > 0)
+      {
+         clRecvBufP.remove(0, slRecvHeadP);
+         slRecvTailP -= slRecvHeadP;
+         slRecvHeadP  = 0;
+      }
+      clRecvBufP.append(pclSockP->readAll());
+   }
+
+   while(slRecvTailP < clRecvBufP.size())
+   {
+      slSizeT = QCanData::arraySize(clRecvBufP, slRecvTailP);
+      if((slSizeT == 0) || ((clRecvBufP.size() - slRecvTailP) < slSizeT))
+      {
+         break;
+      }
+
+      //--------------------------------------------------------
+      // the network confirms the wire format and the checksum
+      // mode and grants transmit credits by an API frame, these
+      // frames are consumed by the socket and never counted
+      //
+      btControlT = false;
+      if((clRecvBufP.at(slRecvTailP) & 0xE0) == 0x40)
+      {
+         clFrameDataT = QByteArray::fromRawData(clRecvBufP.constData() +
+                                                slRecvTailP, slSizeT);
+         if(clApiFrameT.fromByteArray(clFrameDataT) == true)
+         {
+            if(clApiFrameT.wireFormat(teFormatT) == true)
+            {
+               btCompactP = (teFormatT == QCanFrameApi::eWIRE_FORMAT_COMPACT);
+               btControlT = true;
+            }
+            if(clApiFrameT.checksum(btChecksumT) == true)
+            {
+               btChecksumRcvP = btChecksumT;
+               btChecksumTrmP = btChecksumT;
+               btControlT     = true;
+            }
+            if(clApiFrameT.credit(ulCreditT) == true)
+            {
+               slTrmCreditP += (int32_t) ulCreditT;
+               btTrmCreditP  = true;
+               btCreditRcvP  = true;
+               btControlT    = true;
+            }
+         }
+      }
+
+      if(btControlT == true)
+      {
+         clRecvBufP.remove(slRecvTailP, slSizeT);
+         continue;
+      }
+      slRecvTailP += slSizeT;
+      slRecvCntP++;
+   }
+}
+
+
 //----------------------------------------------------------------------------//
 // readFrame()                                                                //
 //                                                                            //
 //----------------------------------------------------------------------------//
 bool QCanSocket::readFrame(QCanFrame & clFrameR)
 {
-   bool  btResultT = false;
-   QByteArray  clDatagramT;
+   bool     btResultT = false;
+   int32_t  slPosT;
+   int32_t  slSizeT;
 
-   if(framesAvailable() > 0)
+   receiveFrames();
+   if(nextFrame(slPosT, slSizeT) == true)
    {
-      clDatagramT = pclTcpSockP->read(QCAN_FRAME_ARRAY_SIZE);
-      btResultT = clFrameR.fromByteArray(clDatagramT);
+      btResultT = clFrameR.fromBuffer((const uint8_t *) clRecvBufP.constData() +
+                                   slPosT, slSizeT, btChecksumRcvP);
    }
    return(btResultT);
 }
 
 
+//----------------------------------------------------------------------------//
+// readFrameView()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::readFrameView(QCanFrameView & clFrameViewR)
+{
+   bool     btResultT = false;
+   int32_t  slPosT;
+   int32_t  slSizeT;
+
+   receiveFrames();
+   if(nextFrame(slPosT, slSizeT) == true)
+   {
+      clFrameViewR.setBuffer((const uint8_t *) clRecvBufP.constData() + slPosT,
+                             slSizeT);
+      btResultT = clFrameViewR.isValid();
+   }
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// readFrames()                                                               //
+// read all available frames in one pass                                      //
+//----------------------------------------------------------------------------//
+int32_t QCanSocket::readFrames(QVector<QCanFrame> & clFrameListR,
+                               QVector<QCanFrameError> * pclErrorListV,
+                               QVector<QCanFrameApi> * pclApiListV)
+{
+   int32_t        slFrameCntT = 0;
+   int32_t        slPosT;
+   int32_t        slSizeT;
+   const uint8_t * pubDataT;
+   QByteArray     clFrameDataT;
+   QCanFrame      clCanFrameT;
+   QCanFrameError clErrFrameT;
+   QCanFrameApi   clApiFrameT;
+
+   receiveFrames();
+   clFrameListR.reserve(clFrameListR.size() + slRecvCntP);
+
+   while(nextFrame(slPosT, slSizeT) == true)
+   {
+      //--------------------------------------------------------
+      // decode directly from the receive buffer, CAN frames
+      // are the common case and are decoded by fromBuffer(),
+      // fromRawData() does not copy the data for the others
+      //
+      pubDataT = (const uint8_t *) clRecvBufP.constData() + slPosT;
+      switch(pubDataT[0] & 0xC0)
+      {
+         case 0x00:
+            if(clCanFrameT.fromBuffer(pubDataT, slSizeT, 
+                                      btChecksumRcvP) == true)
+            {
+               clFrameListR.append(clCanFrameT);
+               slFrameCntT++;
+            }
+            break;
+
+         case 0x40:
+            if(pclApiListV != Q_NULLPTR)
+            {
+               clFrameDataT = QByteArray::fromRawData((const char *) pubDataT,
+                                                      slSizeT);
+               if(clApiFrameT.fromByteArray(clFrameDataT) == true)
+               {
+                  pclApiListV->append(clApiFrameT);
+                  slFrameCntT++;
+               }
+            }
+            break;
+
+         case 0x80:
+            if(pclErrorListV != Q_NULLPTR)
+            {
+               clFrameDataT = QByteArray::fromRawData((const char *) pubDataT,
+                                                      slSizeT);
+               if(clErrFrameT.fromByteArray(clFrameDataT) == true)
+               {
+                  pclErrorListV->append(clErrFrameT);
+                  slFrameCntT++;
+               }
+            }
+            break;
+
+         default:
+
+            break;
+      }
+   }
+
+   return (slFrameCntT);
+}
+
+
+//----------------------------------------------------------------------------//
+// setChecksum()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::setChecksum(bool btEnableV)
+{
+   QCanFrameApi   clApiFrameT;
+
+   //----------------------------------------------------------------
+   // the network verifies the checksum right after the request,
+   // so it has to be calculated from now on
+   //
+   if(btEnableV == true)
+   {
+      btChecksumTrmP = true;
+   }
+   clApiFrameT.setChecksum(btEnableV);
+   return (writeFrame(clApiFrameT));
+}
+
+
+//----------------------------------------------------------------------------//
+// setFlushThreshold()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::setFlushThreshold(uint32_t ulFrameCntV)
+{
+   if(ulFrameCntV == 0)
+   {
+      ulFrameCntV = 1;
+   }
+   ulFlushThresholdP = ulFrameCntV;
+}
+
+
 //----------------------------------------------------------------------------//
 // setHostAddress()                                                           //
 //                                                                            //
@@ -323,6 +1017,120 @@ void QCanSocket::setHostAddress(QHostAddress clHostAddressV)
    }
 }
 
+//----------------------------------------------------------------------------//
+// setLocalConnection()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::setLocalConnection(bool btEnableV)
+{
+   if(btIsConnectedP == false)
+   {
+      btLocalP = btEnableV;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setNoDelay()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::setNoDelay(bool btEnableV)
+{
+   btNoDelayP = btEnableV;
+   if((btIsConnectedP == true) && (pclSockP == pclTcpSockP.data()) && 
+      (btSharedP == false))
+   {
+      pclTcpSockP->setSocketOption(QAbstractSocket::LowDelayOption, 
+                                   btEnableV ? 1 : 0);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setPriority()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::setPriority(QCanFrameApi::Priority_e tePriorityV)
+{
+   QCanFrameApi   clApiFrameT;
+
+   clApiFrameT.setPriority(tePriorityV);
+   return (writeFrame(clApiFrameT));
+}
+
+
+//----------------------------------------------------------------------------//
+// setSharedRingReader()                                                      //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::setSharedRingReader(bool btEnableV)
+{
+   if(btIsConnectedP == false)
+   {
+      btSharedP = btEnableV;
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// setTransmitConfirm()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::setTransmitConfirm(bool btEnableV)
+{
+   QCanFrameApi   clApiFrameT;
+
+   clApiFrameT.setConfirm(btEnableV);
+   return (writeFrame(clApiFrameT));
+}
+
+
+//----------------------------------------------------------------------------//
+// setWireFormat()                                                            //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::setWireFormat(QCanFrameApi::WireFormat_e teFormatV)
+{
+   QCanFrameApi   clApiFrameT;
+
+   clApiFrameT.setWireFormat(teFormatV);
+   return (writeFrame(clApiFrameT));
+}
+
+
+//----------------------------------------------------------------------------//
+// transmitCredit()                                                           //
+//                                                                            //
+//----------------------------------------------------------------------------//
+int32_t QCanSocket::transmitCredit(void) const
+{
+   //----------------------------------------------------------------
+   // credits might be pending inside the socket
+   //
+   if(btIsConnectedP == true)
+   {
+      receiveFrames();
+   }
+
+   if(btTrmCreditP == false)
+   {
+      return (-1);
+   }
+   return (qMax(slTrmCreditP, 0));
+}
+
+
+//----------------------------------------------------------------------------//
+// uncork()                                                                   //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void QCanSocket::uncork(void)
+{
+   btCorkP = false;
+   flush();
+}
+
+
 //----------------------------------------------------------------------------//
 // writeFrame()                                                               //
 //                                                                            //
@@ -331,13 +1139,20 @@ bool QCanSocket::writeFrame(const QCanFrame & clFrameR)
 {
    bool  btResultT = false;
 
-   if(btIsConnectedP == true)
+   if((btIsConnectedP == true) && 
+      ((btTrmCreditP == false) || (slTrmCreditP > 0)))
    {
-      QByteArray  clDatagramT = clFrameR.toByteArray();
-      if(pclTcpSockP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+      slTrmCreditP--;
+
+      if(btCompactP == true)
+      {
+         btResultT = queueData(clFrameR.toCompactArray());
+      }
+      else
       {
-         pclTcpSockP->flush();
-         btResultT = true;
+         QByteArray clFrameDataT(QCAN_FRAME_ARRAY_SIZE, Qt::Uninitialized);
+         clFrameR.toBuffer((uint8_t *) clFrameDataT.data(), btChecksumTrmP);
+         btResultT = queueData(clFrameDataT);
       }
    }
 
@@ -354,14 +1169,80 @@ bool QCanSocket::writeFrame(const QCanFrameApi & clFrameR)
 
    if(btIsConnectedP == true)
    {
-      QByteArray  clDatagramT = clFrameR.toByteArray();
-      if(pclTcpSockP->write(clDatagramT) == QCAN_FRAME_ARRAY_SIZE)
+      btResultT = queueData(clFrameR.toByteArray());
+   }
+
+   return(btResultT);
+}
+
+
+//----------------------------------------------------------------------------//
+// writeFrames()                                                              //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool QCanSocket::writeFrames(const QCanFrame * pclFrameListV, 
+                             int32_t slFrameCntV)
+{
+   bool     btResultT = false;
+   int32_t  slIdxT;
+   int32_t  slPosT;
+
+   if((btIsConnectedP == true) && (btSharedP == false) &&
+      (pclFrameListV != Q_NULLPTR))
+   {
+      //--------------------------------------------------------
+      // the frames are written as a whole or not at all
+      //
+      if((btTrmCreditP == true) && (slTrmCreditP < slFrameCntV))
       {
-         pclTcpSockP->flush();
-         btResultT = true;
+         return (false);
+      }
+      slTrmCreditP -= slFrameCntV;
+
+      //--------------------------------------------------------
+      // serialize all frames directly into the send buffer and
+      // write them at once, the buffer is truncated to the
+      // number of bytes used afterwards
+      //
+      slPosT = clSendBufP.size();
+      clSendBufP.resize(slPosT + (slFrameCntV * QCAN_FRAME_ARRAY_SIZE));
+      for(slIdxT = 0; slIdxT < slFrameCntV; slIdxT++)
+      {
+         if(btCompactP == true)
+         {
+            slPosT += pclFrameListV[slIdxT].toCompactBuffer(
+                                    (uint8_t *) clSendBufP.data() + slPosT);
+         }
+         else
+         {
+            slPosT += pclFrameListV[slIdxT].toBuffer(
+                                    (uint8_t *) clSendBufP.data() + slPosT,
+                                    btChecksumTrmP);
+         }
+         ulSendCntP++;
+      }
+      clSendBufP.resize(slPosT);
+
+      btResultT = true;
+      if(btCorkP == false)
+      {
+         btResultT = flush();
       }
    }
 
    return(btResultT);
 }
 
+
+//----------------------------------------------------------------------------//
+// wireFormat()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanFrameApi::WireFormat_e QCanSocket::wireFormat(void) const
+{
+   if(btCompactP == true)
+   {
+      return (QCanFrameApi::eWIRE_FORMAT_COMPACT);
+   }
+   return (QCanFrameApi::eWIRE_FORMAT_FIXED);
+}
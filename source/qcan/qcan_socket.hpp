@@ -33,16 +33,27 @@
 
 #include <QHostAddress>
 #include <QPointer>
+#include <QLocalSocket>
 #include <QString>
 #include <QTcpSocket>
+#include <QTimer>
 #include <QVector>
 
 #include "qcan_defs.hpp"
 #include "qcan_frame.hpp"
 #include "qcan_frame_api.hpp"
 #include "qcan_frame_error.hpp"
+#include "qcan_frame_view.hpp"
 
 
+/*----------------------------------------------------------------------------*\
+** Referenced classes                                                         **
+**                                                                            **
+\*----------------------------------------------------------------------------*/
+class QCanNetwork;
+class QCanPipe;
+class QCanSharedRing;
+
 
 //-----------------------------------------------------------------------------
 /*!
@@ -57,6 +68,13 @@
 ** state can be evaluated with isConnected() and error(). Each CAN socket
 ** has an unique identifier for socket management (uuidString()).
 **
+** A client running on the same host as the CAN network can connect by
+** the local server of the network instead of TCP, refer to
+** setLocalConnection(). A client which only receives frames can read the
+** shared memory ring of the network instead, refer to setSharedRingReader().
+** Inside the process of the network the socket can be connected directly to
+** the QCanNetwork object, refer to connectNetwork(QCanNetwork *).
+**
 */
 
 class QCanSocket : public QObject
@@ -74,6 +92,44 @@ public:
 	
 	virtual ~QCanSocket();
 
+   /*!
+   ** \param[in]  ulIdentifierV  Identifier value
+   ** \param[in]  ulMaskV        Mask value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \return     \c true if the filter was sent to the network
+   ** \see        addFilterRange(), clearFilter()
+   **
+   ** Add an identifier / mask acceptance filter for this socket. The filter
+   ** is evaluated by the CAN network (QCanNetwork), a CAN frame is sent to
+   ** the socket if all identifier bits that are set in \a ulMaskV are equal
+   ** to the bits of \a ulIdentifierV. Without any filter the socket
+   ** receives all CAN frames, CAN error frames and API frames are not
+   ** filtered.
+   */
+   bool addFilterMask(uint32_t ulIdentifierV, uint32_t ulMaskV,
+                      bool btExtendedV = false);
+
+   /*!
+   ** \param[in]  ulIdStartV     First identifier value
+   ** \param[in]  ulIdStopV      Last identifier value
+   ** \param[in]  btExtendedV    Extended frame format
+   ** \return     \c true if the filter was sent to the network
+   ** \see        addFilterMask(), clearFilter()
+   **
+   ** Add an identifier range acceptance filter for this socket.
+   */
+   bool addFilterRange(uint32_t ulIdStartV, uint32_t ulIdStopV,
+                       bool btExtendedV = false);
+
+   /*!
+   ** \return     \c true if the request was sent to the network
+   ** \see        addFilterMask(), addFilterRange()
+   **
+   ** Remove all acceptance filters of this socket, afterwards the socket
+   ** receives all CAN frames of the network.
+   */
+   bool clearFilter(void);
+
    /*!
    ** \param[in]  teChannelV     CAN channel
    ** \return     \c true if connection is possible
@@ -87,10 +143,35 @@ public:
    **
    ** The connection is made to QHostAddress::LocalHost, using the port
    ** #QCAN_TCP_DEFAULT_PORT. The host address can be changed with
-   ** setHostAddress().
+   ** setHostAddress(). If setLocalConnection() has been enabled, the
+   ** connection is made to the local server of the network instead.
    */
    bool connectNetwork(CAN_Channel_e teChannelV);
 
+   /*!
+   ** \param[in]  pclNetworkV    Pointer to CAN network
+   ** \return     \c true if connection is possible
+   ** \see        disconnectNetwork()
+   **
+   ** Connect the CAN socket to the CAN network \a pclNetworkV, which must
+   ** exist inside the same process. The frames are exchanged by an
+   ** in-process pipe (QCanPipe) instead of a TCP socket, the kernel is
+   ** not involved. The network dispatches the frames like for any other
+   ** socket. The signal connected() is emitted when the event loop is
+   ** entered again. The method returns \c false if the socket is already
+   ** connected or if the network is not enabled.
+   */
+   bool connectNetwork(QCanNetwork * pclNetworkV);
+
+   /*!
+   ** \see        uncork(), flush()
+   **
+   ** Hold back all frames written to the socket until uncork() or flush()
+   ** is called. This allows a producer to pass a burst of frames to the
+   ** network with a single write operation.
+   */
+   void cork(void);
+
 
    /*!
    ** \see  connectNetwork()
@@ -115,16 +196,41 @@ public:
    ** Returns a description of error that last occurred.
    */
    QString  errorString() const;
+
+   /*!
+   ** \return     \c true if all pending frames were written
+   ** \see        cork(), setFlushThreshold()
+   **
+   ** Write all frames which are pending inside the send buffer of the
+   ** socket to the CAN network.
+   */
+   bool     flush(void);
+
+   /*!
+   ** \return     Flush threshold
+   ** \see        setFlushThreshold()
+   */
+   uint32_t flushThreshold(void) const    { return (ulFlushThresholdP); };
    
    
    /*!
    ** \return     Number of CAN frames available
    **
-   ** Returns the number of CAN frames available on the socket.
+   ** Returns the number of CAN frames available on the socket. API frames
+   ** which only confirm the wire format or the checksum mode or grant
+   ** transmit credits are evaluated by the socket and not counted.
    */
    int32_t  framesAvailable(void) const;
 
 
+   /*!
+   ** \return     \c true if the checksum is used
+   ** \see        setChecksum()
+   **
+   ** The function returns the checksum mode confirmed by the CAN network.
+   */
+   bool isChecksumEnabled(void) const     { return (btChecksumRcvP);    };
+
    /*!
    ** \return     \c true if socket is connected
    **
@@ -133,6 +239,34 @@ public:
    */
    bool isConnected(void);
 
+   /*!
+   ** \return     \c true if the local server is used
+   ** \see        setLocalConnection()
+   */
+   bool isLocalConnection(void) const     { return (btLocalP);          };
+
+   /*!
+   ** \return     \c true if Nagle's algorithm is disabled
+   ** \see        setNoDelay()
+   */
+   bool isNoDelay(void) const             { return (btNoDelayP);        };
+
+   /*!
+   ** \return     \c true if the shared memory ring is read
+   ** \see        setSharedRingReader()
+   */
+   bool isSharedRingReader(void) const    { return (btSharedP);         };
+
+   /*!
+   ** \return     Number of frames lost
+   ** \see        setSharedRingReader()
+   **
+   ** The function returns the number of frames which have been overwritten
+   ** inside the shared memory ring before they could be read. The value is
+   ** reset by connectNetwork().
+   */
+   uint64_t overrunCount(void) const;
+
 
    /*!
    ** \return     UUID string
@@ -151,6 +285,72 @@ public:
    */
    void  setHostAddress(QHostAddress clHostAddressV);
 
+   /*!
+   ** \param[in]  btEnableV      Enable / disable
+   ** \see        isLocalConnection()
+   **
+   ** Connect to the local server of the CAN network (Unix domain socket
+   ** or named pipe, refer to QCanNetwork::localServerName()) instead of
+   ** the TCP server if \a btEnableV is \c true. This avoids the overhead
+   ** of the TCP/IP stack for a client on the same host, the host address
+   ** is not evaluated in that case. The setting can only be modified in
+   ** unconnected state.
+   */
+   void  setLocalConnection(bool btEnableV);
+
+   /*!
+   ** \param[in]  ulFrameCntV    Number of frames
+   ** \see        flush(), cork()
+   **
+   ** Frames written to the socket are collected in a send buffer, the
+   ** buffer is written to the CAN network when it holds \a ulFrameCntV
+   ** frames. Pending frames below the threshold are written when the
+   ** event loop is entered again. The default value is 1, i.e. each
+   ** frame is written immediately.
+   */
+   void  setFlushThreshold(uint32_t ulFrameCntV);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable
+   ** \see        isNoDelay()
+   **
+   ** Enable or disable Nagle's algorithm (option TCP_NODELAY) for the
+   ** connection to the CAN network. Disabling the algorithm reduces the
+   ** latency for single frames, a producer of bursts should use cork()
+   ** or setFlushThreshold() instead.
+   */
+   void  setNoDelay(bool btEnableV);
+
+   /*!
+   ** \param[in]  btEnableV      Enable / disable
+   ** \see        isSharedRingReader()
+   **
+   ** Read the CAN frames from the shared memory ring of the CAN network
+   ** (refer to QCanNetwork::setSharedRingEnabled()) instead of a socket
+   ** connection if \a btEnableV is \c true. The ring is polled every
+   ** millisecond, frames which have been overwritten before they could be
+   ** read are counted by overrunCount(). A shared ring reader can not
+   ** write frames and gets all frames of the network, filters are not
+   ** supported. The setting can only be modified in unconnected state.
+   */
+   void  setSharedRingReader(bool btEnableV);
+
+   /*!
+   ** \param[in]  btEnableV      Enable transmit confirmation
+   ** \return     \c true if the request was sent to the network
+   **
+   ** Request a transmit confirmation for each CAN frame written by the
+   ** socket. The network returns a copy of the frame after it has been
+   ** transmitted, the copy is read like any other frame and has the
+   ** attribute QCanFrame::isTransmitConfirm() set. Its time-stamp is
+   ** the time of transmission taken by the CAN interface if the network
+   ** has enabled QCanNetwork::setTransmitConfirmEnabled(). Together with
+   ** transmitCredit() this allows to keep a defined number of frames in
+   ** flight and to measure the latency up to the CAN bus. The request
+   ** is not confirmed by the network.
+   */
+   bool  setTransmitConfirm(bool btEnableV);
+
 
    /*!
    ** Get error state
@@ -160,6 +360,63 @@ public:
 
    bool  setMode(CAN_Mode_e & teModeR);
 
+   /*!
+   ** \param[in]  btEnableV      Enable checksum
+   ** \return     \c true if the request was sent to the network
+   ** \see        isChecksumEnabled()
+   **
+   ** CAN frames in fixed format carry a CRC-16 which is calculated by
+   ** the sender and verified by the receiver. For a connection via the
+   ** local host the checksum may be disabled, the network rejects the
+   ** request for remote connections. The checksum is disabled as soon
+   ** as the network has confirmed the request, it is enabled again
+   ** immediately for transmission.
+   */
+   bool  setChecksum(bool btEnableV);
+
+   /*!
+   ** \param[in]  tePriorityV    Priority class
+   ** \return     \c true if the request was sent to the network
+   **
+   ** Request the priority class \a tePriorityV for the socket. The
+   ** network reads the frames of sockets with a higher priority class
+   ** first, e.g. a real-time control application should use
+   ** QCanFrameApi::ePRIORITY_REALTIME, an application replaying a trace
+   ** file should use QCanFrameApi::ePRIORITY_BULK. The request is not
+   ** confirmed by the network.
+   */
+   bool  setPriority(QCanFrameApi::Priority_e tePriorityV);
+
+   /*!
+   ** \param[in]  teFormatV      Wire format
+   ** \return     \c true if the request was sent to the network
+   ** \see        wireFormat()
+   **
+   ** Request the wire format \a teFormatV for the CAN frames exchanged
+   ** with the CAN network. The compact format
+   ** (QCanFrameApi::eWIRE_FORMAT_COMPACT) transmits only the payload bytes
+   ** defined by the DLC, it is used as soon as the network has confirmed
+   ** the request. Until then the socket uses the fixed format of
+   ** #QCAN_FRAME_ARRAY_SIZE bytes.
+   */
+   bool  setWireFormat(QCanFrameApi::WireFormat_e teFormatV);
+
+   /*!
+   ** \return     Wire format
+   ** \see        setWireFormat()
+   **
+   ** The function returns the wire format confirmed by the CAN network.
+   */
+   QCanFrameApi::WireFormat_e wireFormat(void) const;
+
+   /*!
+   ** \param[out] clFrameDataR   Byte array of the frame
+   ** \param[out] pubFrameType   Pointer to frame type, may be \c Q_NULLPTR
+   ** \return     \c true if a frame was read
+   **
+   ** The function reads the next frame from the CAN socket, the byte
+   ** array always uses the fixed format of #QCAN_FRAME_ARRAY_SIZE bytes.
+   */
    bool  read( QByteArray & clFrameDataR, 
                QCanData::Type_e * pubFrameType = Q_NULLPTR);
    
@@ -174,6 +431,56 @@ public:
    */
    bool  readFrame(QCanFrame & clFrameR);
 
+   /*!
+   ** \param[out] clFrameViewR   Reference to frame view
+   ** \return     \c true if a frame was read
+   ** \see        readFrame()
+   **
+   ** The function takes the next frame (CAN, API or error frame) from the
+   ** CAN socket and places a view of the frame inside the receive buffer
+   ** in \a clFrameViewR, the frame is not copied. The view is valid until
+   ** the next read function of the socket is called.
+   */
+   bool  readFrameView(QCanFrameView & clFrameViewR);
+
+   /*!
+   ** \param[out] clFrameListR   List of CAN frames
+   ** \param[out] pclErrorListV  Pointer to list of CAN error frames
+   ** \param[out] pclApiListV    Pointer to list of CAN API frames
+   ** \return     Number of frames read
+   ** \see        readFrame()
+   **
+   ** The function reads all frames available on the CAN socket in one
+   ** pass and appends them to the given lists. Error frames and API
+   ** frames are discarded if the corresponding pointer is \c Q_NULLPTR.
+   ** The lists are not cleared by this function.
+   */
+   int32_t  readFrames(QVector<QCanFrame> & clFrameListR,
+                       QVector<QCanFrameError> * pclErrorListV = Q_NULLPTR,
+                       QVector<QCanFrameApi> * pclApiListV = Q_NULLPTR);
+
+   /*!
+   ** \return     Number of transmit credits
+   **
+   ** The network grants transmit credits to the socket, each CAN frame
+   ** written to the socket consumes one credit. A credit is returned by
+   ** the network when the frame has been passed to the CAN interface,
+   ** refer to QCanNetwork::setTransmitCredit(). writeFrame() and
+   ** writeFrames() fail if there are not enough credits left, so a
+   ** producer can write at the rate of the CAN bus without losing frames.
+   ** The signal creditReceived() denotes new credits. The function
+   ** returns -1 if the network does not grant credits.
+   */
+   int32_t  transmitCredit(void) const;
+
+   /*!
+   ** \see        cork(), flush()
+   **
+   ** Write all frames that have been held back since cork() was called
+   ** and return to normal operation.
+   */
+   void  uncork(void);
+
    bool  write(const QByteArray & clFrameDataR);
    
    /*!
@@ -182,7 +489,8 @@ public:
    ** \see  readFrame()
    **
    ** The function writes the CAN frame \a clFrameR to the CAN socket. If
-   ** writing fails, the function returns \c false.
+   ** writing fails or if there is no transmit credit left, the function
+   ** returns \c false.
    */
    bool  writeFrame(const QCanFrame & clFrameR);
 
@@ -201,6 +509,29 @@ public:
    ** This is an overloaded function, using QCanFrameError as parameter.
    */
    bool  writeFrame(const QCanFrameError & clFrameR);
+
+   /*!
+   ** \param[in]  pclFrameListV  Pointer to array of CAN frames
+   ** \param[in]  slFrameCntV    Number of CAN frames
+   ** \return     \c true if all CAN frames were written
+   ** \see        writeFrame()
+   **
+   ** The function writes \a slFrameCntV CAN frames to the CAN socket.
+   ** All frames are passed to the network with one write operation,
+   ** unless the socket is corked. No frame is written if there are less
+   ** than \a slFrameCntV transmit credits left.
+   */
+   bool  writeFrames(const QCanFrame * pclFrameListV, int32_t slFrameCntV);
+
+   /*!
+   ** \param[in]  clFrameListR   List of CAN frames
+   ** \return     \c true if all CAN frames were written
+   **
+   ** This is an overloaded function, using QVector as parameter.
+   */
+   bool  writeFrames(const QVector<QCanFrame> & clFrameListR)
+                     { return (writeFrames(clFrameListR.constData(),
+                                           clFrameListR.size()));      };
    
 
 public slots:
@@ -238,20 +569,85 @@ signals:
    */
    void  framesReceived(uint32_t ulFrameCntV);
 
+   /*!
+   ** \param[in]  ulCreditV      Number of transmit credits
+   **
+   ** This signal is emitted when the network has granted new transmit
+   ** credits. The \a ulCreditV parameter holds the number of available
+   ** credits, refer to transmitCredit().
+   */
+   void  creditReceived(uint32_t ulCreditV);
+
 protected:
 
 private:
 
+   //----------------------------------------------------------------
+   // the socket is connected either by TCP, by the local server or
+   // by an in-process pipe, pclSockP points to the socket in use
+   //
    QPointer<QTcpSocket> pclTcpSockP;
+   QPointer<QLocalSocket> pclLocalSockP;
+   QPointer<QCanPipe>   pclPipeP;
+   QIODevice *          pclSockP;
+   bool                 btLocalP;
+   bool                 btPipeP;
    QHostAddress         clTcpHostAddrP;
    uint16_t             uwTcpPortP;
    bool                 btIsConnectedP;
    int32_t              slSocketErrorP;
 
+   //----------------------------------------------------------------
+   // received data is kept in one buffer: frames between head and
+   // tail are complete and have not been read yet, the data behind
+   // the tail is an incomplete frame
+   //
+   void                 clearBuffers(void);
+   bool                 nextFrame(int32_t & slPosR, int32_t & slSizeR);
+   void                 receiveFrames(void) const;
+   mutable QByteArray   clRecvBufP;
+   mutable int32_t      slRecvHeadP;
+   mutable int32_t      slRecvTailP;
+   mutable int32_t      slRecvCntP;
+   mutable bool         btCompactP;
+   mutable bool         btChecksumRcvP;
+   mutable bool         btChecksumTrmP;
+
+   //----------------------------------------------------------------
+   // transmit credits granted by the network, they are evaluated
+   // as soon as the network has granted the first credits; frames
+   // written before are counted, so the value may be negative
+   //
+   mutable int32_t      slTrmCreditP;
+   mutable bool         btTrmCreditP;
+   mutable bool         btCreditRcvP;
+
+   //----------------------------------------------------------------
+   // reader of the shared memory ring, it is polled by a timer
+   //
+   void                 closeSharedRing(void);
+   QCanSharedRing *     pclSharedRingP;
+   QTimer *             pclRingTmrP;
+   bool                 btSharedP;
+
+   //----------------------------------------------------------------
+   // frames to send are collected in the send buffer
+   //
+   bool                 queueData(const QByteArray & clFrameDataR);
+   QByteArray           clSendBufP;
+   uint32_t             ulSendCntP;
+   uint32_t             ulFlushThresholdP;
+   bool                 btCorkP;
+   bool                 btFlushPendingP;
+   bool                 btNoDelayP;
+
 private slots:
+   void  onFlushTimer(void);
+   void  onRingTimer(void);
    void  onSocketConnect(void);
    void  onSocketDisconnect(void);
    void  onSocketError(QAbstractSocket::SocketError teSocketErrorV);
+   void  onLocalError(QLocalSocket::LocalSocketError teSocketErrorV);
    virtual void  onSocketReceive(void);
 };
 
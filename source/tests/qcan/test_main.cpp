@@ -9,14 +9,28 @@ using namespace std;
 
 
 #include "test_qcan_timestamp.hpp"
+#include "test_qcan_bus_load.hpp"
+#include "test_qcan_histogram.hpp"
+#include "test_qcan_filter.hpp"
+#include "test_qcan_frame_ring.hpp"
+#include "test_qcan_data.hpp"
+#include "test_qcan_pipe.hpp"
+#include "test_qcan_shared_ring.hpp"
 #include "test_qcan_frame.hpp"
 #include "test_qcan_socket.hpp"
+#include "test_qcan_network.hpp"
+#include "test_qcan_interface.hpp"
 
 
 int main(int argc, char *argv[])
 {
    int32_t  slResultT;
 
+   //----------------------------------------------------------------
+   // the network and the socket need an event loop
+   //
+   QCoreApplication  clAppT(argc, argv);
+
    cout << "#===========================================================\n";
    cout << "# Run test cases for QCan classes                           \n";
    cout << "#                                                           \n";
@@ -37,12 +51,66 @@ int main(int argc, char *argv[])
    TestQCanFrame  clTestQCanFrameT;
    slResultT = QTest::qExec(&clTestQCanFrameT, argc, &argv[0]);
 
+   //----------------------------------------------------------------
+   // test QCanData
+   //
+   TestQCanData  clTestQCanDataT;
+   slResultT = QTest::qExec(&clTestQCanDataT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanFilter
+   //
+   TestQCanFilter  clTestQCanFilterT;
+   slResultT = QTest::qExec(&clTestQCanFilterT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanBusLoad
+   //
+   TestQCanBusLoad  clTestQCanBusLoadT;
+   slResultT = QTest::qExec(&clTestQCanBusLoadT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanHistogram
+   //
+   TestQCanHistogram  clTestQCanHistogramT;
+   slResultT = QTest::qExec(&clTestQCanHistogramT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanFrameRing
+   //
+   TestQCanFrameRing  clTestQCanFrameRingT;
+   slResultT = QTest::qExec(&clTestQCanFrameRingT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanSharedRing
+   //
+   TestQCanSharedRing  clTestQCanSharedRingT;
+   slResultT = QTest::qExec(&clTestQCanSharedRingT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanPipe
+   //
+   TestQCanPipe  clTestQCanPipeT;
+   slResultT = QTest::qExec(&clTestQCanPipeT) + slResultT;
+
    //----------------------------------------------------------------
    // test QCanStub
    //
    TestQCanSocket  clTestQCanSockT;
    slResultT = QTest::qExec(&clTestQCanSockT) + slResultT;
 
+   //----------------------------------------------------------------
+   // test QCanInterface
+   //
+   TestQCanInterface  clTestQCanInterfaceT;
+   slResultT = QTest::qExec(&clTestQCanInterfaceT) + slResultT;
+
+   //----------------------------------------------------------------
+   // test QCanNetwork
+   //
+   TestQCanNetwork  clTestQCanNetworkT;
+   slResultT = QTest::qExec(&clTestQCanNetworkT) + slResultT;
+
    cout << "\n";
    cout << "#===========================================================\n";
    cout << "# Total result                                              \n";
@@ -0,0 +1,221 @@
+//============================================================================//
+// File:          test_qcan_bus_load.cpp                                      //
+// Description:   QCAN classes - Test CAN bus load                            //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#include "test_qcan_bus_load.hpp"
+
+
+TestQCanBusLoad::TestQCanBusLoad()
+{
+
+}
+
+
+TestQCanBusLoad::~TestQCanBusLoad()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::initTestCase()
+{
+   pclBusLoadP = new QCanBusLoad();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkBitrate()                                                             //
+// conversion of bit-rate values                                              //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkBitrate()
+{
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_NONE) == 0);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_AUTO) == 0);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_10K)  ==   10000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_20K)  ==   20000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_50K)  ==   50000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_100K) ==  100000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_125K) ==  125000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_250K) ==  250000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_500K) ==  500000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_800K) ==  800000);
+   QVERIFY(QCanBusLoad::bitrateValue(eCAN_BITRATE_1M)   == 1000000);
+   QVERIFY(QCanBusLoad::bitrateValue(250)               ==  250000);
+   QVERIFY(QCanBusLoad::bitrateValue(2000000)           == 2000000);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkClassicBits()                                                         //
+// frame length of classical CAN frames                                       //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkClassicBits()
+{
+   uint32_t ulNomBitsT;
+   uint32_t ulDatBitsT;
+
+   //----------------------------------------------------------------
+   // without stuff bits: 47 + 8 * s (standard), 67 + 8 * s (extended)
+   //
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_STD, 8, false,
+                          QCanBusLoad::eSTUFF_NONE, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 111);
+   QVERIFY(ulDatBitsT == 0);
+
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_EXT, 0, false,
+                          QCanBusLoad::eSTUFF_NONE, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 67);
+
+   //----------------------------------------------------------------
+   // worst case including intermission: 135 and 160 bits
+   //
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_STD, 8, false,
+                          QCanBusLoad::eSTUFF_WORST, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 135);
+
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_EXT, 8, false,
+                          QCanBusLoad::eSTUFF_WORST, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 160);
+
+   //----------------------------------------------------------------
+   // a remote frame has no payload, a DLC above 8 is limited
+   //
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_STD, 8, true,
+                          QCanBusLoad::eSTUFF_NONE, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 47);
+
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_STD, 15, false,
+                          QCanBusLoad::eSTUFF_NONE, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 111);
+
+   //----------------------------------------------------------------
+   // the typical value is between both limits
+   //
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_CAN_STD, 8, false,
+                          QCanBusLoad::eSTUFF_TYPICAL, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT > 111);
+   QVERIFY(ulNomBitsT < 135);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkFdBits()                                                              //
+// frame length of CAN FD frames                                              //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkFdBits()
+{
+   uint32_t ulNomBitsT;
+   uint32_t ulDatBitsT;
+
+   //----------------------------------------------------------------
+   // 64 bytes: arbitration 17 + 12 bits, data phase 5 + 512 bits,
+   // stuff count, CRC-21, fixed stuff bits and CRC delimiter
+   //
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_FD_STD, 15, false,
+                          QCanBusLoad::eSTUFF_NONE, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 29);
+   QVERIFY(ulDatBitsT == 550);
+
+   //----------------------------------------------------------------
+   // 16 bytes use CRC-17
+   //
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_FD_EXT, 10, false,
+                          QCanBusLoad::eSTUFF_NONE, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 48);
+   QVERIFY(ulDatBitsT == 5 + 128 + 4 + 17 + 6 + 1);
+
+   QCanBusLoad::frameBits(QCanFrame::eFORMAT_FD_STD, 15, false,
+                          QCanBusLoad::eSTUFF_WORST, ulNomBitsT, ulDatBitsT);
+   QVERIFY(ulNomBitsT == 29 + 4);
+   QVERIFY(ulDatBitsT == 550 + 129);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkLoad()                                                                //
+// bus load in percent                                                        //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::checkLoad()
+{
+   uint32_t    ulCntT;
+   QCanFrame   clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x123, 8);
+
+   pclBusLoadP->setStuffing(QCanBusLoad::eSTUFF_NONE);
+   pclBusLoadP->setBitrate(eCAN_BITRATE_500K, eCAN_BITRATE_NONE);
+   pclBusLoadP->reset();
+   QVERIFY(pclBusLoadP->load(1000) == 0);
+
+   //----------------------------------------------------------------
+   // 2500 frames with 111 bits at 500 kBit/s: 55.5 %
+   //
+   for(ulCntT = 0; ulCntT < 2500; ulCntT++)
+   {
+      pclBusLoadP->addFrame(clFrameT);
+   }
+   QVERIFY(pclBusLoadP->load(1000) == 55);
+   QVERIFY(pclBusLoadP->load(100)  == 100);
+
+   //----------------------------------------------------------------
+   // 1000 CAN FD frames with 64 bytes at 500 kBit/s / 2 MBit/s:
+   // 58 us + 275 us per frame
+   //
+   pclBusLoadP->setBitrate(eCAN_BITRATE_500K, 2000000);
+   pclBusLoadP->reset();
+   clFrameT = QCanFrame(QCanFrame::eFORMAT_FD_STD, 0x123, 15);
+   clFrameT.setBitrateSwitch(true);
+   for(ulCntT = 0; ulCntT < 1000; ulCntT++)
+   {
+      pclBusLoadP->addFrame(clFrameT);
+   }
+   QVERIFY(pclBusLoadP->load(1000) == 33);
+
+   //----------------------------------------------------------------
+   // without BRS the data phase uses the nominal bit-rate
+   //
+   pclBusLoadP->reset();
+   clFrameT.setBitrateSwitch(false);
+   for(ulCntT = 0; ulCntT < 100; ulCntT++)
+   {
+      pclBusLoadP->addFrame(clFrameT);
+   }
+   QVERIFY(pclBusLoadP->load(1000) == 11);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanBusLoad::cleanupTestCase()
+{
+   delete (pclBusLoadP);
+}
@@ -27,6 +27,10 @@
 //============================================================================//
 
 
+#include <string.h>
+
+#include <QtEndian>
+
 #include "test_qcan_data.hpp"
 
 
@@ -241,6 +245,255 @@ void TestQCanData::checkByteArray()
 }
 
 
+//----------------------------------------------------------------------------//
+// checkBuffer()                                                              //
+// check conversion to / from a caller supplied buffer                        //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkBuffer()
+{
+   QByteArray  clByteArrayT;
+   uint8_t     aubBufferT[QCAN_FRAME_ARRAY_SIZE];
+
+   //----------------------------------------------------------------
+   // the buffer must be identical to the byte array
+   //
+   clByteArrayT = pclCanFrameP->toByteArray();
+   QVERIFY(pclCanFrameP->toBuffer(aubBufferT) == QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(memcmp(aubBufferT, clByteArrayT.constData(), 
+                  QCAN_FRAME_ARRAY_SIZE) == 0);
+
+   //----------------------------------------------------------------
+   // convert back to QCanFrame and check the contents
+   //
+   QCanFrame      clCanFrameCheckT;
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, 
+                                       QCAN_FRAME_ARRAY_SIZE) == true);
+   QVERIFY(clCanFrameCheckT.identifier() == ID_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.dlc()        == DLC_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.marker()     == MARKER_TEST_VALUE);  
+   QVERIFY(clCanFrameCheckT.user()       == USER_TEST_VALUE);
+
+   //----------------------------------------------------------------
+   // a buffer that is too small or has a wrong checksum is rejected
+   //
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, 
+                                       QCAN_FRAME_ARRAY_SIZE - 1) == false);
+   aubBufferT[10] ^= 0xFF;
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, 
+                                       QCAN_FRAME_ARRAY_SIZE) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkChecksum()                                                            //
+// check table driven CRC, corrupted checksum and conversion without checksum //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkChecksum()
+{
+   uint8_t     aubBufferT[QCAN_FRAME_ARRAY_SIZE];
+   uint8_t     ubPosT;
+   QCanFrame   clCanFrameCheckT;
+
+   //----------------------------------------------------------------
+   // the result must be identical to qChecksum()
+   //
+   for(ubPosT = 0; ubPosT < QCAN_FRAME_ARRAY_SIZE; ubPosT++)
+   {
+      aubBufferT[ubPosT] = (uint8_t) (ubPosT * 37 + 11);
+   }
+   QVERIFY(QCanData::checksum(aubBufferT, QCAN_FRAME_ARRAY_SIZE - 2) ==
+           qChecksum((const char *) aubBufferT, QCAN_FRAME_ARRAY_SIZE - 2));
+   QVERIFY(QCanData::checksum(aubBufferT, 0) == 
+           qChecksum((const char *) aubBufferT, 0));
+
+   //----------------------------------------------------------------
+   // a buffer without checksum is only accepted if the checksum
+   // test is disabled
+   //
+   QVERIFY(pclCanFrameP->toBuffer(aubBufferT, false) == QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(aubBufferT[94] == 0);
+   QVERIFY(aubBufferT[95] == 0);
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       false) == true);
+   QVERIFY(clCanFrameCheckT.identifier() == ID_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.dlc()        == DLC_TEST_VALUE);
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       true) == false);
+
+   //----------------------------------------------------------------
+   // the checksum of a fixed frame is stored in big endian format
+   // at byte 94 / 95, a corrupted checksum byte is rejected
+   //
+   QVERIFY(pclCanFrameP->toBuffer(aubBufferT, true) == QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(qFromBigEndian<uint16_t>(aubBufferT + 94) ==
+           qChecksum((const char *) aubBufferT, QCAN_FRAME_ARRAY_SIZE - 2));
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       true) == true);
+
+   aubBufferT[94] ^= 0x01;
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       true) == false);
+   aubBufferT[94] ^= 0x01;
+   aubBufferT[95] ^= 0x80;
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       true) == false);
+   aubBufferT[95] ^= 0x80;
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       true) == true);
+
+   //----------------------------------------------------------------
+   // a corrupted data byte is detected as well
+   //
+   aubBufferT[6] ^= 0x10;
+   QVERIFY(clCanFrameCheckT.fromBuffer(aubBufferT, QCAN_FRAME_ARRAY_SIZE, 
+                                       true) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkPriority()                                                            //
+// priority class inside an API frame                                         //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkPriority()
+{
+   QCanFrameApi               clApiSendT;
+   QCanFrameApi               clApiRcvT;
+   QCanFrameApi::Priority_e   tePriorityT;
+
+   clApiSendT.setPriority(QCanFrameApi::ePRIORITY_BULK);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.function() == QCanFrameApi::eAPI_FUNC_PRIORITY);
+   QVERIFY(clApiRcvT.priority(tePriorityT) == true);
+   QVERIFY(tePriorityT == QCanFrameApi::ePRIORITY_BULK);
+
+   //----------------------------------------------------------------
+   // an unknown class is rejected
+   //
+   clApiSendT.setPriority(QCanFrameApi::ePRIORITY_MAX);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.priority(tePriorityT) == false);
+
+   clApiSendT.setWireFormat(QCanFrameApi::eWIRE_FORMAT_COMPACT);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.priority(tePriorityT) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkCredit()                                                              //
+// transmit credits inside an API frame                                       //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkCredit()
+{
+   QCanFrameApi   clApiSendT;
+   QCanFrameApi   clApiRcvT;
+   uint32_t       ulCreditT = 0;
+
+   clApiSendT.setCredit(0x00012345);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.function() == QCanFrameApi::eAPI_FUNC_CREDIT);
+   QVERIFY(clApiRcvT.credit(ulCreditT) == true);
+   QVERIFY(ulCreditT == 0x00012345);
+
+   clApiSendT.setPriority(QCanFrameApi::ePRIORITY_NORMAL);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.credit(ulCreditT) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkConfirm()                                                             //
+// transmit confirmation inside an API frame and a CAN frame                  //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkConfirm()
+{
+   QCanFrameApi   clApiSendT;
+   QCanFrameApi   clApiRcvT;
+   QCanFrame      clFrameSendT(QCanFrame::eFORMAT_CAN_EXT, 0x1ABCDEF, 4);
+   QCanFrame      clFrameRcvT;
+   bool           btEnableT = false;
+
+   clApiSendT.setConfirm(true);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.function() == QCanFrameApi::eAPI_FUNC_CONFIRM);
+   QVERIFY(clApiRcvT.confirm(btEnableT) == true);
+   QVERIFY(btEnableT == true);
+
+   //----------------------------------------------------------------
+   // the attribute is kept by both wire formats and does not
+   // change the frame format
+   //
+   QVERIFY(clFrameSendT.isTransmitConfirm() == false);
+   clFrameSendT.setTransmitConfirm(true);
+   QVERIFY(clFrameSendT.isTransmitConfirm() == true);
+   QVERIFY(clFrameSendT.frameFormat() == QCanFrame::eFORMAT_CAN_EXT);
+   QVERIFY(clFrameSendT.isRemote() == false);
+
+   QVERIFY(clFrameRcvT.fromByteArray(clFrameSendT.toByteArray()) == true);
+   QVERIFY(clFrameRcvT.isTransmitConfirm() == true);
+   QVERIFY(QCanFrameView(clFrameSendT.toCompactArray()).isTransmitConfirm());
+
+   clFrameSendT.setTransmitConfirm(false);
+   QVERIFY(clFrameRcvT.fromByteArray(clFrameSendT.toByteArray()) == true);
+   QVERIFY(clFrameRcvT.isTransmitConfirm() == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkRawFrame()                                                            //
+// conversion of CAN frame and error frame into binary format                 //
+//----------------------------------------------------------------------------//
+void TestQCanData::checkRawFrame()
+{
+   QCanFrame         clFrameSendT(QCanFrame::eFORMAT_FD_EXT, 0x1ABCDEF, 12);
+   QCanFrame         clFrameRcvT;
+   QCanFrameError    clErrFrameSendT;
+   QCanFrameError    clErrFrameRcvT;
+   QCanData          clDataT(QCanData::eTYPE_CAN);
+   QCanRawFrame_ts   tsRawT;
+   uint8_t           ubCntT;
+
+   for(ubCntT = 0; ubCntT < clFrameSendT.dataSize(); ubCntT++)
+   {
+      clFrameSendT.setData(ubCntT, ubCntT + 0x20);
+   }
+   clFrameSendT.setBitrateSwitch();
+   clFrameSendT.setTimeStamp(QCanTimeStamp(12, 3456));
+
+   //----------------------------------------------------------------
+   // the fields are passed in native byte order
+   //
+   clFrameSendT.toRawFrame(tsRawT);
+   QVERIFY(tsRawT.ulIdentifier == 0x1ABCDEF);
+   QVERIFY(tsRawT.ubMsgDlc     == 12);
+   QVERIFY((tsRawT.ubMsgCtrl & QCAN_RAW_CTRL_EXT) > 0);
+   QVERIFY((tsRawT.ubMsgCtrl & QCAN_RAW_CTRL_FDF) > 0);
+   QVERIFY((tsRawT.ubMsgCtrl & QCAN_RAW_CTRL_BRS) > 0);
+   QVERIFY(tsRawT.ulTimeSec    == 12);
+   QVERIFY(tsRawT.ulTimeNsec   == 3456);
+   QVERIFY(tsRawT.aubData[11]  == 0x2B);
+
+   QVERIFY(clFrameRcvT.fromRawFrame(tsRawT) == true);
+   QVERIFY(clFrameRcvT.toByteArray() == clFrameSendT.toByteArray());
+
+   tsRawT.ubMsgDlc = 16;
+   QVERIFY(clFrameRcvT.fromRawFrame(tsRawT) == false);
+
+   //----------------------------------------------------------------
+   // an error frame keeps its type, it is not accepted as CAN frame
+   //
+   clErrFrameSendT.setErrorState(eCAN_STATE_BUS_PASSIVE);
+   clErrFrameSendT.setErrorCounterReceive(128);
+   clErrFrameSendT.toRawFrame(tsRawT);
+   QVERIFY(clFrameRcvT.fromRawFrame(tsRawT) == false);
+   QVERIFY(clDataT.fromRawFrame(tsRawT) == true);
+   QVERIFY(clDataT.frameType() == QCanData::eTYPE_ERROR);
+   QVERIFY(clErrFrameRcvT.fromByteArray(clDataT.toByteArray()) == true);
+   QVERIFY(clErrFrameRcvT.errorState() == eCAN_STATE_BUS_PASSIVE);
+   QVERIFY(clErrFrameRcvT.errorCounterReceive() == 128);
+}
+
+
 //----------------------------------------------------------------------------//
 // cleanupTestCase()                                                          //
 // cleanup test cases                                                         //
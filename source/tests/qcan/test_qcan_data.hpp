@@ -35,6 +35,7 @@
 #include <QCanFrame>
 #include <QCanFrameApi>
 #include <QCanFrameError>
+#include <QCanFrameView>
 
 
 //-----------------------------------------------------------------------------
@@ -68,6 +69,12 @@ private slots:
    void checkFrameType();
    void checkConversion();
    void checkByteArray();
+   void checkBuffer();
+   void checkChecksum();
+   void checkPriority();
+   void checkCredit();
+   void checkConfirm();
+   void checkRawFrame();
    void cleanupTestCase();
 };
 
@@ -0,0 +1,236 @@
+//============================================================================//
+// File:          test_qcan_filter.cpp                                        //
+// Description:   QCAN classes - Test CAN filter                              //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#include "test_qcan_filter.hpp"
+
+
+TestQCanFilter::TestQCanFilter()
+{
+
+}
+
+
+TestQCanFilter::~TestQCanFilter()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::initTestCase()
+{
+   pclFilterP = new QCanFilter();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkEmpty()                                                               //
+// an empty filter accepts all frames                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::checkEmpty()
+{
+   QVERIFY(pclFilterP->isEmpty() == true);
+   QVERIFY(pclFilterP->match(0x000, false) == true);
+   QVERIFY(pclFilterP->match(0x7FF, false) == true);
+   QVERIFY(pclFilterP->match(0x1FFFFFFF, true) == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkStdMask()                                                             //
+// identifier / mask filter for standard frames                               //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::checkStdMask()
+{
+   uint32_t ulIdValueT;
+
+   pclFilterP->clear();
+   pclFilterP->addMask(0x180, 0x780);
+   QVERIFY(pclFilterP->isEmpty() == false);
+
+   for(ulIdValueT = 0; ulIdValueT <= 0x07FF; ulIdValueT++)
+   {
+      if((ulIdValueT & 0x780) == 0x180)
+      {
+         QVERIFY(pclFilterP->match(ulIdValueT, false) == true);
+      }
+      else
+      {
+         QVERIFY(pclFilterP->match(ulIdValueT, false) == false);
+      }
+   }
+
+   //----------------------------------------------------------------
+   // a filter for standard frames does not accept extended frames
+   //
+   QVERIFY(pclFilterP->match(0x180, true) == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkStdRange()                                                            //
+// identifier range filter for standard frames                                //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::checkStdRange()
+{
+   pclFilterP->clear();
+   pclFilterP->addRange(0x100, 0x10F);
+   pclFilterP->addRange(0x700, 0x7FF);
+
+   QVERIFY(pclFilterP->match(0x0FF, false) == false);
+   QVERIFY(pclFilterP->match(0x100, false) == true);
+   QVERIFY(pclFilterP->match(0x10F, false) == true);
+   QVERIFY(pclFilterP->match(0x110, false) == false);
+   QVERIFY(pclFilterP->match(0x6FF, false) == false);
+   QVERIFY(pclFilterP->match(0x7FF, false) == true);
+
+   //----------------------------------------------------------------
+   // a range with start > stop is ignored
+   //
+   pclFilterP->clear();
+   pclFilterP->addRange(0x200, 0x100);
+   QVERIFY(pclFilterP->isEmpty() == true);
+
+   //----------------------------------------------------------------
+   // a range above the standard identifiers holds no identifier,
+   // it is ignored; a range crossing the limit is clamped
+   //
+   pclFilterP->addRange(0x800, 0xFFF);
+   QVERIFY(pclFilterP->isEmpty() == true);
+   QVERIFY(pclFilterP->match(0x123, false) == true);
+
+   pclFilterP->addRange(0x7F0, 0x9FF);
+   QVERIFY(pclFilterP->isEmpty() == false);
+   QVERIFY(pclFilterP->match(0x7EF, false) == false);
+   QVERIFY(pclFilterP->match(0x7F0, false) == true);
+   QVERIFY(pclFilterP->match(0x7FF, false) == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkExtMask()                                                             //
+// identifier / mask filter for extended frames                               //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::checkExtMask()
+{
+   pclFilterP->clear();
+
+   //----------------------------------------------------------------
+   // small filter (256 identifiers), expanded into the hash
+   //
+   pclFilterP->addMask(0x18FEF100, 0x1FFFFF00, true);
+   QVERIFY(pclFilterP->match(0x18FEF100, true) == true);
+   QVERIFY(pclFilterP->match(0x18FEF1FF, true) == true);
+   QVERIFY(pclFilterP->match(0x18FEF200, true) == false);
+   QVERIFY(pclFilterP->match(0x100, false) == false);
+
+   //----------------------------------------------------------------
+   // large filter, checked one by one
+   //
+   pclFilterP->addMask(0x0C000000, 0x1F000000, true);
+   QVERIFY(pclFilterP->match(0x0C123456, true) == true);
+   QVERIFY(pclFilterP->match(0x0D123456, true) == false);
+   QVERIFY(pclFilterP->match(0x18FEF1AA, true) == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkExtRange()                                                            //
+// identifier range filter for extended frames                                //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::checkExtRange()
+{
+   pclFilterP->clear();
+   pclFilterP->addRange(0x00010000, 0x0001000F, true);
+   pclFilterP->addRange(0x10000000, 0x1FFFFFFF, true);
+
+   QVERIFY(pclFilterP->match(0x0000FFFF, true) == false);
+   QVERIFY(pclFilterP->match(0x00010000, true) == true);
+   QVERIFY(pclFilterP->match(0x0001000F, true) == true);
+   QVERIFY(pclFilterP->match(0x00010010, true) == false);
+   QVERIFY(pclFilterP->match(0x0FFFFFFF, true) == false);
+   QVERIFY(pclFilterP->match(0x1ABCDEF0, true) == true);
+
+   //----------------------------------------------------------------
+   // a range above the extended identifiers is ignored
+   //
+   pclFilterP->clear();
+   pclFilterP->addRange(0x20000000, 0x2FFFFFFF, true);
+   QVERIFY(pclFilterP->isEmpty() == true);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkApiFrame()                                                            //
+// filter definition inside an API frame                                      //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::checkApiFrame()
+{
+   QCanFrameApi               clApiSendT;
+   QCanFrameApi               clApiRcvT;
+   QCanFrameApi::FilterType_e teTypeT;
+   uint32_t                   ulValue1T;
+   uint32_t                   ulValue2T;
+   bool                       btExtendedT;
+
+   clApiSendT.setFilterRange(0x18FEF100, 0x18FEF1FF, true);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.function() == QCanFrameApi::eAPI_FUNC_FILTER);
+   QVERIFY(clApiRcvT.filter(teTypeT, ulValue1T, ulValue2T, btExtendedT) == true);
+   QVERIFY(teTypeT     == QCanFrameApi::eFILTER_RANGE);
+   QVERIFY(ulValue1T   == 0x18FEF100);
+   QVERIFY(ulValue2T   == 0x18FEF1FF);
+   QVERIFY(btExtendedT == true);
+
+   clApiSendT.setFilterMask(0x123, 0x7FF);
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.filter(teTypeT, ulValue1T, ulValue2T, btExtendedT) == true);
+   QVERIFY(teTypeT     == QCanFrameApi::eFILTER_MASK);
+   QVERIFY(ulValue1T   == 0x123);
+   QVERIFY(ulValue2T   == 0x7FF);
+   QVERIFY(btExtendedT == false);
+
+   clApiSendT.setFilterClear();
+   QVERIFY(clApiRcvT.fromByteArray(clApiSendT.toByteArray()) == true);
+   QVERIFY(clApiRcvT.filter(teTypeT, ulValue1T, ulValue2T, btExtendedT) == true);
+   QVERIFY(teTypeT     == QCanFrameApi::eFILTER_CLEAR);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void TestQCanFilter::cleanupTestCase()
+{
+   delete (pclFilterP);
+}
@@ -305,6 +305,159 @@ void TestQCanFrame::checkByteArray()
    }
 }
 
+//----------------------------------------------------------------------------//
+// checkCompactArray()                                                        //
+// check conversion to / from compact format                                  //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::checkCompactArray()
+{
+   QByteArray  clByteArrayT;
+   QByteArray  clCompactT;
+
+   for(uint8_t ubCntT = 0; ubCntT < 16; ubCntT++)
+   {
+      pclFdExtP->setIdentifier(0x18FF0000 + ubCntT);
+      pclFdExtP->setDlc(ubCntT);
+      for(uint8_t ubPosT = 0; ubPosT < pclFdExtP->dataSize(); ubPosT++)
+      {
+         pclFdExtP->setData(ubPosT, ubPosT + ubCntT);
+      }
+      pclFdExtP->setMarker(0);
+      pclFdExtP->setUser(0);
+
+      //--------------------------------------------------------
+      // without user / marker field only the header and the
+      // payload are transmitted
+      //
+      clCompactT = pclFdExtP->toCompactArray();
+      QVERIFY(clCompactT.size() == (QCAN_FRAME_COMPACT_SIZE +
+                                    pclFdExtP->dataSize()));
+      QVERIFY(QCanData::arraySize(clCompactT) == clCompactT.size());
+
+      QVERIFY(pclFrameP->fromByteArray(clCompactT) == true);
+      QVERIFY(pclFrameP->identifier() == (0x18FF0000 + ubCntT));
+      QVERIFY(pclFrameP->dlc() == ubCntT);
+      QVERIFY(pclFrameP->toByteArray() == pclFdExtP->toByteArray());
+
+      //--------------------------------------------------------
+      // user / marker field are optional
+      //
+      pclFdExtP->setMarker(0x223344);
+      pclFdExtP->setUser(0xAB1023);
+      clByteArrayT = pclFdExtP->toByteArray();
+      clCompactT   = pclFdExtP->toCompactArray();
+      QVERIFY(clCompactT.size() == (QCAN_FRAME_COMPACT_SIZE + 8 +
+                                    pclFdExtP->dataSize()));
+      QVERIFY(QCanData::convertToCompact(clByteArrayT) == clCompactT);
+      QVERIFY(QCanData::convertToFixed(clCompactT) == clByteArrayT);
+
+      QVERIFY(pclFrameP->fromByteArray(clCompactT) == true);
+      QVERIFY(pclFrameP->marker() == 0x223344);
+      QVERIFY(pclFrameP->user() == 0xAB1023);
+   }
+
+   //----------------------------------------------------------------
+   // incomplete frame
+   //
+   QVERIFY(QCanData::arraySize(clCompactT.left(5)) == 0);
+   QVERIFY(QCanData::convertToFixed(clCompactT.left(10)).isEmpty());
+}
+
+//----------------------------------------------------------------------------//
+// checkFrameView()                                                           //
+// check view of fixed and compact format                                     //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::checkFrameView()
+{
+   QByteArray     clByteArrayT;
+   QCanFrameView  clFrameViewT;
+
+   pclFdExtP->setIdentifier(0x1234567);
+   pclFdExtP->setDlc(10);
+   for(uint8_t ubPosT = 0; ubPosT < pclFdExtP->dataSize(); ubPosT++)
+   {
+      pclFdExtP->setData(ubPosT, 0xA0 + ubPosT);
+   }
+   pclFdExtP->setMarker(0x11);
+   pclFdExtP->setUser(0x22);
+
+   for(uint8_t ubCntT = 0; ubCntT < 2; ubCntT++)
+   {
+      if(ubCntT == 0)
+      {
+         clByteArrayT = pclFdExtP->toByteArray();
+      }
+      else
+      {
+         clByteArrayT = pclFdExtP->toCompactArray();
+      }
+
+      clFrameViewT.setBuffer((const uint8_t *) clByteArrayT.constData(),
+                             clByteArrayT.size());
+      QVERIFY(clFrameViewT.isValid() == true);
+      QVERIFY(clFrameViewT.isCompact() == (ubCntT == 1));
+      QVERIFY(clFrameViewT.size() == clByteArrayT.size());
+      QVERIFY(clFrameViewT.frameType()   == QCanData::eTYPE_CAN);
+      QVERIFY(clFrameViewT.frameFormat() == QCanFrame::eFORMAT_FD_EXT);
+      QVERIFY(clFrameViewT.identifier()  == 0x1234567);
+      QVERIFY(clFrameViewT.dlc()         == 10);
+      QVERIFY(clFrameViewT.dataSize()    == 16);
+      QVERIFY(clFrameViewT.data(15)      == 0xAF);
+      QVERIFY(clFrameViewT.data(16)      == 0);
+      QVERIFY(clFrameViewT.marker()      == 0x11);
+      QVERIFY(clFrameViewT.user()        == 0x22);
+
+      QVERIFY(clFrameViewT.toFrame(*pclFrameP) == true);
+      QVERIFY(pclFrameP->toByteArray() == pclFdExtP->toByteArray());
+      QVERIFY(clFrameViewT.toByteArray() == pclFdExtP->toByteArray());
+      QVERIFY(clFrameViewT.toCompactArray() == pclFdExtP->toCompactArray());
+
+      //--------------------------------------------------------
+      // an incomplete frame results in an invalid view
+      //
+      clFrameViewT.setBuffer((const uint8_t *) clByteArrayT.constData(),
+                             clByteArrayT.size() - 1);
+      QVERIFY(clFrameViewT.isValid() == false);
+   }
+}
+
+//----------------------------------------------------------------------------//
+// checkArbitration()                                                         //
+// check priority of frames on the CAN bus                                    //
+//----------------------------------------------------------------------------//
+void TestQCanFrame::checkArbitration()
+{
+   QCanFrame   clStdT(QCanFrame::eFORMAT_CAN_STD, 0x123);
+   QCanFrame   clExtT(QCanFrame::eFORMAT_CAN_EXT, 0x123 << 18);
+   QCanFrame   clDataT;
+
+   //----------------------------------------------------------------
+   // lower identifier wins
+   //
+   pclCanStdP->setIdentifier(0x100);
+   QVERIFY(pclCanStdP->arbitrationField() < clStdT.arbitrationField());
+   pclCanExtP->setIdentifier(0x12345678);
+   pclFdExtP->setIdentifier(0x12345679);
+   QVERIFY(pclCanExtP->arbitrationField() < pclFdExtP->arbitrationField());
+
+   //----------------------------------------------------------------
+   // standard frame wins against extended frame with same base
+   // identifier, also as remote frame
+   //
+   QVERIFY(clStdT.arbitrationField() < clExtT.arbitrationField());
+   clStdT.setRemote(true);
+   QVERIFY(clStdT.arbitrationField() < clExtT.arbitrationField());
+
+   //----------------------------------------------------------------
+   // data frame wins against remote frame
+   //
+   clDataT = QCanFrame(QCanFrame::eFORMAT_CAN_STD, 0x123);
+   QVERIFY(clDataT.arbitrationField() < clStdT.arbitrationField());
+   clDataT = clExtT;
+   clExtT.setRemote(true);
+   QVERIFY(clDataT.arbitrationField() < clExtT.arbitrationField());
+}
+
 //----------------------------------------------------------------------------//
 // cleanupTestCase()                                                          //
 // cleanup test cases                                                         //
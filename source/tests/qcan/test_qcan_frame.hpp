@@ -32,6 +32,7 @@
 
 #include <QTest>
 #include <QCanFrame>
+#include <QCanFrameView>
 
 
 //-----------------------------------------------------------------------------
@@ -71,6 +72,9 @@ private slots:
    void checkFrameData();
    void checkFrameRemote();
    void checkByteArray();
+   void checkCompactArray();
+   void checkFrameView();
+   void checkArbitration();
    void cleanupTestCase();
 };
 
@@ -0,0 +1,150 @@
+//============================================================================//
+// File:          test_qcan_frame_ring.cpp                                    //
+// Description:   QCAN classes - Test frame ring                              //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#include "test_qcan_frame_ring.hpp"
+
+
+TestQCanFrameRing::TestQCanFrameRing()
+{
+
+}
+
+
+TestQCanFrameRing::~TestQCanFrameRing()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFrameRing::initTestCase()
+{
+   pclRingP = new QCanFrameRing(6);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkCapacity()                                                            //
+// the number of slots is a power of two                                      //
+//----------------------------------------------------------------------------//
+void TestQCanFrameRing::checkCapacity()
+{
+   QCanFrameRing  clRingT(64);
+
+   QVERIFY(pclRingP->capacity() == 8);
+   QVERIFY(clRingT.capacity()   == 64);
+   QVERIFY(pclRingP->isEmpty()  == true);
+   QVERIFY(pclRingP->isFull()   == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkOrder()                                                               //
+// frames are taken from the ring in the order they have been added           //
+//----------------------------------------------------------------------------//
+void TestQCanFrameRing::checkOrder()
+{
+   int32_t                                      slFrameT;
+   int32_t                                      slLoopT;
+   QByteArray                                   clDataT(QCAN_FRAME_ARRAY_SIZE, 0);
+   const QCanFrameRing::QCanFrameRingSlot_ts *  ptsSlotT;
+
+   //----------------------------------------------------------------
+   // the head and tail index wrap around several times
+   //
+   for(slLoopT = 0; slLoopT < 10; slLoopT++)
+   {
+      for(slFrameT = 0; slFrameT < 5; slFrameT++)
+      {
+         clDataT[0] = (char) slFrameT;
+         QVERIFY(pclRingP->push(clDataT, slLoopT * 10 + slFrameT) == true);
+      }
+      QVERIFY(pclRingP->count() == 5);
+
+      for(slFrameT = 0; slFrameT < 5; slFrameT++)
+      {
+         QVERIFY(pclRingP->front(ptsSlotT) == true);
+         QVERIFY(ptsSlotT->aubData[0] == slFrameT);
+         QVERIFY(ptsSlotT->slSize     == QCAN_FRAME_ARRAY_SIZE);
+         QVERIFY(ptsSlotT->sqTime     == slLoopT * 10 + slFrameT);
+         pclRingP->pop();
+      }
+      QVERIFY(pclRingP->isEmpty() == true);
+      QVERIFY(pclRingP->front(ptsSlotT) == false);
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// checkOverflow()                                                            //
+// a full ring rejects new frames                                             //
+//----------------------------------------------------------------------------//
+void TestQCanFrameRing::checkOverflow()
+{
+   uint32_t       ulFrameT;
+   QByteArray     clDataT(QCAN_FRAME_ARRAY_SIZE, 0);
+   QByteArray     clLargeT(QCAN_FRAME_ARRAY_SIZE + 1, 0);
+
+   QVERIFY(pclRingP->push(QByteArray()) == false);
+   QVERIFY(pclRingP->push(clLargeT) == false);
+
+   for(ulFrameT = 0; ulFrameT < pclRingP->capacity(); ulFrameT++)
+   {
+      QVERIFY(pclRingP->push(clDataT) == true);
+   }
+   QVERIFY(pclRingP->isFull() == true);
+   QVERIFY(pclRingP->push(clDataT) == false);
+
+   //----------------------------------------------------------------
+   // one free slot after pop()
+   //
+   pclRingP->pop();
+   QVERIFY(pclRingP->isFull() == false);
+   QVERIFY(pclRingP->push(clDataT) == true);
+
+   while(pclRingP->isEmpty() == false)
+   {
+      pclRingP->pop();
+   }
+   pclRingP->pop();
+   QVERIFY(pclRingP->count() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanFrameRing::cleanupTestCase()
+{
+   delete (pclRingP);
+}
@@ -0,0 +1,153 @@
+//============================================================================//
+// File:          test_qcan_histogram.cpp                                     //
+// Description:   QCAN classes - Test histogram                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#include "test_qcan_histogram.hpp"
+
+
+TestQCanHistogram::TestQCanHistogram()
+{
+
+}
+
+
+TestQCanHistogram::~TestQCanHistogram()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanHistogram::initTestCase()
+{
+   pclHistogramP = new QCanHistogram();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkBuckets()                                                             //
+// limits of the logarithmic buckets                                          //
+//----------------------------------------------------------------------------//
+void TestQCanHistogram::checkBuckets()
+{
+   int32_t  slBucketT;
+
+   //----------------------------------------------------------------
+   // the values 0 .. 3 have a bucket of their own
+   //
+   QVERIFY(QCanHistogram::bucketLimit(0) == 0);
+   QVERIFY(QCanHistogram::bucketLimit(3) == 3);
+
+   //----------------------------------------------------------------
+   // 4 buckets for each power of two
+   //
+   QVERIFY(QCanHistogram::bucketLimit(4)  ==  4);
+   QVERIFY(QCanHistogram::bucketLimit(8)  ==  8);
+   QVERIFY(QCanHistogram::bucketLimit(9)  == 10);
+   QVERIFY(QCanHistogram::bucketLimit(12) == 16);
+   QVERIFY(QCanHistogram::bucketLimit(13) == 20);
+
+   //----------------------------------------------------------------
+   // the limits must increase
+   //
+   for(slBucketT = 1; slBucketT < QCAN_HISTOGRAM_BUCKETS - 4; slBucketT++)
+   {
+      QVERIFY(QCanHistogram::bucketLimit(slBucketT) > 
+              QCanHistogram::bucketLimit(slBucketT - 1));
+   }
+
+   //----------------------------------------------------------------
+   // each value is counted in the bucket with the matching limits
+   //
+   pclHistogramP->clear();
+   pclHistogramP->add(9);
+   QVERIFY(pclHistogramP->bucketCount(8) == 1);
+   pclHistogramP->add(1000);
+   QVERIFY(pclHistogramP->bucketCount(35) == 1);
+   pclHistogramP->add(UINT64_MAX);
+   QVERIFY(pclHistogramP->bucketCount(251) == 1);
+   QVERIFY(pclHistogramP->count() == 3);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkEmpty()                                                               //
+// histogram without values                                                   //
+//----------------------------------------------------------------------------//
+void TestQCanHistogram::checkEmpty()
+{
+   pclHistogramP->clear();
+   QVERIFY(pclHistogramP->count()   == 0);
+   QVERIFY(pclHistogramP->minimum() == 0);
+   QVERIFY(pclHistogramP->maximum() == 0);
+   QVERIFY(pclHistogramP->mean()    == 0);
+   QVERIFY(pclHistogramP->percentile(500) == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkValues()                                                              //
+// statistic values                                                           //
+//----------------------------------------------------------------------------//
+void TestQCanHistogram::checkValues()
+{
+   uint64_t uqValueT;
+
+   pclHistogramP->clear();
+   for(uqValueT = 1; uqValueT <= 1000; uqValueT++)
+   {
+      pclHistogramP->add(uqValueT);
+   }
+
+   QVERIFY(pclHistogramP->count()   == 1000);
+   QVERIFY(pclHistogramP->minimum() == 1);
+   QVERIFY(pclHistogramP->maximum() == 1000);
+   QVERIFY(pclHistogramP->mean()    == 500);
+
+   //----------------------------------------------------------------
+   // the percentile is the upper limit of the bucket, the median
+   // 500 is inside the bucket 448 .. 511
+   //
+   QVERIFY(pclHistogramP->percentile(500)  == 511);
+   QVERIFY(pclHistogramP->percentile(990)  == 1000);
+   QVERIFY(pclHistogramP->percentile(1000) == 1000);
+   QVERIFY(pclHistogramP->percentile(0)    == 1);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanHistogram::cleanupTestCase()
+{
+   delete (pclHistogramP);
+}
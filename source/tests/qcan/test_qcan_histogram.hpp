@@ -0,0 +1,73 @@
+//============================================================================//
+// File:          test_qcan_histogram.hpp                                     //
+// Description:   QCAN classes - Test histogram                               //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+#ifndef TEST_QCAN_HISTOGRAM_HPP_
+#define TEST_QCAN_HISTOGRAM_HPP_
+
+
+#include <QTest>
+#include <QCanHistogram>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanHistogram
+** \brief   Test histogram
+** 
+*/
+class TestQCanHistogram : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanHistogram();
+   
+   
+   ~TestQCanHistogram();
+
+private:
+   
+   QCanHistogram *   pclHistogramP;
+
+private slots:
+
+   void initTestCase();
+   
+   void checkBuckets();
+   void checkEmpty();
+   void checkValues();
+
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_HISTOGRAM_HPP_
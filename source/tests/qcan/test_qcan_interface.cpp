@@ -0,0 +1,265 @@
+//============================================================================//
+// File:          test_qcan_interface.cpp                                     //
+// Description:   QCAN classes - Test CAN interface                           //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+
+
+#include "test_qcan_interface.hpp"
+
+
+TestQCanInterface::TestQCanInterface()
+{
+
+}
+
+
+TestQCanInterface::~TestQCanInterface()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// create the CAN interface stub                                              //
+//----------------------------------------------------------------------------//
+void TestQCanInterface::initTestCase()
+{
+   pclInterfaceP = new TestQCanInterfaceStub();
+   QVERIFY(pclInterfaceP->connect() == QCanInterface::eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkReadBatch()                                                           //
+// test the default implementation of readBatch()                             //
+//----------------------------------------------------------------------------//
+void TestQCanInterface::checkReadBatch()
+{
+   QCanRawFrame_ts   atsFrameListT[QCAN_INTERFACE_BATCH_MAX];
+   uint32_t          ulFrameCntT;
+   uint32_t          ulFrameNumT;
+   QCanFrame         clCanFrameT(QCanFrame::eFORMAT_FD_EXT, 0x18DA1234, 12);
+   QByteArray        clDataT;
+
+   //----------------------------------------------------------------
+   // no frame available
+   //
+   ulFrameCntT = 99;
+   QVERIFY(pclInterfaceP->readBatch(atsFrameListT, QCAN_INTERFACE_BATCH_MAX,
+                                    ulFrameCntT) == 
+           QCanInterface::eERROR_FIFO_RCV_EMPTY);
+   QVERIFY(ulFrameCntT == 0);
+
+   //----------------------------------------------------------------
+   // the converted frame keeps identifier, control field, DLC,
+   // data and time stamp
+   //
+   for(ulFrameNumT = 0; ulFrameNumT < 24; ulFrameNumT++)
+   {
+      clCanFrameT.setData((uint8_t) ulFrameNumT,
+                          (uint8_t) (0xA0 + ulFrameNumT));
+   }
+   clCanFrameT.setTimeStamp(QCanTimeStamp(12, 345000));
+   pclInterfaceP->appendReceive(clCanFrameT.toByteArray());
+   QVERIFY(pclInterfaceP->readBatch(atsFrameListT, QCAN_INTERFACE_BATCH_MAX,
+                                    ulFrameCntT) == 
+           QCanInterface::eERROR_NONE);
+   QVERIFY(ulFrameCntT == 1);
+   QVERIFY(atsFrameListT[0].ulIdentifier == 0x18DA1234);
+   QVERIFY((atsFrameListT[0].ubMsgCtrl & QCAN_RAW_CTRL_EXT) > 0);
+   QVERIFY((atsFrameListT[0].ubMsgCtrl & QCAN_RAW_CTRL_FDF) > 0);
+   QVERIFY(atsFrameListT[0].ubMsgDlc     == 12);
+   QVERIFY(atsFrameListT[0].ulTimeSec    == 12);
+   QVERIFY(atsFrameListT[0].ulTimeNsec   == 345000);
+   for(ulFrameNumT = 0; ulFrameNumT < 24; ulFrameNumT++)
+   {
+      QVERIFY(atsFrameListT[0].aubData[ulFrameNumT] == 0xA0 + ulFrameNumT);
+   }
+
+   //----------------------------------------------------------------
+   // data which can not be converted by fromByteArray() is skipped:
+   // a short buffer, an empty buffer and a corrupted checksum
+   //
+   for(ulFrameNumT = 0; ulFrameNumT < 4; ulFrameNumT++)
+   {
+      QCanFrame clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x100 + ulFrameNumT, 8);
+
+      pclInterfaceP->appendReceive(clFrameT.toByteArray());
+      if(ulFrameNumT == 0)
+      {
+         pclInterfaceP->appendReceive(QByteArray("abc"));
+      }
+      if(ulFrameNumT == 1)
+      {
+         pclInterfaceP->appendReceive(QByteArray());
+      }
+      if(ulFrameNumT == 2)
+      {
+         clDataT = clFrameT.toByteArray();
+         clDataT[94] = clDataT[94] ^ 0x01;
+         pclInterfaceP->appendReceive(clDataT);
+      }
+   }
+   QVERIFY(pclInterfaceP->readBatch(atsFrameListT, QCAN_INTERFACE_BATCH_MAX,
+                                    ulFrameCntT) == 
+           QCanInterface::eERROR_NONE);
+   QVERIFY(ulFrameCntT == 4);
+   for(ulFrameNumT = 0; ulFrameNumT < 4; ulFrameNumT++)
+   {
+      QVERIFY(atsFrameListT[ulFrameNumT].ulIdentifier == 0x100 + ulFrameNumT);
+      QVERIFY((atsFrameListT[ulFrameNumT].ubMsgCtrl & 
+               (QCAN_RAW_CTRL_EXT | QCAN_RAW_CTRL_FDF)) == 0);
+      QVERIFY(atsFrameListT[ulFrameNumT].ubMsgDlc     == 8);
+   }
+
+   //----------------------------------------------------------------
+   // the batch is limited by ulFrameMaxV, the remaining frames
+   // are returned by the next call
+   //
+   for(ulFrameNumT = 0; ulFrameNumT < 5; ulFrameNumT++)
+   {
+      QCanFrame clFrameT(QCanFrame::eFORMAT_CAN_STD, 0x200 + ulFrameNumT, 0);
+
+      pclInterfaceP->appendReceive(clFrameT.toByteArray());
+   }
+   QVERIFY(pclInterfaceP->readBatch(atsFrameListT, 3, ulFrameCntT) == 
+           QCanInterface::eERROR_NONE);
+   QVERIFY(ulFrameCntT == 3);
+   QVERIFY(atsFrameListT[2].ulIdentifier == 0x202);
+   QVERIFY(pclInterfaceP->readBatch(atsFrameListT, 3, ulFrameCntT) == 
+           QCanInterface::eERROR_NONE);
+   QVERIFY(ulFrameCntT == 2);
+   QVERIFY(atsFrameListT[0].ulIdentifier == 0x203);
+   QVERIFY(atsFrameListT[1].ulIdentifier == 0x204);
+
+   //----------------------------------------------------------------
+   // if no data can be converted, the receive FIFO is reported
+   // as empty
+   //
+   pclInterfaceP->appendReceive(QByteArray("abc"));
+   pclInterfaceP->appendReceive(clDataT);
+   QVERIFY(pclInterfaceP->readBatch(atsFrameListT, QCAN_INTERFACE_BATCH_MAX,
+                                    ulFrameCntT) == 
+           QCanInterface::eERROR_FIFO_RCV_EMPTY);
+   QVERIFY(ulFrameCntT == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkWriteBatch()                                                          //
+// test the default implementation of writeBatch()                            //
+//----------------------------------------------------------------------------//
+void TestQCanInterface::checkWriteBatch()
+{
+   QCanRawFrame_ts   atsFrameListT[4];
+   uint32_t          ulFrameCntT;
+   uint32_t          ulFrameNumT;
+   QCanFrame         clCanFrameT;
+
+   for(ulFrameNumT = 0; ulFrameNumT < 4; ulFrameNumT++)
+   {
+      clCanFrameT = QCanFrame(QCanFrame::eFORMAT_CAN_EXT, 
+                              0x1000 + ulFrameNumT, 8);
+      clCanFrameT.setData(0, (uint8_t) ulFrameNumT);
+      clCanFrameT.toRawFrame(atsFrameListT[ulFrameNumT]);
+   }
+
+   //----------------------------------------------------------------
+   // all frames are written in the given order
+   //
+   pclInterfaceP->writeList().clear();
+   pclInterfaceP->setWriteLimit(-1);
+   QVERIFY(pclInterfaceP->writeBatch(atsFrameListT, 4, ulFrameCntT) == 
+           QCanInterface::eERROR_NONE);
+   QVERIFY(ulFrameCntT == 4);
+   QVERIFY(pclInterfaceP->writeList().size() == 4);
+   for(ulFrameNumT = 0; ulFrameNumT < 4; ulFrameNumT++)
+   {
+      clCanFrameT = pclInterfaceP->writeList().at(ulFrameNumT);
+      QVERIFY(clCanFrameT.identifier() == 0x1000 + ulFrameNumT);
+      QVERIFY(clCanFrameT.isExtended() == true);
+      QVERIFY(clCanFrameT.dlc()        == 8);
+      QVERIFY(clCanFrameT.data(0)      == ulFrameNumT);
+   }
+
+   //----------------------------------------------------------------
+   // partial write: the transmit FIFO accepts only 2 frames, the
+   // error of the first rejected frame is returned
+   //
+   pclInterfaceP->writeList().clear();
+   pclInterfaceP->setWriteLimit(2);
+   QVERIFY(pclInterfaceP->writeBatch(atsFrameListT, 4, ulFrameCntT) == 
+           QCanInterface::eERROR_FIFO_TRM_FULL);
+   QVERIFY(ulFrameCntT == 2);
+   QVERIFY(pclInterfaceP->writeList().size() == 2);
+   QVERIFY(pclInterfaceP->writeList().at(1).identifier() == 0x1001);
+
+   //----------------------------------------------------------------
+   // the remaining frames are written after the FIFO is emptied
+   //
+   pclInterfaceP->writeList().clear();
+   QVERIFY(pclInterfaceP->writeBatch(&atsFrameListT[ulFrameCntT], 
+                                     4 - ulFrameCntT, ulFrameCntT) == 
+           QCanInterface::eERROR_NONE);
+   QVERIFY(ulFrameCntT == 2);
+   QVERIFY(pclInterfaceP->writeList().at(0).identifier() == 0x1002);
+   QVERIFY(pclInterfaceP->writeList().at(1).identifier() == 0x1003);
+
+   //----------------------------------------------------------------
+   // a raw frame which can not be converted stops the batch, 
+   // the frames in front of it are written
+   //
+   pclInterfaceP->writeList().clear();
+   pclInterfaceP->setWriteLimit(-1);
+   atsFrameListT[1].ulIdentifier |= 0x40000000;
+   QVERIFY(pclInterfaceP->writeBatch(atsFrameListT, 4, ulFrameCntT) == 
+           QCanInterface::eERROR_UNKNOWN);
+   QVERIFY(ulFrameCntT == 1);
+   QVERIFY(pclInterfaceP->writeList().size() == 1);
+   atsFrameListT[1].ulIdentifier &= ~0x40000000;
+
+   pclInterfaceP->writeList().clear();
+   atsFrameListT[2].ubMsgDlc = 16;
+   QVERIFY(pclInterfaceP->writeBatch(atsFrameListT, 4, ulFrameCntT) == 
+           QCanInterface::eERROR_UNKNOWN);
+   QVERIFY(ulFrameCntT == 2);
+   QVERIFY(pclInterfaceP->writeList().size() == 2);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+//                                                                            //
+//----------------------------------------------------------------------------//
+void TestQCanInterface::cleanupTestCase()
+{
+   pclInterfaceP->disconnect();
+   delete (pclInterfaceP);
+}
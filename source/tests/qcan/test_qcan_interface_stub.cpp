@@ -0,0 +1,220 @@
+//============================================================================//
+// File:          test_qcan_interface_stub.cpp                                //
+// Description:   QCAN classes - CAN interface stub for tests                 //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+
+#include "test_qcan_interface_stub.hpp"
+
+
+TestQCanInterfaceStub::TestQCanInterfaceStub()
+{
+   btConnectedP  = false;
+   btTrmConfirmP = false;
+   slWriteMaxP   = -1;
+}
+
+
+TestQCanInterfaceStub::~TestQCanInterfaceStub()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// appendReceive()                                                            //
+// add a frame which is returned by read()                                    //
+//----------------------------------------------------------------------------//
+void TestQCanInterfaceStub::appendReceive(const QByteArray & clDataR)
+{
+   clReadListP.append(clDataR);
+}
+
+
+//----------------------------------------------------------------------------//
+// connect()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::connect(void)
+{
+   btConnectedP = true;
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// connected()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+bool TestQCanInterfaceStub::connected(void)
+{
+   return (btConnectedP);
+}
+
+
+//----------------------------------------------------------------------------//
+// disconnect()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::disconnect(void)
+{
+   btConnectedP = false;
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// icon()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QIcon TestQCanInterfaceStub::icon(void)
+{
+   return (QIcon());
+}
+
+
+//----------------------------------------------------------------------------//
+// name()                                                                     //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QString TestQCanInterfaceStub::name(void)
+{
+   return (QString("CAN interface stub"));
+}
+
+
+//----------------------------------------------------------------------------//
+// read()                                                                     //
+// return the frames added by appendReceive()                                 //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::read(
+                                             QByteArray & clDataR)
+{
+   if(clReadListP.isEmpty() == true)
+   {
+      return (eERROR_FIFO_RCV_EMPTY);
+   }
+
+   clDataR = clReadListP.takeFirst();
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// setBitrate()                                                               //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::setBitrate(
+                                             int32_t slNomBitRateV,
+                                             int32_t slDatBitRateV)
+{
+   Q_UNUSED(slNomBitRateV);
+   Q_UNUSED(slDatBitRateV);
+
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// setMode()                                                                  //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::setMode(
+                                             const CAN_Mode_e teModeV)
+{
+   Q_UNUSED(teModeV);
+
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// setTransmitConfirm()                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::setTransmitConfirm(
+                                             bool btEnableV)
+{
+   btTrmConfirmP = btEnableV;
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// state()                                                                    //
+//                                                                            //
+//----------------------------------------------------------------------------//
+CAN_State_e TestQCanInterfaceStub::state(void)
+{
+   return (eCAN_STATE_BUS_ACTIVE);
+}
+
+
+//----------------------------------------------------------------------------//
+// statistic()                                                                //
+//                                                                            //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::statistic(
+                                             QCanStatistic_ts & clStatisticR)
+{
+   clStatisticR.ulRcvCount = 0;
+   clStatisticR.ulTrmCount = (uint32_t) clWriteListP.size();
+   clStatisticR.ulErrCount = 0;
+
+   return (eERROR_NONE);
+}
+
+
+//----------------------------------------------------------------------------//
+// supportedFeatures()                                                        //
+//                                                                            //
+//----------------------------------------------------------------------------//
+uint32_t TestQCanInterfaceStub::supportedFeatures(void)
+{
+   return (QCAN_IF_SUPPORT_TRM_CONFIRM);
+}
+
+
+//----------------------------------------------------------------------------//
+// write()                                                                    //
+// keep the frame in the write list                                           //
+//----------------------------------------------------------------------------//
+QCanInterface::InterfaceError_e TestQCanInterfaceStub::write(
+                                             const QCanFrame & clFrameR)
+{
+   //----------------------------------------------------------------
+   // a write limit of -1 means the transmit FIFO is never full
+   //
+   if((slWriteMaxP >= 0) && (clWriteListP.size() >= slWriteMaxP))
+   {
+      return (eERROR_FIFO_TRM_FULL);
+   }
+
+   clWriteListP.append(clFrameR);
+   return (eERROR_NONE);
+}
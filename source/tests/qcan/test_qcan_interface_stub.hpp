@@ -0,0 +1,114 @@
+//============================================================================//
+// File:          test_qcan_interface_stub.hpp                                //
+// Description:   QCAN classes - CAN interface stub for tests                 //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+
+#ifndef TEST_QCAN_INTERFACE_STUB_HPP_
+#define TEST_QCAN_INTERFACE_STUB_HPP_
+
+
+#include <QIcon>
+#include <QList>
+#include <QVector>
+#include <QCanInterface>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanInterfaceStub
+** \brief   CAN interface stub
+** 
+** The stub replaces a CAN plug-in during the tests. It only implements
+** read() and write(), so the default implementations of readBatch() and
+** writeBatch() are used. The frames returned by read() are added by
+** appendReceive(), the frames passed to write() are kept in a list.
+** A full transmit FIFO is simulated by setWriteLimit().
+*/
+class TestQCanInterfaceStub : public QCanInterface
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanInterfaceStub();
+   
+   
+   ~TestQCanInterfaceStub();
+
+   InterfaceError_e  connect(void);
+   
+   bool              connected(void);
+
+   InterfaceError_e  disconnect(void);
+
+   QIcon             icon(void);
+
+   QString           name(void);
+
+   InterfaceError_e  read(QByteArray & clDataR);
+
+   InterfaceError_e  setBitrate(int32_t slNomBitRateV,
+                                int32_t slDatBitRateV = eCAN_BITRATE_NONE);
+
+   InterfaceError_e  setMode(const CAN_Mode_e teModeV);
+
+   InterfaceError_e  setTransmitConfirm(bool btEnableV);
+
+   CAN_State_e       state(void);
+
+   InterfaceError_e  statistic(QCanStatistic_ts & clStatisticR);
+
+   uint32_t          supportedFeatures(void);
+
+   InterfaceError_e  write(const QCanFrame & clFrameR);
+
+   //----------------------------------------------------------------
+   // control of the stub
+   //
+   void  appendReceive(const QByteArray & clDataR);
+
+   bool  isTransmitConfirmEnabled(void) { return (btTrmConfirmP);  };
+
+   void  setWriteLimit(int32_t slFrameMaxV) { slWriteMaxP = slFrameMaxV; };
+
+   QVector<QCanFrame> & writeList(void) { return (clWriteListP);   };
+
+private:
+   
+   bool                 btConnectedP;
+   bool                 btTrmConfirmP;
+   QList<QByteArray>    clReadListP;
+   QVector<QCanFrame>   clWriteListP;
+   int32_t              slWriteMaxP;
+};
+
+
+
+
+#endif   // TEST_QCAN_INTERFACE_STUB_HPP_
@@ -0,0 +1,494 @@
+//============================================================================//
+// File:          test_qcan_network.cpp                                       //
+// Description:   QCAN classes - Test CAN network                             //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+
+#include "test_qcan_network.hpp"
+
+
+#define  NETWORK_TEST_PORT       ((uint16_t) 55670)
+
+
+TestQCanNetwork::TestQCanNetwork()
+{
+
+}
+
+
+TestQCanNetwork::~TestQCanNetwork()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// dispatch()                                                                 //
+// run one cycle of the dispatcher                                            //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::dispatch(QCanNetwork * pclNetworkV)
+{
+   //----------------------------------------------------------------
+   // the slot is private, it is called by name like the timer of
+   // the network does
+   //
+   QMetaObject::invokeMethod(pclNetworkV, "onTimerEvent", 
+                             Qt::DirectConnection);
+}
+
+
+//----------------------------------------------------------------------------//
+// receive()                                                                  //
+// read the CAN frames and the returned credits of a client                   //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::receive(QCanPipe * pclPipeV, 
+                              QVector<QCanFrame> & clFrameListR,
+                              uint32_t & ulCreditR)
+{
+   int32_t        slPosT = 0;
+   int32_t        slSizeT;
+   uint32_t       ulCreditT;
+   QByteArray     clDataT;
+   QByteArray     clFrameDataT;
+   QCanFrame      clCanFrameT;
+   QCanFrameApi   clApiFrameT;
+
+   clFrameListR.clear();
+   ulCreditR = 0;
+
+   clDataT = pclPipeV->readAll();
+   while(slPosT < clDataT.size())
+   {
+      slSizeT = QCanData::arraySize(clDataT, slPosT);
+      if((slSizeT == 0) || ((clDataT.size() - slPosT) < slSizeT))
+      {
+         break;
+      }
+      clFrameDataT = clDataT.mid(slPosT, slSizeT);
+      slPosT += slSizeT;
+
+      //--------------------------------------------------------
+      // the network sends its name, the bit-rate and the
+      // transmit credits by API frames
+      //
+      if((clFrameDataT.at(0) & 0xE0) == 0x40)
+      {
+         if((clApiFrameT.fromByteArray(clFrameDataT) == true) &&
+            (clApiFrameT.credit(ulCreditT) == true))
+         {
+            ulCreditR += ulCreditT;
+         }
+      }
+      else if(clCanFrameT.fromByteArray(clFrameDataT) == true)
+      {
+         clFrameListR.append(clCanFrameT);
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// send()                                                                     //
+// write CAN frames with ascending identifier to the network                  //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::send(QCanPipe * pclPipeV, uint32_t ulIdentifierV, 
+                           int32_t slFrameCntV)
+{
+   int32_t     slFrameT;
+   QCanFrame   clCanFrameT(QCanFrame::eFORMAT_CAN_STD, ulIdentifierV, 2);
+
+   for(slFrameT = 0; slFrameT < slFrameCntV; slFrameT++)
+   {
+      clCanFrameT.setIdentifier(ulIdentifierV + slFrameT);
+      pclPipeV->write(clCanFrameT.toByteArray());
+   }
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::initTestCase()
+{
+}
+
+
+//----------------------------------------------------------------------------//
+// checkCredit()                                                              //
+// a client can not write beyond its credits, the credits are returned        //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::checkCredit()
+{
+   int32_t              slFrameT;
+   uint32_t             ulCreditT;
+   uint64_t             uqDropT;
+   QCanNetwork          clNetworkT(Q_NULLPTR, NETWORK_TEST_PORT);
+   QCanSocket           clSocketT;
+   QCanPipe             clPipeT;
+   QCanFrame            clCanFrameT(QCanFrame::eFORMAT_CAN_STD, 0x120, 2);
+   QCanFrameApi         clApiFrameT;
+   QVector<QCanFrame>   clFrameListT;
+   QByteArray           clFrameDataT;
+   QCanData::Type_e     teTypeT;
+
+   clNetworkT.setTransmitCredit(4);
+   clNetworkT.setNetworkEnabled(true);
+   QVERIFY(clNetworkT.transmitCredit() == 4);
+
+   //----------------------------------------------------------------
+   // the network grants the credits when the socket connects, the
+   // socket does not write beyond them
+   //
+   QVERIFY(clSocketT.transmitCredit() == -1);
+   QVERIFY(clSocketT.connectNetwork(&clNetworkT) == true);
+   QTRY_VERIFY(clSocketT.isConnected() == true);
+   QVERIFY(clSocketT.transmitCredit() == 4);
+
+   for(slFrameT = 0; slFrameT < 4; slFrameT++)
+   {
+      QVERIFY(clSocketT.writeFrame(clCanFrameT) == true);
+   }
+   QVERIFY(clSocketT.transmitCredit() == 0);
+   QVERIFY(clSocketT.writeFrame(clCanFrameT)  == false);
+   QVERIFY(clSocketT.flush() == true);
+
+   //----------------------------------------------------------------
+   // without CAN interface the frames are passed to the other
+   // clients during the cycle, the credits are returned with the
+   // next write operation of the network
+   //
+   dispatch(&clNetworkT);
+   QVERIFY(clSocketT.transmitCredit() == 4);
+
+   //----------------------------------------------------------------
+   // the credits are consumed by the socket, they are neither
+   // counted nor returned by read()
+   //
+   while(clSocketT.framesAvailable() > 0)
+   {
+      QVERIFY(clSocketT.read(clFrameDataT, &teTypeT) == true);
+      if(teTypeT == QCanData::eTYPE_API)
+      {
+         QVERIFY(clApiFrameT.fromByteArray(clFrameDataT) == true);
+         QVERIFY(clApiFrameT.credit(ulCreditT) == false);
+      }
+   }
+   QVERIFY(clSocketT.read(clFrameDataT, &teTypeT) == false);
+
+   QVERIFY(clSocketT.writeFrame(clCanFrameT)  == true);
+   QVERIFY(clSocketT.transmitCredit() == 3);
+   QVERIFY(clSocketT.flush() == true);
+   dispatch(&clNetworkT);
+   QVERIFY(clSocketT.transmitCredit() == 4);
+
+   //----------------------------------------------------------------
+   // a client ignoring its credits loses the frames beyond them,
+   // which are returned as well; with transmit confirmation the
+   // frames pass the transmit queue of the network
+   //
+   QVERIFY(clNetworkT.connectPipe(&clPipeT) == true);
+   receive(&clPipeT, clFrameListT, ulCreditT);
+   QVERIFY(ulCreditT == 4);
+
+   clApiFrameT.setConfirm(true);
+   clPipeT.write(clApiFrameT.toByteArray());
+   send(&clPipeT, 0x140, 6);
+
+   uqDropT = clNetworkT.metric(QCanNetwork::eMETRIC_TRM_DROP);
+   dispatch(&clNetworkT);
+   QVERIFY(clNetworkT.metric(QCanNetwork::eMETRIC_TRM_DROP) == uqDropT + 2);
+
+   receive(&clPipeT, clFrameListT, ulCreditT);
+   QVERIFY(ulCreditT == 6);
+   QVERIFY(clFrameListT.size() == 4);
+   for(slFrameT = 0; slFrameT < clFrameListT.size(); slFrameT++)
+   {
+      QVERIFY(clFrameListT.at(slFrameT).isTransmitConfirm() == true);
+      QVERIFY(clFrameListT.at(slFrameT).identifier() == 
+              (uint32_t) (0x140 + slFrameT));
+   }
+
+   //----------------------------------------------------------------
+   // the frames within the credits reach the other clients
+   //
+   slFrameT = 0;
+   while(clSocketT.read(clFrameDataT, &teTypeT) == true)
+   {
+      if((teTypeT == QCanData::eTYPE_CAN) && 
+         (clCanFrameT.fromByteArray(clFrameDataT) == true))
+      {
+         QVERIFY(clCanFrameT.identifier() == (uint32_t) (0x140 + slFrameT));
+         slFrameT++;
+      }
+   }
+   QVERIFY(slFrameT == 4);
+
+   //----------------------------------------------------------------
+   // all credits are back, the next frames are accepted
+   //
+   send(&clPipeT, 0x150, 4);
+   uqDropT = clNetworkT.metric(QCanNetwork::eMETRIC_TRM_DROP);
+   dispatch(&clNetworkT);
+   QVERIFY(clNetworkT.metric(QCanNetwork::eMETRIC_TRM_DROP) == uqDropT);
+   receive(&clPipeT, clFrameListT, ulCreditT);
+   QVERIFY(ulCreditT == 4);
+   QVERIFY(clFrameListT.size() == 4);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkScheduler()                                                           //
+// the frame budget is shared by the priority classes                         //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::checkScheduler()
+{
+   int32_t              slCycleT;
+   int32_t              slFrameT;
+   uint32_t             ulCreditT;
+   QCanNetwork          clNetworkT(Q_NULLPTR, NETWORK_TEST_PORT);
+   QCanPipe             clBulkT;
+   QCanPipe             clNormalT;
+   QCanPipe             clRealtimeT;
+   QCanPipe             clObserverT;
+   QCanFrameApi         clApiFrameT;
+   QVector<QCanFrame>   clFrameListT;
+   QCanNetwork::QCanClientStatistic_ts tsStatisticT;
+
+   //----------------------------------------------------------------
+   // one round reads 4 frames from a real-time client, 2 frames
+   // from a normal client and 1 frame from a bulk client, which
+   // is the complete budget
+   //
+   clNetworkT.setFrameBudget(7);
+   clNetworkT.setPriorityWeight(QCanFrameApi::ePRIORITY_REALTIME, 4);
+   clNetworkT.setPriorityWeight(QCanFrameApi::ePRIORITY_NORMAL,   2);
+   clNetworkT.setPriorityWeight(QCanFrameApi::ePRIORITY_BULK,     1);
+   clNetworkT.setNetworkEnabled(true);
+
+   //----------------------------------------------------------------
+   // the bulk client is connected first, so the order of the client
+   // list does not favour the real-time client; the observer keeps
+   // the default class and does not send
+   //
+   QVERIFY(clNetworkT.connectPipe(&clBulkT)     == true);
+   QVERIFY(clNetworkT.connectPipe(&clNormalT)   == true);
+   QVERIFY(clNetworkT.connectPipe(&clRealtimeT) == true);
+   QVERIFY(clNetworkT.connectPipe(&clObserverT) == true);
+
+   clApiFrameT.setPriority(QCanFrameApi::ePRIORITY_BULK);
+   clBulkT.write(clApiFrameT.toByteArray());
+   clApiFrameT.setPriority(QCanFrameApi::ePRIORITY_NORMAL);
+   clNormalT.write(clApiFrameT.toByteArray());
+   clApiFrameT.setPriority(QCanFrameApi::ePRIORITY_REALTIME);
+   clRealtimeT.write(clApiFrameT.toByteArray());
+   dispatch(&clNetworkT);
+
+   QVERIFY(clNetworkT.clientStatistic(0, tsStatisticT) == true);
+   QVERIFY(tsStatisticT.tePriority == QCanFrameApi::ePRIORITY_BULK);
+   QVERIFY(clNetworkT.clientStatistic(2, tsStatisticT) == true);
+   QVERIFY(tsStatisticT.tePriority == QCanFrameApi::ePRIORITY_REALTIME);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+
+   //----------------------------------------------------------------
+   // the real-time client has more frames than it can send during
+   // the test, it must not starve the other classes
+   //
+   send(&clBulkT,     0x300,  8);
+   send(&clNormalT,   0x200, 16);
+   send(&clRealtimeT, 0x100, 64);
+
+   for(slCycleT = 0; slCycleT < 8; slCycleT++)
+   {
+      dispatch(&clNetworkT);
+      receive(&clObserverT, clFrameListT, ulCreditT);
+
+      //--------------------------------------------------------
+      // the real-time class is served first, each class gets
+      // its share of the budget during every cycle
+      //
+      QVERIFY(clFrameListT.size() == 7);
+      for(slFrameT = 0; slFrameT < 4; slFrameT++)
+      {
+         QVERIFY(clFrameListT.at(slFrameT).identifier() == 
+                 (uint32_t) (0x100 + (slCycleT * 4) + slFrameT));
+      }
+      QVERIFY(clFrameListT.at(4).identifier() == 
+              (uint32_t) (0x200 + (slCycleT * 2)));
+      QVERIFY(clFrameListT.at(5).identifier() == 
+              (uint32_t) (0x201 + (slCycleT * 2)));
+      QVERIFY(clFrameListT.at(6).identifier() == 
+              (uint32_t) (0x300 + slCycleT));
+   }
+
+   //----------------------------------------------------------------
+   // the bulk client has sent all frames, it was deferred during
+   // each cycle but the last one
+   //
+   QVERIFY(clNetworkT.clientStatistic(0, tsStatisticT) == true);
+   QVERIFY(tsStatisticT.ulDeferCount == 7);
+   QVERIFY(clNetworkT.metric(QCanNetwork::eMETRIC_DEFER_BULK) == 7);
+
+   //----------------------------------------------------------------
+   // the budget not used by the bulk client is passed to the next
+   // round, which starts with the real-time class again
+   //
+   dispatch(&clNetworkT);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+   QVERIFY(clFrameListT.size() == 7);
+   QVERIFY(clFrameListT.at(0).identifier() == 0x120);
+   QVERIFY(clFrameListT.at(3).identifier() == 0x123);
+   QVERIFY(clFrameListT.at(4).identifier() == 0x210);
+   QVERIFY(clFrameListT.at(5).identifier() == 0x211);
+   QVERIFY(clFrameListT.at(6).identifier() == 0x124);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkTrmConfirm()                                                          //
+// frames are matched with the transmit confirmations of the CAN interface    //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::checkTrmConfirm()
+{
+   uint32_t                ulCreditT;
+   TestQCanInterfaceStub   clInterfaceT;
+   QCanNetwork             clNetworkT(Q_NULLPTR, NETWORK_TEST_PORT);
+   QCanPipe                clSenderT;
+   QCanPipe                clObserverT;
+   QCanFrame               clConfirmT(QCanFrame::eFORMAT_CAN_STD, 0, 2);
+   QCanFrameApi            clApiFrameT;
+   QVector<QCanFrame>      clFrameListT;
+
+   clNetworkT.setTransmitConfirmEnabled(true);
+   clNetworkT.setNetworkEnabled(true);
+   QVERIFY(clNetworkT.addInterface(&clInterfaceT) == true);
+   QVERIFY(clInterfaceT.isTransmitConfirmEnabled() == true);
+
+   QVERIFY(clNetworkT.connectPipe(&clSenderT)   == true);
+   QVERIFY(clNetworkT.connectPipe(&clObserverT) == true);
+   receive(&clSenderT,   clFrameListT, ulCreditT);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+
+   //----------------------------------------------------------------
+   // the frames are written to the CAN interface, they are kept
+   // back until the CAN interface confirms the transmission
+   //
+   clApiFrameT.setConfirm(true);
+   clSenderT.write(clApiFrameT.toByteArray());
+   send(&clSenderT, 0x100, 1);
+   send(&clSenderT, 0x200, 1);
+   send(&clSenderT, 0x300, 1);
+   dispatch(&clNetworkT);
+
+   QVERIFY(clInterfaceT.writeList().size() == 3);
+   QVERIFY(clInterfaceT.writeList().at(0).identifier() == 0x100);
+   QVERIFY(clInterfaceT.writeList().at(2).identifier() == 0x300);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+   QVERIFY(clFrameListT.size() == 0);
+
+   //----------------------------------------------------------------
+   // the confirmation of the second frame also releases the first
+   // frame, whose confirmation is missing: it is forwarded without
+   // the time-stamp of the CAN interface
+   //
+   clConfirmT.setIdentifier(0x200);
+   clConfirmT.setTransmitConfirm(true);
+   clConfirmT.setTimeStamp(QCanTimeStamp(5, 0));
+   clInterfaceT.appendReceive(clConfirmT.toByteArray());
+   dispatch(&clNetworkT);
+
+   QVERIFY(clNetworkT.metric(QCanNetwork::eMETRIC_TRM_CONFIRM) == 1);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+   QVERIFY(clFrameListT.size() == 2);
+   QVERIFY(clFrameListT.at(0).identifier() == 0x100);
+   QVERIFY(clFrameListT.at(0).timeStamp().seconds() != 5);
+   QVERIFY(clFrameListT.at(1).identifier() == 0x200);
+   QVERIFY(clFrameListT.at(1).timeStamp().seconds() == 5);
+   QVERIFY(clFrameListT.at(1).isTransmitConfirm() == false);
+
+   receive(&clSenderT, clFrameListT, ulCreditT);
+   QVERIFY(ulCreditT == 2);
+   QVERIFY(clFrameListT.size() == 2);
+   QVERIFY(clFrameListT.at(0).identifier() == 0x100);
+   QVERIFY(clFrameListT.at(0).isTransmitConfirm() == true);
+   QVERIFY(clFrameListT.at(1).identifier() == 0x200);
+   QVERIFY(clFrameListT.at(1).isTransmitConfirm() == true);
+   QVERIFY(clFrameListT.at(1).timeStamp().seconds() == 5);
+
+   //----------------------------------------------------------------
+   // a confirmation arriving out of order does not match a frame
+   // in flight anymore, it is ignored
+   //
+   clConfirmT.setIdentifier(0x100);
+   clConfirmT.setTimeStamp(QCanTimeStamp(6, 0));
+   clInterfaceT.appendReceive(clConfirmT.toByteArray());
+   clConfirmT.setIdentifier(0x300);
+   clConfirmT.setTimeStamp(QCanTimeStamp(7, 0));
+   clInterfaceT.appendReceive(clConfirmT.toByteArray());
+   dispatch(&clNetworkT);
+
+   QVERIFY(clNetworkT.metric(QCanNetwork::eMETRIC_TRM_CONFIRM) == 2);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+   QVERIFY(clFrameListT.size() == 1);
+   QVERIFY(clFrameListT.at(0).identifier() == 0x300);
+   QVERIFY(clFrameListT.at(0).timeStamp().seconds() == 7);
+
+   receive(&clSenderT, clFrameListT, ulCreditT);
+   QVERIFY(ulCreditT == 1);
+   QVERIFY(clFrameListT.size() == 1);
+   QVERIFY(clFrameListT.at(0).identifier() == 0x300);
+   QVERIFY(clFrameListT.at(0).timeStamp().seconds() == 7);
+
+   //----------------------------------------------------------------
+   // a frame which is never confirmed is forwarded when the
+   // transmit confirmation is disabled
+   //
+   send(&clSenderT, 0x400, 1);
+   dispatch(&clNetworkT);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+   QVERIFY(clFrameListT.size() == 0);
+
+   clNetworkT.setTransmitConfirmEnabled(false);
+   QVERIFY(clInterfaceT.isTransmitConfirmEnabled() == false);
+   dispatch(&clNetworkT);
+   receive(&clObserverT, clFrameListT, ulCreditT);
+   QVERIFY(clFrameListT.size() == 1);
+   QVERIFY(clFrameListT.at(0).identifier() == 0x400);
+   QVERIFY(clNetworkT.metric(QCanNetwork::eMETRIC_TRM_CONFIRM) == 2);
+
+   clNetworkT.removeInterface();
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanNetwork::cleanupTestCase()
+{
+}
@@ -0,0 +1,88 @@
+//============================================================================//
+// File:          test_qcan_network.hpp                                       //
+// Description:   QCAN classes - Test CAN network                             //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+
+#ifndef TEST_QCAN_NETWORK_HPP_
+#define TEST_QCAN_NETWORK_HPP_
+
+
+#include <QTest>
+#include <QVector>
+#include <QCanFrame>
+#include <QCanFrameApi>
+#include <QCanNetwork>
+#include <QCanPipe>
+#include <QCanSocket>
+
+#include "test_qcan_interface_stub.hpp"
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanNetwork
+** \brief   Test CAN network
+** 
+** The clients are connected by in-process pipes. The dispatcher cycle
+** is started by the test case, the timer of the network is not used.
+*/
+class TestQCanNetwork : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanNetwork();
+   
+   
+   ~TestQCanNetwork();
+
+private:
+
+   void  dispatch(QCanNetwork * pclNetworkV);
+   void  receive(QCanPipe * pclPipeV, QVector<QCanFrame> & clFrameListR,
+                 uint32_t & ulCreditR);
+   void  send(QCanPipe * pclPipeV, uint32_t ulIdentifierV, 
+              int32_t slFrameCntV);
+
+private slots:
+
+   void initTestCase();
+   
+   void checkCredit();
+   void checkScheduler();
+   void checkTrmConfirm();
+
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_NETWORK_HPP_
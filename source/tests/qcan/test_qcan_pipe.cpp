@@ -0,0 +1,122 @@
+//============================================================================//
+// File:          test_qcan_pipe.cpp                                          //
+// Description:   QCAN classes - Test in-process pipe                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+#include "test_qcan_pipe.hpp"
+
+
+TestQCanPipe::TestQCanPipe()
+{
+
+}
+
+
+TestQCanPipe::~TestQCanPipe()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanPipe::initTestCase()
+{
+   pclFirstP  = new QCanPipe();
+   pclSecondP = new QCanPipe();
+}
+
+
+//----------------------------------------------------------------------------//
+// checkConnect()                                                             //
+// the second end can be connected only once                                  //
+//----------------------------------------------------------------------------//
+void TestQCanPipe::checkConnect()
+{
+   QCanPipe    clThirdT;
+
+   QVERIFY(pclFirstP->isConnected()            == false);
+   QVERIFY(pclFirstP->write("data", 4)         == -1);
+
+   QVERIFY(pclSecondP->connectPeer(pclSecondP) == false);
+   QVERIFY(pclSecondP->connectPeer(pclFirstP)  == true);
+   QVERIFY(pclFirstP->isConnected()            == true);
+   QVERIFY(pclSecondP->isConnected()           == true);
+
+   QVERIFY(clThirdT.connectPeer(pclFirstP)     == false);
+   QVERIFY(pclFirstP->connectPeer(&clThirdT)   == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkTransfer()                                                            //
+// data is passed in both directions                                          //
+//----------------------------------------------------------------------------//
+void TestQCanPipe::checkTransfer()
+{
+   QByteArray  clDataT(QCAN_FRAME_ARRAY_SIZE, 0x55);
+
+   QVERIFY(pclFirstP->write(clDataT)        == QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(pclFirstP->write(clDataT)        == QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(pclFirstP->bytesToWrite()        == 2 * QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(pclSecondP->bytesAvailable()     == 2 * QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(pclFirstP->bytesAvailable()      == 0);
+
+   QVERIFY(pclSecondP->read(10)             == clDataT.left(10));
+   QVERIFY(pclSecondP->readAll()            == clDataT + clDataT.mid(10));
+   QVERIFY(pclFirstP->bytesToWrite()        == 0);
+
+   QVERIFY(pclSecondP->write("abc", 3)      == 3);
+   QVERIFY(pclFirstP->readAll()             == QByteArray("abc"));
+}
+
+
+//----------------------------------------------------------------------------//
+// checkClose()                                                               //
+// no data can be written to a closed pipe                                    //
+//----------------------------------------------------------------------------//
+void TestQCanPipe::checkClose()
+{
+   pclSecondP->close();
+   QVERIFY(pclSecondP->isOpen()             == false);
+   QVERIFY(pclFirstP->isConnected()         == false);
+   QVERIFY(pclFirstP->write("data", 4)      == -1);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanPipe::cleanupTestCase()
+{
+   delete (pclSecondP);
+   delete (pclFirstP);
+}
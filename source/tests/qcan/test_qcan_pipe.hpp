@@ -0,0 +1,76 @@
+//============================================================================//
+// File:          test_qcan_pipe.hpp                                          //
+// Description:   QCAN classes - Test in-process pipe                         //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+#ifndef TEST_QCAN_PIPE_HPP_
+#define TEST_QCAN_PIPE_HPP_
+
+
+#include <QTest>
+#include <QCanData>
+#include <QCanPipe>
+
+
+//-----------------------------------------------------------------------------
+/*!
+** \class   TestQCanPipe
+** \brief   Test in-process pipe
+** 
+*/
+class TestQCanPipe : public QObject
+{
+   Q_OBJECT
+
+public:
+   
+   TestQCanPipe();
+   
+   
+   ~TestQCanPipe();
+
+private:
+   
+   QCanPipe *  pclFirstP;
+   QCanPipe *  pclSecondP;
+
+private slots:
+
+   void initTestCase();
+   
+   void checkConnect();
+   void checkTransfer();
+   void checkClose();
+
+   void cleanupTestCase();
+};
+
+
+
+
+#endif   // TEST_QCAN_PIPE_HPP_
@@ -0,0 +1,173 @@
+//============================================================================//
+// File:          test_qcan_shared_ring.cpp                                   //
+// Description:   QCAN classes - Test shared memory ring                      //
+//                                                                            //
+// Copyright (C) MicroControl GmbH & Co. KG                                   //
+// 53844 Troisdorf - Germany                                                  //
+// www.microcontrol.net                                                       //
+//                                                                            //
+//----------------------------------------------------------------------------//
+// Redistribution and use in source and binary forms, with or without         //
+// modification, are permitted provided that the following conditions         //
+// are met:                                                                   //
+// 1. Redistributions of source code must retain the above copyright          //
+//    notice, this list of conditions, the following disclaimer and           //
+//    the referenced file 'LICENSE'.                                          //
+// 2. Redistributions in binary form must reproduce the above copyright       //
+//    notice, this list of conditions and the following disclaimer in the     //
+//    documentation and/or other materials provided with the distribution.    //
+// 3. Neither the name of MicroControl nor the names of its contributors      //
+//    may be used to endorse or promote products derived from this software   //
+//    without specific prior written permission.                              //
+//                                                                            //
+// Provided that this notice is retained in full, this software may be        //
+// distributed under the terms of the GNU Lesser General Public License       //
+// ("LGPL") version 3 as distributed in the 'LICENSE' file.                   //
+//                                                                            //
+//============================================================================//
+
+
+
+#include "test_qcan_shared_ring.hpp"
+
+
+//-------------------------------------------------------------------
+// the key differs from the name of a CAN network, so the test
+// can run while a server is active
+//
+#define  TEST_SHARED_RING_KEY    "canpie-test-ring"
+
+
+TestQCanSharedRing::TestQCanSharedRing()
+{
+
+}
+
+
+TestQCanSharedRing::~TestQCanSharedRing()
+{
+
+}
+
+
+//----------------------------------------------------------------------------//
+// initTestCase()                                                             //
+// prepare test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::initTestCase()
+{
+   pclWriterP = new QCanSharedRing(TEST_SHARED_RING_KEY);
+   pclReaderP = new QCanSharedRing(TEST_SHARED_RING_KEY);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkAttach()                                                              //
+// a reader can only attach to an existing ring                               //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkAttach()
+{
+   QVERIFY(pclReaderP->attach()     == false);
+   QVERIFY(pclReaderP->isAttached() == false);
+   QVERIFY(pclReaderP->isClosed()   == true);
+
+   QVERIFY(pclWriterP->create(6)    == true);
+   QVERIFY(pclWriterP->create(6)    == false);
+   QVERIFY(pclReaderP->attach()     == true);
+   QVERIFY(pclReaderP->isClosed()   == false);
+   QVERIFY(pclReaderP->available()  == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkOrder()                                                               //
+// frames are read in the order they have been written                        //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkOrder()
+{
+   int32_t     slFrameT;
+   int32_t     slLoopT;
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   memset(aubDataT, 0, QCAN_FRAME_ARRAY_SIZE);
+
+   //----------------------------------------------------------------
+   // the sequence numbers wrap around the slots several times
+   //
+   for(slLoopT = 0; slLoopT < 10; slLoopT++)
+   {
+      for(slFrameT = 0; slFrameT < 5; slFrameT++)
+      {
+         aubDataT[0] = (uint8_t) slFrameT;
+         pclWriterP->write(aubDataT, QCAN_FRAME_ARRAY_SIZE);
+      }
+      QVERIFY(pclReaderP->available() == 5);
+
+      for(slFrameT = 0; slFrameT < 5; slFrameT++)
+      {
+         QVERIFY(pclReaderP->read(aubDataT) == QCAN_FRAME_ARRAY_SIZE);
+         QVERIFY(aubDataT[0] == slFrameT);
+      }
+      QVERIFY(pclReaderP->read(aubDataT)  == 0);
+   }
+   QVERIFY(pclReaderP->overrunCount() == 0);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkOverrun()                                                             //
+// a slow reader continues with the oldest frame                              //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkOverrun()
+{
+   int32_t     slFrameT;
+   uint8_t     aubDataT[QCAN_FRAME_ARRAY_SIZE];
+
+   memset(aubDataT, 0, QCAN_FRAME_ARRAY_SIZE);
+
+   //----------------------------------------------------------------
+   // 20 frames for 8 slots: the first 12 frames are lost
+   //
+   for(slFrameT = 0; slFrameT < 20; slFrameT++)
+   {
+      aubDataT[0] = (uint8_t) slFrameT;
+      pclWriterP->write(aubDataT, QCAN_FRAME_ARRAY_SIZE);
+   }
+   QVERIFY(pclReaderP->available() == 8);
+
+   QVERIFY(pclReaderP->read(aubDataT) == QCAN_FRAME_ARRAY_SIZE);
+   QVERIFY(aubDataT[0] == 12);
+   QVERIFY(pclReaderP->overrunCount() == 12);
+
+   while(pclReaderP->read(aubDataT) > 0)
+   {
+      QVERIFY(aubDataT[0] < 20);
+   }
+   QVERIFY(aubDataT[0] == 19);
+}
+
+
+//----------------------------------------------------------------------------//
+// checkClose()                                                               //
+// the reader detects the end of the writer                                   //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::checkClose()
+{
+   pclWriterP->detach();
+   QVERIFY(pclWriterP->isAttached() == false);
+   QVERIFY(pclReaderP->isClosed()   == true);
+
+   pclReaderP->detach();
+   QVERIFY(pclReaderP->isAttached() == false);
+}
+
+
+//----------------------------------------------------------------------------//
+// cleanupTestCase()                                                          //
+// cleanup test cases                                                         //
+//----------------------------------------------------------------------------//
+void TestQCanSharedRing::cleanupTestCase()
+{
+   delete (pclReaderP);
+   delete (pclWriterP);
+}
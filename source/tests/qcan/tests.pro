@@ -86,21 +86,52 @@ VPATH += ./../../qcan
 #
 HEADERS +=  qcan_frame.hpp             \
             qcan_interface.hpp         \
+            qcan_network.hpp           \
+            qcan_pipe.hpp              \
             qcan_socket.hpp            \
+            test_qcan_bus_load.hpp     \
+            test_qcan_data.hpp         \
+            test_qcan_filter.hpp       \
             test_qcan_frame.hpp        \
+            test_qcan_frame_ring.hpp   \
+            test_qcan_histogram.hpp    \
+            test_qcan_interface.hpp    \
+            test_qcan_interface_stub.hpp \
+            test_qcan_network.hpp      \
+            test_qcan_pipe.hpp         \
+            test_qcan_shared_ring.hpp  \
             test_qcan_socket.hpp       \
             test_qcan_timestamp.hpp
 
 #---------------------------------------------------------------
 # source files of project 
 #
-SOURCES +=  qcan_data.cpp              \
+SOURCES +=  qcan_bus_load.cpp          \
+            qcan_data.cpp              \
+            qcan_filter.cpp            \
             qcan_frame.cpp             \
             qcan_frame_api.cpp         \
             qcan_frame_error.cpp       \
+            qcan_frame_ring.cpp        \
+            qcan_frame_view.cpp        \
+            qcan_histogram.cpp         \
+            qcan_interface_reader.cpp  \
+            qcan_network.cpp           \
             qcan_timestamp.cpp         \
+            qcan_pipe.cpp              \
+            qcan_shared_ring.cpp       \
             qcan_socket.cpp            \
+            test_qcan_bus_load.cpp     \
+            test_qcan_data.cpp         \
+            test_qcan_filter.cpp       \
             test_qcan_frame.cpp        \
+            test_qcan_frame_ring.cpp   \
+            test_qcan_histogram.cpp    \
+            test_qcan_interface.cpp    \
+            test_qcan_interface_stub.cpp \
+            test_qcan_network.cpp      \
+            test_qcan_pipe.cpp         \
+            test_qcan_shared_ring.cpp  \
             test_qcan_socket.cpp       \
             test_qcan_timestamp.cpp    \
             test_main.cpp